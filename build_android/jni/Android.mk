@@ -7,8 +7,19 @@ include $(CLEAR_VARS)
 LOCAL_MODULE       := libNuanceur
 LOCAL_SRC_FILES    := ../../src/builder/Operations.cpp \
                       ../../src/builder/ShaderBuilder.cpp \
+                      ../../src/builder/UniformLayout.cpp \
                       ../../src/generators/GlslShaderGenerator.cpp \
-                      ../../src/generators/SpirvShaderGenerator.cpp
+                      ../../src/generators/SpirvShaderGenerator.cpp \
+                      ../../src/passes/ConstantFoldingPass.cpp \
+                      ../../src/passes/DeadCodeEliminationPass.cpp \
+                      ../../src/passes/FunctionInliningPass.cpp \
+                      ../../src/passes/IfConversionPass.cpp \
+                      ../../src/passes/InterlockMinimizationPass.cpp \
+                      ../../src/passes/LoopUnrollingPass.cpp \
+                      ../../src/passes/PassUtils.cpp \
+                      ../../src/passes/PrecisionLoweringPass.cpp \
+                      ../../src/passes/UniformBakingPass.cpp \
+                      ../../src/passes/VectorizationPass.cpp
 LOCAL_C_INCLUDES   := $(FRAMEWORK_PATH)/include $(LOCAL_PATH)/../../include
 LOCAL_CPP_FEATURES := exceptions rtti
 
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "ShaderBuilder.h"
+
+namespace Nuanceur
+{
+	class CArrayUint4Value : public CShaderBuilder::SYMBOLREF
+	{
+	public:
+		CArrayUint4Value(const CShaderBuilder::SYMBOL& symbol)
+		    : SYMBOLREF(symbol, SWIZZLE_XYZW)
+		{
+		}
+	};
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "ShaderBuilder.h"
+
+namespace Nuanceur
+{
+	class CBufferPointerUintValue : public CShaderBuilder::SYMBOLREF
+	{
+	public:
+		CBufferPointerUintValue(const CShaderBuilder::SYMBOL& symbol)
+		    : SYMBOLREF(symbol, SWIZZLE_XYZW)
+		{
+		}
+	};
+
+	class CBufferPointerFloat4Value : public CShaderBuilder::SYMBOLREF
+	{
+	public:
+		CBufferPointerFloat4Value(const CShaderBuilder::SYMBOL& symbol)
+		    : SYMBOLREF(symbol, SWIZZLE_XYZW)
+		{
+		}
+	};
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "ShaderBuilder.h"
+
+namespace Nuanceur
+{
+	class CTexture2DDescriptorArrayValue : public CShaderBuilder::SYMBOLREF
+	{
+	public:
+		CTexture2DDescriptorArrayValue(const CShaderBuilder::SYMBOL& symbol)
+		    : SYMBOLREF(symbol, SWIZZLE_XYZW)
+		{
+		}
+	};
+
+	class CImage2DDescriptorArrayValue : public CShaderBuilder::SYMBOLREF
+	{
+	public:
+		CImage2DDescriptorArrayValue(const CShaderBuilder::SYMBOL& symbol)
+		    : SYMBOLREF(symbol, SWIZZLE_XYZW)
+		{
+		}
+	};
+
+	class CImageUint2DDescriptorArrayValue : public CShaderBuilder::SYMBOLREF
+	{
+	public:
+		CImageUint2DDescriptorArrayValue(const CShaderBuilder::SYMBOL& symbol)
+		    : SYMBOLREF(symbol, SWIZZLE_XYZW)
+		{
+		}
+	};
+
+	class CArrayUintDescriptorArrayValue : public CShaderBuilder::SYMBOLREF
+	{
+	public:
+		CArrayUintDescriptorArrayValue(const CShaderBuilder::SYMBOL& symbol)
+		    : SYMBOLREF(symbol, SWIZZLE_XYZW)
+		{
+		}
+	};
+}
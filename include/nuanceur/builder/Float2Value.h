@@ -6,6 +6,7 @@ namespace Nuanceur
 {
 	class CFloat2Rvalue;
 	class CFloatSwizzleSelector4;
+	class CHalf2Value;
 	class CInt2Value;
 	class CBool2Value;
 
@@ -54,6 +55,7 @@ namespace Nuanceur
 		friend CFloat2Rvalue Mix(const CFloat2Value&, const CFloat2Value&, const CBool2Value&);
 		friend CFloat2Rvalue NewFloat2(CShaderBuilder&, float, float);
 		friend CFloat2Rvalue NewFloat2(const CFloatValue&, const CFloatValue&);
+		friend CFloat2Rvalue ToFloat(const CHalf2Value&);
 		friend CFloat2Rvalue ToFloat(const CInt2Value&);
 
 		CFloat2Rvalue(const CFloat2Rvalue&) = default;
@@ -11,10 +11,20 @@ namespace Nuanceur
 	class CFloat4Rvalue;
 	class CTexture2DValue;
 	class CSubpassInputValue;
+	class CUniformTexelBufferValue;
+	class CImage2DValue;
+	class CImage2DArrayValue;
+	class CImage3DValue;
 	class CMatrix44Value;
+	class CArrayFloat4Value;
+	class CArrayMatrix44Value;
+	class CBufferPointerFloat4Value;
 	class CFloatSwizzleSelector;
 	class CFloatSwizzleSelector4;
+	class CHalf4Value;
 	class CInt2Value;
+	class CInt3Value;
+	class CIntValue;
 	class CInt4Value;
 	class CUint4Value;
 
@@ -60,6 +70,9 @@ namespace Nuanceur
 		friend CFloat4Rvalue operator*(const CFloat4Value&, const CFloat4Value&);
 		friend CFloat4Rvalue operator/(const CFloat4Value&, const CFloat4Value&);
 		friend CFloat4Rvalue operator*(const CMatrix44Value&, const CFloat4Value&);
+		friend CFloat4Rvalue Multiply(const CArrayMatrix44Value&, const CIntValue&, const CFloat4Value&);
+		friend CFloat4Rvalue Load(const CArrayFloat4Value&, const CIntValue&);
+		friend CFloat4Rvalue Load(const CBufferPointerFloat4Value&, const CIntValue&);
 		friend CFloat4Rvalue Clamp(const CFloat4Value&, const CFloat4Value&, const CFloat4Value&);
 		friend CFloat4Rvalue NewFloat4(CShaderBuilder&, float, float, float, float);
 		friend CFloat4Rvalue NewFloat4(const CFloatValue&, const CFloat3Value&);
@@ -68,7 +81,17 @@ namespace Nuanceur
 		friend CFloat4Rvalue NewFloat4(const CFloat3Value&, const CFloatValue&);
 		friend CFloat4Rvalue Normalize(const CFloat4Value&);
 		friend CFloat4Rvalue Sample(const CTexture2DValue&, const CFloat2Value&);
+		friend CFloat4Rvalue SampleLod(const CTexture2DValue&, const CFloat2Value&, const CFloatValue&);
+		friend CFloat4Rvalue SampleGrad(const CTexture2DValue&, const CFloat2Value&, const CFloat2Value&, const CFloat2Value&);
+		friend CFloat4Rvalue SampleOffset(const CTexture2DValue&, const CFloat2Value&, int32, int32);
+		friend CFloat4Rvalue Fetch(const CTexture2DValue&, const CInt2Value&, const CIntValue&);
+		friend CFloat4Rvalue Gather(const CTexture2DValue&, const CFloat2Value&, uint32);
+		friend CFloat4Rvalue Fetch(const CUniformTexelBufferValue&, const CIntValue&);
 		friend CFloat4Rvalue Load(const CSubpassInputValue&, const CInt2Value&);
+		friend CFloat4Rvalue Load(const CImage2DValue&, const CInt2Value&);
+		friend CFloat4Rvalue Load(const CImage2DArrayValue&, const CInt3Value&);
+		friend CFloat4Rvalue Load(const CImage3DValue&, const CInt3Value&);
+		friend CFloat4Rvalue ToFloat(const CHalf4Value&);
 		friend CFloat4Rvalue ToFloat(const CInt4Value&);
 		friend CFloat4Rvalue ToFloat(const CUint4Value&);
 
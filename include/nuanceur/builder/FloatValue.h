@@ -5,6 +5,7 @@
 
 namespace Nuanceur
 {
+	class CHalfValue;
 	class CIntValue;
 	class CUintValue;
 	class CFloatRvalue;
@@ -58,6 +59,12 @@ namespace Nuanceur
 		friend CFloatRvalue Mix(const CFloatValue&, const CFloatValue&, const CFloatValue&);
 		friend CFloatRvalue NewFloat(CShaderBuilder&, float);
 		friend CFloatRvalue Saturate(const CFloatValue&);
+		friend CFloatRvalue SubgroupBroadcast(const CFloatValue&, uint32);
+		friend CFloatRvalue SubgroupShuffle(const CFloatValue&, const CUintValue&);
+		friend CFloatRvalue SubgroupAdd(const CFloatValue&, SUBGROUP_OPERATION);
+		friend CFloatRvalue SubgroupMax(const CFloatValue&, SUBGROUP_OPERATION);
+		friend CFloatRvalue SubgroupMin(const CFloatValue&, SUBGROUP_OPERATION);
+		friend CFloatRvalue ToFloat(const CHalfValue&);
 		friend CFloatRvalue ToFloat(const CIntValue&);
 		friend CFloatRvalue ToFloat(const CUintValue&);
 		friend CFloatRvalue Trunc(const CFloatValue&);
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "ShaderBuilder.h"
+
+namespace Nuanceur
+{
+	class CFloat2Value;
+	class CHalfValue;
+	class CHalf2Rvalue;
+
+	class CHalf2Value : public CShaderBuilder::SYMBOLREF
+	{
+	protected:
+		CHalf2Value(const CShaderBuilder::SYMBOL& symbol, SWIZZLE_TYPE swizzle = SWIZZLE_XY)
+		    : SYMBOLREF(symbol, swizzle)
+		{
+			assert(GetSwizzleElementCount(swizzle) == 2);
+		}
+	};
+
+	class CHalf2Lvalue : public CHalf2Value
+	{
+	public:
+		CHalf2Lvalue(const CShaderBuilder::SYMBOL& symbol, SWIZZLE_TYPE swizzle = SWIZZLE_XY)
+		    : CHalf2Value(symbol, swizzle)
+		{
+			assert(IsMaskSwizzle(swizzle));
+		}
+
+		void operator=(const CHalf2Lvalue& lvalue) = delete;
+		void operator=(const CHalf2Rvalue& rvalue);
+	};
+
+	class CHalf2Rvalue : public CHalf2Value
+	{
+	private:
+		friend CHalf2Rvalue operator+(const CHalf2Value&, const CHalf2Value&);
+		friend CHalf2Rvalue operator-(const CHalf2Value&, const CHalf2Value&);
+		friend CHalf2Rvalue operator*(const CHalf2Value&, const CHalf2Value&);
+		friend CHalf2Rvalue operator/(const CHalf2Value&, const CHalf2Value&);
+		friend CHalf2Rvalue NewHalf2(CShaderBuilder&, float, float);
+		friend CHalf2Rvalue NewHalf2(const CHalfValue&, const CHalfValue&);
+		friend CHalf2Rvalue ToHalf(const CFloat2Value&);
+
+		CHalf2Rvalue(const CHalf2Rvalue&) = default;
+
+		CHalf2Rvalue(const CShaderBuilder::SYMBOL& symbol, SWIZZLE_TYPE swizzle = SWIZZLE_XY)
+		    : CHalf2Value(symbol, swizzle)
+		{
+		}
+
+		CHalf2Rvalue& operator=(const CHalf2Rvalue&) = delete;
+	};
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "ShaderBuilder.h"
+
+namespace Nuanceur
+{
+	class CFloat4Value;
+	class CHalf2Value;
+	class CHalf4Rvalue;
+
+	class CHalf4Value : public CShaderBuilder::SYMBOLREF
+	{
+	protected:
+		CHalf4Value(const CShaderBuilder::SYMBOL& symbol, SWIZZLE_TYPE swizzle = SWIZZLE_XYZW)
+		    : SYMBOLREF(symbol, swizzle)
+		{
+			assert(GetSwizzleElementCount(swizzle) == 4);
+		}
+	};
+
+	class CHalf4Lvalue : public CHalf4Value
+	{
+	public:
+		CHalf4Lvalue(const CShaderBuilder::SYMBOL& symbol)
+		    : CHalf4Value(symbol, SWIZZLE_XYZW)
+		{
+		}
+
+		void operator=(const CHalf4Lvalue& lvalue) = delete;
+		void operator=(const CHalf4Rvalue& rvalue);
+	};
+
+	class CHalf4Rvalue : public CHalf4Value
+	{
+	private:
+		friend CHalf4Rvalue operator+(const CHalf4Value&, const CHalf4Value&);
+		friend CHalf4Rvalue operator-(const CHalf4Value&, const CHalf4Value&);
+		friend CHalf4Rvalue operator*(const CHalf4Value&, const CHalf4Value&);
+		friend CHalf4Rvalue operator/(const CHalf4Value&, const CHalf4Value&);
+		friend CHalf4Rvalue Clamp(const CHalf4Value&, const CHalf4Value&, const CHalf4Value&);
+		friend CHalf4Rvalue Mix(const CHalf4Value&, const CHalf4Value&, const CHalf4Value&);
+		friend CHalf4Rvalue NewHalf4(CShaderBuilder&, float, float, float, float);
+		friend CHalf4Rvalue NewHalf4(const CHalf2Value&, const CHalf2Value&);
+		friend CHalf4Rvalue ToHalf(const CFloat4Value&);
+
+		CHalf4Rvalue(const CHalf4Rvalue&) = default;
+
+		CHalf4Rvalue(const CShaderBuilder::SYMBOL& symbol, SWIZZLE_TYPE swizzle = SWIZZLE_XYZW)
+		    : CHalf4Value(symbol, swizzle)
+		{
+		}
+
+		CHalf4Rvalue& operator=(const CHalf4Rvalue&) = delete;
+	};
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "ShaderBuilder.h"
+
+namespace Nuanceur
+{
+	class CFloatValue;
+	class CHalfRvalue;
+
+	class CHalfValue : public CShaderBuilder::SYMBOLREF
+	{
+	protected:
+		CHalfValue(const CShaderBuilder::SYMBOL& symbol, SWIZZLE_TYPE swizzle = SWIZZLE_X)
+		    : SYMBOLREF(symbol, swizzle)
+		{
+			assert(GetSwizzleElementCount(swizzle) == 1);
+		}
+	};
+
+	class CHalfLvalue : public CHalfValue
+	{
+	public:
+		CHalfLvalue(const CShaderBuilder::SYMBOL& symbol, SWIZZLE_TYPE swizzle = SWIZZLE_X)
+		    : CHalfValue(symbol, swizzle)
+		{
+			assert(IsMaskSwizzle(swizzle));
+		}
+
+		void operator=(const CHalfLvalue& lvalue) = delete;
+		void operator=(const CHalfRvalue& rvalue);
+	};
+
+	class CHalfRvalue : public CHalfValue
+	{
+	private:
+		friend CHalfRvalue operator+(const CHalfValue&, const CHalfValue&);
+		friend CHalfRvalue operator-(const CHalfValue&, const CHalfValue&);
+		friend CHalfRvalue operator*(const CHalfValue&, const CHalfValue&);
+		friend CHalfRvalue operator/(const CHalfValue&, const CHalfValue&);
+		friend CHalfRvalue NewHalf(CShaderBuilder&, float);
+		friend CHalfRvalue ToHalf(const CFloatValue&);
+
+		CHalfRvalue(const CHalfRvalue&) = default;
+
+		CHalfRvalue(const CShaderBuilder::SYMBOL& symbol, SWIZZLE_TYPE swizzle = SWIZZLE_X)
+		    : CHalfValue(symbol, swizzle)
+		{
+		}
+
+		CHalfRvalue& operator=(const CHalfRvalue&) = delete;
+	};
+}
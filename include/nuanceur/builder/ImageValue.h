@@ -0,0 +1,51 @@
+#pragma once
+
+#include "ShaderBuilder.h"
+
+namespace Nuanceur
+{
+	class CImage2DValue : public CShaderBuilder::SYMBOLREF
+	{
+	public:
+		CImage2DValue(const CShaderBuilder::SYMBOL& symbol)
+		    : SYMBOLREF(symbol, SWIZZLE_XYZW)
+		{
+		}
+	};
+
+	class CImage2DArrayValue : public CShaderBuilder::SYMBOLREF
+	{
+	public:
+		CImage2DArrayValue(const CShaderBuilder::SYMBOL& symbol)
+		    : SYMBOLREF(symbol, SWIZZLE_XYZW)
+		{
+		}
+	};
+
+	class CImage3DValue : public CShaderBuilder::SYMBOLREF
+	{
+	public:
+		CImage3DValue(const CShaderBuilder::SYMBOL& symbol)
+		    : SYMBOLREF(symbol, SWIZZLE_XYZW)
+		{
+		}
+	};
+
+	class CImageUint2DArrayValue : public CShaderBuilder::SYMBOLREF
+	{
+	public:
+		CImageUint2DArrayValue(const CShaderBuilder::SYMBOL& symbol)
+		    : SYMBOLREF(symbol, SWIZZLE_XYZW)
+		{
+		}
+	};
+
+	class CImageUint3DValue : public CShaderBuilder::SYMBOLREF
+	{
+	public:
+		CImageUint3DValue(const CShaderBuilder::SYMBOL& symbol)
+		    : SYMBOLREF(symbol, SWIZZLE_XYZW)
+		{
+		}
+	};
+}
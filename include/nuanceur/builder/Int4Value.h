@@ -7,6 +7,8 @@ namespace Nuanceur
 	class CIntSwizzleSelector4;
 	class CInt4Rvalue;
 	class CFloat4Value;
+	class CArrayInt4Value;
+	class CIntValue;
 
 	class CInt4Value : public CShaderBuilder::SYMBOLREF
 	{
@@ -52,6 +54,7 @@ namespace Nuanceur
 		friend CInt4Rvalue NewInt4(const CIntValue&, const CIntValue&, const CIntValue&, const CIntValue&);
 		friend CInt4Rvalue NewInt4(const CInt3Value&, const CIntValue&);
 		friend CInt4Rvalue ToInt(const CFloat4Value&);
+		friend CInt4Rvalue Load(const CArrayInt4Value&, const CIntValue&);
 
 		CInt4Rvalue(const CInt4Rvalue&) = default;
 
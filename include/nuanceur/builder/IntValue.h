@@ -54,6 +54,13 @@ namespace Nuanceur
 		friend CIntRvalue Clamp(const CIntValue&, const CIntValue&, const CIntValue&);
 		friend CIntRvalue Min(const CIntValue&, const CIntValue&);
 		friend CIntRvalue NewInt(CShaderBuilder& owner, int32 x);
+		friend CIntRvalue SubgroupBroadcast(const CIntValue&, uint32);
+		friend CIntRvalue SubgroupShuffle(const CIntValue&, const CUintValue&);
+		friend CIntRvalue SubgroupAdd(const CIntValue&, SUBGROUP_OPERATION);
+		friend CIntRvalue SubgroupAnd(const CIntValue&, SUBGROUP_OPERATION);
+		friend CIntRvalue SubgroupMax(const CIntValue&, SUBGROUP_OPERATION);
+		friend CIntRvalue SubgroupMin(const CIntValue&, SUBGROUP_OPERATION);
+		friend CIntRvalue SubgroupOr(const CIntValue&, SUBGROUP_OPERATION);
 		friend CIntRvalue ToInt(const CFloatValue&);
 		friend CIntRvalue ToInt(const CUintValue&);
 
@@ -4,27 +4,38 @@
 #include "ShaderBuilder.h"
 
 #include "ArrayUintValue.h"
+#include "ArrayUint2Value.h"
+#include "ArrayUint4Value.h"
 #include "ArrayUcharValue.h"
 #include "ArrayUshortValue.h"
 #include "BoolValue.h"
 #include "Bool2Value.h"
+#include "BufferPointerValue.h"
+#include "DescriptorArrayValue.h"
 #include "FloatValue.h"
 #include "Float2Value.h"
 #include "Float3Value.h"
 #include "Float4Value.h"
+#include "HalfValue.h"
+#include "Half2Value.h"
+#include "Half4Value.h"
 #include "ImageUint2DValue.h"
+#include "ImageValue.h"
 #include "IntValue.h"
 #include "Int2Value.h"
 #include "Int3Value.h"
 #include "Int4Value.h"
 #include "Matrix44Value.h"
 #include "SubpassInputValue.h"
+#include "TexelBufferValue.h"
 #include "Texture2DValue.h"
 #include "UintValue.h"
 #include "UshortValue.h"
 #include "UcharValue.h"
+#include "Uint2Value.h"
 #include "Uint3Value.h"
 #include "Uint4Value.h"
+#include "UniformArrayValue.h"
 
 namespace Nuanceur
 {
@@ -32,6 +43,9 @@ namespace Nuanceur
 	CFloat2Rvalue operator+(const CFloat2Value& lhs, const CFloat2Value& rhs);
 	CFloat3Rvalue operator+(const CFloat3Value& lhs, const CFloat3Value& rhs);
 	CFloat4Rvalue operator+(const CFloat4Value& lhs, const CFloat4Value& rhs);
+	CHalfRvalue operator+(const CHalfValue& lhs, const CHalfValue& rhs);
+	CHalf2Rvalue operator+(const CHalf2Value& lhs, const CHalf2Value& rhs);
+	CHalf4Rvalue operator+(const CHalf4Value& lhs, const CHalf4Value& rhs);
 	CIntRvalue operator+(const CIntValue& lhs, const CIntValue& rhs);
 	CInt2Rvalue operator+(const CInt2Value& lhs, const CInt2Value& rhs);
 	CInt3Rvalue operator+(const CInt3Value& lhs, const CInt3Value& rhs);
@@ -41,6 +55,9 @@ namespace Nuanceur
 	CFloatRvalue operator-(const CFloatValue& lhs, const CFloatValue& rhs);
 	CFloat3Rvalue operator-(const CFloat3Value& lhs, const CFloat3Value& rhs);
 	CFloat4Rvalue operator-(const CFloat4Value& lhs, const CFloat4Value& rhs);
+	CHalfRvalue operator-(const CHalfValue& lhs, const CHalfValue& rhs);
+	CHalf2Rvalue operator-(const CHalf2Value& lhs, const CHalf2Value& rhs);
+	CHalf4Rvalue operator-(const CHalf4Value& lhs, const CHalf4Value& rhs);
 	CIntRvalue operator-(const CIntValue& lhs, const CIntValue& rhs);
 	CInt3Rvalue operator-(const CInt3Value& lhs, const CInt3Value& rhs);
 	CUint3Rvalue operator-(const CUint3Value& lhs, const CUint3Value& rhs);
@@ -49,6 +66,9 @@ namespace Nuanceur
 	CFloat2Rvalue operator*(const CFloat2Value& lhs, const CFloat2Value& rhs);
 	CFloat3Rvalue operator*(const CFloat3Value& lhs, const CFloat3Value& rhs);
 	CFloat4Rvalue operator*(const CFloat4Value& lhs, const CFloat4Value& rhs);
+	CHalfRvalue operator*(const CHalfValue& lhs, const CHalfValue& rhs);
+	CHalf2Rvalue operator*(const CHalf2Value& lhs, const CHalf2Value& rhs);
+	CHalf4Rvalue operator*(const CHalf4Value& lhs, const CHalf4Value& rhs);
 	CInt3Rvalue operator*(const CInt3Value& lhs, const CInt3Value& rhs);
 	CUint3Rvalue operator*(const CUint3Value& lhs, const CUint3Value& rhs);
 
@@ -60,6 +80,9 @@ namespace Nuanceur
 	CFloatRvalue operator/(const CFloatValue& lhs, const CFloatValue& rhs);
 	CFloat2Rvalue operator/(const CFloat2Value& lhs, const CFloat2Value& rhs);
 	CFloat4Rvalue operator/(const CFloat4Value& lhs, const CFloat4Value& rhs);
+	CHalfRvalue operator/(const CHalfValue& lhs, const CHalfValue& rhs);
+	CHalf2Rvalue operator/(const CHalf2Value& lhs, const CHalf2Value& rhs);
+	CHalf4Rvalue operator/(const CHalf4Value& lhs, const CHalf4Value& rhs);
 	CIntRvalue operator/(const CIntValue& lhs, const CIntValue& rhs);
 
 	CIntRvalue operator%(const CIntValue& lhs, const CIntValue& rhs);
@@ -113,6 +136,7 @@ namespace Nuanceur
 
 	CFloatRvalue Abs(const CFloatValue&);
 	CFloat4Rvalue Clamp(const CFloat4Value&, const CFloat4Value&, const CFloat4Value&);
+	CHalf4Rvalue Clamp(const CHalf4Value&, const CHalf4Value&, const CHalf4Value&);
 	CIntRvalue Clamp(const CIntValue&, const CIntValue&, const CIntValue&);
 	CInt4Rvalue Clamp(const CInt4Value&, const CInt4Value&, const CInt4Value&);
 	CFloat2Rvalue Fract(const CFloat2Value&);
@@ -122,6 +146,7 @@ namespace Nuanceur
 	CFloatRvalue Mix(const CFloatValue&, const CFloatValue&, const CFloatValue&);
 	CFloat2Rvalue Mix(const CFloat2Value&, const CFloat2Value&, const CBool2Value&);
 	CFloat3Rvalue Mix(const CFloat3Value&, const CFloat3Value&, const CFloat3Value&);
+	CHalf4Rvalue Mix(const CHalf4Value&, const CHalf4Value&, const CHalf4Value&);
 	CFloat4Rvalue Normalize(const CFloat4Value& rhs);
 	CFloatRvalue Saturate(const CFloatValue& rhs);
 	CInt3Rvalue ShiftRightArithmetic(const CInt3Value&, const CInt3Value&);
@@ -141,6 +166,14 @@ namespace Nuanceur
 	CFloat4Rvalue NewFloat4(const CFloat2Value& xy, const CFloat2Value& zw);
 	CFloat4Rvalue NewFloat4(const CFloat3Value& xyz, const CFloatValue& w);
 
+	CHalfRvalue NewHalf(CShaderBuilder& owner, float x);
+
+	CHalf2Rvalue NewHalf2(CShaderBuilder& owner, float x, float y);
+	CHalf2Rvalue NewHalf2(const CHalfValue& x, const CHalfValue& y);
+
+	CHalf4Rvalue NewHalf4(CShaderBuilder& owner, float x, float y, float z, float w);
+	CHalf4Rvalue NewHalf4(const CHalf2Value& xy, const CHalf2Value& zw);
+
 	CIntRvalue NewInt(CShaderBuilder& owner, int32 x);
 
 	CInt2Rvalue NewInt2(CShaderBuilder& owner, int32 x, int32 y);
@@ -154,6 +187,8 @@ namespace Nuanceur
 
 	CUintRvalue NewUint(CShaderBuilder& owner, uint32 x);
 
+	CUint2Rvalue NewUint2(CShaderBuilder& owner, uint32 x, uint32 y);
+
 	CUint3Rvalue NewUint3(CShaderBuilder& owner, uint32 x, uint32 y, uint32 z);
 
 	CUint4Rvalue NewUint4(CShaderBuilder& owner, uint32 x, uint32 y, uint32 z, uint32 w);
@@ -163,20 +198,100 @@ namespace Nuanceur
 	CBoolRvalue NewBool(CShaderBuilder& owner, bool x);
 
 	CFloat4Rvalue Sample(const CTexture2DValue& texture, const CFloat2Value& coord);
+	CFloat4Rvalue SampleLod(const CTexture2DValue& texture, const CFloat2Value& coord, const CFloatValue& lod);
+	CFloat4Rvalue SampleGrad(const CTexture2DValue& texture, const CFloat2Value& coord, const CFloat2Value& dPdx, const CFloat2Value& dPdy);
+	//Offset is in texels and must be within the device's texel offset range
+	CFloat4Rvalue SampleOffset(const CTexture2DValue& texture, const CFloat2Value& coord, int32 offsetX, int32 offsetY);
+	//Reads a single texel without filtering
+	CFloat4Rvalue Fetch(const CTexture2DValue& texture, const CInt2Value& coord, const CIntValue& lod);
+	//Returns the selected component of the four texels used for bilinear filtering
+	CFloat4Rvalue Gather(const CTexture2DValue& texture, const CFloat2Value& coord, uint32 component = 0);
 
 	CUint4Rvalue Load(const CImageUint2DValue& image, const CInt2Value& coord);
 	void Store(const CImageUint2DValue& image, const CInt2Value& coord, const CUint4Value&);
-
-	CUintRvalue AtomicAnd(const CImageUint2DValue& image, const CInt2Value& coord, const CUintValue&);
-	CUintRvalue AtomicOr(const CImageUint2DValue& image, const CInt2Value& coord, const CUintValue&);
+	CUint4Rvalue Load(const CImageUint2DArrayValue& image, const CInt3Value& coord);
+	void Store(const CImageUint2DArrayValue& image, const CInt3Value& coord, const CUint4Value&);
+	CUint4Rvalue Load(const CImageUint3DValue& image, const CInt3Value& coord);
+	void Store(const CImageUint3DValue& image, const CInt3Value& coord, const CUint4Value&);
+
+	//Normalized and float formats, components missing from the format read as (0, 0, 0, 1)
+	CFloat4Rvalue Load(const CImage2DValue& image, const CInt2Value& coord);
+	void Store(const CImage2DValue& image, const CInt2Value& coord, const CFloat4Value&);
+	CFloat4Rvalue Load(const CImage2DArrayValue& image, const CInt3Value& coord);
+	void Store(const CImage2DArrayValue& image, const CInt3Value& coord, const CFloat4Value&);
+	CFloat4Rvalue Load(const CImage3DValue& image, const CInt3Value& coord);
+	void Store(const CImage3DValue& image, const CInt3Value& coord, const CFloat4Value&);
+
+	//Selects an element of a descriptor array, the index must be the same for all invocations
+	CTexture2DValue Element(const CTexture2DDescriptorArrayValue& array, const CIntValue& index);
+	CImage2DValue Element(const CImage2DDescriptorArrayValue& array, const CIntValue& index);
+	CImageUint2DValue Element(const CImageUint2DDescriptorArrayValue& array, const CIntValue& index);
+	CArrayUintValue Element(const CArrayUintDescriptorArrayValue& array, const CIntValue& index);
+	//Same as Element, but the index can differ between invocations
+	CTexture2DValue NonUniformElement(const CTexture2DDescriptorArrayValue& array, const CIntValue& index);
+	CImage2DValue NonUniformElement(const CImage2DDescriptorArrayValue& array, const CIntValue& index);
+	CImageUint2DValue NonUniformElement(const CImageUint2DDescriptorArrayValue& array, const CIntValue& index);
+	CArrayUintValue NonUniformElement(const CArrayUintDescriptorArrayValue& array, const CIntValue& index);
+
+	CFloat4Rvalue Fetch(const CUniformTexelBufferValue& buffer, const CIntValue& index);
+	CUint4Rvalue Load(const CStorageTexelBufferUintValue& buffer, const CIntValue& index);
+	void Store(const CStorageTexelBufferUintValue& buffer, const CIntValue& index, const CUint4Value&);
+
+	//Atomic operations return the value held in memory before the operation
+	//Min and Max compare values as unsigned integers
+	CUintRvalue AtomicAnd(const CImageUint2DValue& image, const CInt2Value& coord, const CUintValue&, MEMORY_SCOPE = MEMORY_SCOPE_DEVICE, MEMORY_ORDER = MEMORY_ORDER_RELAXED);
+	CUintRvalue AtomicOr(const CImageUint2DValue& image, const CInt2Value& coord, const CUintValue&, MEMORY_SCOPE = MEMORY_SCOPE_DEVICE, MEMORY_ORDER = MEMORY_ORDER_RELAXED);
+	CUintRvalue AtomicXor(const CImageUint2DValue& image, const CInt2Value& coord, const CUintValue&, MEMORY_SCOPE = MEMORY_SCOPE_DEVICE, MEMORY_ORDER = MEMORY_ORDER_RELAXED);
+	CUintRvalue AtomicAdd(const CImageUint2DValue& image, const CInt2Value& coord, const CUintValue&, MEMORY_SCOPE = MEMORY_SCOPE_DEVICE, MEMORY_ORDER = MEMORY_ORDER_RELAXED);
+	CUintRvalue AtomicMin(const CImageUint2DValue& image, const CInt2Value& coord, const CUintValue&, MEMORY_SCOPE = MEMORY_SCOPE_DEVICE, MEMORY_ORDER = MEMORY_ORDER_RELAXED);
+	CUintRvalue AtomicMax(const CImageUint2DValue& image, const CInt2Value& coord, const CUintValue&, MEMORY_SCOPE = MEMORY_SCOPE_DEVICE, MEMORY_ORDER = MEMORY_ORDER_RELAXED);
+	CUintRvalue AtomicExchange(const CImageUint2DValue& image, const CInt2Value& coord, const CUintValue&, MEMORY_SCOPE = MEMORY_SCOPE_DEVICE, MEMORY_ORDER = MEMORY_ORDER_RELAXED);
+	//Stores value if the value in memory is equal to comparator
+	CUintRvalue AtomicCompareExchange(const CImageUint2DValue& image, const CInt2Value& coord, const CUintValue& value, const CUintValue& comparator,
+	                                  MEMORY_SCOPE = MEMORY_SCOPE_DEVICE, MEMORY_ORDER = MEMORY_ORDER_RELAXED);
 
 	CUintRvalue Load(const CArrayUintValue& buffer, const CIntValue& index);
+	CUint2Rvalue Load(const CArrayUint2Value& buffer, const CIntValue& index);
+	CUint4Rvalue Load(const CArrayUint4Value& buffer, const CIntValue& index);
+	//Loads an 8 or 16 bits element, zero extended to 32 bits
+	CUintRvalue Load(const CArrayUcharValue& buffer, const CIntValue& index);
+	CUintRvalue Load(const CArrayUshortValue& buffer, const CIntValue& index);
 	void Store(const CArrayUintValue& buffer, const CIntValue& index, const CUintValue&);
+	void Store(const CArrayUint2Value& buffer, const CIntValue& index, const CUint2Value&);
+	void Store(const CArrayUint4Value& buffer, const CIntValue& index, const CUint4Value&);
 	void Store(const CArrayUshortValue& buffer, const CIntValue& index, const CUshortValue&);
 	void Store(const CArrayUcharValue& buffer, const CIntValue& index, const CUcharValue&);
 
-	CUintRvalue AtomicAnd(const CArrayUintValue& image, const CIntValue& index, const CUintValue&);
-	CUintRvalue AtomicOr(const CArrayUintValue& image, const CIntValue& index, const CUintValue&);
+	CUintRvalue AtomicAnd(const CArrayUintValue& buffer, const CIntValue& index, const CUintValue&, MEMORY_SCOPE = MEMORY_SCOPE_DEVICE, MEMORY_ORDER = MEMORY_ORDER_RELAXED);
+	CUintRvalue AtomicOr(const CArrayUintValue& buffer, const CIntValue& index, const CUintValue&, MEMORY_SCOPE = MEMORY_SCOPE_DEVICE, MEMORY_ORDER = MEMORY_ORDER_RELAXED);
+	CUintRvalue AtomicXor(const CArrayUintValue& buffer, const CIntValue& index, const CUintValue&, MEMORY_SCOPE = MEMORY_SCOPE_DEVICE, MEMORY_ORDER = MEMORY_ORDER_RELAXED);
+	CUintRvalue AtomicAdd(const CArrayUintValue& buffer, const CIntValue& index, const CUintValue&, MEMORY_SCOPE = MEMORY_SCOPE_DEVICE, MEMORY_ORDER = MEMORY_ORDER_RELAXED);
+	CUintRvalue AtomicMin(const CArrayUintValue& buffer, const CIntValue& index, const CUintValue&, MEMORY_SCOPE = MEMORY_SCOPE_DEVICE, MEMORY_ORDER = MEMORY_ORDER_RELAXED);
+	CUintRvalue AtomicMax(const CArrayUintValue& buffer, const CIntValue& index, const CUintValue&, MEMORY_SCOPE = MEMORY_SCOPE_DEVICE, MEMORY_ORDER = MEMORY_ORDER_RELAXED);
+	CUintRvalue AtomicExchange(const CArrayUintValue& buffer, const CIntValue& index, const CUintValue&, MEMORY_SCOPE = MEMORY_SCOPE_DEVICE, MEMORY_ORDER = MEMORY_ORDER_RELAXED);
+	CUintRvalue AtomicCompareExchange(const CArrayUintValue& buffer, const CIntValue& index, const CUintValue& value, const CUintValue& comparator,
+	                                  MEMORY_SCOPE = MEMORY_SCOPE_DEVICE, MEMORY_ORDER = MEMORY_ORDER_RELAXED);
+
+	//Accesses through a buffer pointer are aligned on 4 bytes
+	CUintRvalue Load(const CBufferPointerUintValue& pointer, const CIntValue& index);
+	void Store(const CBufferPointerUintValue& pointer, const CIntValue& index, const CUintValue&);
+
+	CUintRvalue AtomicAnd(const CBufferPointerUintValue& pointer, const CIntValue& index, const CUintValue&, MEMORY_SCOPE = MEMORY_SCOPE_DEVICE, MEMORY_ORDER = MEMORY_ORDER_RELAXED);
+	CUintRvalue AtomicOr(const CBufferPointerUintValue& pointer, const CIntValue& index, const CUintValue&, MEMORY_SCOPE = MEMORY_SCOPE_DEVICE, MEMORY_ORDER = MEMORY_ORDER_RELAXED);
+	CUintRvalue AtomicXor(const CBufferPointerUintValue& pointer, const CIntValue& index, const CUintValue&, MEMORY_SCOPE = MEMORY_SCOPE_DEVICE, MEMORY_ORDER = MEMORY_ORDER_RELAXED);
+	CUintRvalue AtomicAdd(const CBufferPointerUintValue& pointer, const CIntValue& index, const CUintValue&, MEMORY_SCOPE = MEMORY_SCOPE_DEVICE, MEMORY_ORDER = MEMORY_ORDER_RELAXED);
+	CUintRvalue AtomicMin(const CBufferPointerUintValue& pointer, const CIntValue& index, const CUintValue&, MEMORY_SCOPE = MEMORY_SCOPE_DEVICE, MEMORY_ORDER = MEMORY_ORDER_RELAXED);
+	CUintRvalue AtomicMax(const CBufferPointerUintValue& pointer, const CIntValue& index, const CUintValue&, MEMORY_SCOPE = MEMORY_SCOPE_DEVICE, MEMORY_ORDER = MEMORY_ORDER_RELAXED);
+	CUintRvalue AtomicExchange(const CBufferPointerUintValue& pointer, const CIntValue& index, const CUintValue&, MEMORY_SCOPE = MEMORY_SCOPE_DEVICE, MEMORY_ORDER = MEMORY_ORDER_RELAXED);
+	CUintRvalue AtomicCompareExchange(const CBufferPointerUintValue& pointer, const CIntValue& index, const CUintValue& value, const CUintValue& comparator,
+	                                  MEMORY_SCOPE = MEMORY_SCOPE_DEVICE, MEMORY_ORDER = MEMORY_ORDER_RELAXED);
+	CFloat4Rvalue Load(const CBufferPointerFloat4Value& pointer, const CIntValue& index);
+	void Store(const CBufferPointerFloat4Value& pointer, const CIntValue& index, const CFloat4Value&);
+
+	CFloat4Rvalue Load(const CArrayFloat4Value& array, const CIntValue& index);
+	CInt4Rvalue Load(const CArrayInt4Value& array, const CIntValue& index);
+	//Multiplies a vector by the matrix found at index
+	CFloat4Rvalue Multiply(const CArrayMatrix44Value& array, const CIntValue& index, const CFloat4Value&);
 
 	CFloat4Rvalue Load(const CSubpassInputValue&, const CInt2Value&);
 	CUint4Rvalue Load(const CSubpassInputUintValue&, const CInt2Value&);
@@ -186,6 +301,12 @@ namespace Nuanceur
 	CFloat2Rvalue ToFloat(const CInt2Value&);
 	CFloat4Rvalue ToFloat(const CInt4Value&);
 	CFloat4Rvalue ToFloat(const CUint4Value&);
+	CFloatRvalue ToFloat(const CHalfValue&);
+	CFloat2Rvalue ToFloat(const CHalf2Value&);
+	CFloat4Rvalue ToFloat(const CHalf4Value&);
+	CHalfRvalue ToHalf(const CFloatValue&);
+	CHalf2Rvalue ToHalf(const CFloat2Value&);
+	CHalf4Rvalue ToHalf(const CFloat4Value&);
 	CIntRvalue ToInt(const CFloatValue&);
 	CIntRvalue ToInt(const CUintValue&);
 	CInt2Rvalue ToInt(const CFloat2Value&);
@@ -201,6 +322,64 @@ namespace Nuanceur
 	void BeginInvocationInterlock(CShaderBuilder& owner);
 	void EndInvocationInterlock(CShaderBuilder& owner);
 
-	void BeginIf(CShaderBuilder& owner, const CBoolValue& condition);
+	//Waits for all invocations of the workgroup, making their shared memory writes visible
+	void WorkgroupBarrier(CShaderBuilder& owner);
+	//Makes memory writes of the invocation visible to other invocations, without waiting for them
+	void DeviceMemoryBarrier(CShaderBuilder& owner);
+
+	//Subgroup operations exchange values between the active invocations of a subgroup
+	//Returns a bit mask of the active invocations for which predicate is true
+	CUint4Rvalue SubgroupBallot(const CBoolValue& predicate);
+	//Returns value as seen by the invocation with the specified id, which must be active
+	CFloatRvalue SubgroupBroadcast(const CFloatValue& value, uint32 invocationId);
+	CIntRvalue SubgroupBroadcast(const CIntValue& value, uint32 invocationId);
+	CUintRvalue SubgroupBroadcast(const CUintValue& value, uint32 invocationId);
+	//Same as SubgroupBroadcast, but the invocation id can be different for every invocation
+	CFloatRvalue SubgroupShuffle(const CFloatValue& value, const CUintValue& invocationId);
+	CIntRvalue SubgroupShuffle(const CIntValue& value, const CUintValue& invocationId);
+	CUintRvalue SubgroupShuffle(const CUintValue& value, const CUintValue& invocationId);
+	CFloatRvalue SubgroupAdd(const CFloatValue&, SUBGROUP_OPERATION = SUBGROUP_OPERATION_REDUCE);
+	CIntRvalue SubgroupAdd(const CIntValue&, SUBGROUP_OPERATION = SUBGROUP_OPERATION_REDUCE);
+	CUintRvalue SubgroupAdd(const CUintValue&, SUBGROUP_OPERATION = SUBGROUP_OPERATION_REDUCE);
+	CFloatRvalue SubgroupMin(const CFloatValue&, SUBGROUP_OPERATION = SUBGROUP_OPERATION_REDUCE);
+	CIntRvalue SubgroupMin(const CIntValue&, SUBGROUP_OPERATION = SUBGROUP_OPERATION_REDUCE);
+	CUintRvalue SubgroupMin(const CUintValue&, SUBGROUP_OPERATION = SUBGROUP_OPERATION_REDUCE);
+	CFloatRvalue SubgroupMax(const CFloatValue&, SUBGROUP_OPERATION = SUBGROUP_OPERATION_REDUCE);
+	CIntRvalue SubgroupMax(const CIntValue&, SUBGROUP_OPERATION = SUBGROUP_OPERATION_REDUCE);
+	CUintRvalue SubgroupMax(const CUintValue&, SUBGROUP_OPERATION = SUBGROUP_OPERATION_REDUCE);
+	CIntRvalue SubgroupAnd(const CIntValue&, SUBGROUP_OPERATION = SUBGROUP_OPERATION_REDUCE);
+	CUintRvalue SubgroupAnd(const CUintValue&, SUBGROUP_OPERATION = SUBGROUP_OPERATION_REDUCE);
+	CIntRvalue SubgroupOr(const CIntValue&, SUBGROUP_OPERATION = SUBGROUP_OPERATION_REDUCE);
+	CUintRvalue SubgroupOr(const CUintValue&, SUBGROUP_OPERATION = SUBGROUP_OPERATION_REDUCE);
+
+	void BeginIf(CShaderBuilder& owner, const CBoolValue& condition, SELECTION_CONTROL selectionControl = SELECTION_CONTROL_NONE);
+	void Else(CShaderBuilder& owner);
 	void EndIf(CShaderBuilder& owner);
+
+	//Cases don't fall through, consecutive cases share the same body
+	void BeginSwitch(CShaderBuilder& owner, const CIntValue& selector, SELECTION_CONTROL selectionControl = SELECTION_CONTROL_NONE);
+	void BeginSwitch(CShaderBuilder& owner, const CUintValue& selector, SELECTION_CONTROL selectionControl = SELECTION_CONTROL_NONE);
+	void Case(CShaderBuilder& owner, int32 value);
+	void Default(CShaderBuilder& owner);
+	void EndSwitch(CShaderBuilder& owner);
+
+	//Break and Continue apply to the innermost loop, Break can't be used inside a switch
+	void BeginLoop(CShaderBuilder& owner, LOOP_CONTROL loopControl = LOOP_CONTROL_NONE);
+	//Runs the body with index going from 0 to count - 1, count is evaluated before every iteration
+	void BeginLoop(CShaderBuilder& owner, const CIntLvalue& index, const CIntValue& count, LOOP_CONTROL loopControl = LOOP_CONTROL_NONE);
+	void Break(CShaderBuilder& owner);
+	void Continue(CShaderBuilder& owner);
+	void EndLoop(CShaderBuilder& owner);
+
+	//Statements between BeginFunction and EndFunction make the body of a new function.
+	//Functions can use their parameters (see CShaderBuilder::CreateParameter), temporaries,
+	//uniforms and textures, temporaries don't keep their values across calls. Recursion isn't allowed.
+	uint32 BeginFunction(CShaderBuilder& owner, CShaderBuilder::SYMBOL_TYPE returnType = CShaderBuilder::SYMBOL_TYPE_NULL);
+	void EndFunction(CShaderBuilder& owner);
+	void Return(CShaderBuilder& owner, const CShaderBuilder::SYMBOLREF& value);
+
+	//Returns a temporary holding the result (or a null symbol if the function doesn't return a value)
+	CShaderBuilder::SYMBOL Call(CShaderBuilder& owner, uint32 function,
+	                            const CShaderBuilder::SYMBOLREF& arg1 = CShaderBuilder::SYMBOLREF(), const CShaderBuilder::SYMBOLREF& arg2 = CShaderBuilder::SYMBOLREF(),
+	                            const CShaderBuilder::SYMBOLREF& arg3 = CShaderBuilder::SYMBOLREF(), const CShaderBuilder::SYMBOLREF& arg4 = CShaderBuilder::SYMBOLREF());
 }
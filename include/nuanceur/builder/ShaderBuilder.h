@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <list>
+#include <map>
 #include <unordered_map>
 #include <cassert>
 #include <string>
@@ -22,11 +23,18 @@ namespace Nuanceur
 		SEMANTIC_SYSTEM_GIID,
 		SEMANTIC_POSITION,
 		SEMANTIC_TEXCOORD,
+		SEMANTIC_SYSTEM_DEPTH,
+		SEMANTIC_SYSTEM_LIID,
+		SEMANTIC_SYSTEM_LIINDEX,
+		SEMANTIC_SYSTEM_WGID,
+		SEMANTIC_SYSTEM_SUBGROUP_INVOCATION_ID,
+		SEMANTIC_SYSTEM_SUBGROUP_SIZE,
 	};
 
 	enum SYMBOL_ATTRIBUTE
 	{
 		SYMBOL_ATTRIBUTE_COHERENT = 0x01,
+		SYMBOL_ATTRIBUTE_NONUNIFORM = 0x02, //Texture or buffer array element selected with an index that can differ between invocations
 	};
 
 	enum
@@ -34,6 +42,78 @@ namespace Nuanceur
 		UNIFORM_UNIT_PUSHCONSTANT = -1,
 	};
 
+	enum SELECTION_CONTROL
+	{
+		SELECTION_CONTROL_NONE,         //Let the generator decide
+		SELECTION_CONTROL_FLATTEN,      //Prefer executing both sides of the branch
+		SELECTION_CONTROL_DONT_FLATTEN, //Prefer keeping a real branch
+	};
+
+	enum LOOP_CONTROL
+	{
+		LOOP_CONTROL_NONE,        //Let the generator decide
+		LOOP_CONTROL_UNROLL,      //Prefer unrolling the loop
+		LOOP_CONTROL_DONT_UNROLL, //Prefer keeping the loop
+	};
+
+	enum PRECISION
+	{
+		PRECISION_DEFAULT, //Use the shader's default precision
+		PRECISION_HIGH,    //Full 32-bit precision
+		PRECISION_MEDIUM,  //Relaxed precision (mediump, RelaxedPrecision in SPIR-V)
+		PRECISION_LOW,     //Lowest precision (lowp, RelaxedPrecision in SPIR-V)
+	};
+
+	enum DEPTH_MODE
+	{
+		DEPTH_MODE_ANY,       //Depth output can be any value
+		DEPTH_MODE_GREATER,   //Depth output is greater or equal to the fragment's depth
+		DEPTH_MODE_LESS,      //Depth output is less or equal to the fragment's depth
+		DEPTH_MODE_UNCHANGED, //Depth output is the fragment's depth
+	};
+
+	enum INTERLOCK_MODE
+	{
+		INTERLOCK_MODE_PIXEL_ORDERED,    //Critical sections of overlapping invocations run in primitive order
+		INTERLOCK_MODE_PIXEL_UNORDERED,  //Critical sections of overlapping invocations are mutually exclusive
+		INTERLOCK_MODE_SAMPLE_ORDERED,   //Same as PIXEL_ORDERED, but only invocations covering the same samples overlap
+		INTERLOCK_MODE_SAMPLE_UNORDERED, //Same as PIXEL_UNORDERED, but only invocations covering the same samples overlap
+	};
+
+	enum MEMORY_SCOPE
+	{
+		MEMORY_SCOPE_DEVICE,     //Synchronizes with all invocations of the device
+		MEMORY_SCOPE_WORKGROUP,  //Synchronizes with invocations of the same workgroup
+		MEMORY_SCOPE_SUBGROUP,   //Synchronizes with invocations of the same subgroup
+		MEMORY_SCOPE_INVOCATION, //Only the current invocation
+	};
+
+	enum MEMORY_ORDER
+	{
+		MEMORY_ORDER_RELAXED,         //Only the atomicity of the operation is guaranteed
+		MEMORY_ORDER_ACQUIRE,         //Following memory accesses can't be moved before the operation
+		MEMORY_ORDER_RELEASE,         //Preceding memory accesses can't be moved after the operation
+		MEMORY_ORDER_ACQUIRE_RELEASE, //Both of the above
+	};
+
+	enum SUBGROUP_OPERATION
+	{
+		SUBGROUP_OPERATION_REDUCE,         //Result over all active invocations of the subgroup
+		SUBGROUP_OPERATION_INCLUSIVE_SCAN, //Result over active invocations with a lower or equal id
+		SUBGROUP_OPERATION_EXCLUSIVE_SCAN, //Result over active invocations with a lower id
+	};
+
+	enum IMAGE_FORMAT
+	{
+		IMAGE_FORMAT_R32UI,
+		IMAGE_FORMAT_RGBA8,   //Unsigned normalized, accessed as float
+		IMAGE_FORMAT_RGBA8UI,
+		IMAGE_FORMAT_R16UI,
+		IMAGE_FORMAT_R8UI,
+		IMAGE_FORMAT_RGBA16F,
+		IMAGE_FORMAT_R32F,
+	};
+
 	enum COMPONENT
 	{
 		COMPONENT_X,
@@ -144,12 +224,18 @@ namespace Nuanceur
 			METADATA_LOCALSIZE_X,
 			METADATA_LOCALSIZE_Y,
 			METADATA_LOCALSIZE_Z,
+			METADATA_PRECISION,            //Default PRECISION of float, int and uint symbols
+			METADATA_INTERLOCK_MODE,       //INTERLOCK_MODE used by invocation interlock sections
+			METADATA_EARLY_FRAGMENT_TESTS, //Non-zero to run depth and stencil tests before fragment shading
+			METADATA_DEPTH_MODE,           //DEPTH_MODE of the SEMANTIC_SYSTEM_DEPTH output
+			METADATA_SCALAR_BLOCK_LAYOUT,  //Non-zero to lay out uniform blocks with scalar alignment (VK_EXT_scalar_block_layout)
 		};
 
 		enum SYMBOL_TYPE
 		{
 			SYMBOL_TYPE_NULL,
 			SYMBOL_TYPE_FLOAT4,
+			SYMBOL_TYPE_HALF4,
 			SYMBOL_TYPE_INT4,
 			SYMBOL_TYPE_UINT4,
 			SYMBOL_TYPE_USHORT4,
@@ -157,12 +243,26 @@ namespace Nuanceur
 			SYMBOL_TYPE_BOOL4,
 			SYMBOL_TYPE_MATRIX,
 			SYMBOL_TYPE_ARRAYUINT,
+			SYMBOL_TYPE_ARRAYUINT2,
+			SYMBOL_TYPE_ARRAYUINT4,
 			SYMBOL_TYPE_ARRAYUCHAR,
 			SYMBOL_TYPE_ARRAYUSHORT,
+			SYMBOL_TYPE_ARRAYFLOAT4,
+			SYMBOL_TYPE_ARRAYINT4,
+			SYMBOL_TYPE_ARRAYMATRIX,
+			SYMBOL_TYPE_BUFFERPOINTERUINT,
+			SYMBOL_TYPE_BUFFERPOINTERFLOAT4,
 			SYMBOL_TYPE_TEXTURE2D,
+			SYMBOL_TYPE_IMAGE2D,
+			SYMBOL_TYPE_IMAGE2DARRAY,
+			SYMBOL_TYPE_IMAGE3D,
 			SYMBOL_TYPE_IMAGE2DUINT,
+			SYMBOL_TYPE_IMAGE2DARRAYUINT,
+			SYMBOL_TYPE_IMAGE3DUINT,
 			SYMBOL_TYPE_SUBPASSINPUT,
 			SYMBOL_TYPE_SUBPASSINPUTUINT,
+			SYMBOL_TYPE_UNIFORMTEXELBUFFER,
+			SYMBOL_TYPE_STORAGETEXELBUFFERUINT,
 		};
 
 		enum SYMBOL_LOCATION
@@ -174,6 +274,9 @@ namespace Nuanceur
 			SYMBOL_LOCATION_OUTPUT,
 			SYMBOL_LOCATION_UNIFORM,
 			SYMBOL_LOCATION_TEXTURE,
+			SYMBOL_LOCATION_TEXTURE_ELEMENT,
+			SYMBOL_LOCATION_BUFFER_ELEMENT,
+			SYMBOL_LOCATION_SHARED,
 		};
 
 		struct SEMANTIC_INFO
@@ -198,10 +301,14 @@ namespace Nuanceur
 			SYMBOL_TYPE type = SYMBOL_TYPE_NULL;
 			SYMBOL_LOCATION location = SYMBOL_LOCATION_NULL;
 			unsigned int unit = 0;
+			unsigned int set = 0;
 			unsigned int index = 0;
 			uint32 attributes = 0;
 		};
 
+		//Descriptor set and unit of a resource, the same unit can be used in different sets
+		typedef std::pair<unsigned int, unsigned int> BINDING;
+
 		struct SYMBOLREF
 		{
 			SYMBOLREF()
@@ -295,13 +402,27 @@ namespace Nuanceur
 			STATEMENT_OP_NEWVECTOR4,
 			STATEMENT_OP_ASSIGN,
 			STATEMENT_OP_SAMPLE,
+			STATEMENT_OP_SAMPLE_LOD,
+			STATEMENT_OP_SAMPLE_GRAD,
+			STATEMENT_OP_SAMPLE_OFFSET,
+			STATEMENT_OP_FETCH,
+			STATEMENT_OP_GATHER,
+			STATEMENT_OP_SELECT_TEXTURE,
+			STATEMENT_OP_SELECT_BUFFER,
 			STATEMENT_OP_LOAD,
 			STATEMENT_OP_STORE,
 			STATEMENT_OP_STORE16,
 			STATEMENT_OP_STORE8,
 			STATEMENT_OP_ATOMICAND,
 			STATEMENT_OP_ATOMICOR,
+			STATEMENT_OP_ATOMICXOR,
+			STATEMENT_OP_ATOMICADD,
+			STATEMENT_OP_ATOMICMIN,
+			STATEMENT_OP_ATOMICMAX,
+			STATEMENT_OP_ATOMICEXCHANGE,
+			STATEMENT_OP_ATOMICCOMPAREEXCHANGE,
 			STATEMENT_OP_TOFLOAT,
+			STATEMENT_OP_TOHALF,
 			STATEMENT_OP_TOINT,
 			STATEMENT_OP_TOUINT,
 			STATEMENT_OP_TOUSHORT,
@@ -309,8 +430,28 @@ namespace Nuanceur
 			STATEMENT_OP_RETURN,
 			STATEMENT_OP_INVOCATION_INTERLOCK_BEGIN,
 			STATEMENT_OP_INVOCATION_INTERLOCK_END,
+			STATEMENT_OP_WORKGROUP_BARRIER,
+			STATEMENT_OP_DEVICE_MEMORY_BARRIER,
+			STATEMENT_OP_SUBGROUP_BALLOT,
+			STATEMENT_OP_SUBGROUP_BROADCAST,
+			STATEMENT_OP_SUBGROUP_SHUFFLE,
+			STATEMENT_OP_SUBGROUP_ADD,
+			STATEMENT_OP_SUBGROUP_MIN,
+			STATEMENT_OP_SUBGROUP_MAX,
+			STATEMENT_OP_SUBGROUP_AND,
+			STATEMENT_OP_SUBGROUP_OR,
 			STATEMENT_OP_IF_BEGIN,
 			STATEMENT_OP_IF_END,
+			STATEMENT_OP_ELSE,
+			STATEMENT_OP_SWITCH_BEGIN,
+			STATEMENT_OP_SWITCH_CASE,
+			STATEMENT_OP_SWITCH_DEFAULT,
+			STATEMENT_OP_SWITCH_END,
+			STATEMENT_OP_LOOP_BEGIN,
+			STATEMENT_OP_LOOP_END,
+			STATEMENT_OP_BREAK,
+			STATEMENT_OP_CONTINUE,
+			STATEMENT_OP_CALL,
 		};
 
 		struct STATEMENT
@@ -333,6 +474,10 @@ namespace Nuanceur
 			SYMBOLREF src2Ref;
 			SYMBOLREF src3Ref;
 			SYMBOLREF src4Ref;
+			uint32 param = 0; //Op specific immediate (ie.: SELECTION_CONTROL for IF_BEGIN, case value for SWITCH_CASE, LOOP_CONTROL for LOOP_BEGIN, function index for CALL,
+			                  //invocation id for SUBGROUP_BROADCAST, SUBGROUP_OPERATION for subgroup arithmetic,
+			                  //MEMORY_SCOPE | (MEMORY_ORDER << 16) for atomics, (offsetX & 0xFFFF) | (offsetY << 16) for SAMPLE_OFFSET,
+			                  //component for GATHER)
 
 			unsigned int GetSourceCount() const
 			{
@@ -369,10 +514,27 @@ namespace Nuanceur
 		typedef std::vector<SYMBOL> SymbolArray;
 		typedef std::list<STATEMENT> StatementList;
 
-		//We need a special operator = that will remap symbol owners
+		struct FUNCTION
+		{
+			SYMBOL_TYPE returnType = SYMBOL_TYPE_NULL;
+			SymbolArray parameters;
+			StatementList statements;
+		};
 
+		typedef std::vector<FUNCTION> FunctionArray;
+
+		enum
+		{
+			INVALID_FUNCTION = ~0U,
+		};
+
+		CShaderBuilder() = default;
+		CShaderBuilder(const CShaderBuilder&);
 		virtual ~CShaderBuilder() = default;
 
+		//Copies remap symbol owners to the new builder
+		CShaderBuilder& operator=(const CShaderBuilder&);
+
 		uint32 GetMetadata(METADATA_TYPE, uint32) const;
 		void SetMetadata(METADATA_TYPE, uint32);
 
@@ -381,19 +543,55 @@ namespace Nuanceur
 		SEMANTIC_INFO GetOutputSemantic(const SYMBOL&) const;
 		std::string GetVariableName(const SYMBOL&) const;
 		std::string GetUniformName(const SYMBOL&) const;
+		uint32 GetSharedArraySize(const SYMBOL&) const;
+		uint32 GetUniformArraySize(const SYMBOL&) const;
+		//Number of components stored for float uniforms, missing components are read as 0
+		uint32 GetUniformComponentCount(const SYMBOL&) const;
+		IMAGE_FORMAT GetImageFormat(const SYMBOL&) const;
+		bool IsTextureArray(const SYMBOL&) const;
+		//Returns 0 for arrays without a fixed size
+		uint32 GetTextureArraySize(const SYMBOL&) const;
+		//Returns the texture array an element was selected from
+		SYMBOL GetTextureArray(const SYMBOL&) const;
+		bool IsBufferArray(const SYMBOL&) const;
+		//Returns 0 for arrays without a fixed size
+		uint32 GetBufferArraySize(const SYMBOL&) const;
+		//Returns the buffer array an element was selected from
+		SYMBOL GetBufferArray(const SYMBOL&) const;
+
+		//Push constants are always in set 0
+		static BINDING GetBinding(const SYMBOL&);
+		//Storage images created with one of the CreateImage* functions
+		static bool IsImageType(SYMBOL_TYPE);
+		//Device memory pointers created with one of the CreateUniformBufferPointer* functions
+		static bool IsBufferPointerType(SYMBOL_TYPE);
 		CVector4 GetTemporaryValue(const SYMBOL&) const;
 		CIntVector4 GetTemporaryValueInt(const SYMBOL&) const;
 		CBoolVector4 GetTemporaryValueBool(const SYMBOL&) const;
 
+		//Returns PRECISION_DEFAULT if the symbol's precision wasn't set
+		PRECISION GetPrecision(const SYMBOL&) const;
+		void SetPrecision(const SYMBOL&, PRECISION);
+
 		const StatementList& GetStatements() const;
+		StatementList& GetStatements();
 		void InsertStatement(const STATEMENT&);
 
+		const FunctionArray& GetFunctions() const;
+		FunctionArray& GetFunctions();
+
+		//Statements are inserted in the new function until EndFunction is called
+		uint32 BeginFunction(SYMBOL_TYPE);
+		void EndFunction();
+		SYMBOL CreateParameter(SYMBOL_TYPE);
+
 		SYMBOL CreateInput(SEMANTIC, unsigned int = 0);
 		SYMBOL CreateInputInt(SEMANTIC, unsigned int = 0);
 		SYMBOL CreateInputUint(SEMANTIC, unsigned int = 0);
 		SYMBOL CreateOutput(SEMANTIC, unsigned int = 0);
 		SYMBOL CreateOutputUint(SEMANTIC, unsigned int = 0);
 		SYMBOL CreateConstant(float, float, float, float);
+		SYMBOL CreateConstantHalf(float, float, float, float);
 		SYMBOL CreateConstantInt(int32, int32, int32, int32);
 		SYMBOL CreateConstantUint(uint32, uint32, uint32, uint32);
 		SYMBOL CreateConstantBool(bool, bool, bool, bool);
@@ -404,52 +602,113 @@ namespace Nuanceur
 		SYMBOL CreateVariableBool(const std::string&);
 
 		SYMBOL CreateTemporary();
+		SYMBOL CreateTemporaryHalf();
 		SYMBOL CreateTemporaryBool();
 		SYMBOL CreateTemporaryInt();
 		SYMBOL CreateTemporaryUint();
 		SYMBOL CreateTemporaryUshort();
 		SYMBOL CreateTemporaryUchar();
 
-		SYMBOL CreateUniformFloat4(const std::string&, unsigned int = 0);
-		SYMBOL CreateUniformInt4(const std::string&, unsigned int = 0);
-		SYMBOL CreateUniformMatrix(const std::string&, unsigned int = 0);
-		SYMBOL CreateUniformArrayUint(const std::string&, unsigned int = 0, uint32 = 0);
-		SYMBOL CreateUniformArrayUchar(const std::string&, unsigned int = 0, uint32 = 0);
-		SYMBOL CreateUniformArrayUshort(const std::string&, unsigned int = 0, uint32 = 0);
-
-		SYMBOL CreateTexture2D(unsigned int);
-
-		SYMBOL CreateImage2DUint(unsigned int);
-
-		SYMBOL CreateSubpassInput(unsigned int, unsigned int);
-		SYMBOL CreateSubpassInputUint(unsigned int, unsigned int);
+		//Resources take their descriptor set as last parameter
+		SYMBOL CreateUniformFloat(const std::string&, unsigned int = 0, unsigned int = 0);
+		SYMBOL CreateUniformFloat2(const std::string&, unsigned int = 0, unsigned int = 0);
+		SYMBOL CreateUniformFloat4(const std::string&, unsigned int = 0, unsigned int = 0);
+		SYMBOL CreateUniformInt4(const std::string&, unsigned int = 0, unsigned int = 0);
+		SYMBOL CreateUniformMatrix(const std::string&, unsigned int = 0, unsigned int = 0);
+		SYMBOL CreateUniformArrayUint(const std::string&, unsigned int = 0, uint32 = 0, unsigned int = 0);
+		SYMBOL CreateUniformArrayUint2(const std::string&, unsigned int = 0, uint32 = 0, unsigned int = 0);
+		SYMBOL CreateUniformArrayUint4(const std::string&, unsigned int = 0, uint32 = 0, unsigned int = 0);
+		SYMBOL CreateUniformArrayUchar(const std::string&, unsigned int = 0, uint32 = 0, unsigned int = 0);
+		SYMBOL CreateUniformArrayUshort(const std::string&, unsigned int = 0, uint32 = 0, unsigned int = 0);
+		//Fixed size arrays of vectors or matrices that can be put in uniform blocks, indexed at runtime
+		SYMBOL CreateUniformArrayFloat4(const std::string&, uint32, unsigned int = 0, unsigned int = 0);
+		SYMBOL CreateUniformArrayInt4(const std::string&, uint32, unsigned int = 0, unsigned int = 0);
+		SYMBOL CreateUniformArrayMatrix(const std::string&, uint32, unsigned int = 0, unsigned int = 0);
+		//Pointers to arrays in device memory, their 64-bit addresses are push constants
+		//Only uint pointers support atomics
+		SYMBOL CreateUniformBufferPointerUint(const std::string&);
+		SYMBOL CreateUniformBufferPointerFloat4(const std::string&);
+
+		//Arrays shared by all invocations of a compute workgroup
+		SYMBOL CreateSharedArrayUint(uint32);
+		SYMBOL CreateSharedArrayUchar(uint32);
+		SYMBOL CreateSharedArrayUshort(uint32);
+
+		SYMBOL CreateTexture2D(unsigned int, unsigned int = 0);
+
+		//Storage images, GetImageFormat returns the IMAGE_FORMAT given at creation
+		SYMBOL CreateImage2D(unsigned int, IMAGE_FORMAT, unsigned int = 0);
+		SYMBOL CreateImage2DArray(unsigned int, IMAGE_FORMAT, unsigned int = 0);
+		SYMBOL CreateImage3D(unsigned int, IMAGE_FORMAT, unsigned int = 0);
+		SYMBOL CreateImage2DUint(unsigned int, IMAGE_FORMAT = IMAGE_FORMAT_R32UI, unsigned int = 0);
+		SYMBOL CreateImage2DArrayUint(unsigned int, IMAGE_FORMAT, unsigned int = 0);
+		SYMBOL CreateImage3DUint(unsigned int, IMAGE_FORMAT, unsigned int = 0);
+
+		//Arrays of descriptors bound to a single unit, a size of 0 declares an unbounded array
+		SYMBOL CreateTexture2DDescriptorArray(unsigned int, uint32, unsigned int = 0);
+		SYMBOL CreateImage2DDescriptorArray(unsigned int, IMAGE_FORMAT, uint32, unsigned int = 0);
+		SYMBOL CreateImage2DUintDescriptorArray(unsigned int, IMAGE_FORMAT, uint32, unsigned int = 0);
+		//Storage buffer arrays need a unit of their own, no other uniform can be bound to it
+		SYMBOL CreateUniformArrayUintDescriptorArray(const std::string&, unsigned int, uint32, unsigned int = 0);
+		//Element of a descriptor array, selected by a STATEMENT_OP_SELECT_TEXTURE statement
+		SYMBOL CreateTextureElement(const SYMBOL&, bool);
+		//Element of a storage buffer array, selected by a STATEMENT_OP_SELECT_BUFFER statement
+		SYMBOL CreateBufferElement(const SYMBOL&, bool);
+
+		SYMBOL CreateSubpassInput(unsigned int, unsigned int, unsigned int = 0);
+		SYMBOL CreateSubpassInputUint(unsigned int, unsigned int, unsigned int = 0);
+
+		//Formatted buffer views, read through the texture cache
+		SYMBOL CreateUniformTexelBuffer(unsigned int, unsigned int = 0);
+		//R32ui formatted buffer view
+		SYMBOL CreateStorageTexelBufferUint(unsigned int, unsigned int = 0);
 
 		SYMBOL CreateOptionalInput(bool, SEMANTIC, unsigned int = 0);
 		SYMBOL CreateOptionalOutput(bool, SEMANTIC, unsigned int = 0);
 		SYMBOL CreateOptionalUniformMatrix(bool, const std::string&);
 
 	private:
+		void RemapSymbolOwners();
+
 		typedef std::unordered_map<unsigned int, SEMANTIC_INFO> SemanticMap;
 		typedef std::unordered_map<unsigned int, std::string> VariableNameMap;
 		typedef std::unordered_map<unsigned int, std::string> UniformNameMap;
+		typedef std::unordered_map<unsigned int, uint32> SharedArraySizeMap;
+		typedef std::unordered_map<unsigned int, uint32> UniformArraySizeMap;
+		typedef std::unordered_map<unsigned int, uint32> UniformComponentCountMap;
+		typedef std::map<BINDING, uint32> TextureArraySizeMap;
+		typedef std::unordered_map<unsigned int, uint32> BufferArraySizeMap;
+		typedef std::map<BINDING, IMAGE_FORMAT> ImageFormatMap;
 		typedef std::unordered_map<unsigned int, CVector4> TemporaryValueMap;
 		typedef std::unordered_map<unsigned int, CIntVector4> TemporaryValueIntMap;
 		typedef std::unordered_map<unsigned int, CBoolVector4> TemporaryValueBoolMap;
+		typedef std::unordered_map<uint64, PRECISION> PrecisionMap;
 
 		MetadataMap m_metadata;
 		SymbolArray m_symbols;
 		StatementList m_statements;
+		FunctionArray m_functions;
+		uint32 m_currentFunction = INVALID_FUNCTION;
 		unsigned int m_currentTempIndex = 0;
 		unsigned int m_currentVariableIndex = 0;
 		unsigned int m_currentInputIndex = 0;
 		unsigned int m_currentOutputIndex = 0;
+		unsigned int m_currentTextureElementIndex = 0;
+		unsigned int m_currentBufferElementIndex = 0;
 
 		SemanticMap m_inputSemantics;
 		SemanticMap m_outputSemantics;
 		VariableNameMap m_variableNames;
 		UniformNameMap m_uniformNames;
+		SharedArraySizeMap m_sharedArraySizes;
+		UniformArraySizeMap m_uniformArraySizes;
+		UniformComponentCountMap m_uniformComponentCounts;
+		TextureArraySizeMap m_textureArraySizes;
+		ImageFormatMap m_imageFormats;
+		BufferArraySizeMap m_bufferArraySizes;
 		TemporaryValueMap m_temporaryValues;
 		TemporaryValueIntMap m_temporaryValuesInt;
 		TemporaryValueBoolMap m_temporaryValuesBool;
+		PrecisionMap m_precisions;
 	};
 }
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "ShaderBuilder.h"
+
+namespace Nuanceur
+{
+	class CUniformTexelBufferValue : public CShaderBuilder::SYMBOLREF
+	{
+	public:
+		CUniformTexelBufferValue(const CShaderBuilder::SYMBOL& symbol)
+		    : SYMBOLREF(symbol, SWIZZLE_XYZW)
+		{
+		}
+	};
+
+	class CStorageTexelBufferUintValue : public CShaderBuilder::SYMBOLREF
+	{
+	public:
+		CStorageTexelBufferUintValue(const CShaderBuilder::SYMBOL& symbol)
+		    : SYMBOLREF(symbol, SWIZZLE_XYZW)
+		{
+		}
+	};
+}
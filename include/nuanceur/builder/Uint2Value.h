@@ -0,0 +1,60 @@
+#pragma once
+
+#include "ShaderBuilder.h"
+
+namespace Nuanceur
+{
+	class CArrayUint2Value;
+	class CIntValue;
+	class CUintSwizzleSelector4;
+	class CUint2Rvalue;
+
+	class CUint2Value : public CShaderBuilder::SYMBOLREF
+	{
+	public:
+		CUintSwizzleSelector4* operator->()
+		{
+			assert(swizzle == SWIZZLE_XY);
+			return m_swizzleSelector.get();
+		}
+
+	protected:
+		CUint2Value(const CShaderBuilder::SYMBOL& symbol, SWIZZLE_TYPE swizzle = SWIZZLE_XY)
+		    : SYMBOLREF(symbol, swizzle)
+		{
+			m_swizzleSelector = std::make_shared<CUintSwizzleSelector4>(symbol);
+		}
+
+	private:
+		std::shared_ptr<CUintSwizzleSelector4> m_swizzleSelector;
+	};
+
+	class CUint2Lvalue : public CUint2Value
+	{
+	public:
+		CUint2Lvalue(const CShaderBuilder::SYMBOL& symbol)
+		    : CUint2Value(symbol, SWIZZLE_XY)
+		{
+		}
+
+		void operator=(const CUint2Lvalue& lvalue) = delete;
+		void operator=(const CUint2Rvalue& rvalue);
+	};
+
+	class CUint2Rvalue : public CUint2Value
+	{
+	private:
+		friend CUintSwizzleSelector4;
+		friend CUint2Rvalue Load(const CArrayUint2Value&, const CIntValue&);
+		friend CUint2Rvalue NewUint2(CShaderBuilder&, uint32, uint32);
+
+		CUint2Rvalue(const CUint2Rvalue&) = default;
+
+		CUint2Rvalue(const CShaderBuilder::SYMBOL& symbol, SWIZZLE_TYPE swizzle = SWIZZLE_XY)
+		    : CUint2Value(symbol, swizzle)
+		{
+		}
+
+		CUint2Rvalue& operator=(const CUint2Rvalue&) = delete;
+	};
+}
@@ -4,9 +4,16 @@
 
 namespace Nuanceur
 {
+	class CArrayUint4Value;
+	class CBoolValue;
 	class CImageUint2DValue;
+	class CImageUint2DArrayValue;
+	class CImageUint3DValue;
 	class CSubpassInputUintValue;
+	class CStorageTexelBufferUintValue;
 	class CInt2Value;
+	class CInt3Value;
+	class CIntValue;
 	class CUintSwizzleSelector4;
 	class CUint4Rvalue;
 
@@ -47,13 +54,18 @@ namespace Nuanceur
 	private:
 		friend CUintSwizzleSelector4;
 		friend CUint4Rvalue Load(const CImageUint2DValue&, const CInt2Value&);
+		friend CUint4Rvalue Load(const CImageUint2DArrayValue&, const CInt3Value&);
+		friend CUint4Rvalue Load(const CImageUint3DValue&, const CInt3Value&);
+		friend CUint4Rvalue Load(const CArrayUint4Value&, const CIntValue&);
 		friend CUint4Rvalue operator&(const CUint4Value&, const CUint4Value&);
 		friend CUint4Rvalue NewUint4(CShaderBuilder&, uint32, uint32, uint32, uint32);
 		friend CUint4Rvalue NewUint4(const CUintValue&, const CUint3Value&);
 		friend CUint4Rvalue NewUint4(const CUint3Value&, const CUintValue&);
 		friend CUint4Rvalue Min(const CUint4Value&, const CUint4Value&);
+		friend CUint4Rvalue SubgroupBallot(const CBoolValue&);
 		friend CUint4Rvalue ToUint(const CFloat4Value&);
 		friend CUint4Rvalue Load(const CSubpassInputUintValue&, const CInt2Value&);
+		friend CUint4Rvalue Load(const CStorageTexelBufferUintValue&, const CIntValue&);
 
 		CUint4Rvalue(const CUint4Rvalue&) = default;
 
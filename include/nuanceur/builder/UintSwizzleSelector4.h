@@ -1,7 +1,7 @@
 #pragma once
 
 #include "UintValue.h"
-//#include "Uint2Value.h"
+#include "Uint2Value.h"
 #include "Uint3Value.h"
 #include "Uint4Value.h"
 
@@ -35,6 +35,16 @@ namespace Nuanceur
 			return CUintRvalue(m_symbol, SWIZZLE_W);
 		}
 
+		CUint2Rvalue xy() const
+		{
+			return CUint2Rvalue(m_symbol, SWIZZLE_XY);
+		}
+
+		CUint2Rvalue zw() const
+		{
+			return CUint2Rvalue(m_symbol, SWIZZLE_ZW);
+		}
+
 		CUint3Rvalue xxx() const
 		{
 			return CUint3Rvalue(m_symbol, SWIZZLE_XXX);
@@ -7,6 +7,9 @@ namespace Nuanceur
 	class CUintSwizzleSelector4;
 	class CImageUint2DValue;
 	class CArrayUintValue;
+	class CArrayUcharValue;
+	class CArrayUshortValue;
+	class CBufferPointerUintValue;
 	class CUintRvalue;
 
 	class CUintValue : public CShaderBuilder::SYMBOLREF
@@ -46,10 +49,33 @@ namespace Nuanceur
 	private:
 		friend CUintSwizzleSelector4;
 		friend CUintRvalue Load(const CArrayUintValue&, const CIntValue&);
-		friend CUintRvalue AtomicAnd(const CArrayUintValue&, const CIntValue&, const CUintValue&);
-		friend CUintRvalue AtomicAnd(const CImageUint2DValue&, const CInt2Value&, const CUintValue&);
-		friend CUintRvalue AtomicOr(const CArrayUintValue&, const CIntValue&, const CUintValue&);
-		friend CUintRvalue AtomicOr(const CImageUint2DValue&, const CInt2Value&, const CUintValue&);
+		friend CUintRvalue Load(const CArrayUcharValue&, const CIntValue&);
+		friend CUintRvalue Load(const CArrayUshortValue&, const CIntValue&);
+		friend CUintRvalue Load(const CBufferPointerUintValue&, const CIntValue&);
+		friend CUintRvalue AtomicAdd(const CArrayUintValue&, const CIntValue&, const CUintValue&, MEMORY_SCOPE, MEMORY_ORDER);
+		friend CUintRvalue AtomicAdd(const CImageUint2DValue&, const CInt2Value&, const CUintValue&, MEMORY_SCOPE, MEMORY_ORDER);
+		friend CUintRvalue AtomicAdd(const CBufferPointerUintValue&, const CIntValue&, const CUintValue&, MEMORY_SCOPE, MEMORY_ORDER);
+		friend CUintRvalue AtomicAnd(const CArrayUintValue&, const CIntValue&, const CUintValue&, MEMORY_SCOPE, MEMORY_ORDER);
+		friend CUintRvalue AtomicAnd(const CImageUint2DValue&, const CInt2Value&, const CUintValue&, MEMORY_SCOPE, MEMORY_ORDER);
+		friend CUintRvalue AtomicAnd(const CBufferPointerUintValue&, const CIntValue&, const CUintValue&, MEMORY_SCOPE, MEMORY_ORDER);
+		friend CUintRvalue AtomicCompareExchange(const CArrayUintValue&, const CIntValue&, const CUintValue&, const CUintValue&, MEMORY_SCOPE, MEMORY_ORDER);
+		friend CUintRvalue AtomicCompareExchange(const CImageUint2DValue&, const CInt2Value&, const CUintValue&, const CUintValue&, MEMORY_SCOPE, MEMORY_ORDER);
+		friend CUintRvalue AtomicCompareExchange(const CBufferPointerUintValue&, const CIntValue&, const CUintValue&, const CUintValue&, MEMORY_SCOPE, MEMORY_ORDER);
+		friend CUintRvalue AtomicExchange(const CArrayUintValue&, const CIntValue&, const CUintValue&, MEMORY_SCOPE, MEMORY_ORDER);
+		friend CUintRvalue AtomicExchange(const CImageUint2DValue&, const CInt2Value&, const CUintValue&, MEMORY_SCOPE, MEMORY_ORDER);
+		friend CUintRvalue AtomicExchange(const CBufferPointerUintValue&, const CIntValue&, const CUintValue&, MEMORY_SCOPE, MEMORY_ORDER);
+		friend CUintRvalue AtomicMax(const CArrayUintValue&, const CIntValue&, const CUintValue&, MEMORY_SCOPE, MEMORY_ORDER);
+		friend CUintRvalue AtomicMax(const CImageUint2DValue&, const CInt2Value&, const CUintValue&, MEMORY_SCOPE, MEMORY_ORDER);
+		friend CUintRvalue AtomicMax(const CBufferPointerUintValue&, const CIntValue&, const CUintValue&, MEMORY_SCOPE, MEMORY_ORDER);
+		friend CUintRvalue AtomicMin(const CArrayUintValue&, const CIntValue&, const CUintValue&, MEMORY_SCOPE, MEMORY_ORDER);
+		friend CUintRvalue AtomicMin(const CImageUint2DValue&, const CInt2Value&, const CUintValue&, MEMORY_SCOPE, MEMORY_ORDER);
+		friend CUintRvalue AtomicMin(const CBufferPointerUintValue&, const CIntValue&, const CUintValue&, MEMORY_SCOPE, MEMORY_ORDER);
+		friend CUintRvalue AtomicOr(const CArrayUintValue&, const CIntValue&, const CUintValue&, MEMORY_SCOPE, MEMORY_ORDER);
+		friend CUintRvalue AtomicOr(const CImageUint2DValue&, const CInt2Value&, const CUintValue&, MEMORY_SCOPE, MEMORY_ORDER);
+		friend CUintRvalue AtomicOr(const CBufferPointerUintValue&, const CIntValue&, const CUintValue&, MEMORY_SCOPE, MEMORY_ORDER);
+		friend CUintRvalue AtomicXor(const CArrayUintValue&, const CIntValue&, const CUintValue&, MEMORY_SCOPE, MEMORY_ORDER);
+		friend CUintRvalue AtomicXor(const CImageUint2DValue&, const CInt2Value&, const CUintValue&, MEMORY_SCOPE, MEMORY_ORDER);
+		friend CUintRvalue AtomicXor(const CBufferPointerUintValue&, const CIntValue&, const CUintValue&, MEMORY_SCOPE, MEMORY_ORDER);
 		friend CUintRvalue operator+(const CUintValue&, const CUintValue&);
 		friend CUintRvalue operator*(const CUintValue&, const CUintValue&);
 		friend CUintRvalue operator<<(const CUintValue&, const CUintValue&);
@@ -59,6 +85,13 @@ namespace Nuanceur
 		friend CUintRvalue operator^(const CUintValue&, const CUintValue&);
 		friend CUintRvalue operator~(const CUintValue&);
 		friend CUintRvalue NewUint(CShaderBuilder&, uint32);
+		friend CUintRvalue SubgroupBroadcast(const CUintValue&, uint32);
+		friend CUintRvalue SubgroupShuffle(const CUintValue&, const CUintValue&);
+		friend CUintRvalue SubgroupAdd(const CUintValue&, SUBGROUP_OPERATION);
+		friend CUintRvalue SubgroupAnd(const CUintValue&, SUBGROUP_OPERATION);
+		friend CUintRvalue SubgroupMax(const CUintValue&, SUBGROUP_OPERATION);
+		friend CUintRvalue SubgroupMin(const CUintValue&, SUBGROUP_OPERATION);
+		friend CUintRvalue SubgroupOr(const CUintValue&, SUBGROUP_OPERATION);
 		friend CUintRvalue ToUint(const CFloatValue&);
 		friend CUintRvalue ToUint(const CIntValue&);
 
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "ShaderBuilder.h"
+
+namespace Nuanceur
+{
+	class CArrayFloat4Value : public CShaderBuilder::SYMBOLREF
+	{
+	public:
+		CArrayFloat4Value(const CShaderBuilder::SYMBOL& symbol)
+		    : SYMBOLREF(symbol, SWIZZLE_XYZW)
+		{
+		}
+	};
+
+	class CArrayInt4Value : public CShaderBuilder::SYMBOLREF
+	{
+	public:
+		CArrayInt4Value(const CShaderBuilder::SYMBOL& symbol)
+		    : SYMBOLREF(symbol, SWIZZLE_XYZW)
+		{
+		}
+	};
+
+	class CArrayMatrix44Value : public CShaderBuilder::SYMBOLREF
+	{
+	public:
+		CArrayMatrix44Value(const CShaderBuilder::SYMBOL& symbol)
+		    : SYMBOLREF(symbol, SWIZZLE_XYZW)
+		{
+		}
+	};
+}
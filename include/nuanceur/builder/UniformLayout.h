@@ -0,0 +1,42 @@
+#pragma once
+
+#include <map>
+#include <vector>
+#include "ShaderBuilder.h"
+
+namespace Nuanceur
+{
+	enum UNIFORM_LAYOUT
+	{
+		UNIFORM_LAYOUT_STD140, //Uniform blocks
+		UNIFORM_LAYOUT_STD430, //Push constants and storage buffers
+		UNIFORM_LAYOUT_SCALAR, //All blocks when METADATA_SCALAR_BLOCK_LAYOUT is set
+	};
+
+	struct UNIFORM_MEMBER_LAYOUT
+	{
+		CShaderBuilder::SYMBOL symbol;
+		uint32 offset = 0;
+		uint32 size = 0;         //0 for arrays without a fixed size
+		uint32 arrayStride = 0;  //0 if the member isn't an array
+		uint32 matrixStride = 0; //0 if the member doesn't contain matrices
+	};
+
+	struct UNIFORM_BLOCK_LAYOUT
+	{
+		UNIFORM_LAYOUT layout = UNIFORM_LAYOUT_STD140;
+		uint32 size = 0;                            //Bytes used by fixed size members
+		std::vector<UNIFORM_MEMBER_LAYOUT> members; //Sorted by offset, position is the member's index in the block
+	};
+
+	typedef std::map<CShaderBuilder::BINDING, UNIFORM_BLOCK_LAYOUT> UniformBlockLayoutMap;
+
+	namespace UniformLayout
+	{
+		//Returns the layout of the block of every uniform unit, keyed by binding.
+		//Members are placed by decreasing alignment to avoid padding, arrays without a fixed size come last.
+		UniformBlockLayoutMap ComputeBlockLayouts(const CShaderBuilder&);
+
+		const char* GetLayoutName(UNIFORM_LAYOUT);
+	}
+}
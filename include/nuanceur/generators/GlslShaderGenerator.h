@@ -15,22 +15,41 @@ namespace Nuanceur
 			SHADER_TYPE_COMPUTE,
 		};
 
-		static std::string Generate(const CShaderBuilder&, SHADER_TYPE, uint32 = 0);
+		enum FLAGS : uint32
+		{
+			FLAG_NATIVE_FLOAT16 = 0x01, //Half symbols use float16_t (GL_EXT_shader_explicit_arithmetic_types_float16), mediump floats otherwise
+		};
+
+		static std::string Generate(const CShaderBuilder&, SHADER_TYPE, uint32 = 0, uint32 flags = 0);
 
 	private:
-		CGlslShaderGenerator(const CShaderBuilder&, SHADER_TYPE, uint32 = 0);
+		CGlslShaderGenerator(const CShaderBuilder&, SHADER_TYPE, uint32, uint32);
 
 		std::string Generate() const;
 
 		std::string GenerateInputs() const;
 		std::string GenerateOutputs() const;
 		std::string GenerateUniforms() const;
+		std::string GenerateSharedArrays() const;
 		std::string GenerateSamplers() const;
+		std::string GenerateFunctions() const;
+		std::string GenerateTemporary(const CShaderBuilder::SYMBOL&) const;
+		std::string GenerateStatements(const CShaderBuilder::StatementList&) const;
 
 		std::string MakeSymbolName(const CShaderBuilder::SYMBOL&) const;
 		std::string MakeLocalSymbolName(const CShaderBuilder::SYMBOL&) const;
+		std::string MakeTextureName(const CShaderBuilder::SYMBOL&) const;
 		static std::string MakeSemanticName(CShaderBuilder::SEMANTIC_INFO);
-		static std::string MakeTypeName(CShaderBuilder::SYMBOL_TYPE);
+		std::string MakeTypeName(CShaderBuilder::SYMBOL_TYPE) const;
+		std::string MakePrecisionQualifier(const CShaderBuilder::SYMBOL&) const;
+		std::string MakeUniformDeclaration(const CShaderBuilder::SYMBOL&) const;
+		static const char* GetPrecisionName(PRECISION);
+		static const char* GetDepthLayoutName(DEPTH_MODE);
+		static const char* GetSubgroupOperationPrefix(SUBGROUP_OPERATION);
+		static const char* GetImageTypeName(CShaderBuilder::SYMBOL_TYPE);
+		static const char* GetImageFormatName(IMAGE_FORMAT);
+		static std::string MakeDescriptorSetQualifier(const CShaderBuilder::SYMBOL&);
+		static std::string MakeBindingName(const CShaderBuilder::SYMBOL&);
 		std::string PrintSymbolRef(const CShaderBuilder::SYMBOLREF&) const;
 
 		std::string EmitConversion(const std::array<const char*, 4>&, const CShaderBuilder::SYMBOLREF&, const CShaderBuilder::SYMBOLREF&) const;
@@ -38,5 +57,6 @@ namespace Nuanceur
 		const CShaderBuilder& m_shaderBuilder;
 		SHADER_TYPE m_shaderType = SHADER_TYPE_VERTEX;
 		uint32 m_glslVersion = 0;
+		uint32 m_flags = 0;
 	};
 }
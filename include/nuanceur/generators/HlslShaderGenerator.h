@@ -10,7 +10,11 @@ namespace Nuanceur
 	public:
 		enum FLAGS : uint32
 		{
-			FLAG_COMBINED_SAMPLER_TEXTURE = 0x01, //Use tex2D/texCUBE instead of texture.Sample
+			FLAG_COMBINED_SAMPLER_TEXTURE = 0x01,       //Use tex2D/texCUBE instead of texture.Sample
+			FLAG_HLSL_2021 = 0x02,                      //Target HLSL 2021, vector selects use select instead of ?:
+			FLAG_DEFAULT_SELECTION_FLATTEN = 0x04,      //IF blocks without a selection control hint use [flatten]
+			FLAG_DEFAULT_SELECTION_DONT_FLATTEN = 0x08, //IF blocks without a selection control hint use [branch]
+			FLAG_NATIVE_FLOAT16 = 0x10,                 //Half symbols use min16float, float otherwise
 		};
 
 		static std::string Generate(const std::string&, const CShaderBuilder&, uint32 flags = 0);
@@ -24,12 +28,22 @@ namespace Nuanceur
 		std::string GenerateOutputStruct() const;
 		std::string GenerateConstants() const;
 		std::string GenerateSamplers() const;
-
+		std::string GenerateBuffers() const;
+		std::string GenerateFunctions() const;
+		std::string GenerateTemporary(const CShaderBuilder::SYMBOL&) const;
+		//Entry point returns the output struct
+		std::string GenerateStatements(const CShaderBuilder::StatementList&, bool isEntryPoint) const;
+
+		std::string MakeTextureName(const CShaderBuilder::SYMBOL&) const;
+		static std::string MakeBindingName(const CShaderBuilder::SYMBOL&);
+		static std::string MakeRegisterName(char, const CShaderBuilder::SYMBOL&);
 		std::string MakeSymbolName(const CShaderBuilder::SYMBOL&) const;
 		std::string MakeLocalSymbolName(const CShaderBuilder::SYMBOL&) const;
-		static std::string MakeSemanticName(CShaderBuilder::SEMANTIC_INFO);
-		static std::string MakeTypeName(CShaderBuilder::SYMBOL_TYPE);
+		std::string MakeSemanticName(CShaderBuilder::SEMANTIC_INFO) const;
+		std::string MakeTypeName(CShaderBuilder::SYMBOL_TYPE) const;
 		std::string PrintSymbolRef(const CShaderBuilder::SYMBOLREF&) const;
+		std::string PrintSelectionControl(uint32) const;
+		static std::string PrintLoopControl(uint32);
 
 		const CShaderBuilder& m_shaderBuilder;
 		uint32 m_flags = 0;
@@ -2,9 +2,10 @@
 
 #include <set>
 #include <map>
-#include <stack>
+#include <vector>
 #include <cstring>
 #include "nuanceur/builder/ShaderBuilder.h"
+#include "nuanceur/builder/UniformLayout.h"
 #include "Stream.h"
 #include "../external/vulkan/spirv.hpp"
 #include "../external/vulkan/GLSL.std.450.h"
@@ -85,19 +86,27 @@ namespace Nuanceur
 			SHADER_TYPE_COMPUTE
 		};
 
-		static void Generate(Framework::CStream&, const CShaderBuilder&, SHADER_TYPE);
+		enum FLAGS : uint32
+		{
+			FLAG_DEFAULT_SELECTION_FLATTEN = 0x01,      //IF blocks without a selection control hint use Flatten
+			FLAG_DEFAULT_SELECTION_DONT_FLATTEN = 0x02, //IF blocks without a selection control hint use DontFlatten
+			FLAG_NATIVE_FLOAT16 = 0x04,                 //Half symbols use 16-bit floats (Float16 capability), relaxed 32-bit floats otherwise
+		};
+
+		static void Generate(Framework::CStream&, const CShaderBuilder&, SHADER_TYPE, uint32 flags = 0);
 
 	private:
-		CSpirvShaderGenerator(Framework::CStream&, const CShaderBuilder&, SHADER_TYPE);
+		CSpirvShaderGenerator(Framework::CStream&, const CShaderBuilder&, SHADER_TYPE, uint32);
 		virtual ~CSpirvShaderGenerator() = default;
 
 		void Generate();
+		void GenerateStatements(const CShaderBuilder::StatementList&);
 
 		void Write32(uint32);
 
 		void WriteOp(spv::Op opcode)
 		{
-			m_outputStream.Write32((1 << 16) | static_cast<uint32>(opcode));
+			m_currentStream->Write32((1 << 16) | static_cast<uint32>(opcode));
 		}
 
 		template <typename... ParamTypes>
@@ -107,8 +116,8 @@ namespace Nuanceur
 			convertedParams.reserve(sizeof...(params));
 			SpirvOpConverter::ConvertParams(convertedParams, std::forward<ParamTypes>(params)...);
 			uint32 paramSize = static_cast<uint32>(convertedParams.size()) + 1;
-			m_outputStream.Write32((paramSize << 16) | static_cast<uint32>(opcode));
-			m_outputStream.Write(convertedParams.data(), convertedParams.size() * sizeof(uint32));
+			m_currentStream->Write32((paramSize << 16) | static_cast<uint32>(opcode));
+			m_currentStream->Write(convertedParams.data(), convertedParams.size() * sizeof(uint32));
 		}
 
 		void AllocateInputPointerIds();
@@ -125,8 +134,16 @@ namespace Nuanceur
 
 		void AllocateVariablePointerIds();
 		void WriteVariablePointerNames();
+		void DecorateVariablePointerIds();
 		void DeclareVariablePointerIds();
 
+		void AllocateSharedArrayIds();
+		void DeclareSharedArrayIds();
+		uint32 GetSharedArrayElementPointerId(const CShaderBuilder::SYMBOLREF&, uint32);
+		uint32 GetBufferPointerElementPointerId(const CShaderBuilder::SYMBOLREF&, uint32);
+		uint32 GetUniformArrayElementPointerId(const CShaderBuilder::SYMBOLREF&, uint32);
+		uint32 GetStorageBufferUintPointerId(const CShaderBuilder::SYMBOLREF&, uint32);
+
 		void AllocateUniformStructsIds();
 		void WriteUniformStructNames();
 		void DecorateUniformStructIds();
@@ -135,8 +152,19 @@ namespace Nuanceur
 		void AllocateTextureIds();
 		void DecorateTextureIds();
 		void DeclareTextureIds();
+		void AllocateTextureArrayIds();
+		void DeclareTextureArrayIds();
+		uint32 GetTextureTypeId(const CShaderBuilder::SYMBOL&);
+		uint32 GetTexturePointerId(const CShaderBuilder::SYMBOL&);
+
+		void AllocateStorageImageTypeIds();
+		void DeclareStorageImageTypeIds();
+		uint32 GetStorageImageKey(const CShaderBuilder::SYMBOL&) const;
+		uint32 LoadStorageImageCoord(const CShaderBuilder::SYMBOLREF&, const CShaderBuilder::SYMBOLREF&);
+		static spv::ImageFormat GetSpirvImageFormat(IMAGE_FORMAT);
 
 		void RegisterFloatConstant(float);
+		void RegisterHalfConstant(float);
 		void RegisterIntConstant(int32);
 		void RegisterUintConstant(uint32);
 		void RegisterUshortConstant(uint32);
@@ -148,9 +176,14 @@ namespace Nuanceur
 
 		uint32 ExtractFloat4X(uint32);
 		uint32 GetResultType(CShaderBuilder::SYMBOL_TYPE) const;
+		uint32 GetVectorTypeId(CShaderBuilder::SYMBOL_TYPE) const;
+		uint32 GetFunctionReturnTypeId(const CShaderBuilder::FUNCTION&) const;
+		spv::SelectionControlMask GetSelectionControl(uint32) const;
+		static spv::LoopControlMask GetLoopControl(uint32);
 
 		static uint32 MapSemanticToLocation(Nuanceur::SEMANTIC, uint32);
 		bool IsBuiltInOutput(Nuanceur::SEMANTIC) const;
+		bool IsRelaxedPrecision(const CShaderBuilder::SYMBOL&) const;
 
 		uint32 MakeDefinedInt4Vector(uint32, Nuanceur::SWIZZLE_TYPE);
 
@@ -175,8 +208,22 @@ namespace Nuanceur
 		         const CShaderBuilder::SYMBOLREF&, const CShaderBuilder::SYMBOLREF&);
 		void Negate(const CShaderBuilder::SYMBOLREF&, const CShaderBuilder::SYMBOLREF&);
 		void Compare(CShaderBuilder::STATEMENT_OP, const CShaderBuilder::SYMBOLREF&, const CShaderBuilder::SYMBOLREF&, const CShaderBuilder::SYMBOLREF&);
-		void AtomicImageOp(spv::Op, const CShaderBuilder::SYMBOLREF&, const CShaderBuilder::SYMBOLREF&,
-		                   const CShaderBuilder::SYMBOLREF&, const CShaderBuilder::SYMBOLREF&);
+		void AtomicImageOp(spv::Op, const CShaderBuilder::STATEMENT&);
+		static bool IsAtomicStatement(CShaderBuilder::STATEMENT_OP);
+		static spv::Scope GetAtomicScope(uint32);
+		static uint32 GetAtomicSemantics(const CShaderBuilder::SYMBOL&, MEMORY_ORDER);
+		static MEMORY_ORDER GetAtomicOrder(uint32);
+		static MEMORY_ORDER GetAtomicUnequalOrder(uint32);
+		void SubgroupBallot(const CShaderBuilder::SYMBOLREF&, const CShaderBuilder::SYMBOLREF&);
+		void SubgroupBroadcast(const CShaderBuilder::SYMBOLREF&, const CShaderBuilder::SYMBOLREF&, uint32);
+		void SubgroupShuffle(const CShaderBuilder::SYMBOLREF&, const CShaderBuilder::SYMBOLREF&, const CShaderBuilder::SYMBOLREF&);
+		void SubgroupArithmeticOp(spv::Op, spv::Op, spv::Op, const CShaderBuilder::SYMBOLREF&, const CShaderBuilder::SYMBOLREF&, uint32);
+		static spv::GroupOperation GetGroupOperation(uint32);
+		void TextureOp(const CShaderBuilder::STATEMENT&);
+		void SelectTexture(const CShaderBuilder::STATEMENT&);
+		void SelectBuffer(const CShaderBuilder::STATEMENT&);
+		static int32 GetSampleOffsetX(uint32);
+		static int32 GetSampleOffsetY(uint32);
 		void Load(const CShaderBuilder::SYMBOLREF&, const CShaderBuilder::SYMBOLREF&, const CShaderBuilder::SYMBOLREF&);
 		void Store(const CShaderBuilder::SYMBOLREF&, const CShaderBuilder::SYMBOLREF&, const CShaderBuilder::SYMBOLREF&);
 		void Store16(const CShaderBuilder::SYMBOLREF&, const CShaderBuilder::SYMBOLREF&, const CShaderBuilder::SYMBOLREF&);
@@ -187,12 +234,51 @@ namespace Nuanceur
 			EMPTY_ID = 0
 		};
 
+		typedef std::map<uint32, uint32> TemporaryValueIdMap;
+		typedef std::pair<uint32, TemporaryValueIdMap> MergeIncoming;
+
+		struct CONTROL_FLOW_BLOCK
+		{
+			uint32 mergeLabelId = EMPTY_ID;
+			std::vector<uint32> regionLabelIds; //Labels for ELSE, CASE and DEFAULT
+			size_t nextRegionIndex = 0;
+			TemporaryValueIdMap headerTemporaryValueIds;
+			std::vector<MergeIncoming> incomings; //Blocks branching to the merge block, with temporary values at that point
+
+			//Loops only
+			uint32 headerLabelId = EMPTY_ID;
+			uint32 continueLabelId = EMPTY_ID;
+			std::vector<MergeIncoming> continueIncomings;
+			TemporaryValueIdMap backEdgeValueIds; //Values of loop carried temporaries, defined at the end of the continue block
+			CShaderBuilder::SYMBOLREF indexRef;
+		};
+
+		static bool IsControlFlowStatement(CShaderBuilder::STATEMENT_OP);
+		static std::vector<CShaderBuilder::StatementList::const_iterator> FindBlockSeparators(CShaderBuilder::StatementList::const_iterator, CShaderBuilder::StatementList::const_iterator);
+		static std::set<uint32> FindLoopWrittenTemporaries(CShaderBuilder::StatementList::const_iterator, CShaderBuilder::StatementList::const_iterator);
+		CONTROL_FLOW_BLOCK& GetInnermostLoopBlock();
+		void BranchToMerge(CONTROL_FLOW_BLOCK&);
+		void BeginMergeBlock(uint32, const std::vector<MergeIncoming>&, const TemporaryValueIdMap&);
+		void BeginLoop(const CShaderBuilder::STATEMENT&, CShaderBuilder::StatementList::const_iterator, CShaderBuilder::StatementList::const_iterator);
+		void EndLoop();
+
 		enum
 		{
 			VERTEX_OUTPUT_POSITION_INDEX = 0,
 			VERTEX_OUTPUT_POINTSIZE_INDEX = 1,
 		};
 
+		//Same memory semantics as GLSL's barrier and memoryBarrier
+		enum : uint32
+		{
+			WORKGROUP_BARRIER_SEMANTICS = static_cast<uint32>(spv::MemorySemanticsAcquireReleaseMask) |
+			                              static_cast<uint32>(spv::MemorySemanticsWorkgroupMemoryMask),
+			DEVICE_MEMORY_BARRIER_SEMANTICS = static_cast<uint32>(spv::MemorySemanticsAcquireReleaseMask) |
+			                                  static_cast<uint32>(spv::MemorySemanticsUniformMemoryMask) |
+			                                  static_cast<uint32>(spv::MemorySemanticsWorkgroupMemoryMask) |
+			                                  static_cast<uint32>(spv::MemorySemanticsImageMemoryMask),
+		};
+
 		struct STRUCTINFO
 		{
 			uint32 typeId = EMPTY_ID;
@@ -200,18 +286,46 @@ namespace Nuanceur
 			uint32 variableId = EMPTY_ID;
 			std::vector<uint32> components;
 			std::map<uint32, uint32> memberIndices;
-			uint32 memberIndex = 0;
-			uint32 currentOffset = 0;
+			UNIFORM_BLOCK_LAYOUT layout;
 			bool isBufferBlock = false;
+			//Only used by storage buffer arrays, pointerTypeId then points to the array
+			uint32 arrayTypeId = EMPTY_ID;
+			uint32 elementPointerTypeId = EMPTY_ID;
+		};
+
+		struct STORAGEIMAGEINFO
+		{
+			uint32 typeId = EMPTY_ID;
+			uint32 pointerTypeId = EMPTY_ID;
+			CShaderBuilder::SYMBOL_TYPE symbolType = CShaderBuilder::SYMBOL_TYPE_NULL;
+			IMAGE_FORMAT format = IMAGE_FORMAT_R32UI;
+		};
+
+		struct TEXTUREARRAYINFO
+		{
+			uint32 typeId = EMPTY_ID;
+			uint32 pointerTypeId = EMPTY_ID;
+			uint32 elementPointerTypeId = EMPTY_ID;
+		};
+
+		struct SHAREDARRAYINFO
+		{
+			uint32 typeId = EMPTY_ID;
+			uint32 pointerTypeId = EMPTY_ID;
+			uint32 variableId = EMPTY_ID;
 		};
 
 		uint32 m_glslStd450ExtInst = EMPTY_ID;
 
 		//Type Ids
+		uint32 m_voidTypeId = EMPTY_ID;
 		uint32 m_boolTypeId = EMPTY_ID;
 		uint32 m_bool4TypeId = EMPTY_ID;
 		uint32 m_floatTypeId = EMPTY_ID;
+		uint32 m_float2TypeId = EMPTY_ID;
 		uint32 m_float4TypeId = EMPTY_ID;
+		uint32 m_halfTypeId = EMPTY_ID;
+		uint32 m_half4TypeId = EMPTY_ID;
 		uint32 m_matrix44TypeId = EMPTY_ID;
 
 		// integer data type
@@ -226,11 +340,14 @@ namespace Nuanceur
 		uint32 m_int2TypeId = EMPTY_ID;
 		uint32 m_int3TypeId = EMPTY_ID;
 		uint32 m_int4TypeId = EMPTY_ID;
+		uint32 m_uint2TypeId = EMPTY_ID;
 		uint32 m_uint4TypeId = EMPTY_ID;
 		uint32 m_uchar4TypeId = EMPTY_ID;
 		uint32 m_ushort4TypeId = EMPTY_ID;
 
 		uint32 m_uintArrayTypeId = EMPTY_ID;
+		uint32 m_uint2ArrayTypeId = EMPTY_ID;
+		uint32 m_uint4ArrayTypeId = EMPTY_ID;
 		uint32 m_ucharArrayTypeId = EMPTY_ID;
 		uint32 m_ushortArrayTypeId = EMPTY_ID;
 
@@ -248,24 +365,44 @@ namespace Nuanceur
 
 		uint32 m_outputPerVertexVariableId = EMPTY_ID;
 
+		uint32 m_pushFloatPointerTypeId = EMPTY_ID;
+		uint32 m_pushFloat2PointerTypeId = EMPTY_ID;
 		uint32 m_pushFloat4PointerTypeId = EMPTY_ID;
 		uint32 m_pushInt4PointerTypeId = EMPTY_ID;
 		uint32 m_pushMatrix44PointerTypeId = EMPTY_ID;
-
+		uint32 m_pushBufferPointerUintPointerTypeId = EMPTY_ID;
+		uint32 m_pushBufferPointerFloat4PointerTypeId = EMPTY_ID;
+
+		//Physical storage buffer
+		uint32 m_bufferPointerUintStructTypeId = EMPTY_ID;
+		uint32 m_bufferPointerUintTypeId = EMPTY_ID;
+		uint32 m_bufferPointerUintElementPtrId = EMPTY_ID;
+		uint32 m_bufferPointerFloat4ArrayTypeId = EMPTY_ID;
+		uint32 m_bufferPointerFloat4StructTypeId = EMPTY_ID;
+		uint32 m_bufferPointerFloat4TypeId = EMPTY_ID;
+		uint32 m_bufferPointerFloat4ElementPtrId = EMPTY_ID;
+
+		uint32 m_uniformFloatPointerTypeId = EMPTY_ID;
+		uint32 m_uniformFloat2PointerTypeId = EMPTY_ID;
 		uint32 m_uniformFloat4PointerTypeId = EMPTY_ID;
 		uint32 m_uniformInt4PointerTypeId = EMPTY_ID;
+		uint32 m_uniformMatrix44PointerTypeId = EMPTY_ID;
 		uint32 m_uniformUintPtrId = EMPTY_ID;
+		uint32 m_uniformUint2PtrId = EMPTY_ID;
+		uint32 m_uniformUint4PtrId = EMPTY_ID;
 		uint32 m_uniformUint8PtrId = EMPTY_ID;
 		uint32 m_uniformUint16PtrId = EMPTY_ID;
 
+		uint32 m_workgroupUintPtrId = EMPTY_ID;
+		uint32 m_workgroupUint8PtrId = EMPTY_ID;
+		uint32 m_workgroupUint16PtrId = EMPTY_ID;
+
 		//Sampled Image
 		uint32 m_sampledImage2DTypeId = EMPTY_ID;
 		uint32 m_sampledImageSamplerTypeId = EMPTY_ID;
 		uint32 m_sampledImageSamplerPointerTypeId = EMPTY_ID;
 
 		//Storage Image
-		uint32 m_storageImage2DTypeId = EMPTY_ID;
-		uint32 m_storageImage2DPointerTypeId = EMPTY_ID;
 		uint32 m_imageUintPtrId = EMPTY_ID;
 
 		//Subpass Input
@@ -274,27 +411,60 @@ namespace Nuanceur
 		uint32 m_subpassInputPointerTypeId = EMPTY_ID;
 		uint32 m_subpassInputUintPointerTypeId = EMPTY_ID;
 
+		//Texel Buffer
+		uint32 m_uniformTexelBufferTypeId = EMPTY_ID;
+		uint32 m_uniformTexelBufferPointerTypeId = EMPTY_ID;
+		uint32 m_storageTexelBufferUintTypeId = EMPTY_ID;
+		uint32 m_storageTexelBufferUintPointerTypeId = EMPTY_ID;
+
 		Framework::CStream& m_outputStream;
+		Framework::CStream* m_currentStream = nullptr;
 		const CShaderBuilder& m_shaderBuilder;
 		SHADER_TYPE m_shaderType = SHADER_TYPE_VERTEX;
+		uint32 m_flags = 0;
 
 		bool m_hasTextures = false;
+		bool m_hasUniformTexelBuffer = false;
+		bool m_hasStorageTexelBuffer = false;
 		bool m_has8BitInt = false;
 		bool m_has16BitInt = false;
-		std::map<uint32, STRUCTINFO> m_structInfos;
+		bool m_hasUint2Array = false;
+		bool m_hasUint4Array = false;
+		bool m_hasBufferPointer = false;
+		bool m_hasBufferPointerUint = false;
+		bool m_hasBufferPointerFloat4 = false;
+		bool m_hasSmallFloatUniform = false;
+		bool m_hasNativeFloat16 = false;
+		std::map<CShaderBuilder::BINDING, STRUCTINFO> m_structInfos;
+		std::map<uint32, uint32> m_uniformArrayTypeIds;
+		std::map<uint32, SHAREDARRAYINFO> m_sharedArrayInfos;
+		std::map<uint32, STORAGEIMAGEINFO> m_storageImageInfos;
 		std::map<uint32, uint32> m_inputPointerIds;
 		std::map<uint32, uint32> m_outputPointerIds;
-		std::map<uint32, uint32> m_temporaryValueIds;
+		TemporaryValueIdMap m_temporaryValueIds;
+		std::map<uint32, uint32> m_temporaryTypeIds;
 		std::map<uint32, uint32> m_variablePointerIds;
-		std::map<uint32, uint32> m_texturePointerIds;
+		std::map<CShaderBuilder::BINDING, uint32> m_texturePointerIds;
+		std::map<CShaderBuilder::BINDING, TEXTUREARRAYINFO> m_textureArrayInfos;
+		std::map<uint32, uint32> m_textureElementPointerIds;
+		std::map<uint32, uint32> m_bufferElementPointerIds;
 		std::map<float, uint32> m_floatConstantIds;
+		std::map<uint32, uint32> m_halfConstantIds;
 		std::map<int32, uint32> m_intConstantIds;
 		std::map<uint32, uint32> m_uintConstantIds;
 		std::map<uint32, uint32> m_ushortConstantIds;
 		std::map<uint32, uint32> m_ucharConstantIds;
+		std::map<uint32, uint32> m_sampleOffsetIds;
 		uint32 m_boolConstantFalseId;
 		uint32 m_boolConstantTrueId;
 		uint32 m_nextId = EMPTY_ID + 1;
-		std::stack<uint32> m_endLabelIds;
+		std::vector<CONTROL_FLOW_BLOCK> m_controlFlowBlocks;
+		uint32 m_currentLabelId = EMPTY_ID;
+		bool m_blockTerminated = false;
+		std::vector<uint32> m_functionIds;
+		std::vector<uint32> m_functionTypeIds;
+		uint32 m_firstInstructionId = EMPTY_ID;
+		std::set<uint32> m_relaxedPrecisionIds;
+		std::set<uint32> m_nonUniformIds;
 	};
 }
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "nuanceur/builder/ShaderBuilder.h"
+
+namespace Nuanceur
+{
+	class CConstantFoldingPass
+	{
+	public:
+		//Evaluates statements that only depend on constants and removes branches with a constant condition
+		static void Run(CShaderBuilder&);
+	};
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "nuanceur/builder/ShaderBuilder.h"
+
+namespace Nuanceur
+{
+	class CDeadCodeEliminationPass
+	{
+	public:
+		//Removes statements whose results are never read and empty blocks
+		static void Run(CShaderBuilder&);
+	};
+}
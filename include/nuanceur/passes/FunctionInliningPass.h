@@ -0,0 +1,21 @@
+#pragma once
+
+#include "nuanceur/builder/ShaderBuilder.h"
+
+namespace Nuanceur
+{
+	class CFunctionInliningPass
+	{
+	public:
+		enum
+		{
+			DEFAULT_MAX_INLINED_STATEMENTS = 16,
+		};
+
+		//Replaces calls by a copy of the called function's body, with fresh temporaries for every copy.
+		//Functions are inlined if they are called only once or if their statement count doesn't exceed maxInlinedStatements.
+		//Functions returning before their last statement are kept. Functions that aren't called anymore are removed,
+		//which changes the index of the remaining ones.
+		static void Run(CShaderBuilder&, unsigned int maxInlinedStatements = DEFAULT_MAX_INLINED_STATEMENTS);
+	};
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "nuanceur/builder/ShaderBuilder.h"
+
+namespace Nuanceur
+{
+	class CIfConversionPass
+	{
+	public:
+		enum
+		{
+			DEFAULT_COST_THRESHOLD = 8,
+		};
+
+		//Replaces small side effect free IF/ELSE blocks by unconditional code and selects (MIX with a bool selector).
+		//Cost is the number of statements left after conversion, a threshold of 0 keeps all branches.
+		//Blocks hinted with SELECTION_CONTROL_DONT_FLATTEN are never converted.
+		static void Run(CShaderBuilder&, unsigned int costThreshold = DEFAULT_COST_THRESHOLD);
+	};
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "nuanceur/builder/ShaderBuilder.h"
+
+namespace Nuanceur
+{
+	class CInterlockMinimizationPass
+	{
+	public:
+		//Shrinks invocation interlock critical sections by moving statements that don't touch memory out of them.
+		//Statements that don't depend on other statements of the section are hoisted before its beginning and
+		//statements that no other statement of the section depends on are sunk after its end.
+		//Loads, statements with side effects and statements inside nested blocks are never moved.
+		static void Run(CShaderBuilder&);
+	};
+}
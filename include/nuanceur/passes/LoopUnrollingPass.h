@@ -0,0 +1,21 @@
+#pragma once
+
+#include "nuanceur/builder/ShaderBuilder.h"
+
+namespace Nuanceur
+{
+	class CLoopUnrollingPass
+	{
+	public:
+		enum
+		{
+			DEFAULT_MAX_UNROLLED_STATEMENTS = 64,
+		};
+
+		//Replaces counted loops with a constant count by copies of their body, the index being replaced by constants.
+		//Loops are unrolled if their count times their statement count doesn't exceed maxUnrolledStatements.
+		//Loops hinted with LOOP_CONTROL_UNROLL are always unrolled, loops hinted with LOOP_CONTROL_DONT_UNROLL never are.
+		//Loops using Break or Continue are kept.
+		static void Run(CShaderBuilder&, unsigned int maxUnrolledStatements = DEFAULT_MAX_UNROLLED_STATEMENTS);
+	};
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <vector>
+#include "nuanceur/builder/ShaderBuilder.h"
+
+namespace Nuanceur
+{
+	namespace PassUtils
+	{
+		typedef uint64 SymbolKey;
+		typedef std::vector<CShaderBuilder::STATEMENT> StatementArray;
+
+		constexpr size_t INVALID_INDEX = ~static_cast<size_t>(0);
+
+		//Uniquely identifies a temporary, variable, input, output or uniform symbol
+		SymbolKey MakeSymbolKey(const CShaderBuilder::SYMBOL&);
+
+		bool HasSideEffects(CShaderBuilder::STATEMENT_OP);
+		bool IsBlockBegin(CShaderBuilder::STATEMENT_OP);
+		bool IsBlockSeparator(CShaderBuilder::STATEMENT_OP);
+		bool IsBlockEnd(CShaderBuilder::STATEMENT_OP);
+
+		//Returns, for every block begin statement, the index of its matching block end (INVALID_INDEX otherwise)
+		std::vector<size_t> MatchBlocks(const StatementArray&);
+
+		//Returns, for every block begin or separator (ELSE, CASE) statement, the index of the
+		//next separator or block end of the same block (INVALID_INDEX otherwise)
+		std::vector<size_t> MatchRegions(const StatementArray&);
+
+		template <typename StatementType, typename FunctionType>
+		void ForEachSourceRef(StatementType& statement, const FunctionType& function)
+		{
+			if(statement.src1Ref.symbol.location != CShaderBuilder::SYMBOL_LOCATION_NULL) function(statement.src1Ref);
+			if(statement.src2Ref.symbol.location != CShaderBuilder::SYMBOL_LOCATION_NULL) function(statement.src2Ref);
+			if(statement.src3Ref.symbol.location != CShaderBuilder::SYMBOL_LOCATION_NULL) function(statement.src3Ref);
+			if(statement.src4Ref.symbol.location != CShaderBuilder::SYMBOL_LOCATION_NULL) function(statement.src4Ref);
+		}
+	}
+}
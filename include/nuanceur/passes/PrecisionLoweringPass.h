@@ -0,0 +1,14 @@
+#pragma once
+
+#include "nuanceur/builder/ShaderBuilder.h"
+
+namespace Nuanceur
+{
+	class CPrecisionLoweringPass
+	{
+	public:
+		//Sets PRECISION_MEDIUM on float temporaries, variables and color outputs whose values only end up
+		//in color outputs or in 8-bit stores. Symbols with an explicit precision are left untouched.
+		static void Run(CShaderBuilder&);
+	};
+}
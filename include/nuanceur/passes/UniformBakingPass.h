@@ -0,0 +1,32 @@
+#pragma once
+
+#include <unordered_map>
+#include "nuanceur/builder/ShaderBuilder.h"
+
+namespace Nuanceur
+{
+	class CUniformBakingPass
+	{
+	public:
+		class CValueMap
+		{
+		public:
+			void SetValue(const CShaderBuilder::SYMBOL&, const CVector4&);
+			void SetValue(const CShaderBuilder::SYMBOL&, const CShaderBuilder::CIntVector4&);
+
+		private:
+			friend class CUniformBakingPass;
+
+			typedef std::unordered_map<unsigned int, CVector4> FloatValueMap;
+			typedef std::unordered_map<unsigned int, CShaderBuilder::CIntVector4> IntValueMap;
+
+			FloatValueMap m_floatValues;
+			IntValueMap m_intValues;
+		};
+
+		//Returns a copy of the shader where the uniforms present in the map are replaced by their value.
+		//Only float, int and uint vector uniforms are baked, values given for other uniforms are ignored.
+		//Uniform declarations are kept to preserve the layout expected by the host.
+		static CShaderBuilder Run(const CShaderBuilder&, const CValueMap&);
+	};
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "nuanceur/builder/ShaderBuilder.h"
+
+namespace Nuanceur
+{
+	class CVectorizationPass
+	{
+	public:
+		enum
+		{
+			DEFAULT_MAX_DISTANCE = 16,
+		};
+
+		//Fuses component-wise statements doing the same operation on different components of the same symbols
+		//into a single statement working on all of them (ie.: a.x = b.x + c.x; a.y = b.y + c.y becomes a.xy = b.xy + c.xy).
+		//Temporaries written by a single statement can be packed together, constants are combined when needed.
+		//Only statements at most maxDistance statements apart, without side effects between them, are fused.
+		static void Run(CShaderBuilder&, unsigned int maxDistance = DEFAULT_MAX_DISTANCE);
+	};
+}
@@ -44,6 +44,18 @@ using namespace Nuanceur;
 		return temp;                                                                                             \
 	}
 
+#define GENERATE_VECTOR_BINARY_HALF_OP(StatementOp, Operator, VectorType)                                        \
+	VectorType##Rvalue Nuanceur::operator Operator(const VectorType##Value & lhs, const VectorType##Value & rhs) \
+	{                                                                                                            \
+		CHECK_ISOPERANDVALID(lhs);                                                                               \
+		CHECK_ISOPERANDVALID(rhs);                                                                               \
+		auto owner = GetCommonOwner(lhs.symbol, rhs.symbol);                                                     \
+		auto temp = VectorType##Rvalue(owner->CreateTemporaryHalf());                                            \
+		owner->InsertStatement(                                                                                  \
+		    CShaderBuilder::STATEMENT(CShaderBuilder::StatementOp, temp, lhs, rhs));                             \
+		return temp;                                                                                             \
+	}
+
 #define GENERATE_VECTOR_COMPARE_OP(StatementOp, Operator, VectorType)                                     \
 	CBoolRvalue Nuanceur::operator Operator(const VectorType##Value & lhs, const VectorType##Value & rhs) \
 	{                                                                                                     \
@@ -74,10 +86,77 @@ static CShaderBuilder* GetCommonOwner(const CShaderBuilder::SYMBOL& symbol1, con
 	return symbol1.owner;
 }
 
+static CShaderBuilder::SYMBOL CreateTemporaryOfType(CShaderBuilder& owner, CShaderBuilder::SYMBOL_TYPE type)
+{
+	switch(type)
+	{
+	case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
+		return owner.CreateTemporary();
+	case CShaderBuilder::SYMBOL_TYPE_HALF4:
+		return owner.CreateTemporaryHalf();
+	case CShaderBuilder::SYMBOL_TYPE_INT4:
+		return owner.CreateTemporaryInt();
+	case CShaderBuilder::SYMBOL_TYPE_UINT4:
+		return owner.CreateTemporaryUint();
+	case CShaderBuilder::SYMBOL_TYPE_BOOL4:
+		return owner.CreateTemporaryBool();
+	default:
+		assert(false);
+		return CShaderBuilder::SYMBOL();
+	}
+}
+
+//Inserts an atomic operation on a resource and returns the temporary receiving its original value
+static CShaderBuilder::SYMBOL EmitAtomic(CShaderBuilder::STATEMENT_OP op, const CShaderBuilder::SYMBOLREF& resource, const CShaderBuilder::SYMBOLREF& address,
+                                         const CShaderBuilder::SYMBOLREF& value, MEMORY_SCOPE scope, MEMORY_ORDER order,
+                                         const CShaderBuilder::SYMBOLREF& comparator = CShaderBuilder::SYMBOLREF())
+{
+	auto owner = GetCommonOwner(resource.symbol, address.symbol);
+	auto temp = owner->CreateTemporaryUint();
+	auto statement = CShaderBuilder::STATEMENT(op, CShaderBuilder::SYMBOLREF(temp, SWIZZLE_X), resource, address, value, comparator);
+	statement.param = static_cast<uint32>(scope) | (static_cast<uint32>(order) << 16);
+	owner->InsertStatement(statement);
+	return temp;
+}
+
+static CShaderBuilder::SYMBOL SelectTexture(const CShaderBuilder::SYMBOLREF& array, const CIntValue& index, bool nonUniform)
+{
+	auto owner = GetCommonOwner(array.symbol, index.symbol);
+	auto element = owner->CreateTextureElement(array.symbol, nonUniform);
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_SELECT_TEXTURE, CShaderBuilder::SYMBOLREF(element, SWIZZLE_XYZW), array, index));
+	return element;
+}
+
+static CShaderBuilder::SYMBOL SelectBuffer(const CShaderBuilder::SYMBOLREF& array, const CIntValue& index, bool nonUniform)
+{
+	auto owner = GetCommonOwner(array.symbol, index.symbol);
+	auto element = owner->CreateBufferElement(array.symbol, nonUniform);
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_SELECT_BUFFER, CShaderBuilder::SYMBOLREF(element, SWIZZLE_XYZW), array, index));
+	return element;
+}
+
+//Function arguments and return values are passed as full vectors, copy swizzled values in a temporary
+static CShaderBuilder::SYMBOLREF MakeFullVector(CShaderBuilder& owner, const CShaderBuilder::SYMBOLREF& value)
+{
+	if(value.swizzle == SWIZZLE_XYZW) return value;
+	static const SWIZZLE_TYPE maskSwizzles[4] = {SWIZZLE_X, SWIZZLE_XY, SWIZZLE_XYZ, SWIZZLE_XYZW};
+	auto elementCount = GetSwizzleElementCount(value.swizzle);
+	assert((elementCount >= 1) && (elementCount <= 4));
+	auto temp = CreateTemporaryOfType(owner, value.symbol.type);
+	owner.InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_ASSIGN, CShaderBuilder::SYMBOLREF(temp, maskSwizzles[elementCount - 1]), value));
+	return CShaderBuilder::SYMBOLREF(temp, SWIZZLE_XYZW);
+}
+
 GENERATE_VECTOR_BINARY_OP(STATEMENT_OP_ADD, +, CFloat)
 GENERATE_VECTOR_BINARY_OP(STATEMENT_OP_ADD, +, CFloat2)
 GENERATE_VECTOR_BINARY_OP(STATEMENT_OP_ADD, +, CFloat3)
 GENERATE_VECTOR_BINARY_OP(STATEMENT_OP_ADD, +, CFloat4)
+GENERATE_VECTOR_BINARY_HALF_OP(STATEMENT_OP_ADD, +, CHalf)
+GENERATE_VECTOR_BINARY_HALF_OP(STATEMENT_OP_ADD, +, CHalf2)
+GENERATE_VECTOR_BINARY_HALF_OP(STATEMENT_OP_ADD, +, CHalf4)
 GENERATE_VECTOR_BINARY_INT_OP(STATEMENT_OP_ADD, +, CInt)
 GENERATE_VECTOR_BINARY_INT_OP(STATEMENT_OP_ADD, +, CInt2)
 GENERATE_VECTOR_BINARY_INT_OP(STATEMENT_OP_ADD, +, CInt3)
@@ -88,6 +167,9 @@ GENERATE_VECTOR_BINARY_UINT_OP(STATEMENT_OP_ADD, +, CUint3)
 GENERATE_VECTOR_BINARY_OP(STATEMENT_OP_SUBSTRACT, -, CFloat)
 GENERATE_VECTOR_BINARY_OP(STATEMENT_OP_SUBSTRACT, -, CFloat3)
 GENERATE_VECTOR_BINARY_OP(STATEMENT_OP_SUBSTRACT, -, CFloat4)
+GENERATE_VECTOR_BINARY_HALF_OP(STATEMENT_OP_SUBSTRACT, -, CHalf)
+GENERATE_VECTOR_BINARY_HALF_OP(STATEMENT_OP_SUBSTRACT, -, CHalf2)
+GENERATE_VECTOR_BINARY_HALF_OP(STATEMENT_OP_SUBSTRACT, -, CHalf4)
 GENERATE_VECTOR_BINARY_INT_OP(STATEMENT_OP_SUBSTRACT, -, CInt)
 GENERATE_VECTOR_BINARY_INT_OP(STATEMENT_OP_SUBSTRACT, -, CInt3)
 GENERATE_VECTOR_BINARY_INT_OP(STATEMENT_OP_SUBSTRACT, -, CInt4)
@@ -97,6 +179,9 @@ GENERATE_VECTOR_BINARY_OP(STATEMENT_OP_MULTIPLY, *, CFloat)
 GENERATE_VECTOR_BINARY_OP(STATEMENT_OP_MULTIPLY, *, CFloat2)
 GENERATE_VECTOR_BINARY_OP(STATEMENT_OP_MULTIPLY, *, CFloat3)
 GENERATE_VECTOR_BINARY_OP(STATEMENT_OP_MULTIPLY, *, CFloat4)
+GENERATE_VECTOR_BINARY_HALF_OP(STATEMENT_OP_MULTIPLY, *, CHalf)
+GENERATE_VECTOR_BINARY_HALF_OP(STATEMENT_OP_MULTIPLY, *, CHalf2)
+GENERATE_VECTOR_BINARY_HALF_OP(STATEMENT_OP_MULTIPLY, *, CHalf4)
 GENERATE_VECTOR_BINARY_INT_OP(STATEMENT_OP_MULTIPLY, *, CInt)
 GENERATE_VECTOR_BINARY_INT_OP(STATEMENT_OP_MULTIPLY, *, CInt2)
 GENERATE_VECTOR_BINARY_INT_OP(STATEMENT_OP_MULTIPLY, *, CInt3)
@@ -106,6 +191,9 @@ GENERATE_VECTOR_BINARY_UINT_OP(STATEMENT_OP_MULTIPLY, *, CUint3)
 GENERATE_VECTOR_BINARY_OP(STATEMENT_OP_DIVIDE, /, CFloat)
 GENERATE_VECTOR_BINARY_OP(STATEMENT_OP_DIVIDE, /, CFloat2)
 GENERATE_VECTOR_BINARY_OP(STATEMENT_OP_DIVIDE, /, CFloat4)
+GENERATE_VECTOR_BINARY_HALF_OP(STATEMENT_OP_DIVIDE, /, CHalf)
+GENERATE_VECTOR_BINARY_HALF_OP(STATEMENT_OP_DIVIDE, /, CHalf2)
+GENERATE_VECTOR_BINARY_HALF_OP(STATEMENT_OP_DIVIDE, /, CHalf4)
 GENERATE_VECTOR_BINARY_INT_OP(STATEMENT_OP_DIVIDE, /, CInt)
 GENERATE_VECTOR_BINARY_INT_OP(STATEMENT_OP_DIVIDE, /, CInt2)
 GENERATE_VECTOR_BINARY_INT_OP(STATEMENT_OP_DIVIDE, /, CInt4)
@@ -154,10 +242,14 @@ GENERATE_VECTOR_ASSIGN(CBool)
 GENERATE_VECTOR_ASSIGN(CFloat)
 GENERATE_VECTOR_ASSIGN(CFloat2)
 GENERATE_VECTOR_ASSIGN(CFloat4)
+GENERATE_VECTOR_ASSIGN(CHalf)
+GENERATE_VECTOR_ASSIGN(CHalf2)
+GENERATE_VECTOR_ASSIGN(CHalf4)
 GENERATE_VECTOR_ASSIGN(CInt)
 GENERATE_VECTOR_ASSIGN(CInt2)
 GENERATE_VECTOR_ASSIGN(CInt4)
 GENERATE_VECTOR_ASSIGN(CUint)
+GENERATE_VECTOR_ASSIGN(CUint2)
 GENERATE_VECTOR_ASSIGN(CUint4)
 
 CFloat4Rvalue Nuanceur::operator*(const CMatrix44Value& lhs, const CFloat4Value& rhs)
@@ -267,6 +359,18 @@ CFloat4Rvalue Nuanceur::Clamp(const CFloat4Value& value, const CFloat4Value& min
 	return temp;
 }
 
+CHalf4Rvalue Nuanceur::Clamp(const CHalf4Value& value, const CHalf4Value& min, const CHalf4Value& max)
+{
+	CHECK_ISOPERANDVALID(value);
+	CHECK_ISOPERANDVALID(min);
+	CHECK_ISOPERANDVALID(max);
+	auto owner = GetCommonOwner(value.symbol, min.symbol);
+	auto temp = CHalf4Rvalue(owner->CreateTemporaryHalf());
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_CLAMP, temp, value, min, max));
+	return temp;
+}
+
 CFloat2Rvalue Nuanceur::Fract(const CFloat2Value& value)
 {
 	CHECK_ISOPERANDVALID(value);
@@ -345,6 +449,18 @@ CFloat3Rvalue Nuanceur::Mix(const CFloat3Value& x, const CFloat3Value& y, const
 	return temp;
 }
 
+CHalf4Rvalue Nuanceur::Mix(const CHalf4Value& x, const CHalf4Value& y, const CHalf4Value& a)
+{
+	CHECK_ISOPERANDVALID(x);
+	CHECK_ISOPERANDVALID(y);
+	CHECK_ISOPERANDVALID(a);
+	auto owner = GetCommonOwner(x.symbol, y.symbol);
+	auto temp = CHalf4Rvalue(owner->CreateTemporaryHalf());
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_MIX, temp, x, y, a));
+	return temp;
+}
+
 CFloat4Rvalue Nuanceur::Normalize(const CFloat4Value& rhs)
 {
 	auto owner = rhs.symbol.owner;
@@ -463,6 +579,42 @@ CFloat4Rvalue Nuanceur::NewFloat4(const CFloat3Value& xyz, const CFloatValue& w)
 	return temp;
 }
 
+CHalfRvalue Nuanceur::NewHalf(CShaderBuilder& owner, float x)
+{
+	auto literal = owner.CreateConstantHalf(x, 0, 0, 0);
+	return CHalfRvalue(literal);
+}
+
+CHalf2Rvalue Nuanceur::NewHalf2(CShaderBuilder& owner, float x, float y)
+{
+	auto literal = owner.CreateConstantHalf(x, y, 0, 0);
+	return CHalf2Rvalue(literal);
+}
+
+CHalf2Rvalue Nuanceur::NewHalf2(const CHalfValue& x, const CHalfValue& y)
+{
+	auto owner = GetCommonOwner(x.symbol, y.symbol);
+	auto temp = CHalf2Rvalue(owner->CreateTemporaryHalf());
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_NEWVECTOR2, temp, x, y));
+	return temp;
+}
+
+CHalf4Rvalue Nuanceur::NewHalf4(CShaderBuilder& owner, float x, float y, float z, float w)
+{
+	auto literal = owner.CreateConstantHalf(x, y, z, w);
+	return CHalf4Rvalue(literal);
+}
+
+CHalf4Rvalue Nuanceur::NewHalf4(const CHalf2Value& xy, const CHalf2Value& zw)
+{
+	auto owner = GetCommonOwner(xy.symbol, zw.symbol);
+	auto temp = CHalf4Rvalue(owner->CreateTemporaryHalf());
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_NEWVECTOR4, temp, xy, zw));
+	return temp;
+}
+
 CIntRvalue Nuanceur::NewInt(CShaderBuilder& owner, int32 x)
 {
 	auto literal = owner.CreateConstantInt(x, 0, 0, 0);
@@ -520,6 +672,12 @@ CUintRvalue Nuanceur::NewUint(CShaderBuilder& owner, uint32 x)
 	return CUintRvalue(literal);
 }
 
+CUint2Rvalue Nuanceur::NewUint2(CShaderBuilder& owner, uint32 x, uint32 y)
+{
+	auto literal = owner.CreateConstantUint(x, y, 0, 0);
+	return CUint2Rvalue(literal);
+}
+
 CUint3Rvalue Nuanceur::NewUint3(CShaderBuilder& owner, uint32 x, uint32 y, uint32 z)
 {
 	auto literal = owner.CreateConstantUint(x, y, z, 1);
@@ -565,6 +723,60 @@ CFloat4Rvalue Nuanceur::Sample(const CTexture2DValue& texture, const CFloat2Valu
 	return temp;
 }
 
+CFloat4Rvalue Nuanceur::SampleLod(const CTexture2DValue& texture, const CFloat2Value& coord, const CFloatValue& lod)
+{
+	CHECK_ISOPERANDVALID(lod);
+	auto owner = GetCommonOwner(texture.symbol, coord.symbol);
+	auto temp = CFloat4Rvalue(owner->CreateTemporary());
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_SAMPLE_LOD, temp, texture, coord, lod));
+	return temp;
+}
+
+CFloat4Rvalue Nuanceur::SampleGrad(const CTexture2DValue& texture, const CFloat2Value& coord, const CFloat2Value& dPdx, const CFloat2Value& dPdy)
+{
+	CHECK_ISOPERANDVALID(dPdx);
+	CHECK_ISOPERANDVALID(dPdy);
+	auto owner = GetCommonOwner(texture.symbol, coord.symbol);
+	auto temp = CFloat4Rvalue(owner->CreateTemporary());
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_SAMPLE_GRAD, temp, texture, coord, dPdx, dPdy));
+	return temp;
+}
+
+CFloat4Rvalue Nuanceur::SampleOffset(const CTexture2DValue& texture, const CFloat2Value& coord, int32 offsetX, int32 offsetY)
+{
+	assert(static_cast<int16>(offsetX) == offsetX);
+	assert(static_cast<int16>(offsetY) == offsetY);
+	auto owner = GetCommonOwner(texture.symbol, coord.symbol);
+	auto temp = CFloat4Rvalue(owner->CreateTemporary());
+	auto statement = CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_SAMPLE_OFFSET, temp, texture, coord);
+	statement.param = (static_cast<uint32>(offsetX) & 0xFFFF) | (static_cast<uint32>(offsetY) << 16);
+	owner->InsertStatement(statement);
+	return temp;
+}
+
+CFloat4Rvalue Nuanceur::Fetch(const CTexture2DValue& texture, const CInt2Value& coord, const CIntValue& lod)
+{
+	CHECK_ISOPERANDVALID(lod);
+	auto owner = GetCommonOwner(texture.symbol, coord.symbol);
+	auto temp = CFloat4Rvalue(owner->CreateTemporary());
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_FETCH, temp, texture, coord, lod));
+	return temp;
+}
+
+CFloat4Rvalue Nuanceur::Gather(const CTexture2DValue& texture, const CFloat2Value& coord, uint32 component)
+{
+	assert(component < 4);
+	auto owner = GetCommonOwner(texture.symbol, coord.symbol);
+	auto temp = CFloat4Rvalue(owner->CreateTemporary());
+	auto statement = CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_GATHER, temp, texture, coord);
+	statement.param = component;
+	owner->InsertStatement(statement);
+	return temp;
+}
+
 CUint4Rvalue Nuanceur::Load(const CImageUint2DValue& image, const CInt2Value& coord)
 {
 	auto owner = GetCommonOwner(image.symbol, coord.symbol);
@@ -581,73 +793,71 @@ void Nuanceur::Store(const CImageUint2DValue& image, const CInt2Value& coord, co
 	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_STORE, CShaderBuilder::SYMBOLREF(), image, coord, value));
 }
 
-CUintRvalue Nuanceur::AtomicAnd(const CImageUint2DValue& image, const CInt2Value& coord, const CUintValue& value)
+CUint4Rvalue Nuanceur::Load(const CImageUint2DArrayValue& image, const CInt3Value& coord)
 {
 	auto owner = GetCommonOwner(image.symbol, coord.symbol);
-	auto temp = CUintRvalue(owner->CreateTemporaryUint());
+	auto temp = CUint4Rvalue(owner->CreateTemporaryUint());
 	owner->InsertStatement(
-	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_ATOMICAND, temp, image, coord, value));
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_LOAD, temp, image, coord));
 	return temp;
 }
 
-CUintRvalue Nuanceur::AtomicOr(const CImageUint2DValue& image, const CInt2Value& coord, const CUintValue& value)
+void Nuanceur::Store(const CImageUint2DArrayValue& image, const CInt3Value& coord, const CUint4Value& value)
 {
 	auto owner = GetCommonOwner(image.symbol, coord.symbol);
-	auto temp = CUintRvalue(owner->CreateTemporaryUint());
 	owner->InsertStatement(
-	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_ATOMICOR, temp, image, coord, value));
-	return temp;
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_STORE, CShaderBuilder::SYMBOLREF(), image, coord, value));
 }
 
-CUintRvalue Nuanceur::Load(const CArrayUintValue& buffer, const CIntValue& index)
+CUint4Rvalue Nuanceur::Load(const CImageUint3DValue& image, const CInt3Value& coord)
 {
-	auto owner = GetCommonOwner(buffer.symbol, index.symbol);
-	auto temp = CUintRvalue(owner->CreateTemporaryUint());
+	auto owner = GetCommonOwner(image.symbol, coord.symbol);
+	auto temp = CUint4Rvalue(owner->CreateTemporaryUint());
 	owner->InsertStatement(
-	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_LOAD, temp, buffer, index));
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_LOAD, temp, image, coord));
 	return temp;
 }
 
-void Nuanceur::Store(const CArrayUintValue& buffer, const CIntValue& index, const CUintValue& value)
+void Nuanceur::Store(const CImageUint3DValue& image, const CInt3Value& coord, const CUint4Value& value)
 {
-	auto owner = GetCommonOwner(buffer.symbol, index.symbol);
+	auto owner = GetCommonOwner(image.symbol, coord.symbol);
 	owner->InsertStatement(
-	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_STORE, CShaderBuilder::SYMBOLREF(), buffer, index, value));
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_STORE, CShaderBuilder::SYMBOLREF(), image, coord, value));
 }
 
-void Nuanceur::Store(const CArrayUshortValue& buffer, const CIntValue& index, const CUshortValue& value)
+CFloat4Rvalue Nuanceur::Load(const CImage2DValue& image, const CInt2Value& coord)
 {
-	auto owner = GetCommonOwner(buffer.symbol, index.symbol);
+	auto owner = GetCommonOwner(image.symbol, coord.symbol);
+	auto temp = CFloat4Rvalue(owner->CreateTemporary());
 	owner->InsertStatement(
-	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_STORE16, CShaderBuilder::SYMBOLREF(), buffer, index, value));
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_LOAD, temp, image, coord));
+	return temp;
 }
 
-void Nuanceur::Store(const CArrayUcharValue& buffer, const CIntValue& index, const CUcharValue& value)
+void Nuanceur::Store(const CImage2DValue& image, const CInt2Value& coord, const CFloat4Value& value)
 {
-	auto owner = GetCommonOwner(buffer.symbol, index.symbol);
+	auto owner = GetCommonOwner(image.symbol, coord.symbol);
 	owner->InsertStatement(
-	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_STORE8, CShaderBuilder::SYMBOLREF(), buffer, index, value));
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_STORE, CShaderBuilder::SYMBOLREF(), image, coord, value));
 }
 
-CUintRvalue Nuanceur::AtomicAnd(const CArrayUintValue& buffer, const CIntValue& index, const CUintValue& value)
+CFloat4Rvalue Nuanceur::Load(const CImage2DArrayValue& image, const CInt3Value& coord)
 {
-	auto owner = GetCommonOwner(buffer.symbol, index.symbol);
-	auto temp = CUintRvalue(owner->CreateTemporaryUint());
+	auto owner = GetCommonOwner(image.symbol, coord.symbol);
+	auto temp = CFloat4Rvalue(owner->CreateTemporary());
 	owner->InsertStatement(
-	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_ATOMICAND, temp, buffer, index, value));
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_LOAD, temp, image, coord));
 	return temp;
 }
 
-CUintRvalue Nuanceur::AtomicOr(const CArrayUintValue& buffer, const CIntValue& index, const CUintValue& value)
+void Nuanceur::Store(const CImage2DArrayValue& image, const CInt3Value& coord, const CFloat4Value& value)
 {
-	auto owner = GetCommonOwner(buffer.symbol, index.symbol);
-	auto temp = CUintRvalue(owner->CreateTemporaryUint());
+	auto owner = GetCommonOwner(image.symbol, coord.symbol);
 	owner->InsertStatement(
-	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_ATOMICOR, temp, buffer, index, value));
-	return temp;
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_STORE, CShaderBuilder::SYMBOLREF(), image, coord, value));
 }
 
-CFloat4Rvalue Nuanceur::Load(const CSubpassInputValue& image, const CInt2Value& coord)
+CFloat4Rvalue Nuanceur::Load(const CImage3DValue& image, const CInt3Value& coord)
 {
 	auto owner = GetCommonOwner(image.symbol, coord.symbol);
 	auto temp = CFloat4Rvalue(owner->CreateTemporary());
@@ -656,167 +866,909 @@ CFloat4Rvalue Nuanceur::Load(const CSubpassInputValue& image, const CInt2Value&
 	return temp;
 }
 
-CUint4Rvalue Nuanceur::Load(const CSubpassInputUintValue& image, const CInt2Value& coord)
+void Nuanceur::Store(const CImage3DValue& image, const CInt3Value& coord, const CFloat4Value& value)
 {
 	auto owner = GetCommonOwner(image.symbol, coord.symbol);
-	auto temp = CUint4Rvalue(owner->CreateTemporaryUint());
 	owner->InsertStatement(
-	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_LOAD, temp, image, coord));
-	return temp;
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_STORE, CShaderBuilder::SYMBOLREF(), image, coord, value));
 }
 
-CFloatRvalue Nuanceur::ToFloat(const CUintValue& rhs)
+CTexture2DValue Nuanceur::Element(const CTexture2DDescriptorArrayValue& array, const CIntValue& index)
 {
-	auto owner = rhs.symbol.owner;
-	auto temp = CFloatRvalue(owner->CreateTemporary());
-	owner->InsertStatement(
-	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_TOFLOAT, temp, rhs));
-	return temp;
+	return CTexture2DValue(SelectTexture(array, index, false));
 }
 
-CFloatRvalue Nuanceur::ToFloat(const CIntValue& rhs)
+CImage2DValue Nuanceur::Element(const CImage2DDescriptorArrayValue& array, const CIntValue& index)
 {
-	auto owner = rhs.symbol.owner;
-	auto temp = CFloatRvalue(owner->CreateTemporary());
-	owner->InsertStatement(
-	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_TOFLOAT, temp, rhs));
-	return temp;
+	return CImage2DValue(SelectTexture(array, index, false));
 }
 
-CFloat2Rvalue Nuanceur::ToFloat(const CInt2Value& rhs)
+CImageUint2DValue Nuanceur::Element(const CImageUint2DDescriptorArrayValue& array, const CIntValue& index)
 {
-	auto owner = rhs.symbol.owner;
-	auto temp = CFloat2Rvalue(owner->CreateTemporary());
-	owner->InsertStatement(
-	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_TOFLOAT, temp, rhs));
-	return temp;
+	return CImageUint2DValue(SelectTexture(array, index, false));
 }
 
-CFloat4Rvalue Nuanceur::ToFloat(const CInt4Value& rhs)
+CArrayUintValue Nuanceur::Element(const CArrayUintDescriptorArrayValue& array, const CIntValue& index)
 {
-	auto owner = rhs.symbol.owner;
-	auto temp = CFloat4Rvalue(owner->CreateTemporary());
-	owner->InsertStatement(
-	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_TOFLOAT, temp, rhs));
-	return temp;
+	return CArrayUintValue(SelectBuffer(array, index, false));
 }
 
-CFloat4Rvalue Nuanceur::ToFloat(const CUint4Value& rhs)
+CTexture2DValue Nuanceur::NonUniformElement(const CTexture2DDescriptorArrayValue& array, const CIntValue& index)
 {
-	auto owner = rhs.symbol.owner;
-	auto temp = CFloat4Rvalue(owner->CreateTemporary());
-	owner->InsertStatement(
-	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_TOFLOAT, temp, rhs));
-	return temp;
+	return CTexture2DValue(SelectTexture(array, index, true));
 }
 
-CIntRvalue Nuanceur::ToInt(const CFloatValue& rhs)
+CImage2DValue Nuanceur::NonUniformElement(const CImage2DDescriptorArrayValue& array, const CIntValue& index)
 {
-	auto owner = rhs.symbol.owner;
-	auto temp = CIntRvalue(owner->CreateTemporaryInt());
-	owner->InsertStatement(
-	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_TOINT, temp, rhs));
-	return temp;
+	return CImage2DValue(SelectTexture(array, index, true));
 }
 
-CIntRvalue Nuanceur::ToInt(const CUintValue& rhs)
+CImageUint2DValue Nuanceur::NonUniformElement(const CImageUint2DDescriptorArrayValue& array, const CIntValue& index)
 {
-	auto owner = rhs.symbol.owner;
-	auto temp = CIntRvalue(owner->CreateTemporaryInt());
-	owner->InsertStatement(
-	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_TOINT, temp, rhs));
-	return temp;
+	return CImageUint2DValue(SelectTexture(array, index, true));
 }
 
-CInt2Rvalue Nuanceur::ToInt(const CFloat2Value& rhs)
+CArrayUintValue Nuanceur::NonUniformElement(const CArrayUintDescriptorArrayValue& array, const CIntValue& index)
 {
-	auto owner = rhs.symbol.owner;
-	auto temp = CInt2Rvalue(owner->CreateTemporaryInt());
-	owner->InsertStatement(
-	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_TOINT, temp, rhs));
-	return temp;
+	return CArrayUintValue(SelectBuffer(array, index, true));
 }
 
-CInt4Rvalue Nuanceur::ToInt(const CFloat4Value& rhs)
+CFloat4Rvalue Nuanceur::Fetch(const CUniformTexelBufferValue& buffer, const CIntValue& index)
 {
-	auto owner = rhs.symbol.owner;
-	auto temp = CInt4Rvalue(owner->CreateTemporaryInt());
+	auto owner = GetCommonOwner(buffer.symbol, index.symbol);
+	auto temp = CFloat4Rvalue(owner->CreateTemporary());
 	owner->InsertStatement(
-	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_TOINT, temp, rhs));
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_FETCH, temp, buffer, index));
 	return temp;
 }
 
-CUintRvalue Nuanceur::ToUint(const CFloatValue& rhs)
+CUint4Rvalue Nuanceur::Load(const CStorageTexelBufferUintValue& buffer, const CIntValue& index)
 {
-	auto owner = rhs.symbol.owner;
-	auto temp = CUintRvalue(owner->CreateTemporaryUint());
+	auto owner = GetCommonOwner(buffer.symbol, index.symbol);
+	auto temp = CUint4Rvalue(owner->CreateTemporaryUint());
 	owner->InsertStatement(
-	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_TOUINT, temp, rhs));
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_LOAD, temp, buffer, index));
 	return temp;
 }
 
-CUintRvalue Nuanceur::ToUint(const CIntValue& rhs)
+void Nuanceur::Store(const CStorageTexelBufferUintValue& buffer, const CIntValue& index, const CUint4Value& value)
 {
-	auto owner = rhs.symbol.owner;
-	auto temp = CUintRvalue(owner->CreateTemporaryUint());
+	auto owner = GetCommonOwner(buffer.symbol, index.symbol);
 	owner->InsertStatement(
-	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_TOUINT, temp, rhs));
-	return temp;
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_STORE, CShaderBuilder::SYMBOLREF(), buffer, index, value));
 }
 
-CUshortRvalue Nuanceur::ToUshort(const CUintValue& rhs)
+CUintRvalue Nuanceur::AtomicAnd(const CImageUint2DValue& image, const CInt2Value& coord, const CUintValue& value, MEMORY_SCOPE scope, MEMORY_ORDER order)
 {
-	auto owner = rhs.symbol.owner;
-	auto temp = CUshortRvalue(owner->CreateTemporaryUshort());
-	owner->InsertStatement(
-	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_TOUSHORT, temp, rhs));
-	return temp;
+	return CUintRvalue(EmitAtomic(CShaderBuilder::STATEMENT_OP_ATOMICAND, image, coord, value, scope, order));
 }
 
-CUcharRvalue Nuanceur::ToUchar(const CUintValue& rhs)
+CUintRvalue Nuanceur::AtomicOr(const CImageUint2DValue& image, const CInt2Value& coord, const CUintValue& value, MEMORY_SCOPE scope, MEMORY_ORDER order)
 {
-	auto owner = rhs.symbol.owner;
-	auto temp = CUcharRvalue(owner->CreateTemporaryUchar());
-	owner->InsertStatement(
-	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_TOUCHAR, temp, rhs));
-	return temp;
+	return CUintRvalue(EmitAtomic(CShaderBuilder::STATEMENT_OP_ATOMICOR, image, coord, value, scope, order));
 }
 
-CUint4Rvalue Nuanceur::ToUint(const CFloat4Value& rhs)
+CUintRvalue Nuanceur::AtomicXor(const CImageUint2DValue& image, const CInt2Value& coord, const CUintValue& value, MEMORY_SCOPE scope, MEMORY_ORDER order)
 {
-	auto owner = rhs.symbol.owner;
-	auto temp = CUint4Rvalue(owner->CreateTemporaryUint());
-	owner->InsertStatement(
-	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_TOUINT, temp, rhs));
-	return temp;
+	return CUintRvalue(EmitAtomic(CShaderBuilder::STATEMENT_OP_ATOMICXOR, image, coord, value, scope, order));
 }
 
-void Nuanceur::Return(CShaderBuilder& owner)
+CUintRvalue Nuanceur::AtomicAdd(const CImageUint2DValue& image, const CInt2Value& coord, const CUintValue& value, MEMORY_SCOPE scope, MEMORY_ORDER order)
 {
-	owner.InsertStatement(
-	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_RETURN, CShaderBuilder::SYMBOLREF(), CShaderBuilder::SYMBOLREF()));
+	return CUintRvalue(EmitAtomic(CShaderBuilder::STATEMENT_OP_ATOMICADD, image, coord, value, scope, order));
 }
 
-void Nuanceur::BeginInvocationInterlock(CShaderBuilder& owner)
+CUintRvalue Nuanceur::AtomicMin(const CImageUint2DValue& image, const CInt2Value& coord, const CUintValue& value, MEMORY_SCOPE scope, MEMORY_ORDER order)
 {
-	owner.InsertStatement(
-	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_INVOCATION_INTERLOCK_BEGIN, CShaderBuilder::SYMBOLREF(), CShaderBuilder::SYMBOLREF()));
+	return CUintRvalue(EmitAtomic(CShaderBuilder::STATEMENT_OP_ATOMICMIN, image, coord, value, scope, order));
 }
 
-void Nuanceur::EndInvocationInterlock(CShaderBuilder& owner)
+CUintRvalue Nuanceur::AtomicMax(const CImageUint2DValue& image, const CInt2Value& coord, const CUintValue& value, MEMORY_SCOPE scope, MEMORY_ORDER order)
 {
-	owner.InsertStatement(
-	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_INVOCATION_INTERLOCK_END, CShaderBuilder::SYMBOLREF(), CShaderBuilder::SYMBOLREF()));
+	return CUintRvalue(EmitAtomic(CShaderBuilder::STATEMENT_OP_ATOMICMAX, image, coord, value, scope, order));
 }
 
-void Nuanceur::BeginIf(CShaderBuilder& owner, const CBoolValue& condition)
+CUintRvalue Nuanceur::AtomicExchange(const CImageUint2DValue& image, const CInt2Value& coord, const CUintValue& value, MEMORY_SCOPE scope, MEMORY_ORDER order)
 {
-	owner.InsertStatement(
-	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_IF_BEGIN, Nuanceur::CShaderBuilder::SYMBOLREF(), condition));
+	return CUintRvalue(EmitAtomic(CShaderBuilder::STATEMENT_OP_ATOMICEXCHANGE, image, coord, value, scope, order));
 }
 
-void Nuanceur::EndIf(CShaderBuilder& owner)
+CUintRvalue Nuanceur::AtomicCompareExchange(const CImageUint2DValue& image, const CInt2Value& coord, const CUintValue& value, const CUintValue& comparator, MEMORY_SCOPE scope, MEMORY_ORDER order)
 {
-	owner.InsertStatement(
-	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_IF_END, Nuanceur::CShaderBuilder::SYMBOLREF(), Nuanceur::CShaderBuilder::SYMBOLREF()));
+	return CUintRvalue(EmitAtomic(CShaderBuilder::STATEMENT_OP_ATOMICCOMPAREEXCHANGE, image, coord, value, scope, order, comparator));
+}
+
+CUintRvalue Nuanceur::Load(const CArrayUintValue& buffer, const CIntValue& index)
+{
+	auto owner = GetCommonOwner(buffer.symbol, index.symbol);
+	auto temp = CUintRvalue(owner->CreateTemporaryUint());
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_LOAD, temp, buffer, index));
+	return temp;
+}
+
+CUint2Rvalue Nuanceur::Load(const CArrayUint2Value& buffer, const CIntValue& index)
+{
+	auto owner = GetCommonOwner(buffer.symbol, index.symbol);
+	auto temp = CUint2Rvalue(owner->CreateTemporaryUint());
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_LOAD, temp, buffer, index));
+	return temp;
+}
+
+CUint4Rvalue Nuanceur::Load(const CArrayUint4Value& buffer, const CIntValue& index)
+{
+	auto owner = GetCommonOwner(buffer.symbol, index.symbol);
+	auto temp = CUint4Rvalue(owner->CreateTemporaryUint());
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_LOAD, temp, buffer, index));
+	return temp;
+}
+
+CUintRvalue Nuanceur::Load(const CArrayUcharValue& buffer, const CIntValue& index)
+{
+	auto owner = GetCommonOwner(buffer.symbol, index.symbol);
+	auto temp = CUintRvalue(owner->CreateTemporaryUint());
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_LOAD, temp, buffer, index));
+	return temp;
+}
+
+CUintRvalue Nuanceur::Load(const CArrayUshortValue& buffer, const CIntValue& index)
+{
+	auto owner = GetCommonOwner(buffer.symbol, index.symbol);
+	auto temp = CUintRvalue(owner->CreateTemporaryUint());
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_LOAD, temp, buffer, index));
+	return temp;
+}
+
+void Nuanceur::Store(const CArrayUintValue& buffer, const CIntValue& index, const CUintValue& value)
+{
+	auto owner = GetCommonOwner(buffer.symbol, index.symbol);
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_STORE, CShaderBuilder::SYMBOLREF(), buffer, index, value));
+}
+
+void Nuanceur::Store(const CArrayUint2Value& buffer, const CIntValue& index, const CUint2Value& value)
+{
+	auto owner = GetCommonOwner(buffer.symbol, index.symbol);
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_STORE, CShaderBuilder::SYMBOLREF(), buffer, index, value));
+}
+
+void Nuanceur::Store(const CArrayUint4Value& buffer, const CIntValue& index, const CUint4Value& value)
+{
+	auto owner = GetCommonOwner(buffer.symbol, index.symbol);
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_STORE, CShaderBuilder::SYMBOLREF(), buffer, index, value));
+}
+
+void Nuanceur::Store(const CArrayUshortValue& buffer, const CIntValue& index, const CUshortValue& value)
+{
+	auto owner = GetCommonOwner(buffer.symbol, index.symbol);
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_STORE16, CShaderBuilder::SYMBOLREF(), buffer, index, value));
+}
+
+void Nuanceur::Store(const CArrayUcharValue& buffer, const CIntValue& index, const CUcharValue& value)
+{
+	auto owner = GetCommonOwner(buffer.symbol, index.symbol);
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_STORE8, CShaderBuilder::SYMBOLREF(), buffer, index, value));
+}
+
+CUintRvalue Nuanceur::AtomicAnd(const CArrayUintValue& buffer, const CIntValue& index, const CUintValue& value, MEMORY_SCOPE scope, MEMORY_ORDER order)
+{
+	return CUintRvalue(EmitAtomic(CShaderBuilder::STATEMENT_OP_ATOMICAND, buffer, index, value, scope, order));
+}
+
+CUintRvalue Nuanceur::AtomicOr(const CArrayUintValue& buffer, const CIntValue& index, const CUintValue& value, MEMORY_SCOPE scope, MEMORY_ORDER order)
+{
+	return CUintRvalue(EmitAtomic(CShaderBuilder::STATEMENT_OP_ATOMICOR, buffer, index, value, scope, order));
+}
+
+CUintRvalue Nuanceur::AtomicXor(const CArrayUintValue& buffer, const CIntValue& index, const CUintValue& value, MEMORY_SCOPE scope, MEMORY_ORDER order)
+{
+	return CUintRvalue(EmitAtomic(CShaderBuilder::STATEMENT_OP_ATOMICXOR, buffer, index, value, scope, order));
+}
+
+CUintRvalue Nuanceur::AtomicAdd(const CArrayUintValue& buffer, const CIntValue& index, const CUintValue& value, MEMORY_SCOPE scope, MEMORY_ORDER order)
+{
+	return CUintRvalue(EmitAtomic(CShaderBuilder::STATEMENT_OP_ATOMICADD, buffer, index, value, scope, order));
+}
+
+CUintRvalue Nuanceur::AtomicMin(const CArrayUintValue& buffer, const CIntValue& index, const CUintValue& value, MEMORY_SCOPE scope, MEMORY_ORDER order)
+{
+	return CUintRvalue(EmitAtomic(CShaderBuilder::STATEMENT_OP_ATOMICMIN, buffer, index, value, scope, order));
+}
+
+CUintRvalue Nuanceur::AtomicMax(const CArrayUintValue& buffer, const CIntValue& index, const CUintValue& value, MEMORY_SCOPE scope, MEMORY_ORDER order)
+{
+	return CUintRvalue(EmitAtomic(CShaderBuilder::STATEMENT_OP_ATOMICMAX, buffer, index, value, scope, order));
+}
+
+CUintRvalue Nuanceur::AtomicExchange(const CArrayUintValue& buffer, const CIntValue& index, const CUintValue& value, MEMORY_SCOPE scope, MEMORY_ORDER order)
+{
+	return CUintRvalue(EmitAtomic(CShaderBuilder::STATEMENT_OP_ATOMICEXCHANGE, buffer, index, value, scope, order));
+}
+
+CUintRvalue Nuanceur::AtomicCompareExchange(const CArrayUintValue& buffer, const CIntValue& index, const CUintValue& value, const CUintValue& comparator, MEMORY_SCOPE scope, MEMORY_ORDER order)
+{
+	return CUintRvalue(EmitAtomic(CShaderBuilder::STATEMENT_OP_ATOMICCOMPAREEXCHANGE, buffer, index, value, scope, order, comparator));
+}
+
+CUintRvalue Nuanceur::Load(const CBufferPointerUintValue& pointer, const CIntValue& index)
+{
+	auto owner = GetCommonOwner(pointer.symbol, index.symbol);
+	auto temp = CUintRvalue(owner->CreateTemporaryUint());
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_LOAD, temp, pointer, index));
+	return temp;
+}
+
+void Nuanceur::Store(const CBufferPointerUintValue& pointer, const CIntValue& index, const CUintValue& value)
+{
+	auto owner = GetCommonOwner(pointer.symbol, index.symbol);
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_STORE, CShaderBuilder::SYMBOLREF(), pointer, index, value));
+}
+
+CUintRvalue Nuanceur::AtomicAnd(const CBufferPointerUintValue& pointer, const CIntValue& index, const CUintValue& value, MEMORY_SCOPE scope, MEMORY_ORDER order)
+{
+	return CUintRvalue(EmitAtomic(CShaderBuilder::STATEMENT_OP_ATOMICAND, pointer, index, value, scope, order));
+}
+
+CUintRvalue Nuanceur::AtomicOr(const CBufferPointerUintValue& pointer, const CIntValue& index, const CUintValue& value, MEMORY_SCOPE scope, MEMORY_ORDER order)
+{
+	return CUintRvalue(EmitAtomic(CShaderBuilder::STATEMENT_OP_ATOMICOR, pointer, index, value, scope, order));
+}
+
+CUintRvalue Nuanceur::AtomicXor(const CBufferPointerUintValue& pointer, const CIntValue& index, const CUintValue& value, MEMORY_SCOPE scope, MEMORY_ORDER order)
+{
+	return CUintRvalue(EmitAtomic(CShaderBuilder::STATEMENT_OP_ATOMICXOR, pointer, index, value, scope, order));
+}
+
+CUintRvalue Nuanceur::AtomicAdd(const CBufferPointerUintValue& pointer, const CIntValue& index, const CUintValue& value, MEMORY_SCOPE scope, MEMORY_ORDER order)
+{
+	return CUintRvalue(EmitAtomic(CShaderBuilder::STATEMENT_OP_ATOMICADD, pointer, index, value, scope, order));
+}
+
+CUintRvalue Nuanceur::AtomicMin(const CBufferPointerUintValue& pointer, const CIntValue& index, const CUintValue& value, MEMORY_SCOPE scope, MEMORY_ORDER order)
+{
+	return CUintRvalue(EmitAtomic(CShaderBuilder::STATEMENT_OP_ATOMICMIN, pointer, index, value, scope, order));
+}
+
+CUintRvalue Nuanceur::AtomicMax(const CBufferPointerUintValue& pointer, const CIntValue& index, const CUintValue& value, MEMORY_SCOPE scope, MEMORY_ORDER order)
+{
+	return CUintRvalue(EmitAtomic(CShaderBuilder::STATEMENT_OP_ATOMICMAX, pointer, index, value, scope, order));
+}
+
+CUintRvalue Nuanceur::AtomicExchange(const CBufferPointerUintValue& pointer, const CIntValue& index, const CUintValue& value, MEMORY_SCOPE scope, MEMORY_ORDER order)
+{
+	return CUintRvalue(EmitAtomic(CShaderBuilder::STATEMENT_OP_ATOMICEXCHANGE, pointer, index, value, scope, order));
+}
+
+CUintRvalue Nuanceur::AtomicCompareExchange(const CBufferPointerUintValue& pointer, const CIntValue& index, const CUintValue& value, const CUintValue& comparator, MEMORY_SCOPE scope, MEMORY_ORDER order)
+{
+	return CUintRvalue(EmitAtomic(CShaderBuilder::STATEMENT_OP_ATOMICCOMPAREEXCHANGE, pointer, index, value, scope, order, comparator));
+}
+
+CFloat4Rvalue Nuanceur::Load(const CBufferPointerFloat4Value& pointer, const CIntValue& index)
+{
+	auto owner = GetCommonOwner(pointer.symbol, index.symbol);
+	auto temp = CFloat4Rvalue(owner->CreateTemporary());
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_LOAD, temp, pointer, index));
+	return temp;
+}
+
+void Nuanceur::Store(const CBufferPointerFloat4Value& pointer, const CIntValue& index, const CFloat4Value& value)
+{
+	auto owner = GetCommonOwner(pointer.symbol, index.symbol);
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_STORE, CShaderBuilder::SYMBOLREF(), pointer, index, value));
+}
+
+CFloat4Rvalue Nuanceur::Load(const CArrayFloat4Value& array, const CIntValue& index)
+{
+	auto owner = GetCommonOwner(array.symbol, index.symbol);
+	auto temp = CFloat4Rvalue(owner->CreateTemporary());
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_LOAD, temp, array, index));
+	return temp;
+}
+
+CInt4Rvalue Nuanceur::Load(const CArrayInt4Value& array, const CIntValue& index)
+{
+	auto owner = GetCommonOwner(array.symbol, index.symbol);
+	auto temp = CInt4Rvalue(owner->CreateTemporaryInt());
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_LOAD, temp, array, index));
+	return temp;
+}
+
+CFloat4Rvalue Nuanceur::Multiply(const CArrayMatrix44Value& array, const CIntValue& index, const CFloat4Value& rhs)
+{
+	auto owner = GetCommonOwner(array.symbol, rhs.symbol);
+	auto temp = CFloat4Rvalue(owner->CreateTemporary());
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_MULTIPLY, temp, array, rhs, index));
+	return temp;
+}
+
+CFloat4Rvalue Nuanceur::Load(const CSubpassInputValue& image, const CInt2Value& coord)
+{
+	auto owner = GetCommonOwner(image.symbol, coord.symbol);
+	auto temp = CFloat4Rvalue(owner->CreateTemporary());
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_LOAD, temp, image, coord));
+	return temp;
+}
+
+CUint4Rvalue Nuanceur::Load(const CSubpassInputUintValue& image, const CInt2Value& coord)
+{
+	auto owner = GetCommonOwner(image.symbol, coord.symbol);
+	auto temp = CUint4Rvalue(owner->CreateTemporaryUint());
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_LOAD, temp, image, coord));
+	return temp;
+}
+
+CFloatRvalue Nuanceur::ToFloat(const CUintValue& rhs)
+{
+	auto owner = rhs.symbol.owner;
+	auto temp = CFloatRvalue(owner->CreateTemporary());
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_TOFLOAT, temp, rhs));
+	return temp;
+}
+
+CFloatRvalue Nuanceur::ToFloat(const CIntValue& rhs)
+{
+	auto owner = rhs.symbol.owner;
+	auto temp = CFloatRvalue(owner->CreateTemporary());
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_TOFLOAT, temp, rhs));
+	return temp;
+}
+
+CFloat2Rvalue Nuanceur::ToFloat(const CInt2Value& rhs)
+{
+	auto owner = rhs.symbol.owner;
+	auto temp = CFloat2Rvalue(owner->CreateTemporary());
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_TOFLOAT, temp, rhs));
+	return temp;
+}
+
+CFloat4Rvalue Nuanceur::ToFloat(const CInt4Value& rhs)
+{
+	auto owner = rhs.symbol.owner;
+	auto temp = CFloat4Rvalue(owner->CreateTemporary());
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_TOFLOAT, temp, rhs));
+	return temp;
+}
+
+CFloat4Rvalue Nuanceur::ToFloat(const CUint4Value& rhs)
+{
+	auto owner = rhs.symbol.owner;
+	auto temp = CFloat4Rvalue(owner->CreateTemporary());
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_TOFLOAT, temp, rhs));
+	return temp;
+}
+
+CFloatRvalue Nuanceur::ToFloat(const CHalfValue& rhs)
+{
+	auto owner = rhs.symbol.owner;
+	auto temp = CFloatRvalue(owner->CreateTemporary());
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_TOFLOAT, temp, rhs));
+	return temp;
+}
+
+CFloat2Rvalue Nuanceur::ToFloat(const CHalf2Value& rhs)
+{
+	auto owner = rhs.symbol.owner;
+	auto temp = CFloat2Rvalue(owner->CreateTemporary());
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_TOFLOAT, temp, rhs));
+	return temp;
+}
+
+CFloat4Rvalue Nuanceur::ToFloat(const CHalf4Value& rhs)
+{
+	auto owner = rhs.symbol.owner;
+	auto temp = CFloat4Rvalue(owner->CreateTemporary());
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_TOFLOAT, temp, rhs));
+	return temp;
+}
+
+CHalfRvalue Nuanceur::ToHalf(const CFloatValue& rhs)
+{
+	auto owner = rhs.symbol.owner;
+	auto temp = CHalfRvalue(owner->CreateTemporaryHalf());
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_TOHALF, temp, rhs));
+	return temp;
+}
+
+CHalf2Rvalue Nuanceur::ToHalf(const CFloat2Value& rhs)
+{
+	auto owner = rhs.symbol.owner;
+	auto temp = CHalf2Rvalue(owner->CreateTemporaryHalf());
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_TOHALF, temp, rhs));
+	return temp;
+}
+
+CHalf4Rvalue Nuanceur::ToHalf(const CFloat4Value& rhs)
+{
+	auto owner = rhs.symbol.owner;
+	auto temp = CHalf4Rvalue(owner->CreateTemporaryHalf());
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_TOHALF, temp, rhs));
+	return temp;
+}
+
+CIntRvalue Nuanceur::ToInt(const CFloatValue& rhs)
+{
+	auto owner = rhs.symbol.owner;
+	auto temp = CIntRvalue(owner->CreateTemporaryInt());
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_TOINT, temp, rhs));
+	return temp;
+}
+
+CIntRvalue Nuanceur::ToInt(const CUintValue& rhs)
+{
+	auto owner = rhs.symbol.owner;
+	auto temp = CIntRvalue(owner->CreateTemporaryInt());
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_TOINT, temp, rhs));
+	return temp;
+}
+
+CInt2Rvalue Nuanceur::ToInt(const CFloat2Value& rhs)
+{
+	auto owner = rhs.symbol.owner;
+	auto temp = CInt2Rvalue(owner->CreateTemporaryInt());
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_TOINT, temp, rhs));
+	return temp;
+}
+
+CInt4Rvalue Nuanceur::ToInt(const CFloat4Value& rhs)
+{
+	auto owner = rhs.symbol.owner;
+	auto temp = CInt4Rvalue(owner->CreateTemporaryInt());
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_TOINT, temp, rhs));
+	return temp;
+}
+
+CUintRvalue Nuanceur::ToUint(const CFloatValue& rhs)
+{
+	auto owner = rhs.symbol.owner;
+	auto temp = CUintRvalue(owner->CreateTemporaryUint());
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_TOUINT, temp, rhs));
+	return temp;
+}
+
+CUintRvalue Nuanceur::ToUint(const CIntValue& rhs)
+{
+	auto owner = rhs.symbol.owner;
+	auto temp = CUintRvalue(owner->CreateTemporaryUint());
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_TOUINT, temp, rhs));
+	return temp;
+}
+
+CUshortRvalue Nuanceur::ToUshort(const CUintValue& rhs)
+{
+	auto owner = rhs.symbol.owner;
+	auto temp = CUshortRvalue(owner->CreateTemporaryUshort());
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_TOUSHORT, temp, rhs));
+	return temp;
+}
+
+CUcharRvalue Nuanceur::ToUchar(const CUintValue& rhs)
+{
+	auto owner = rhs.symbol.owner;
+	auto temp = CUcharRvalue(owner->CreateTemporaryUchar());
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_TOUCHAR, temp, rhs));
+	return temp;
+}
+
+CUint4Rvalue Nuanceur::ToUint(const CFloat4Value& rhs)
+{
+	auto owner = rhs.symbol.owner;
+	auto temp = CUint4Rvalue(owner->CreateTemporaryUint());
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_TOUINT, temp, rhs));
+	return temp;
+}
+
+void Nuanceur::Return(CShaderBuilder& owner)
+{
+	owner.InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_RETURN, CShaderBuilder::SYMBOLREF(), CShaderBuilder::SYMBOLREF()));
+}
+
+void Nuanceur::BeginInvocationInterlock(CShaderBuilder& owner)
+{
+	owner.InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_INVOCATION_INTERLOCK_BEGIN, CShaderBuilder::SYMBOLREF(), CShaderBuilder::SYMBOLREF()));
+}
+
+void Nuanceur::EndInvocationInterlock(CShaderBuilder& owner)
+{
+	owner.InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_INVOCATION_INTERLOCK_END, CShaderBuilder::SYMBOLREF(), CShaderBuilder::SYMBOLREF()));
+}
+
+void Nuanceur::WorkgroupBarrier(CShaderBuilder& owner)
+{
+	owner.InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_WORKGROUP_BARRIER, CShaderBuilder::SYMBOLREF(), CShaderBuilder::SYMBOLREF()));
+}
+
+void Nuanceur::DeviceMemoryBarrier(CShaderBuilder& owner)
+{
+	owner.InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_DEVICE_MEMORY_BARRIER, CShaderBuilder::SYMBOLREF(), CShaderBuilder::SYMBOLREF()));
+}
+
+CUint4Rvalue Nuanceur::SubgroupBallot(const CBoolValue& predicate)
+{
+	CHECK_ISOPERANDVALID(predicate);
+	auto owner = predicate.symbol.owner;
+	auto temp = CUint4Rvalue(owner->CreateTemporaryUint());
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_SUBGROUP_BALLOT, temp, predicate));
+	return temp;
+}
+
+CFloatRvalue Nuanceur::SubgroupBroadcast(const CFloatValue& value, uint32 invocationId)
+{
+	CHECK_ISOPERANDVALID(value);
+	auto owner = value.symbol.owner;
+	auto temp = CFloatRvalue(owner->CreateTemporary());
+	auto statement = CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_SUBGROUP_BROADCAST, temp, value);
+	statement.param = invocationId;
+	owner->InsertStatement(statement);
+	return temp;
+}
+
+CIntRvalue Nuanceur::SubgroupBroadcast(const CIntValue& value, uint32 invocationId)
+{
+	CHECK_ISOPERANDVALID(value);
+	auto owner = value.symbol.owner;
+	auto temp = CIntRvalue(owner->CreateTemporaryInt());
+	auto statement = CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_SUBGROUP_BROADCAST, temp, value);
+	statement.param = invocationId;
+	owner->InsertStatement(statement);
+	return temp;
+}
+
+CUintRvalue Nuanceur::SubgroupBroadcast(const CUintValue& value, uint32 invocationId)
+{
+	CHECK_ISOPERANDVALID(value);
+	auto owner = value.symbol.owner;
+	auto temp = CUintRvalue(owner->CreateTemporaryUint());
+	auto statement = CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_SUBGROUP_BROADCAST, temp, value);
+	statement.param = invocationId;
+	owner->InsertStatement(statement);
+	return temp;
+}
+
+CFloatRvalue Nuanceur::SubgroupShuffle(const CFloatValue& value, const CUintValue& invocationId)
+{
+	CHECK_ISOPERANDVALID(value);
+	CHECK_ISOPERANDVALID(invocationId);
+	auto owner = GetCommonOwner(value.symbol, invocationId.symbol);
+	auto temp = CFloatRvalue(owner->CreateTemporary());
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_SUBGROUP_SHUFFLE, temp, value, invocationId));
+	return temp;
+}
+
+CIntRvalue Nuanceur::SubgroupShuffle(const CIntValue& value, const CUintValue& invocationId)
+{
+	CHECK_ISOPERANDVALID(value);
+	CHECK_ISOPERANDVALID(invocationId);
+	auto owner = GetCommonOwner(value.symbol, invocationId.symbol);
+	auto temp = CIntRvalue(owner->CreateTemporaryInt());
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_SUBGROUP_SHUFFLE, temp, value, invocationId));
+	return temp;
+}
+
+CUintRvalue Nuanceur::SubgroupShuffle(const CUintValue& value, const CUintValue& invocationId)
+{
+	CHECK_ISOPERANDVALID(value);
+	CHECK_ISOPERANDVALID(invocationId);
+	auto owner = GetCommonOwner(value.symbol, invocationId.symbol);
+	auto temp = CUintRvalue(owner->CreateTemporaryUint());
+	owner->InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_SUBGROUP_SHUFFLE, temp, value, invocationId));
+	return temp;
+}
+
+CFloatRvalue Nuanceur::SubgroupAdd(const CFloatValue& value, SUBGROUP_OPERATION operation)
+{
+	CHECK_ISOPERANDVALID(value);
+	auto owner = value.symbol.owner;
+	auto temp = CFloatRvalue(owner->CreateTemporary());
+	auto statement = CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_SUBGROUP_ADD, temp, value);
+	statement.param = operation;
+	owner->InsertStatement(statement);
+	return temp;
+}
+
+CIntRvalue Nuanceur::SubgroupAdd(const CIntValue& value, SUBGROUP_OPERATION operation)
+{
+	CHECK_ISOPERANDVALID(value);
+	auto owner = value.symbol.owner;
+	auto temp = CIntRvalue(owner->CreateTemporaryInt());
+	auto statement = CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_SUBGROUP_ADD, temp, value);
+	statement.param = operation;
+	owner->InsertStatement(statement);
+	return temp;
+}
+
+CUintRvalue Nuanceur::SubgroupAdd(const CUintValue& value, SUBGROUP_OPERATION operation)
+{
+	CHECK_ISOPERANDVALID(value);
+	auto owner = value.symbol.owner;
+	auto temp = CUintRvalue(owner->CreateTemporaryUint());
+	auto statement = CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_SUBGROUP_ADD, temp, value);
+	statement.param = operation;
+	owner->InsertStatement(statement);
+	return temp;
+}
+
+CFloatRvalue Nuanceur::SubgroupMin(const CFloatValue& value, SUBGROUP_OPERATION operation)
+{
+	CHECK_ISOPERANDVALID(value);
+	auto owner = value.symbol.owner;
+	auto temp = CFloatRvalue(owner->CreateTemporary());
+	auto statement = CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_SUBGROUP_MIN, temp, value);
+	statement.param = operation;
+	owner->InsertStatement(statement);
+	return temp;
+}
+
+CIntRvalue Nuanceur::SubgroupMin(const CIntValue& value, SUBGROUP_OPERATION operation)
+{
+	CHECK_ISOPERANDVALID(value);
+	auto owner = value.symbol.owner;
+	auto temp = CIntRvalue(owner->CreateTemporaryInt());
+	auto statement = CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_SUBGROUP_MIN, temp, value);
+	statement.param = operation;
+	owner->InsertStatement(statement);
+	return temp;
+}
+
+CUintRvalue Nuanceur::SubgroupMin(const CUintValue& value, SUBGROUP_OPERATION operation)
+{
+	CHECK_ISOPERANDVALID(value);
+	auto owner = value.symbol.owner;
+	auto temp = CUintRvalue(owner->CreateTemporaryUint());
+	auto statement = CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_SUBGROUP_MIN, temp, value);
+	statement.param = operation;
+	owner->InsertStatement(statement);
+	return temp;
+}
+
+CFloatRvalue Nuanceur::SubgroupMax(const CFloatValue& value, SUBGROUP_OPERATION operation)
+{
+	CHECK_ISOPERANDVALID(value);
+	auto owner = value.symbol.owner;
+	auto temp = CFloatRvalue(owner->CreateTemporary());
+	auto statement = CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_SUBGROUP_MAX, temp, value);
+	statement.param = operation;
+	owner->InsertStatement(statement);
+	return temp;
+}
+
+CIntRvalue Nuanceur::SubgroupMax(const CIntValue& value, SUBGROUP_OPERATION operation)
+{
+	CHECK_ISOPERANDVALID(value);
+	auto owner = value.symbol.owner;
+	auto temp = CIntRvalue(owner->CreateTemporaryInt());
+	auto statement = CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_SUBGROUP_MAX, temp, value);
+	statement.param = operation;
+	owner->InsertStatement(statement);
+	return temp;
+}
+
+CUintRvalue Nuanceur::SubgroupMax(const CUintValue& value, SUBGROUP_OPERATION operation)
+{
+	CHECK_ISOPERANDVALID(value);
+	auto owner = value.symbol.owner;
+	auto temp = CUintRvalue(owner->CreateTemporaryUint());
+	auto statement = CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_SUBGROUP_MAX, temp, value);
+	statement.param = operation;
+	owner->InsertStatement(statement);
+	return temp;
+}
+
+CIntRvalue Nuanceur::SubgroupAnd(const CIntValue& value, SUBGROUP_OPERATION operation)
+{
+	CHECK_ISOPERANDVALID(value);
+	auto owner = value.symbol.owner;
+	auto temp = CIntRvalue(owner->CreateTemporaryInt());
+	auto statement = CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_SUBGROUP_AND, temp, value);
+	statement.param = operation;
+	owner->InsertStatement(statement);
+	return temp;
+}
+
+CUintRvalue Nuanceur::SubgroupAnd(const CUintValue& value, SUBGROUP_OPERATION operation)
+{
+	CHECK_ISOPERANDVALID(value);
+	auto owner = value.symbol.owner;
+	auto temp = CUintRvalue(owner->CreateTemporaryUint());
+	auto statement = CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_SUBGROUP_AND, temp, value);
+	statement.param = operation;
+	owner->InsertStatement(statement);
+	return temp;
+}
+
+CIntRvalue Nuanceur::SubgroupOr(const CIntValue& value, SUBGROUP_OPERATION operation)
+{
+	CHECK_ISOPERANDVALID(value);
+	auto owner = value.symbol.owner;
+	auto temp = CIntRvalue(owner->CreateTemporaryInt());
+	auto statement = CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_SUBGROUP_OR, temp, value);
+	statement.param = operation;
+	owner->InsertStatement(statement);
+	return temp;
+}
+
+CUintRvalue Nuanceur::SubgroupOr(const CUintValue& value, SUBGROUP_OPERATION operation)
+{
+	CHECK_ISOPERANDVALID(value);
+	auto owner = value.symbol.owner;
+	auto temp = CUintRvalue(owner->CreateTemporaryUint());
+	auto statement = CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_SUBGROUP_OR, temp, value);
+	statement.param = operation;
+	owner->InsertStatement(statement);
+	return temp;
+}
+
+void Nuanceur::BeginIf(CShaderBuilder& owner, const CBoolValue& condition, SELECTION_CONTROL selectionControl)
+{
+	auto statement = CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_IF_BEGIN, Nuanceur::CShaderBuilder::SYMBOLREF(), condition);
+	statement.param = selectionControl;
+	owner.InsertStatement(statement);
+}
+
+void Nuanceur::Else(CShaderBuilder& owner)
+{
+	owner.InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_ELSE, Nuanceur::CShaderBuilder::SYMBOLREF(), Nuanceur::CShaderBuilder::SYMBOLREF()));
+}
+
+void Nuanceur::EndIf(CShaderBuilder& owner)
+{
+	owner.InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_IF_END, Nuanceur::CShaderBuilder::SYMBOLREF(), Nuanceur::CShaderBuilder::SYMBOLREF()));
+}
+
+void Nuanceur::BeginSwitch(CShaderBuilder& owner, const CIntValue& selector, SELECTION_CONTROL selectionControl)
+{
+	auto statement = CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_SWITCH_BEGIN, Nuanceur::CShaderBuilder::SYMBOLREF(), selector);
+	statement.param = selectionControl;
+	owner.InsertStatement(statement);
+}
+
+void Nuanceur::BeginSwitch(CShaderBuilder& owner, const CUintValue& selector, SELECTION_CONTROL selectionControl)
+{
+	auto statement = CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_SWITCH_BEGIN, Nuanceur::CShaderBuilder::SYMBOLREF(), selector);
+	statement.param = selectionControl;
+	owner.InsertStatement(statement);
+}
+
+void Nuanceur::Case(CShaderBuilder& owner, int32 value)
+{
+	auto statement = CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_SWITCH_CASE, Nuanceur::CShaderBuilder::SYMBOLREF(), Nuanceur::CShaderBuilder::SYMBOLREF());
+	statement.param = static_cast<uint32>(value);
+	owner.InsertStatement(statement);
+}
+
+void Nuanceur::Default(CShaderBuilder& owner)
+{
+	owner.InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_SWITCH_DEFAULT, Nuanceur::CShaderBuilder::SYMBOLREF(), Nuanceur::CShaderBuilder::SYMBOLREF()));
+}
+
+void Nuanceur::EndSwitch(CShaderBuilder& owner)
+{
+	owner.InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_SWITCH_END, Nuanceur::CShaderBuilder::SYMBOLREF(), Nuanceur::CShaderBuilder::SYMBOLREF()));
+}
+
+void Nuanceur::BeginLoop(CShaderBuilder& owner, LOOP_CONTROL loopControl)
+{
+	auto statement = CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_LOOP_BEGIN, Nuanceur::CShaderBuilder::SYMBOLREF(), Nuanceur::CShaderBuilder::SYMBOLREF());
+	statement.param = loopControl;
+	owner.InsertStatement(statement);
+}
+
+void Nuanceur::BeginLoop(CShaderBuilder& owner, const CIntLvalue& index, const CIntValue& count, LOOP_CONTROL loopControl)
+{
+	auto statement = CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_LOOP_BEGIN, index, count);
+	statement.param = loopControl;
+	owner.InsertStatement(statement);
+}
+
+void Nuanceur::Break(CShaderBuilder& owner)
+{
+	owner.InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_BREAK, Nuanceur::CShaderBuilder::SYMBOLREF(), Nuanceur::CShaderBuilder::SYMBOLREF()));
+}
+
+void Nuanceur::Continue(CShaderBuilder& owner)
+{
+	owner.InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_CONTINUE, Nuanceur::CShaderBuilder::SYMBOLREF(), Nuanceur::CShaderBuilder::SYMBOLREF()));
+}
+
+void Nuanceur::EndLoop(CShaderBuilder& owner)
+{
+	owner.InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_LOOP_END, Nuanceur::CShaderBuilder::SYMBOLREF(), Nuanceur::CShaderBuilder::SYMBOLREF()));
+}
+
+uint32 Nuanceur::BeginFunction(CShaderBuilder& owner, CShaderBuilder::SYMBOL_TYPE returnType)
+{
+	return owner.BeginFunction(returnType);
+}
+
+void Nuanceur::EndFunction(CShaderBuilder& owner)
+{
+	owner.EndFunction();
+}
+
+void Nuanceur::Return(CShaderBuilder& owner, const CShaderBuilder::SYMBOLREF& value)
+{
+	auto valueRef = MakeFullVector(owner, value);
+	owner.InsertStatement(
+	    CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_RETURN, CShaderBuilder::SYMBOLREF(), valueRef));
+}
+
+CShaderBuilder::SYMBOL Nuanceur::Call(CShaderBuilder& owner, uint32 function,
+                                      const CShaderBuilder::SYMBOLREF& arg1, const CShaderBuilder::SYMBOLREF& arg2,
+                                      const CShaderBuilder::SYMBOLREF& arg3, const CShaderBuilder::SYMBOLREF& arg4)
+{
+	assert(function < owner.GetFunctions().size());
+	const auto& functionInfo = owner.GetFunctions()[function];
+	CShaderBuilder::SYMBOLREF argRefs[4];
+	uint32 argCount = 0;
+	for(const auto* arg : {&arg1, &arg2, &arg3, &arg4})
+	{
+		if(arg->symbol.location == CShaderBuilder::SYMBOL_LOCATION_NULL) break;
+		assert(arg->symbol.type == functionInfo.parameters[argCount].type);
+		argRefs[argCount++] = MakeFullVector(owner, *arg);
+	}
+	assert(argCount == functionInfo.parameters.size());
+	CShaderBuilder::SYMBOL result;
+	CShaderBuilder::SYMBOLREF resultRef;
+	if(functionInfo.returnType != CShaderBuilder::SYMBOL_TYPE_NULL)
+	{
+		result = CreateTemporaryOfType(owner, functionInfo.returnType);
+		resultRef = CShaderBuilder::SYMBOLREF(result, SWIZZLE_XYZW);
+	}
+	auto statement = CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_CALL, resultRef, argRefs[0], argRefs[1], argRefs[2], argRefs[3]);
+	statement.param = function;
+	owner.InsertStatement(statement);
+	return result;
 }
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include "nuanceur/builder/ShaderBuilder.h"
 
 using namespace Nuanceur;
@@ -12,23 +13,13 @@ bool Nuanceur::IsIdentitySwizzle(SWIZZLE_TYPE swizzle)
 
 bool Nuanceur::IsMaskSwizzle(SWIZZLE_TYPE swizzle)
 {
-	switch(swizzle)
+	//Components must be in increasing order, without repeats
+	uint32 elemCount = GetSwizzleElementCount(swizzle);
+	for(uint32 i = 1; i < elemCount; i++)
 	{
-	case SWIZZLE_X:
-	case SWIZZLE_Y:
-	case SWIZZLE_Z:
-	case SWIZZLE_W:
-	case SWIZZLE_XY:
-	case SWIZZLE_YZ:
-	case SWIZZLE_YW:
-	case SWIZZLE_ZW:
-	case SWIZZLE_XYZ:
-	case SWIZZLE_XYZW:
-		return true;
-	default:
-		assert(false);
-		return false;
+		if(GetSwizzleElement(swizzle, i) <= GetSwizzleElement(swizzle, i - 1)) return false;
 	}
+	return true;
 }
 
 SWIZZLE_TYPE Nuanceur::TransformSwizzle(SWIZZLE_TYPE a, SWIZZLE_TYPE b)
@@ -73,6 +64,47 @@ SWIZZLE_TYPE Nuanceur::TransformSwizzle(SWIZZLE_TYPE a, SWIZZLE_TYPE b)
 	}
 }
 
+CShaderBuilder::CShaderBuilder(const CShaderBuilder& src)
+{
+	*this = src;
+}
+
+CShaderBuilder& CShaderBuilder::operator=(const CShaderBuilder& src)
+{
+	if(this == &src) return *this;
+
+	m_metadata = src.m_metadata;
+	m_symbols = src.m_symbols;
+	m_statements = src.m_statements;
+	m_functions = src.m_functions;
+	m_currentFunction = src.m_currentFunction;
+	m_currentTempIndex = src.m_currentTempIndex;
+	m_currentVariableIndex = src.m_currentVariableIndex;
+	m_currentInputIndex = src.m_currentInputIndex;
+	m_currentOutputIndex = src.m_currentOutputIndex;
+	m_currentTextureElementIndex = src.m_currentTextureElementIndex;
+	m_currentBufferElementIndex = src.m_currentBufferElementIndex;
+
+	m_inputSemantics = src.m_inputSemantics;
+	m_outputSemantics = src.m_outputSemantics;
+	m_variableNames = src.m_variableNames;
+	m_uniformNames = src.m_uniformNames;
+	m_sharedArraySizes = src.m_sharedArraySizes;
+	m_uniformArraySizes = src.m_uniformArraySizes;
+	m_uniformComponentCounts = src.m_uniformComponentCounts;
+	m_textureArraySizes = src.m_textureArraySizes;
+	m_imageFormats = src.m_imageFormats;
+	m_bufferArraySizes = src.m_bufferArraySizes;
+	m_temporaryValues = src.m_temporaryValues;
+	m_temporaryValuesInt = src.m_temporaryValuesInt;
+	m_temporaryValuesBool = src.m_temporaryValuesBool;
+	m_precisions = src.m_precisions;
+
+	RemapSymbolOwners();
+
+	return *this;
+}
+
 uint32 CShaderBuilder::GetMetadata(METADATA_TYPE type, uint32 defaultValue) const
 {
 	auto iterator = m_metadata.find(type);
@@ -114,11 +146,121 @@ std::string CShaderBuilder::GetUniformName(const SYMBOL& sym) const
 	return m_uniformNames.find(sym.index)->second;
 }
 
+uint32 CShaderBuilder::GetSharedArraySize(const SYMBOL& sym) const
+{
+	assert(sym.location == SYMBOL_LOCATION_SHARED);
+	return m_sharedArraySizes.find(sym.index)->second;
+}
+
+uint32 CShaderBuilder::GetUniformArraySize(const SYMBOL& sym) const
+{
+	assert(sym.location == SYMBOL_LOCATION_UNIFORM);
+	return m_uniformArraySizes.find(sym.index)->second;
+}
+
+uint32 CShaderBuilder::GetUniformComponentCount(const SYMBOL& sym) const
+{
+	assert(sym.location == SYMBOL_LOCATION_UNIFORM);
+	auto componentCountIterator = m_uniformComponentCounts.find(sym.index);
+	if(componentCountIterator == std::end(m_uniformComponentCounts)) return 4;
+	return componentCountIterator->second;
+}
+
+IMAGE_FORMAT CShaderBuilder::GetImageFormat(const SYMBOL& sym) const
+{
+	assert(IsImageType(sym.type));
+	if(sym.location == SYMBOL_LOCATION_TEXTURE_ELEMENT)
+	{
+		return GetImageFormat(GetTextureArray(sym));
+	}
+	assert(sym.location == SYMBOL_LOCATION_TEXTURE);
+	return m_imageFormats.find(GetBinding(sym))->second;
+}
+
+bool CShaderBuilder::IsTextureArray(const SYMBOL& sym) const
+{
+	assert(sym.location == SYMBOL_LOCATION_TEXTURE);
+	return m_textureArraySizes.find(GetBinding(sym)) != std::end(m_textureArraySizes);
+}
+
+uint32 CShaderBuilder::GetTextureArraySize(const SYMBOL& sym) const
+{
+	assert(IsTextureArray(sym));
+	return m_textureArraySizes.find(GetBinding(sym))->second;
+}
+
+CShaderBuilder::SYMBOL CShaderBuilder::GetTextureArray(const SYMBOL& sym) const
+{
+	assert(sym.location == SYMBOL_LOCATION_TEXTURE_ELEMENT);
+	auto symbolIterator = std::find_if(m_symbols.begin(), m_symbols.end(),
+	                                   [&](const SYMBOL& symbol) { return (symbol.location == SYMBOL_LOCATION_TEXTURE) && (GetBinding(symbol) == GetBinding(sym)); });
+	assert(symbolIterator != std::end(m_symbols));
+	return *symbolIterator;
+}
+
+bool CShaderBuilder::IsBufferArray(const SYMBOL& sym) const
+{
+	assert(sym.location == SYMBOL_LOCATION_UNIFORM);
+	return m_bufferArraySizes.find(sym.index) != std::end(m_bufferArraySizes);
+}
+
+uint32 CShaderBuilder::GetBufferArraySize(const SYMBOL& sym) const
+{
+	assert(IsBufferArray(sym));
+	return m_bufferArraySizes.find(sym.index)->second;
+}
+
+CShaderBuilder::SYMBOL CShaderBuilder::GetBufferArray(const SYMBOL& sym) const
+{
+	assert(sym.location == SYMBOL_LOCATION_BUFFER_ELEMENT);
+	auto symbolIterator = std::find_if(m_symbols.begin(), m_symbols.end(),
+	                                   [&](const SYMBOL& symbol) { return (symbol.location == SYMBOL_LOCATION_UNIFORM) && (GetBinding(symbol) == GetBinding(sym)); });
+	assert(symbolIterator != std::end(m_symbols));
+	return *symbolIterator;
+}
+
+CShaderBuilder::BINDING CShaderBuilder::GetBinding(const SYMBOL& sym)
+{
+	if(sym.unit == static_cast<uint32>(UNIFORM_UNIT_PUSHCONSTANT))
+	{
+		return BINDING(0, sym.unit);
+	}
+	return BINDING(sym.set, sym.unit);
+}
+
+bool CShaderBuilder::IsImageType(SYMBOL_TYPE type)
+{
+	switch(type)
+	{
+	case SYMBOL_TYPE_IMAGE2D:
+	case SYMBOL_TYPE_IMAGE2DARRAY:
+	case SYMBOL_TYPE_IMAGE3D:
+	case SYMBOL_TYPE_IMAGE2DUINT:
+	case SYMBOL_TYPE_IMAGE2DARRAYUINT:
+	case SYMBOL_TYPE_IMAGE3DUINT:
+		return true;
+	default:
+		return false;
+	}
+}
+
+bool CShaderBuilder::IsBufferPointerType(SYMBOL_TYPE type)
+{
+	switch(type)
+	{
+	case SYMBOL_TYPE_BUFFERPOINTERUINT:
+	case SYMBOL_TYPE_BUFFERPOINTERFLOAT4:
+		return true;
+	default:
+		return false;
+	}
+}
+
 CVector4 CShaderBuilder::GetTemporaryValue(const SYMBOL& sym) const
 {
 	CVector4 result(0, 0, 0, 0);
 	assert(sym.location == SYMBOL_LOCATION_TEMPORARY);
-	assert(sym.type == SYMBOL_TYPE_FLOAT4);
+	assert((sym.type == SYMBOL_TYPE_FLOAT4) || (sym.type == SYMBOL_TYPE_HALF4));
 	auto temporaryValueIterator = m_temporaryValues.find(sym.index);
 	if(temporaryValueIterator != std::end(m_temporaryValues))
 	{
@@ -156,14 +298,87 @@ CShaderBuilder::CBoolVector4 CShaderBuilder::GetTemporaryValueBool(const SYMBOL&
 	return result;
 }
 
+static uint64 MakePrecisionKey(const CShaderBuilder::SYMBOL& sym)
+{
+	return (static_cast<uint64>(sym.location) << 32) | static_cast<uint64>(sym.index);
+}
+
+PRECISION CShaderBuilder::GetPrecision(const SYMBOL& sym) const
+{
+	auto precisionIterator = m_precisions.find(MakePrecisionKey(sym));
+	if(precisionIterator == std::end(m_precisions)) return PRECISION_DEFAULT;
+	return precisionIterator->second;
+}
+
+void CShaderBuilder::SetPrecision(const SYMBOL& sym, PRECISION precision)
+{
+	assert((sym.type == SYMBOL_TYPE_FLOAT4) || (sym.type == SYMBOL_TYPE_INT4) || (sym.type == SYMBOL_TYPE_UINT4));
+	m_precisions[MakePrecisionKey(sym)] = precision;
+}
+
 const CShaderBuilder::StatementList& CShaderBuilder::GetStatements() const
 {
 	return m_statements;
 }
 
+CShaderBuilder::StatementList& CShaderBuilder::GetStatements()
+{
+	return m_statements;
+}
+
 void CShaderBuilder::InsertStatement(const STATEMENT& statement)
 {
-	m_statements.push_back(statement);
+	if(m_currentFunction != INVALID_FUNCTION)
+	{
+		m_functions[m_currentFunction].statements.push_back(statement);
+	}
+	else
+	{
+		m_statements.push_back(statement);
+	}
+}
+
+const CShaderBuilder::FunctionArray& CShaderBuilder::GetFunctions() const
+{
+	return m_functions;
+}
+
+CShaderBuilder::FunctionArray& CShaderBuilder::GetFunctions()
+{
+	return m_functions;
+}
+
+uint32 CShaderBuilder::BeginFunction(SYMBOL_TYPE returnType)
+{
+	//Functions can't be nested
+	assert(m_currentFunction == INVALID_FUNCTION);
+	FUNCTION function;
+	function.returnType = returnType;
+	m_currentFunction = static_cast<uint32>(m_functions.size());
+	m_functions.push_back(function);
+	return m_currentFunction;
+}
+
+void CShaderBuilder::EndFunction()
+{
+	assert(m_currentFunction != INVALID_FUNCTION);
+	m_currentFunction = INVALID_FUNCTION;
+}
+
+CShaderBuilder::SYMBOL CShaderBuilder::CreateParameter(SYMBOL_TYPE type)
+{
+	assert(m_currentFunction != INVALID_FUNCTION);
+
+	SYMBOL sym;
+	sym.owner = this;
+	sym.index = m_currentTempIndex++;
+	sym.type = type;
+	sym.location = SYMBOL_LOCATION_TEMPORARY;
+	m_symbols.push_back(sym);
+
+	m_functions[m_currentFunction].parameters.push_back(sym);
+
+	return sym;
 }
 
 CShaderBuilder::SYMBOL CShaderBuilder::CreateInput(SEMANTIC semantic, unsigned int semanticIndex)
@@ -304,6 +519,18 @@ CShaderBuilder::SYMBOL CShaderBuilder::CreateTemporary()
 	return sym;
 }
 
+CShaderBuilder::SYMBOL CShaderBuilder::CreateTemporaryHalf()
+{
+	SYMBOL sym;
+	sym.owner = this;
+	sym.index = m_currentTempIndex++;
+	sym.type = SYMBOL_TYPE_HALF4;
+	sym.location = SYMBOL_LOCATION_TEMPORARY;
+	m_symbols.push_back(sym);
+
+	return sym;
+}
+
 CShaderBuilder::SYMBOL CShaderBuilder::CreateTemporaryBool()
 {
 	SYMBOL sym;
@@ -381,6 +608,21 @@ CShaderBuilder::SYMBOL CShaderBuilder::CreateConstant(float v1, float v2, float
 	return sym;
 }
 
+CShaderBuilder::SYMBOL CShaderBuilder::CreateConstantHalf(float v1, float v2, float v3, float v4)
+{
+	SYMBOL sym;
+	sym.owner = this;
+	sym.index = m_currentTempIndex++;
+	sym.type = SYMBOL_TYPE_HALF4;
+	sym.location = SYMBOL_LOCATION_TEMPORARY;
+	m_symbols.push_back(sym);
+
+	auto tempValue = CVector4(v1, v2, v3, v4);
+	m_temporaryValues.insert(std::make_pair(sym.index, tempValue));
+
+	return sym;
+}
+
 CShaderBuilder::SYMBOL CShaderBuilder::CreateConstantInt(int32 v1, int32 v2, int32 v3, int32 v4)
 {
 	//TODO: Check if constant already exists
@@ -432,7 +674,21 @@ CShaderBuilder::SYMBOL CShaderBuilder::CreateConstantBool(bool v1, bool v2, bool
 	return sym;
 }
 
-CShaderBuilder::SYMBOL CShaderBuilder::CreateUniformFloat4(const std::string& name, unsigned int unit)
+CShaderBuilder::SYMBOL CShaderBuilder::CreateUniformFloat(const std::string& name, unsigned int unit, unsigned int set)
+{
+	auto sym = CreateUniformFloat4(name, unit, set);
+	m_uniformComponentCounts.insert(std::make_pair(sym.index, 1));
+	return sym;
+}
+
+CShaderBuilder::SYMBOL CShaderBuilder::CreateUniformFloat2(const std::string& name, unsigned int unit, unsigned int set)
+{
+	auto sym = CreateUniformFloat4(name, unit, set);
+	m_uniformComponentCounts.insert(std::make_pair(sym.index, 2));
+	return sym;
+}
+
+CShaderBuilder::SYMBOL CShaderBuilder::CreateUniformFloat4(const std::string& name, unsigned int unit, unsigned int set)
 {
 	SYMBOL sym;
 	sym.owner = this;
@@ -440,6 +696,7 @@ CShaderBuilder::SYMBOL CShaderBuilder::CreateUniformFloat4(const std::string& na
 	sym.type = SYMBOL_TYPE_FLOAT4;
 	sym.location = SYMBOL_LOCATION_UNIFORM;
 	sym.unit = unit;
+	sym.set = set;
 	m_symbols.push_back(sym);
 
 	m_uniformNames.insert(std::make_pair(sym.index, name));
@@ -447,7 +704,7 @@ CShaderBuilder::SYMBOL CShaderBuilder::CreateUniformFloat4(const std::string& na
 	return sym;
 }
 
-CShaderBuilder::SYMBOL CShaderBuilder::CreateUniformInt4(const std::string& name, unsigned int unit)
+CShaderBuilder::SYMBOL CShaderBuilder::CreateUniformInt4(const std::string& name, unsigned int unit, unsigned int set)
 {
 	SYMBOL sym;
 	sym.owner = this;
@@ -455,6 +712,7 @@ CShaderBuilder::SYMBOL CShaderBuilder::CreateUniformInt4(const std::string& name
 	sym.type = SYMBOL_TYPE_INT4;
 	sym.location = SYMBOL_LOCATION_UNIFORM;
 	sym.unit = unit;
+	sym.set = set;
 	m_symbols.push_back(sym);
 
 	m_uniformNames.insert(std::make_pair(sym.index, name));
@@ -462,7 +720,7 @@ CShaderBuilder::SYMBOL CShaderBuilder::CreateUniformInt4(const std::string& name
 	return sym;
 }
 
-CShaderBuilder::SYMBOL CShaderBuilder::CreateUniformMatrix(const std::string& name, unsigned int unit)
+CShaderBuilder::SYMBOL CShaderBuilder::CreateUniformMatrix(const std::string& name, unsigned int unit, unsigned int set)
 {
 	SYMBOL sym;
 	sym.owner = this;
@@ -470,6 +728,7 @@ CShaderBuilder::SYMBOL CShaderBuilder::CreateUniformMatrix(const std::string& na
 	sym.type = SYMBOL_TYPE_MATRIX;
 	sym.location = SYMBOL_LOCATION_UNIFORM;
 	sym.unit = unit;
+	sym.set = set;
 	m_symbols.push_back(sym);
 
 	m_uniformNames.insert(std::make_pair(sym.index, name));
@@ -477,7 +736,7 @@ CShaderBuilder::SYMBOL CShaderBuilder::CreateUniformMatrix(const std::string& na
 	return sym;
 }
 
-CShaderBuilder::SYMBOL CShaderBuilder::CreateUniformArrayUint(const std::string& name, unsigned int unit, uint32 attributes)
+CShaderBuilder::SYMBOL CShaderBuilder::CreateUniformArrayUint(const std::string& name, unsigned int unit, uint32 attributes, unsigned int set)
 {
 	SYMBOL sym;
 	sym.owner = this;
@@ -485,6 +744,24 @@ CShaderBuilder::SYMBOL CShaderBuilder::CreateUniformArrayUint(const std::string&
 	sym.type = SYMBOL_TYPE_ARRAYUINT;
 	sym.location = SYMBOL_LOCATION_UNIFORM;
 	sym.unit = unit;
+	sym.set = set;
+	sym.attributes = attributes;
+	m_symbols.push_back(sym);
+
+	m_uniformNames.insert(std::make_pair(sym.index, name));
+
+	return sym;
+}
+
+CShaderBuilder::SYMBOL CShaderBuilder::CreateUniformArrayUint2(const std::string& name, unsigned int unit, uint32 attributes, unsigned int set)
+{
+	SYMBOL sym;
+	sym.owner = this;
+	sym.index = m_currentTempIndex++;
+	sym.type = SYMBOL_TYPE_ARRAYUINT2;
+	sym.location = SYMBOL_LOCATION_UNIFORM;
+	sym.unit = unit;
+	sym.set = set;
 	sym.attributes = attributes;
 	m_symbols.push_back(sym);
 
@@ -493,7 +770,24 @@ CShaderBuilder::SYMBOL CShaderBuilder::CreateUniformArrayUint(const std::string&
 	return sym;
 }
 
-CShaderBuilder::SYMBOL CShaderBuilder::CreateUniformArrayUchar(const std::string& name, unsigned int unit, uint32 attributes)
+CShaderBuilder::SYMBOL CShaderBuilder::CreateUniformArrayUint4(const std::string& name, unsigned int unit, uint32 attributes, unsigned int set)
+{
+	SYMBOL sym;
+	sym.owner = this;
+	sym.index = m_currentTempIndex++;
+	sym.type = SYMBOL_TYPE_ARRAYUINT4;
+	sym.location = SYMBOL_LOCATION_UNIFORM;
+	sym.unit = unit;
+	sym.set = set;
+	sym.attributes = attributes;
+	m_symbols.push_back(sym);
+
+	m_uniformNames.insert(std::make_pair(sym.index, name));
+
+	return sym;
+}
+
+CShaderBuilder::SYMBOL CShaderBuilder::CreateUniformArrayUchar(const std::string& name, unsigned int unit, uint32 attributes, unsigned int set)
 {
 	SYMBOL sym;
 	sym.owner = this;
@@ -501,6 +795,7 @@ CShaderBuilder::SYMBOL CShaderBuilder::CreateUniformArrayUchar(const std::string
 	sym.type = SYMBOL_TYPE_ARRAYUCHAR;
 	sym.location = SYMBOL_LOCATION_UNIFORM;
 	sym.unit = unit;
+	sym.set = set;
 	sym.attributes = attributes;
 	m_symbols.push_back(sym);
 
@@ -509,7 +804,7 @@ CShaderBuilder::SYMBOL CShaderBuilder::CreateUniformArrayUchar(const std::string
 	return sym;
 }
 
-CShaderBuilder::SYMBOL CShaderBuilder::CreateUniformArrayUshort(const std::string& name, unsigned int unit, uint32 attributes)
+CShaderBuilder::SYMBOL CShaderBuilder::CreateUniformArrayUshort(const std::string& name, unsigned int unit, uint32 attributes, unsigned int set)
 {
 	SYMBOL sym;
 	sym.owner = this;
@@ -517,6 +812,7 @@ CShaderBuilder::SYMBOL CShaderBuilder::CreateUniformArrayUshort(const std::strin
 	sym.type = SYMBOL_TYPE_ARRAYUSHORT;
 	sym.location = SYMBOL_LOCATION_UNIFORM;
 	sym.unit = unit;
+	sym.set = set;
 	sym.attributes = attributes;
 	m_symbols.push_back(sym);
 
@@ -525,58 +821,372 @@ CShaderBuilder::SYMBOL CShaderBuilder::CreateUniformArrayUshort(const std::strin
 	return sym;
 }
 
-CShaderBuilder::SYMBOL CShaderBuilder::CreateTexture2D(unsigned int unit)
+CShaderBuilder::SYMBOL CShaderBuilder::CreateUniformArrayFloat4(const std::string& name, uint32 size, unsigned int unit, unsigned int set)
+{
+	assert(size != 0);
+
+	SYMBOL sym;
+	sym.owner = this;
+	sym.index = m_currentTempIndex++;
+	sym.type = SYMBOL_TYPE_ARRAYFLOAT4;
+	sym.location = SYMBOL_LOCATION_UNIFORM;
+	sym.unit = unit;
+	sym.set = set;
+	m_symbols.push_back(sym);
+
+	m_uniformNames.insert(std::make_pair(sym.index, name));
+	m_uniformArraySizes.insert(std::make_pair(sym.index, size));
+
+	return sym;
+}
+
+CShaderBuilder::SYMBOL CShaderBuilder::CreateUniformArrayInt4(const std::string& name, uint32 size, unsigned int unit, unsigned int set)
+{
+	assert(size != 0);
+
+	SYMBOL sym;
+	sym.owner = this;
+	sym.index = m_currentTempIndex++;
+	sym.type = SYMBOL_TYPE_ARRAYINT4;
+	sym.location = SYMBOL_LOCATION_UNIFORM;
+	sym.unit = unit;
+	sym.set = set;
+	m_symbols.push_back(sym);
+
+	m_uniformNames.insert(std::make_pair(sym.index, name));
+	m_uniformArraySizes.insert(std::make_pair(sym.index, size));
+
+	return sym;
+}
+
+CShaderBuilder::SYMBOL CShaderBuilder::CreateUniformArrayMatrix(const std::string& name, uint32 size, unsigned int unit, unsigned int set)
+{
+	assert(size != 0);
+
+	SYMBOL sym;
+	sym.owner = this;
+	sym.index = m_currentTempIndex++;
+	sym.type = SYMBOL_TYPE_ARRAYMATRIX;
+	sym.location = SYMBOL_LOCATION_UNIFORM;
+	sym.unit = unit;
+	sym.set = set;
+	m_symbols.push_back(sym);
+
+	m_uniformNames.insert(std::make_pair(sym.index, name));
+	m_uniformArraySizes.insert(std::make_pair(sym.index, size));
+
+	return sym;
+}
+
+CShaderBuilder::SYMBOL CShaderBuilder::CreateUniformBufferPointerUint(const std::string& name)
+{
+	SYMBOL sym;
+	sym.owner = this;
+	sym.index = m_currentTempIndex++;
+	sym.type = SYMBOL_TYPE_BUFFERPOINTERUINT;
+	sym.location = SYMBOL_LOCATION_UNIFORM;
+	sym.unit = UNIFORM_UNIT_PUSHCONSTANT;
+	m_symbols.push_back(sym);
+
+	m_uniformNames.insert(std::make_pair(sym.index, name));
+
+	return sym;
+}
+
+CShaderBuilder::SYMBOL CShaderBuilder::CreateUniformBufferPointerFloat4(const std::string& name)
+{
+	SYMBOL sym;
+	sym.owner = this;
+	sym.index = m_currentTempIndex++;
+	sym.type = SYMBOL_TYPE_BUFFERPOINTERFLOAT4;
+	sym.location = SYMBOL_LOCATION_UNIFORM;
+	sym.unit = UNIFORM_UNIT_PUSHCONSTANT;
+	m_symbols.push_back(sym);
+
+	m_uniformNames.insert(std::make_pair(sym.index, name));
+
+	return sym;
+}
+
+CShaderBuilder::SYMBOL CShaderBuilder::CreateSharedArrayUint(uint32 size)
+{
+	assert(size != 0);
+
+	SYMBOL sym;
+	sym.owner = this;
+	sym.index = m_currentTempIndex++;
+	sym.type = SYMBOL_TYPE_ARRAYUINT;
+	sym.location = SYMBOL_LOCATION_SHARED;
+	m_symbols.push_back(sym);
+
+	m_sharedArraySizes.insert(std::make_pair(sym.index, size));
+
+	return sym;
+}
+
+CShaderBuilder::SYMBOL CShaderBuilder::CreateSharedArrayUchar(uint32 size)
+{
+	assert(size != 0);
+
+	SYMBOL sym;
+	sym.owner = this;
+	sym.index = m_currentTempIndex++;
+	sym.type = SYMBOL_TYPE_ARRAYUCHAR;
+	sym.location = SYMBOL_LOCATION_SHARED;
+	m_symbols.push_back(sym);
+
+	m_sharedArraySizes.insert(std::make_pair(sym.index, size));
+
+	return sym;
+}
+
+CShaderBuilder::SYMBOL CShaderBuilder::CreateSharedArrayUshort(uint32 size)
+{
+	assert(size != 0);
+
+	SYMBOL sym;
+	sym.owner = this;
+	sym.index = m_currentTempIndex++;
+	sym.type = SYMBOL_TYPE_ARRAYUSHORT;
+	sym.location = SYMBOL_LOCATION_SHARED;
+	m_symbols.push_back(sym);
+
+	m_sharedArraySizes.insert(std::make_pair(sym.index, size));
+
+	return sym;
+}
+
+CShaderBuilder::SYMBOL CShaderBuilder::CreateTexture2D(unsigned int unit, unsigned int set)
 {
 	SYMBOL sym;
 	sym.owner = this;
 	sym.type = SYMBOL_TYPE_TEXTURE2D;
 	sym.location = SYMBOL_LOCATION_TEXTURE;
 	sym.unit = unit;
+	sym.set = set;
+	sym.index = -1;
+	m_symbols.push_back(sym);
+
+	return sym;
+}
+
+CShaderBuilder::SYMBOL CShaderBuilder::CreateImage2D(unsigned int unit, IMAGE_FORMAT format, unsigned int set)
+{
+	SYMBOL sym;
+	sym.owner = this;
+	sym.type = SYMBOL_TYPE_IMAGE2D;
+	sym.location = SYMBOL_LOCATION_TEXTURE;
+	sym.unit = unit;
+	sym.set = set;
+	sym.index = -1;
+	m_symbols.push_back(sym);
+
+	m_imageFormats[GetBinding(sym)] = format;
+
+	return sym;
+}
+
+CShaderBuilder::SYMBOL CShaderBuilder::CreateImage2DArray(unsigned int unit, IMAGE_FORMAT format, unsigned int set)
+{
+	SYMBOL sym;
+	sym.owner = this;
+	sym.type = SYMBOL_TYPE_IMAGE2DARRAY;
+	sym.location = SYMBOL_LOCATION_TEXTURE;
+	sym.unit = unit;
+	sym.set = set;
+	sym.index = -1;
+	m_symbols.push_back(sym);
+
+	m_imageFormats[GetBinding(sym)] = format;
+
+	return sym;
+}
+
+CShaderBuilder::SYMBOL CShaderBuilder::CreateImage3D(unsigned int unit, IMAGE_FORMAT format, unsigned int set)
+{
+	SYMBOL sym;
+	sym.owner = this;
+	sym.type = SYMBOL_TYPE_IMAGE3D;
+	sym.location = SYMBOL_LOCATION_TEXTURE;
+	sym.unit = unit;
+	sym.set = set;
 	sym.index = -1;
 	m_symbols.push_back(sym);
 
+	m_imageFormats[GetBinding(sym)] = format;
+
 	return sym;
 }
 
-CShaderBuilder::SYMBOL CShaderBuilder::CreateImage2DUint(unsigned int unit)
+CShaderBuilder::SYMBOL CShaderBuilder::CreateImage2DUint(unsigned int unit, IMAGE_FORMAT format, unsigned int set)
 {
 	SYMBOL sym;
 	sym.owner = this;
 	sym.type = SYMBOL_TYPE_IMAGE2DUINT;
 	sym.location = SYMBOL_LOCATION_TEXTURE;
 	sym.unit = unit;
+	sym.set = set;
+	sym.index = -1;
+	m_symbols.push_back(sym);
+
+	m_imageFormats[GetBinding(sym)] = format;
+
+	return sym;
+}
+
+CShaderBuilder::SYMBOL CShaderBuilder::CreateImage2DArrayUint(unsigned int unit, IMAGE_FORMAT format, unsigned int set)
+{
+	SYMBOL sym;
+	sym.owner = this;
+	sym.type = SYMBOL_TYPE_IMAGE2DARRAYUINT;
+	sym.location = SYMBOL_LOCATION_TEXTURE;
+	sym.unit = unit;
+	sym.set = set;
+	sym.index = -1;
+	m_symbols.push_back(sym);
+
+	m_imageFormats[GetBinding(sym)] = format;
+
+	return sym;
+}
+
+CShaderBuilder::SYMBOL CShaderBuilder::CreateImage3DUint(unsigned int unit, IMAGE_FORMAT format, unsigned int set)
+{
+	SYMBOL sym;
+	sym.owner = this;
+	sym.type = SYMBOL_TYPE_IMAGE3DUINT;
+	sym.location = SYMBOL_LOCATION_TEXTURE;
+	sym.unit = unit;
+	sym.set = set;
 	sym.index = -1;
 	m_symbols.push_back(sym);
 
+	m_imageFormats[GetBinding(sym)] = format;
+
+	return sym;
+}
+
+CShaderBuilder::SYMBOL CShaderBuilder::CreateTexture2DDescriptorArray(unsigned int unit, uint32 size, unsigned int set)
+{
+	auto sym = CreateTexture2D(unit, set);
+	m_textureArraySizes[GetBinding(sym)] = size;
+	return sym;
+}
+
+CShaderBuilder::SYMBOL CShaderBuilder::CreateImage2DDescriptorArray(unsigned int unit, IMAGE_FORMAT format, uint32 size, unsigned int set)
+{
+	auto sym = CreateImage2D(unit, format, set);
+	m_textureArraySizes[GetBinding(sym)] = size;
+	return sym;
+}
+
+CShaderBuilder::SYMBOL CShaderBuilder::CreateImage2DUintDescriptorArray(unsigned int unit, IMAGE_FORMAT format, uint32 size, unsigned int set)
+{
+	auto sym = CreateImage2DUint(unit, format, set);
+	m_textureArraySizes[GetBinding(sym)] = size;
+	return sym;
+}
+
+CShaderBuilder::SYMBOL CShaderBuilder::CreateUniformArrayUintDescriptorArray(const std::string& name, unsigned int unit, uint32 size, unsigned int set)
+{
+	assert(unit != static_cast<uint32>(UNIFORM_UNIT_PUSHCONSTANT));
+	auto sym = CreateUniformArrayUint(name, unit, 0, set);
+	m_bufferArraySizes[sym.index] = size;
+	return sym;
+}
+
+CShaderBuilder::SYMBOL CShaderBuilder::CreateTextureElement(const SYMBOL& array, bool nonUniform)
+{
+	assert(array.location == SYMBOL_LOCATION_TEXTURE);
+	assert(IsTextureArray(array));
+
+	SYMBOL sym;
+	sym.owner = this;
+	sym.type = array.type;
+	sym.location = SYMBOL_LOCATION_TEXTURE_ELEMENT;
+	sym.unit = array.unit;
+	sym.set = array.set;
+	sym.index = m_currentTextureElementIndex++;
+	sym.attributes = nonUniform ? SYMBOL_ATTRIBUTE_NONUNIFORM : 0;
+	m_symbols.push_back(sym);
+
 	return sym;
 }
 
-CShaderBuilder::SYMBOL CShaderBuilder::CreateSubpassInput(unsigned int unit, unsigned int index)
+CShaderBuilder::SYMBOL CShaderBuilder::CreateBufferElement(const SYMBOL& array, bool nonUniform)
+{
+	assert(array.location == SYMBOL_LOCATION_UNIFORM);
+	assert(IsBufferArray(array));
+
+	SYMBOL sym;
+	sym.owner = this;
+	sym.type = array.type;
+	sym.location = SYMBOL_LOCATION_BUFFER_ELEMENT;
+	sym.unit = array.unit;
+	sym.set = array.set;
+	sym.index = m_currentBufferElementIndex++;
+	sym.attributes = nonUniform ? SYMBOL_ATTRIBUTE_NONUNIFORM : 0;
+	m_symbols.push_back(sym);
+
+	return sym;
+}
+
+CShaderBuilder::SYMBOL CShaderBuilder::CreateSubpassInput(unsigned int unit, unsigned int index, unsigned int set)
 {
 	SYMBOL sym;
 	sym.owner = this;
 	sym.type = SYMBOL_TYPE_SUBPASSINPUT;
 	sym.location = SYMBOL_LOCATION_TEXTURE;
 	sym.unit = unit;
+	sym.set = set;
 	sym.index = index;
 	m_symbols.push_back(sym);
 
 	return sym;
 }
 
-CShaderBuilder::SYMBOL CShaderBuilder::CreateSubpassInputUint(unsigned int unit, unsigned int index)
+CShaderBuilder::SYMBOL CShaderBuilder::CreateSubpassInputUint(unsigned int unit, unsigned int index, unsigned int set)
 {
 	SYMBOL sym;
 	sym.owner = this;
 	sym.type = SYMBOL_TYPE_SUBPASSINPUTUINT;
 	sym.location = SYMBOL_LOCATION_TEXTURE;
 	sym.unit = unit;
+	sym.set = set;
 	sym.index = index;
 	m_symbols.push_back(sym);
 
 	return sym;
 }
 
+CShaderBuilder::SYMBOL CShaderBuilder::CreateUniformTexelBuffer(unsigned int unit, unsigned int set)
+{
+	SYMBOL sym;
+	sym.owner = this;
+	sym.type = SYMBOL_TYPE_UNIFORMTEXELBUFFER;
+	sym.location = SYMBOL_LOCATION_TEXTURE;
+	sym.unit = unit;
+	sym.set = set;
+	sym.index = -1;
+	m_symbols.push_back(sym);
+
+	return sym;
+}
+
+CShaderBuilder::SYMBOL CShaderBuilder::CreateStorageTexelBufferUint(unsigned int unit, unsigned int set)
+{
+	SYMBOL sym;
+	sym.owner = this;
+	sym.type = SYMBOL_TYPE_STORAGETEXELBUFFERUINT;
+	sym.location = SYMBOL_LOCATION_TEXTURE;
+	sym.unit = unit;
+	sym.set = set;
+	sym.index = -1;
+	m_symbols.push_back(sym);
+
+	return sym;
+}
+
 CShaderBuilder::SYMBOL CShaderBuilder::CreateOptionalInput(bool available, SEMANTIC semantic, unsigned int semanticIndex)
 {
 	return available ? CreateInput(semantic, semanticIndex) : SYMBOL();
@@ -591,3 +1201,36 @@ CShaderBuilder::SYMBOL CShaderBuilder::CreateOptionalUniformMatrix(bool availabl
 {
 	return available ? CreateUniformMatrix(name) : SYMBOL();
 }
+
+void CShaderBuilder::RemapSymbolOwners()
+{
+	auto remapSymbol =
+	    [this](SYMBOL& symbol) {
+		    if(symbol.owner == nullptr) return;
+		    symbol.owner = this;
+	    };
+	for(auto& symbol : m_symbols)
+	{
+		remapSymbol(symbol);
+	}
+	auto remapStatements =
+	    [&](StatementList& statements) {
+		    for(auto& statement : statements)
+		    {
+			    remapSymbol(statement.dstRef.symbol);
+			    remapSymbol(statement.src1Ref.symbol);
+			    remapSymbol(statement.src2Ref.symbol);
+			    remapSymbol(statement.src3Ref.symbol);
+			    remapSymbol(statement.src4Ref.symbol);
+		    }
+	    };
+	remapStatements(m_statements);
+	for(auto& function : m_functions)
+	{
+		for(auto& parameter : function.parameters)
+		{
+			remapSymbol(parameter);
+		}
+		remapStatements(function.statements);
+	}
+}
@@ -0,0 +1,195 @@
+#include <algorithm>
+#include "nuanceur/builder/UniformLayout.h"
+
+using namespace Nuanceur;
+
+struct MEMBER_INFO
+{
+	UNIFORM_MEMBER_LAYOUT layout;
+	uint32 alignment = 0;
+};
+
+static bool IsRuntimeArray(CShaderBuilder::SYMBOL_TYPE type)
+{
+	switch(type)
+	{
+	case CShaderBuilder::SYMBOL_TYPE_ARRAYUINT:
+	case CShaderBuilder::SYMBOL_TYPE_ARRAYUINT2:
+	case CShaderBuilder::SYMBOL_TYPE_ARRAYUINT4:
+	case CShaderBuilder::SYMBOL_TYPE_ARRAYUCHAR:
+	case CShaderBuilder::SYMBOL_TYPE_ARRAYUSHORT:
+		return true;
+	default:
+		return false;
+	}
+}
+
+static uint32 AlignUp(uint32 value, uint32 alignment)
+{
+	return (value + alignment - 1) & ~(alignment - 1);
+}
+
+static MEMBER_INFO MakeMemberInfo(const CShaderBuilder& shaderBuilder, const CShaderBuilder::SYMBOL& symbol, UNIFORM_LAYOUT layout)
+{
+	//Scalar layout aligns on the size of the components, other layouts align vectors on their size
+	bool isScalar = (layout == UNIFORM_LAYOUT_SCALAR);
+	uint32 vectorAlignment = isScalar ? 4 : 16;
+
+	MEMBER_INFO result;
+	result.layout.symbol = symbol;
+	auto& memberLayout = result.layout;
+	switch(symbol.type)
+	{
+	case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
+		switch(shaderBuilder.GetUniformComponentCount(symbol))
+		{
+		case 1:
+			result.alignment = 4;
+			memberLayout.size = 4;
+			break;
+		case 2:
+			result.alignment = isScalar ? 4 : 8;
+			memberLayout.size = 8;
+			break;
+		default:
+			result.alignment = vectorAlignment;
+			memberLayout.size = 16;
+			break;
+		}
+		break;
+	case CShaderBuilder::SYMBOL_TYPE_INT4:
+	case CShaderBuilder::SYMBOL_TYPE_UINT4:
+		result.alignment = vectorAlignment;
+		memberLayout.size = 16;
+		break;
+	case CShaderBuilder::SYMBOL_TYPE_MATRIX:
+		result.alignment = vectorAlignment;
+		memberLayout.size = 64;
+		memberLayout.matrixStride = 16;
+		break;
+	case CShaderBuilder::SYMBOL_TYPE_BUFFERPOINTERUINT:
+	case CShaderBuilder::SYMBOL_TYPE_BUFFERPOINTERFLOAT4:
+		//64-bit address
+		result.alignment = 8;
+		memberLayout.size = 8;
+		break;
+	case CShaderBuilder::SYMBOL_TYPE_ARRAYFLOAT4:
+	case CShaderBuilder::SYMBOL_TYPE_ARRAYINT4:
+		result.alignment = vectorAlignment;
+		memberLayout.arrayStride = 16;
+		memberLayout.size = 16 * shaderBuilder.GetUniformArraySize(symbol);
+		break;
+	case CShaderBuilder::SYMBOL_TYPE_ARRAYMATRIX:
+		result.alignment = vectorAlignment;
+		memberLayout.arrayStride = 64;
+		memberLayout.matrixStride = 16;
+		memberLayout.size = 64 * shaderBuilder.GetUniformArraySize(symbol);
+		break;
+	case CShaderBuilder::SYMBOL_TYPE_ARRAYUINT:
+		result.alignment = 4;
+		memberLayout.arrayStride = 4;
+		break;
+	case CShaderBuilder::SYMBOL_TYPE_ARRAYUINT2:
+		result.alignment = isScalar ? 4 : 8;
+		memberLayout.arrayStride = 8;
+		break;
+	case CShaderBuilder::SYMBOL_TYPE_ARRAYUINT4:
+		result.alignment = vectorAlignment;
+		memberLayout.arrayStride = 16;
+		break;
+	case CShaderBuilder::SYMBOL_TYPE_ARRAYUCHAR:
+		result.alignment = 1;
+		memberLayout.arrayStride = 1;
+		break;
+	case CShaderBuilder::SYMBOL_TYPE_ARRAYUSHORT:
+		result.alignment = 2;
+		memberLayout.arrayStride = 2;
+		break;
+	default:
+		assert(false);
+		break;
+	}
+	//std140 would require scalar array strides to be rounded up to 16 bytes
+	assert(!IsRuntimeArray(symbol.type) || (layout != UNIFORM_LAYOUT_STD140));
+	return result;
+}
+
+UniformBlockLayoutMap UniformLayout::ComputeBlockLayouts(const CShaderBuilder& shaderBuilder)
+{
+	std::map<CShaderBuilder::BINDING, std::vector<CShaderBuilder::SYMBOL>> blockSymbols;
+	for(const auto& symbol : shaderBuilder.GetSymbols())
+	{
+		if(symbol.location != CShaderBuilder::SYMBOL_LOCATION_UNIFORM) continue;
+		blockSymbols[CShaderBuilder::GetBinding(symbol)].push_back(symbol);
+	}
+
+	bool useScalarLayout = shaderBuilder.GetMetadata(CShaderBuilder::METADATA_SCALAR_BLOCK_LAYOUT, 0) != 0;
+
+	UniformBlockLayoutMap result;
+	for(const auto& blockSymbolsPair : blockSymbols)
+	{
+		auto binding = blockSymbolsPair.first;
+		const auto& symbols = blockSymbolsPair.second;
+
+		//Blocks holding arrays without a fixed size are storage buffers
+		bool isBufferBlock = std::any_of(symbols.begin(), symbols.end(),
+		                                 [](const CShaderBuilder::SYMBOL& symbol) { return IsRuntimeArray(symbol.type); });
+
+		auto& blockLayout = result[binding];
+		if(useScalarLayout)
+		{
+			blockLayout.layout = UNIFORM_LAYOUT_SCALAR;
+		}
+		else if((binding.second == static_cast<uint32>(UNIFORM_UNIT_PUSHCONSTANT)) || isBufferBlock)
+		{
+			blockLayout.layout = UNIFORM_LAYOUT_STD430;
+		}
+		else
+		{
+			blockLayout.layout = UNIFORM_LAYOUT_STD140;
+		}
+
+		std::vector<MEMBER_INFO> memberInfos;
+		for(const auto& symbol : symbols)
+		{
+			memberInfos.push_back(MakeMemberInfo(shaderBuilder, symbol, blockLayout.layout));
+		}
+
+		//Every size is a multiple of its alignment, ordering by decreasing alignment leaves no holes.
+		//Stable to keep members with the same alignment in declaration order.
+		std::stable_sort(memberInfos.begin(), memberInfos.end(),
+		                 [](const MEMBER_INFO& lhs, const MEMBER_INFO& rhs) {
+			                 bool lhsRuntimeArray = IsRuntimeArray(lhs.layout.symbol.type);
+			                 bool rhsRuntimeArray = IsRuntimeArray(rhs.layout.symbol.type);
+			                 if(lhsRuntimeArray != rhsRuntimeArray) return rhsRuntimeArray;
+			                 return lhs.alignment > rhs.alignment;
+		                 });
+
+		uint32 currentOffset = 0;
+		for(auto& memberInfo : memberInfos)
+		{
+			auto& memberLayout = memberInfo.layout;
+			memberLayout.offset = AlignUp(currentOffset, memberInfo.alignment);
+			currentOffset = memberLayout.offset + memberLayout.size;
+			blockLayout.members.push_back(memberLayout);
+		}
+		blockLayout.size = currentOffset;
+	}
+	return result;
+}
+
+const char* UniformLayout::GetLayoutName(UNIFORM_LAYOUT layout)
+{
+	switch(layout)
+	{
+	default:
+		assert(false);
+		[[fallthrough]];
+	case UNIFORM_LAYOUT_STD140:
+		return "std140";
+	case UNIFORM_LAYOUT_STD430:
+		return "std430";
+	case UNIFORM_LAYOUT_SCALAR:
+		return "scalar";
+	}
+}
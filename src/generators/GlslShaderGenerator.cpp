@@ -1,18 +1,33 @@
 #include "nuanceur/generators/GlslShaderGenerator.h"
+#include "nuanceur/builder/UniformLayout.h"
 #include "string_format.h"
+#include <algorithm>
+#include <set>
 
 using namespace Nuanceur;
 
-CGlslShaderGenerator::CGlslShaderGenerator(const CShaderBuilder& shaderBuilder, SHADER_TYPE shaderType, uint32 glslVersion)
+static bool HasStatementOp(const CShaderBuilder& shaderBuilder, std::initializer_list<CShaderBuilder::STATEMENT_OP> ops)
+{
+	auto predicate = [&](const CShaderBuilder::STATEMENT& statement) { return std::find(ops.begin(), ops.end(), statement.op) != ops.end(); };
+	if(std::any_of(shaderBuilder.GetStatements().begin(), shaderBuilder.GetStatements().end(), predicate)) return true;
+	for(const auto& function : shaderBuilder.GetFunctions())
+	{
+		if(std::any_of(function.statements.begin(), function.statements.end(), predicate)) return true;
+	}
+	return false;
+}
+
+CGlslShaderGenerator::CGlslShaderGenerator(const CShaderBuilder& shaderBuilder, SHADER_TYPE shaderType, uint32 glslVersion, uint32 flags)
     : m_shaderBuilder(shaderBuilder)
     , m_shaderType(shaderType)
     , m_glslVersion(glslVersion)
+    , m_flags(flags)
 {
 }
 
-std::string CGlslShaderGenerator::Generate(const CShaderBuilder& shaderBuilder, SHADER_TYPE shaderType, uint32 glslVersion)
+std::string CGlslShaderGenerator::Generate(const CShaderBuilder& shaderBuilder, SHADER_TYPE shaderType, uint32 glslVersion, uint32 flags)
 {
-	CGlslShaderGenerator generator(shaderBuilder, shaderType, glslVersion);
+	CGlslShaderGenerator generator(shaderBuilder, shaderType, glslVersion, flags);
 	return generator.Generate();
 }
 
@@ -25,11 +40,133 @@ std::string CGlslShaderGenerator::Generate() const
 		result += string_format("#version %d\r\n", m_glslVersion);
 	}
 
-	if(m_shaderType == SHADER_TYPE_FRAGMENT)
+	if(m_flags & FLAG_NATIVE_FLOAT16)
+	{
+		bool hasHalf = std::any_of(m_shaderBuilder.GetSymbols().begin(), m_shaderBuilder.GetSymbols().end(),
+		                           [](const CShaderBuilder::SYMBOL& symbol) { return symbol.type == CShaderBuilder::SYMBOL_TYPE_HALF4; });
+		if(hasHalf)
+		{
+			result += "#extension GL_EXT_shader_explicit_arithmetic_types_float16 : require\r\n";
+		}
+	}
+
+	{
+		bool has8BitStorage = false;
+		bool has16BitStorage = false;
+		bool has8BitArithmetic = false;
+		bool has16BitArithmetic = false;
+		for(const auto& symbol : m_shaderBuilder.GetSymbols())
+		{
+			bool isBuffer = (symbol.location == CShaderBuilder::SYMBOL_LOCATION_UNIFORM);
+			switch(symbol.type)
+			{
+			case CShaderBuilder::SYMBOL_TYPE_ARRAYUCHAR:
+				has8BitStorage |= isBuffer;
+				has8BitArithmetic |= !isBuffer;
+				break;
+			case CShaderBuilder::SYMBOL_TYPE_ARRAYUSHORT:
+				has16BitStorage |= isBuffer;
+				has16BitArithmetic |= !isBuffer;
+				break;
+			case CShaderBuilder::SYMBOL_TYPE_UCHAR4:
+				has8BitArithmetic = true;
+				break;
+			case CShaderBuilder::SYMBOL_TYPE_USHORT4:
+				has16BitArithmetic = true;
+				break;
+			default:
+				break;
+			}
+		}
+		if(has8BitStorage)
+		{
+			result += "#extension GL_EXT_shader_8bit_storage : require\r\n";
+		}
+		if(has16BitStorage)
+		{
+			result += "#extension GL_EXT_shader_16bit_storage : require\r\n";
+		}
+		//Shared arrays and temporaries of small integers need the explicit types
+		if(has8BitArithmetic)
+		{
+			result += "#extension GL_EXT_shader_explicit_arithmetic_types_int8 : require\r\n";
+		}
+		if(has16BitArithmetic)
+		{
+			result += "#extension GL_EXT_shader_explicit_arithmetic_types_int16 : require\r\n";
+		}
+	}
+
+	bool hasBufferPointer = std::any_of(m_shaderBuilder.GetSymbols().begin(), m_shaderBuilder.GetSymbols().end(),
+	                                    [](const CShaderBuilder::SYMBOL& symbol) { return CShaderBuilder::IsBufferPointerType(symbol.type); });
+	if(hasBufferPointer)
+	{
+		result += "#extension GL_EXT_buffer_reference : require\r\n";
+	}
+
+	if(m_shaderBuilder.GetMetadata(CShaderBuilder::METADATA_SCALAR_BLOCK_LAYOUT, 0))
+	{
+		result += "#extension GL_EXT_scalar_block_layout : require\r\n";
+	}
+
+	{
+		bool hasNonUniformElement = std::any_of(m_shaderBuilder.GetSymbols().begin(), m_shaderBuilder.GetSymbols().end(),
+		                                        [&](const CShaderBuilder::SYMBOL& symbol) {
+			                                        if(symbol.location == CShaderBuilder::SYMBOL_LOCATION_TEXTURE_ELEMENT) return (symbol.attributes & SYMBOL_ATTRIBUTE_NONUNIFORM) != 0;
+			                                        if(symbol.location == CShaderBuilder::SYMBOL_LOCATION_BUFFER_ELEMENT) return (symbol.attributes & SYMBOL_ATTRIBUTE_NONUNIFORM) != 0;
+			                                        if(symbol.location == CShaderBuilder::SYMBOL_LOCATION_TEXTURE) return m_shaderBuilder.IsTextureArray(symbol) && (m_shaderBuilder.GetTextureArraySize(symbol) == 0);
+			                                        if(symbol.location == CShaderBuilder::SYMBOL_LOCATION_UNIFORM) return m_shaderBuilder.IsBufferArray(symbol) && (m_shaderBuilder.GetBufferArraySize(symbol) == 0);
+			                                        return false;
+		                                        });
+		if(hasNonUniformElement)
+		{
+			result += "#extension GL_EXT_nonuniform_qualifier : require\r\n";
+		}
+	}
+
+	{
+		bool hasSubgroupBallot = HasStatementOp(m_shaderBuilder, {CShaderBuilder::STATEMENT_OP_SUBGROUP_BALLOT, CShaderBuilder::STATEMENT_OP_SUBGROUP_BROADCAST});
+		bool hasSubgroupShuffle = HasStatementOp(m_shaderBuilder, {CShaderBuilder::STATEMENT_OP_SUBGROUP_SHUFFLE});
+		bool hasSubgroupArithmetic = HasStatementOp(m_shaderBuilder, {CShaderBuilder::STATEMENT_OP_SUBGROUP_ADD, CShaderBuilder::STATEMENT_OP_SUBGROUP_MIN,
+		                                                              CShaderBuilder::STATEMENT_OP_SUBGROUP_MAX, CShaderBuilder::STATEMENT_OP_SUBGROUP_AND,
+		                                                              CShaderBuilder::STATEMENT_OP_SUBGROUP_OR});
+		bool hasSubgroupInput = std::any_of(m_shaderBuilder.GetSymbols().begin(), m_shaderBuilder.GetSymbols().end(),
+		                                    [&](const CShaderBuilder::SYMBOL& symbol) {
+			                                    if(symbol.location != CShaderBuilder::SYMBOL_LOCATION_INPUT) return false;
+			                                    auto semanticType = m_shaderBuilder.GetInputSemantic(symbol).type;
+			                                    return (semanticType == SEMANTIC_SYSTEM_SUBGROUP_INVOCATION_ID) ||
+			                                           (semanticType == SEMANTIC_SYSTEM_SUBGROUP_SIZE);
+		                                    });
+		if(hasSubgroupBallot || hasSubgroupShuffle || hasSubgroupArithmetic || hasSubgroupInput)
+		{
+			result += "#extension GL_KHR_shader_subgroup_basic : require\r\n";
+		}
+		if(hasSubgroupBallot)
+		{
+			result += "#extension GL_KHR_shader_subgroup_ballot : require\r\n";
+		}
+		if(hasSubgroupShuffle)
+		{
+			result += "#extension GL_KHR_shader_subgroup_shuffle : require\r\n";
+		}
+		if(hasSubgroupArithmetic)
+		{
+			result += "#extension GL_KHR_shader_subgroup_arithmetic : require\r\n";
+		}
+	}
+
+	auto defaultPrecision = static_cast<PRECISION>(m_shaderBuilder.GetMetadata(CShaderBuilder::METADATA_PRECISION, PRECISION_DEFAULT));
+	if(defaultPrecision != PRECISION_DEFAULT)
+	{
+		result += string_format("precision %s float;\r\n", GetPrecisionName(defaultPrecision));
+		result += string_format("precision %s int;\r\n", GetPrecisionName(defaultPrecision));
+	}
+	else if(m_shaderType == SHADER_TYPE_FRAGMENT)
 	{
 		result += "precision mediump float;\r\n";
 	}
-	else if(m_shaderType == SHADER_TYPE_COMPUTE)
+
+	if(m_shaderType == SHADER_TYPE_COMPUTE)
 	{
 		uint32 localSizeX = m_shaderBuilder.GetMetadata(CShaderBuilder::METADATA_LOCALSIZE_X, 1);
 		uint32 localSizeY = m_shaderBuilder.GetMetadata(CShaderBuilder::METADATA_LOCALSIZE_Y, 1);
@@ -38,10 +175,17 @@ std::string CGlslShaderGenerator::Generate() const
 		                        localSizeX, localSizeY, localSizeZ);
 	}
 
+	if((m_shaderType == SHADER_TYPE_FRAGMENT) && m_shaderBuilder.GetMetadata(CShaderBuilder::METADATA_EARLY_FRAGMENT_TESTS, 0))
+	{
+		result += "layout(early_fragment_tests) in;\r\n";
+	}
+
 	result += GenerateInputs();
 	result += GenerateOutputs();
 	result += GenerateUniforms();
+	result += GenerateSharedArrays();
 	result += GenerateSamplers();
+	result += GenerateFunctions();
 
 	result += "void main()\r\n";
 	result += "{\r\n";
@@ -50,55 +194,139 @@ std::string CGlslShaderGenerator::Generate() const
 	for(const auto& symbol : m_shaderBuilder.GetSymbols())
 	{
 		if(symbol.location != CShaderBuilder::SYMBOL_LOCATION_TEMPORARY) continue;
-		switch(symbol.type)
-		{
-		default:
-			assert(false);
-			[[fallthrough]];
-		case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
-		{
-			auto temporaryValue = m_shaderBuilder.GetTemporaryValue(symbol);
-			result += string_format("\t%s %s = vec4(%f, %f, %f, %f);\r\n",
-			                        MakeTypeName(symbol.type).c_str(), MakeSymbolName(symbol).c_str(),
-			                        temporaryValue.x, temporaryValue.y, temporaryValue.z, temporaryValue.w);
-		}
-		break;
-		case CShaderBuilder::SYMBOL_TYPE_INT4:
+		result += GenerateTemporary(symbol);
+	}
+
+	//Write all variables
+	for(const auto& symbol : m_shaderBuilder.GetSymbols())
+	{
+		if(symbol.location != CShaderBuilder::SYMBOL_LOCATION_VARIABLE) continue;
+		result += string_format("\t%s%s %s;\r\n",
+		                        MakePrecisionQualifier(symbol).c_str(), MakeTypeName(symbol.type).c_str(), MakeSymbolName(symbol).c_str());
+	}
+
+	result += GenerateStatements(m_shaderBuilder.GetStatements());
+
+	result += "}\r\n";
+
+	return result;
+}
+
+std::string CGlslShaderGenerator::GenerateFunctions() const
+{
+	std::string result;
+	const auto& functions = m_shaderBuilder.GetFunctions();
+	for(uint32 functionIndex = 0; functionIndex < functions.size(); functionIndex++)
+	{
+		const auto& function = functions[functionIndex];
+		std::string params;
+		std::set<uint32> paramIndices;
+		for(const auto& parameter : function.parameters)
 		{
-			auto temporaryValue = m_shaderBuilder.GetTemporaryValueInt(symbol);
-			result += string_format("\t%s %s = ivec4(%d, %d, %d, %d);\r\n",
-			                        MakeTypeName(symbol.type).c_str(), MakeSymbolName(symbol).c_str(),
-			                        temporaryValue.x, temporaryValue.y, temporaryValue.z, temporaryValue.w);
+			if(!params.empty()) params += ", ";
+			params += string_format("%s %s", MakeTypeName(parameter.type).c_str(), MakeSymbolName(parameter).c_str());
+			paramIndices.insert(parameter.index);
 		}
-		break;
-		case CShaderBuilder::SYMBOL_TYPE_UINT4:
+		auto returnTypeName = (function.returnType == CShaderBuilder::SYMBOL_TYPE_NULL) ? std::string("void") : MakeTypeName(function.returnType);
+		result += string_format("%s f%d(%s)\r\n", returnTypeName.c_str(), functionIndex, params.c_str());
+		result += "{\r\n";
+
+		//Only declare temps used by this function
+		std::set<uint32> tempIndices;
+		for(const auto& statement : function.statements)
 		{
-			auto temporaryValue = m_shaderBuilder.GetTemporaryValueInt(symbol);
-			result += string_format("\t%s %s = uvec4(%u, %u, %u, %u);\r\n",
-			                        MakeTypeName(symbol.type).c_str(), MakeSymbolName(symbol).c_str(),
-			                        temporaryValue.x, temporaryValue.y, temporaryValue.z, temporaryValue.w);
+			for(const auto* ref : {&statement.dstRef, &statement.src1Ref, &statement.src2Ref, &statement.src3Ref, &statement.src4Ref})
+			{
+				if(ref->symbol.location != CShaderBuilder::SYMBOL_LOCATION_TEMPORARY) continue;
+				if(paramIndices.count(ref->symbol.index)) continue;
+				tempIndices.insert(ref->symbol.index);
+			}
 		}
-		break;
-		case CShaderBuilder::SYMBOL_TYPE_BOOL4:
+		for(const auto& symbol : m_shaderBuilder.GetSymbols())
 		{
-			auto temporaryValue = m_shaderBuilder.GetTemporaryValueBool(symbol);
-			result += string_format("\t%s %s = bvec4(%u, %u, %u, %u);\r\n",
-			                        MakeTypeName(symbol.type).c_str(), MakeSymbolName(symbol).c_str(),
-			                        temporaryValue.x, temporaryValue.y, temporaryValue.z, temporaryValue.w);
-		}
-		break;
+			if(symbol.location != CShaderBuilder::SYMBOL_LOCATION_TEMPORARY) continue;
+			if(!tempIndices.count(symbol.index)) continue;
+			result += GenerateTemporary(symbol);
 		}
+
+		result += GenerateStatements(function.statements);
+		result += "}\r\n";
 	}
+	return result;
+}
 
-	//Write all variables
-	for(const auto& symbol : m_shaderBuilder.GetSymbols())
+std::string CGlslShaderGenerator::GenerateTemporary(const CShaderBuilder::SYMBOL& symbol) const
+{
+	std::string result;
+	switch(symbol.type)
 	{
-		if(symbol.location != CShaderBuilder::SYMBOL_LOCATION_VARIABLE) continue;
-		result += string_format("\t%s %s;\r\n",
-		                        MakeTypeName(symbol.type).c_str(), MakeSymbolName(symbol).c_str());
+	default:
+		assert(false);
+		[[fallthrough]];
+	case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
+	{
+		auto temporaryValue = m_shaderBuilder.GetTemporaryValue(symbol);
+		result = string_format("\t%s%s %s = vec4(%f, %f, %f, %f);\r\n",
+		                        MakePrecisionQualifier(symbol).c_str(), MakeTypeName(symbol.type).c_str(), MakeSymbolName(symbol).c_str(),
+		                        temporaryValue.x, temporaryValue.y, temporaryValue.z, temporaryValue.w);
+	}
+	break;
+	case CShaderBuilder::SYMBOL_TYPE_HALF4:
+	{
+		auto temporaryValue = m_shaderBuilder.GetTemporaryValue(symbol);
+		auto typeName = MakeTypeName(symbol.type);
+		result = string_format("\t%s%s %s = %s(%f, %f, %f, %f);\r\n",
+		                        MakePrecisionQualifier(symbol).c_str(), typeName.c_str(), MakeSymbolName(symbol).c_str(), typeName.c_str(),
+		                        temporaryValue.x, temporaryValue.y, temporaryValue.z, temporaryValue.w);
+	}
+	break;
+	case CShaderBuilder::SYMBOL_TYPE_INT4:
+	{
+		auto temporaryValue = m_shaderBuilder.GetTemporaryValueInt(symbol);
+		result = string_format("\t%s%s %s = ivec4(%d, %d, %d, %d);\r\n",
+		                        MakePrecisionQualifier(symbol).c_str(), MakeTypeName(symbol.type).c_str(), MakeSymbolName(symbol).c_str(),
+		                        temporaryValue.x, temporaryValue.y, temporaryValue.z, temporaryValue.w);
 	}
+	break;
+	case CShaderBuilder::SYMBOL_TYPE_UINT4:
+	{
+		auto temporaryValue = m_shaderBuilder.GetTemporaryValueInt(symbol);
+		result = string_format("\t%s%s %s = uvec4(%u, %u, %u, %u);\r\n",
+		                        MakePrecisionQualifier(symbol).c_str(), MakeTypeName(symbol.type).c_str(), MakeSymbolName(symbol).c_str(),
+		                        temporaryValue.x, temporaryValue.y, temporaryValue.z, temporaryValue.w);
+	}
+	break;
+	case CShaderBuilder::SYMBOL_TYPE_USHORT4:
+	case CShaderBuilder::SYMBOL_TYPE_UCHAR4:
+	{
+		auto temporaryValue = m_shaderBuilder.GetTemporaryValueInt(symbol);
+		auto typeName = MakeTypeName(symbol.type);
+		result = string_format("\t%s%s %s = %s(%u, %u, %u, %u);\r\n",
+		                        MakePrecisionQualifier(symbol).c_str(), typeName.c_str(), MakeSymbolName(symbol).c_str(), typeName.c_str(),
+		                        temporaryValue.x, temporaryValue.y, temporaryValue.z, temporaryValue.w);
+	}
+	break;
+	case CShaderBuilder::SYMBOL_TYPE_BOOL4:
+	{
+		auto temporaryValue = m_shaderBuilder.GetTemporaryValueBool(symbol);
+		result = string_format("\t%s%s %s = bvec4(%u, %u, %u, %u);\r\n",
+		                        MakePrecisionQualifier(symbol).c_str(), MakeTypeName(symbol.type).c_str(), MakeSymbolName(symbol).c_str(),
+		                        temporaryValue.x, temporaryValue.y, temporaryValue.z, temporaryValue.w);
+	}
+	break;
+	}
+	return result;
+}
+
+std::string CGlslShaderGenerator::GenerateStatements(const CShaderBuilder::StatementList& statements) const
+{
+	std::string result;
 
-	for(const auto& statement : m_shaderBuilder.GetStatements())
+	//Cases don't fall through, a break is needed before the next case if the previous one has a body
+	std::vector<CShaderBuilder::SYMBOL_TYPE> switchSelectorTypes;
+	bool caseHasBody = false;
+
+	for(const auto& statement : statements)
 	{
 		const auto& dstRef = statement.dstRef;
 		const auto& src1Ref = statement.src1Ref;
@@ -120,6 +348,15 @@ std::string CGlslShaderGenerator::Generate() const
 			                        PrintSymbolRef(src2Ref).c_str());
 			break;
 		case CShaderBuilder::STATEMENT_OP_MULTIPLY:
+			if(src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_ARRAYMATRIX)
+			{
+				result += string_format("\t%s = %s[%s] * %s;\r\n",
+				                        PrintSymbolRef(dstRef).c_str(),
+				                        MakeSymbolName(src1Ref.symbol).c_str(),
+				                        PrintSymbolRef(src3Ref).c_str(),
+				                        PrintSymbolRef(src2Ref).c_str());
+				break;
+			}
 			result += string_format("\t%s = %s * %s;\r\n",
 			                        PrintSymbolRef(dstRef).c_str(),
 			                        PrintSymbolRef(src1Ref).c_str(),
@@ -170,8 +407,9 @@ std::string CGlslShaderGenerator::Generate() const
 			                        PrintSymbolRef(src3Ref).c_str());
 			break;
 		case CShaderBuilder::STATEMENT_OP_NEWVECTOR2:
-			result += string_format("\t%s = vec2(%s, %s);\r\n",
+			result += string_format("\t%s = %s(%s, %s);\r\n",
 			                        PrintSymbolRef(dstRef).c_str(),
+			                        ((dstRef.symbol.type == CShaderBuilder::SYMBOL_TYPE_HALF4) && (m_flags & FLAG_NATIVE_FLOAT16)) ? "f16vec2" : "vec2",
 			                        PrintSymbolRef(src1Ref).c_str(),
 			                        PrintSymbolRef(src2Ref).c_str());
 			break;
@@ -230,33 +468,195 @@ std::string CGlslShaderGenerator::Generate() const
 			                        PrintSymbolRef(src1Ref).c_str());
 			break;
 		case CShaderBuilder::STATEMENT_OP_SAMPLE:
-			assert(src1Ref.symbol.location == CShaderBuilder::SYMBOL_LOCATION_TEXTURE);
-			result += string_format("\t%s = texture2D(c_sampler%d, %s);\r\n",
+			result += string_format("\t%s = texture2D(%s, %s);\r\n",
 			                        PrintSymbolRef(dstRef).c_str(),
-			                        src1Ref.symbol.index,
+			                        MakeTextureName(src1Ref.symbol).c_str(),
+			                        PrintSymbolRef(src2Ref).c_str());
+			break;
+		case CShaderBuilder::STATEMENT_OP_SAMPLE_LOD:
+			result += string_format("\t%s = textureLod(%s, %s, %s);\r\n",
+			                        PrintSymbolRef(dstRef).c_str(),
+			                        MakeTextureName(src1Ref.symbol).c_str(),
+			                        PrintSymbolRef(src2Ref).c_str(),
+			                        PrintSymbolRef(src3Ref).c_str());
+			break;
+		case CShaderBuilder::STATEMENT_OP_SAMPLE_GRAD:
+			result += string_format("\t%s = textureGrad(%s, %s, %s, %s);\r\n",
+			                        PrintSymbolRef(dstRef).c_str(),
+			                        MakeTextureName(src1Ref.symbol).c_str(),
+			                        PrintSymbolRef(src2Ref).c_str(),
+			                        PrintSymbolRef(src3Ref).c_str(),
+			                        PrintSymbolRef(src4Ref).c_str());
+			break;
+		case CShaderBuilder::STATEMENT_OP_SAMPLE_OFFSET:
+			result += string_format("\t%s = textureOffset(%s, %s, ivec2(%d, %d));\r\n",
+			                        PrintSymbolRef(dstRef).c_str(),
+			                        MakeTextureName(src1Ref.symbol).c_str(),
+			                        PrintSymbolRef(src2Ref).c_str(),
+			                        static_cast<int16>(statement.param & 0xFFFF),
+			                        static_cast<int16>(statement.param >> 16));
+			break;
+		case CShaderBuilder::STATEMENT_OP_FETCH:
+			if(src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_UNIFORMTEXELBUFFER)
+			{
+				result += string_format("\t%s = texelFetch(%s, %s);\r\n",
+				                        PrintSymbolRef(dstRef).c_str(),
+				                        MakeTextureName(src1Ref.symbol).c_str(),
+				                        PrintSymbolRef(src2Ref).c_str());
+				break;
+			}
+			result += string_format("\t%s = texelFetch(%s, %s, %s);\r\n",
+			                        PrintSymbolRef(dstRef).c_str(),
+			                        MakeTextureName(src1Ref.symbol).c_str(),
+			                        PrintSymbolRef(src2Ref).c_str(),
+			                        PrintSymbolRef(src3Ref).c_str());
+			break;
+		case CShaderBuilder::STATEMENT_OP_GATHER:
+			result += string_format("\t%s = textureGather(%s, %s, %d);\r\n",
+			                        PrintSymbolRef(dstRef).c_str(),
+			                        MakeTextureName(src1Ref.symbol).c_str(),
+			                        PrintSymbolRef(src2Ref).c_str(),
+			                        statement.param);
+			break;
+		case CShaderBuilder::STATEMENT_OP_SELECT_TEXTURE:
+			result += string_format("\te%d = %s;\r\n",
+			                        dstRef.symbol.index,
+			                        PrintSymbolRef(src2Ref).c_str());
+			break;
+		case CShaderBuilder::STATEMENT_OP_SELECT_BUFFER:
+			result += string_format("\tb%d = %s;\r\n",
+			                        dstRef.symbol.index,
 			                        PrintSymbolRef(src2Ref).c_str());
 			break;
 		case CShaderBuilder::STATEMENT_OP_TOFLOAT:
 			result += EmitConversion({"float", "vec2", "vec3", "vec4"}, dstRef, src1Ref);
 			break;
+		case CShaderBuilder::STATEMENT_OP_TOHALF:
+			if(m_flags & FLAG_NATIVE_FLOAT16)
+			{
+				result += EmitConversion({"float16_t", "f16vec2", "f16vec3", "f16vec4"}, dstRef, src1Ref);
+			}
+			else
+			{
+				result += string_format("\t%s = %s;\r\n",
+				                        PrintSymbolRef(dstRef).c_str(),
+				                        PrintSymbolRef(src1Ref).c_str());
+			}
+			break;
 		case CShaderBuilder::STATEMENT_OP_TOINT:
 			result += EmitConversion({"int", "ivec2", "ivec3", "ivec4"}, dstRef, src1Ref);
 			break;
 		case CShaderBuilder::STATEMENT_OP_TOUINT:
 			result += EmitConversion({"uint", "uvec2", "uvec3", "uvec4"}, dstRef, src1Ref);
 			break;
+		case CShaderBuilder::STATEMENT_OP_TOUSHORT:
+			result += EmitConversion({"uint16_t", "u16vec2", "u16vec3", "u16vec4"}, dstRef, src1Ref);
+			break;
+		case CShaderBuilder::STATEMENT_OP_TOUCHAR:
+			result += EmitConversion({"uint8_t", "u8vec2", "u8vec3", "u8vec4"}, dstRef, src1Ref);
+			break;
 		case CShaderBuilder::STATEMENT_OP_LOAD:
+			if(
+			    (src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_ARRAYUCHAR) ||
+			    (src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_ARRAYUSHORT))
+			{
+				//Small integers need to be explicitly extended
+				result += string_format("\t%s = uint(%s[%s]);\r\n",
+				                        PrintSymbolRef(dstRef).c_str(),
+				                        MakeSymbolName(src1Ref.symbol).c_str(),
+				                        PrintSymbolRef(src2Ref).c_str());
+				break;
+			}
+			if(
+			    (src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_STORAGETEXELBUFFERUINT) ||
+			    CShaderBuilder::IsImageType(src1Ref.symbol.type))
+			{
+				result += string_format("\t%s = imageLoad(%s, %s);\r\n",
+				                        PrintSymbolRef(dstRef).c_str(),
+				                        MakeTextureName(src1Ref.symbol).c_str(),
+				                        PrintSymbolRef(src2Ref).c_str());
+				break;
+			}
 			result += string_format("\t%s = %s[%s];\r\n",
 			                        PrintSymbolRef(dstRef).c_str(),
 			                        MakeSymbolName(src1Ref.symbol).c_str(),
 			                        PrintSymbolRef(src2Ref).c_str());
 			break;
 		case CShaderBuilder::STATEMENT_OP_STORE:
+			if(
+			    (src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_STORAGETEXELBUFFERUINT) ||
+			    CShaderBuilder::IsImageType(src1Ref.symbol.type))
+			{
+				result += string_format("\timageStore(%s, %s, %s);\r\n",
+				                        MakeTextureName(src1Ref.symbol).c_str(),
+				                        PrintSymbolRef(src2Ref).c_str(),
+				                        PrintSymbolRef(src3Ref).c_str());
+				break;
+			}
 			result += string_format("\t%s[%s] = %s;\r\n",
 			                        MakeSymbolName(src1Ref.symbol).c_str(),
 			                        PrintSymbolRef(src2Ref).c_str(),
 			                        PrintSymbolRef(src3Ref).c_str());
 			break;
+		case CShaderBuilder::STATEMENT_OP_STORE16:
+		case CShaderBuilder::STATEMENT_OP_STORE8:
+			result += string_format("\t%s[%s] = %s;\r\n",
+			                        MakeSymbolName(src1Ref.symbol).c_str(),
+			                        PrintSymbolRef(src2Ref).c_str(),
+			                        PrintSymbolRef(src3Ref).c_str());
+			break;
+		case CShaderBuilder::STATEMENT_OP_ATOMICAND:
+		case CShaderBuilder::STATEMENT_OP_ATOMICOR:
+		case CShaderBuilder::STATEMENT_OP_ATOMICXOR:
+		case CShaderBuilder::STATEMENT_OP_ATOMICADD:
+		case CShaderBuilder::STATEMENT_OP_ATOMICMIN:
+		case CShaderBuilder::STATEMENT_OP_ATOMICMAX:
+		case CShaderBuilder::STATEMENT_OP_ATOMICEXCHANGE:
+		{
+			//GLSL atomics don't have scope or memory order, they behave as relaxed device atomics
+			assert((src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_ARRAYUINT) || (src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_BUFFERPOINTERUINT));
+			const char* functionName = "";
+			switch(statement.op)
+			{
+			case CShaderBuilder::STATEMENT_OP_ATOMICAND:
+				functionName = "atomicAnd";
+				break;
+			case CShaderBuilder::STATEMENT_OP_ATOMICOR:
+				functionName = "atomicOr";
+				break;
+			case CShaderBuilder::STATEMENT_OP_ATOMICXOR:
+				functionName = "atomicXor";
+				break;
+			case CShaderBuilder::STATEMENT_OP_ATOMICADD:
+				functionName = "atomicAdd";
+				break;
+			case CShaderBuilder::STATEMENT_OP_ATOMICMIN:
+				functionName = "atomicMin";
+				break;
+			case CShaderBuilder::STATEMENT_OP_ATOMICMAX:
+				functionName = "atomicMax";
+				break;
+			default:
+				functionName = "atomicExchange";
+				break;
+			}
+			result += string_format("\t%s = %s(%s[%s], %s);\r\n",
+			                        PrintSymbolRef(dstRef).c_str(),
+			                        functionName,
+			                        MakeSymbolName(src1Ref.symbol).c_str(),
+			                        PrintSymbolRef(src2Ref).c_str(),
+			                        PrintSymbolRef(src3Ref).c_str());
+		}
+		break;
+		case CShaderBuilder::STATEMENT_OP_ATOMICCOMPAREEXCHANGE:
+			assert((src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_ARRAYUINT) || (src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_BUFFERPOINTERUINT));
+			result += string_format("\t%s = atomicCompSwap(%s[%s], %s, %s);\r\n",
+			                        PrintSymbolRef(dstRef).c_str(),
+			                        MakeSymbolName(src1Ref.symbol).c_str(),
+			                        PrintSymbolRef(src2Ref).c_str(),
+			                        PrintSymbolRef(src4Ref).c_str(),
+			                        PrintSymbolRef(src3Ref).c_str());
+			break;
 		case CShaderBuilder::STATEMENT_OP_LSHIFT:
 			result += string_format("\t%s = %s << %s;\r\n",
 			                        PrintSymbolRef(dstRef).c_str(),
@@ -307,20 +707,168 @@ std::string CGlslShaderGenerator::Generate() const
 			result += string_format("\tif(%s)\r\n", PrintSymbolRef(src1Ref).c_str());
 			result += "\t{\r\n";
 			break;
+		case CShaderBuilder::STATEMENT_OP_ELSE:
+			result += "\t}\r\n";
+			result += "\telse\r\n";
+			result += "\t{\r\n";
+			break;
 		case CShaderBuilder::STATEMENT_OP_IF_END:
 			result += "\t}\r\n";
 			break;
+		case CShaderBuilder::STATEMENT_OP_SWITCH_BEGIN:
+			result += string_format("\tswitch(%s)\r\n", PrintSymbolRef(src1Ref).c_str());
+			result += "\t{\r\n";
+			switchSelectorTypes.push_back(src1Ref.symbol.type);
+			caseHasBody = false;
+			break;
+		case CShaderBuilder::STATEMENT_OP_SWITCH_CASE:
+			assert(!switchSelectorTypes.empty());
+			if(caseHasBody) result += "\tbreak;\r\n";
+			if(switchSelectorTypes.back() == CShaderBuilder::SYMBOL_TYPE_UINT4)
+			{
+				result += string_format("\tcase %uu:\r\n", statement.param);
+			}
+			else
+			{
+				result += string_format("\tcase %d:\r\n", static_cast<int32>(statement.param));
+			}
+			caseHasBody = false;
+			break;
+		case CShaderBuilder::STATEMENT_OP_SWITCH_DEFAULT:
+			if(caseHasBody) result += "\tbreak;\r\n";
+			result += "\tdefault:\r\n";
+			caseHasBody = false;
+			break;
+		case CShaderBuilder::STATEMENT_OP_SWITCH_END:
+			assert(!switchSelectorTypes.empty());
+			result += "\tbreak;\r\n";
+			result += "\t}\r\n";
+			switchSelectorTypes.pop_back();
+			break;
+		case CShaderBuilder::STATEMENT_OP_LOOP_BEGIN:
+			if(dstRef.symbol.location != CShaderBuilder::SYMBOL_LOCATION_NULL)
+			{
+				auto indexString = PrintSymbolRef(dstRef);
+				result += string_format("\tfor(%s = 0; %s < %s; %s++)\r\n",
+				                        indexString.c_str(), indexString.c_str(),
+				                        PrintSymbolRef(src1Ref).c_str(), indexString.c_str());
+			}
+			else
+			{
+				result += "\twhile(true)\r\n";
+			}
+			result += "\t{\r\n";
+			break;
+		case CShaderBuilder::STATEMENT_OP_LOOP_END:
+			result += "\t}\r\n";
+			break;
+		case CShaderBuilder::STATEMENT_OP_BREAK:
+			result += "\tbreak;\r\n";
+			break;
+		case CShaderBuilder::STATEMENT_OP_CONTINUE:
+			result += "\tcontinue;\r\n";
+			break;
+		case CShaderBuilder::STATEMENT_OP_SUBGROUP_BALLOT:
+			result += string_format("\t%s = subgroupBallot(%s);\r\n",
+			                        PrintSymbolRef(dstRef).c_str(),
+			                        PrintSymbolRef(src1Ref).c_str());
+			break;
+		case CShaderBuilder::STATEMENT_OP_SUBGROUP_BROADCAST:
+			result += string_format("\t%s = subgroupBroadcast(%s, %du);\r\n",
+			                        PrintSymbolRef(dstRef).c_str(),
+			                        PrintSymbolRef(src1Ref).c_str(),
+			                        statement.param);
+			break;
+		case CShaderBuilder::STATEMENT_OP_SUBGROUP_SHUFFLE:
+			result += string_format("\t%s = subgroupShuffle(%s, %s);\r\n",
+			                        PrintSymbolRef(dstRef).c_str(),
+			                        PrintSymbolRef(src1Ref).c_str(),
+			                        PrintSymbolRef(src2Ref).c_str());
+			break;
+		case CShaderBuilder::STATEMENT_OP_SUBGROUP_ADD:
+		case CShaderBuilder::STATEMENT_OP_SUBGROUP_MIN:
+		case CShaderBuilder::STATEMENT_OP_SUBGROUP_MAX:
+		case CShaderBuilder::STATEMENT_OP_SUBGROUP_AND:
+		case CShaderBuilder::STATEMENT_OP_SUBGROUP_OR:
+		{
+			const char* opName = "";
+			switch(statement.op)
+			{
+			case CShaderBuilder::STATEMENT_OP_SUBGROUP_ADD:
+				opName = "Add";
+				break;
+			case CShaderBuilder::STATEMENT_OP_SUBGROUP_MIN:
+				opName = "Min";
+				break;
+			case CShaderBuilder::STATEMENT_OP_SUBGROUP_MAX:
+				opName = "Max";
+				break;
+			case CShaderBuilder::STATEMENT_OP_SUBGROUP_AND:
+				opName = "And";
+				break;
+			default:
+				opName = "Or";
+				break;
+			}
+			result += string_format("\t%s = subgroup%s%s(%s);\r\n",
+			                        PrintSymbolRef(dstRef).c_str(),
+			                        GetSubgroupOperationPrefix(static_cast<SUBGROUP_OPERATION>(statement.param)),
+			                        opName,
+			                        PrintSymbolRef(src1Ref).c_str());
+		}
+		break;
+		case CShaderBuilder::STATEMENT_OP_WORKGROUP_BARRIER:
+			result += "\tbarrier();\r\n";
+			break;
+		case CShaderBuilder::STATEMENT_OP_DEVICE_MEMORY_BARRIER:
+			result += "\tmemoryBarrier();\r\n";
+			break;
 		case CShaderBuilder::STATEMENT_OP_RETURN:
-			result += "\treturn;\r\n";
+			if(src1Ref.symbol.location != CShaderBuilder::SYMBOL_LOCATION_NULL)
+			{
+				result += string_format("\treturn %s;\r\n", PrintSymbolRef(src1Ref).c_str());
+			}
+			else
+			{
+				result += "\treturn;\r\n";
+			}
 			break;
+		case CShaderBuilder::STATEMENT_OP_CALL:
+		{
+			std::string args;
+			for(const auto* argRef : {&src1Ref, &src2Ref, &src3Ref, &src4Ref})
+			{
+				if(argRef->symbol.location == CShaderBuilder::SYMBOL_LOCATION_NULL) break;
+				if(!args.empty()) args += ", ";
+				args += PrintSymbolRef(*argRef);
+			}
+			if(dstRef.symbol.location != CShaderBuilder::SYMBOL_LOCATION_NULL)
+			{
+				result += string_format("\t%s = f%d(%s);\r\n",
+				                        PrintSymbolRef(dstRef).c_str(), statement.param, args.c_str());
+			}
+			else
+			{
+				result += string_format("\tf%d(%s);\r\n", statement.param, args.c_str());
+			}
+		}
+		break;
 		default:
 			assert(0);
 			break;
 		}
+		switch(statement.op)
+		{
+		case CShaderBuilder::STATEMENT_OP_SWITCH_BEGIN:
+		case CShaderBuilder::STATEMENT_OP_SWITCH_CASE:
+		case CShaderBuilder::STATEMENT_OP_SWITCH_DEFAULT:
+			break;
+		default:
+			caseHasBody = true;
+			break;
+		}
 	}
 
-	result += "}\r\n";
-
 	return result;
 }
 
@@ -339,8 +887,13 @@ std::string CGlslShaderGenerator::GenerateInputs() const
 		if(semantic.type == SEMANTIC_SYSTEM_POSITION) continue;
 		if(semantic.type == SEMANTIC_SYSTEM_COLOR) continue;
 		if(semantic.type == SEMANTIC_SYSTEM_GIID) continue;
-		result += string_format("%s %s %s;\r\n",
-		                        inputTag, MakeTypeName(symbol.type).c_str(),
+		if(semantic.type == SEMANTIC_SYSTEM_LIID) continue;
+		if(semantic.type == SEMANTIC_SYSTEM_LIINDEX) continue;
+		if(semantic.type == SEMANTIC_SYSTEM_WGID) continue;
+		if(semantic.type == SEMANTIC_SYSTEM_SUBGROUP_INVOCATION_ID) continue;
+		if(semantic.type == SEMANTIC_SYSTEM_SUBGROUP_SIZE) continue;
+		result += string_format("%s %s%s %s;\r\n",
+		                        inputTag, MakePrecisionQualifier(symbol).c_str(), MakeTypeName(symbol.type).c_str(),
 		                        MakeLocalSymbolName(symbol).c_str());
 	}
 	return result;
@@ -360,8 +913,18 @@ std::string CGlslShaderGenerator::GenerateOutputs() const
 		auto semantic = m_shaderBuilder.GetOutputSemantic(symbol);
 		if(semantic.type == SEMANTIC_SYSTEM_POSITION) continue;
 		if((semantic.type == SEMANTIC_SYSTEM_COLOR) && (m_glslVersion <= 420)) continue;
-		result += string_format("%s %s %s;\r\n",
-		                        inputTag, MakeTypeName(symbol.type).c_str(),
+		if(semantic.type == SEMANTIC_SYSTEM_DEPTH)
+		{
+			//gl_FragDepth only needs to be redeclared to specify a depth layout
+			auto depthLayout = GetDepthLayoutName(static_cast<DEPTH_MODE>(m_shaderBuilder.GetMetadata(CShaderBuilder::METADATA_DEPTH_MODE, DEPTH_MODE_ANY)));
+			if(depthLayout)
+			{
+				result += string_format("layout(%s) out float gl_FragDepth;\r\n", depthLayout);
+			}
+			continue;
+		}
+		result += string_format("%s %s%s %s;\r\n",
+		                        inputTag, MakePrecisionQualifier(symbol).c_str(), MakeTypeName(symbol.type).c_str(),
 		                        MakeLocalSymbolName(symbol).c_str());
 	}
 	return result;
@@ -370,21 +933,144 @@ std::string CGlslShaderGenerator::GenerateOutputs() const
 std::string CGlslShaderGenerator::GenerateUniforms() const
 {
 	std::string result;
+	bool hasBufferPointerUint = false;
+	bool hasBufferPointerFloat4 = false;
 	for(const auto& symbol : m_shaderBuilder.GetSymbols())
 	{
+		hasBufferPointerUint |= (symbol.type == CShaderBuilder::SYMBOL_TYPE_BUFFERPOINTERUINT);
+		hasBufferPointerFloat4 |= (symbol.type == CShaderBuilder::SYMBOL_TYPE_BUFFERPOINTERFLOAT4);
+	}
+	bool hasBufferPointer = hasBufferPointerUint || hasBufferPointerFloat4;
+	if(hasBufferPointerUint)
+	{
+		result += "layout(buffer_reference, std430, buffer_reference_align = 4) buffer BufferPointerUint\r\n";
+		result += "{\r\n\tuint data[];\r\n};\r\n";
+	}
+	if(hasBufferPointerFloat4)
+	{
+		result += "layout(buffer_reference, std430, buffer_reference_align = 16) buffer BufferPointerFloat4\r\n";
+		result += "{\r\n\tvec4 data[];\r\n};\r\n";
+	}
+	auto blockLayouts = UniformLayout::ComputeBlockLayouts(m_shaderBuilder);
+	//Bindings holding uniform blocks
+	std::set<CShaderBuilder::BINDING> blockBindings;
+	for(const auto& symbol : m_shaderBuilder.GetSymbols())
+	{
+		if(symbol.location == CShaderBuilder::SYMBOL_LOCATION_BUFFER_ELEMENT)
+		{
+			//Index of the selected array element
+			result += string_format("int b%d;\r\n", symbol.index);
+			continue;
+		}
 		if(symbol.location != CShaderBuilder::SYMBOL_LOCATION_UNIFORM) continue;
-		if(symbol.unit == UNIFORM_UNIT_PUSHCONSTANT)
+		if(symbol.unit == static_cast<uint32>(UNIFORM_UNIT_PUSHCONSTANT))
 		{
-			result += string_format("uniform %s %s;\r\n",
-			                        MakeTypeName(symbol.type).c_str(), MakeLocalSymbolName(symbol).c_str());
+			//Buffer pointers are only available on Vulkan, push constants then get a proper block
+			if(hasBufferPointer) continue;
+			result += string_format("uniform %s;\r\n", MakeUniformDeclaration(symbol).c_str());
+		}
+		else if(
+		    (symbol.type == CShaderBuilder::SYMBOL_TYPE_FLOAT4) ||
+		    (symbol.type == CShaderBuilder::SYMBOL_TYPE_INT4) ||
+		    (symbol.type == CShaderBuilder::SYMBOL_TYPE_MATRIX) ||
+		    (symbol.type == CShaderBuilder::SYMBOL_TYPE_ARRAYFLOAT4) ||
+		    (symbol.type == CShaderBuilder::SYMBOL_TYPE_ARRAYINT4) ||
+		    (symbol.type == CShaderBuilder::SYMBOL_TYPE_ARRAYMATRIX))
+		{
+			blockBindings.insert(CShaderBuilder::GetBinding(symbol));
 		}
 		else
 		{
-			assert(symbol.type == CShaderBuilder::SYMBOL_TYPE_ARRAYUINT);
-			result += string_format("layout(std430, binding = %d) buffer uniforms_%d\r\n",
-			                        symbol.unit, symbol.unit);
-			result += string_format("{\r\n\tuint %s[];\r\n};\r\n", MakeLocalSymbolName(symbol).c_str());
+			const char* elementTypeName = "";
+			switch(symbol.type)
+			{
+			case CShaderBuilder::SYMBOL_TYPE_ARRAYUINT:
+				elementTypeName = "uint";
+				break;
+			case CShaderBuilder::SYMBOL_TYPE_ARRAYUINT2:
+				elementTypeName = "uvec2";
+				break;
+			case CShaderBuilder::SYMBOL_TYPE_ARRAYUINT4:
+				elementTypeName = "uvec4";
+				break;
+			case CShaderBuilder::SYMBOL_TYPE_ARRAYUCHAR:
+				elementTypeName = "uint8_t";
+				break;
+			case CShaderBuilder::SYMBOL_TYPE_ARRAYUSHORT:
+				elementTypeName = "uint16_t";
+				break;
+			default:
+				assert(false);
+				break;
+			}
+			result += string_format("layout(%s, %sbinding = %d) buffer uniforms_%s\r\n",
+			                        UniformLayout::GetLayoutName(blockLayouts[CShaderBuilder::GetBinding(symbol)].layout),
+			                        MakeDescriptorSetQualifier(symbol).c_str(), symbol.unit, MakeBindingName(symbol).c_str());
+			if(m_shaderBuilder.IsBufferArray(symbol))
+			{
+				//Elements are accessed through the selected block's array
+				auto size = m_shaderBuilder.GetBufferArraySize(symbol);
+				auto arraySuffix = (size == 0) ? std::string("[]") : string_format("[%d]", size);
+				result += string_format("{\r\n\t%s data[];\r\n} %s%s;\r\n", elementTypeName,
+				                        MakeLocalSymbolName(symbol).c_str(), arraySuffix.c_str());
+				continue;
+			}
+			result += string_format("{\r\n\t%s %s[];\r\n};\r\n", elementTypeName, MakeLocalSymbolName(symbol).c_str());
+		}
+	}
+	for(const auto& binding : blockBindings)
+	{
+		//Members are declared in layout order so that the implicit offsets match the SPIR-V generator's
+		const auto& blockLayout = blockLayouts[binding];
+		const auto& firstMember = blockLayout.members[0].symbol;
+		result += string_format("layout(%s, %sbinding = %d) uniform uniformBlock_%s\r\n",
+		                        UniformLayout::GetLayoutName(blockLayout.layout),
+		                        MakeDescriptorSetQualifier(firstMember).c_str(), binding.second, MakeBindingName(firstMember).c_str());
+		result += "{\r\n";
+		for(const auto& member : blockLayout.members)
+		{
+			result += string_format("\t%s;\r\n", MakeUniformDeclaration(member.symbol).c_str());
+		}
+		result += "};\r\n";
+	}
+	if(hasBufferPointer)
+	{
+		const auto& blockLayout = blockLayouts[CShaderBuilder::BINDING(0, UNIFORM_UNIT_PUSHCONSTANT)];
+		result += string_format("layout(push_constant, %s) uniform pushConstants\r\n", UniformLayout::GetLayoutName(blockLayout.layout));
+		result += "{\r\n";
+		for(const auto& member : blockLayout.members)
+		{
+			result += string_format("\t%s;\r\n", MakeUniformDeclaration(member.symbol).c_str());
+		}
+		result += "};\r\n";
+	}
+	return result;
+}
+
+std::string CGlslShaderGenerator::GenerateSharedArrays() const
+{
+	std::string result;
+	for(const auto& symbol : m_shaderBuilder.GetSymbols())
+	{
+		if(symbol.location != CShaderBuilder::SYMBOL_LOCATION_SHARED) continue;
+		const char* elementType = nullptr;
+		switch(symbol.type)
+		{
+		default:
+			assert(false);
+			[[fallthrough]];
+		case CShaderBuilder::SYMBOL_TYPE_ARRAYUINT:
+			elementType = "uint";
+			break;
+		case CShaderBuilder::SYMBOL_TYPE_ARRAYUSHORT:
+			elementType = "uint16_t";
+			break;
+		case CShaderBuilder::SYMBOL_TYPE_ARRAYUCHAR:
+			elementType = "uint8_t";
+			break;
 		}
+		result += string_format("shared %s %s[%d];\r\n", elementType,
+		                        MakeLocalSymbolName(symbol).c_str(), m_shaderBuilder.GetSharedArraySize(symbol));
 	}
 	return result;
 }
@@ -395,12 +1081,69 @@ std::string CGlslShaderGenerator::GenerateSamplers() const
 	//Generate samplers/textures
 	for(const auto& symbol : m_shaderBuilder.GetSymbols())
 	{
+		if(symbol.location == CShaderBuilder::SYMBOL_LOCATION_TEXTURE_ELEMENT)
+		{
+			//Index of the selected array element
+			result += string_format("int e%d;\r\n", symbol.index);
+			continue;
+		}
 		if(symbol.location != CShaderBuilder::SYMBOL_LOCATION_TEXTURE) continue;
-		result += string_format("uniform sampler2D c_sampler%d;\r\n", symbol.index);
+		std::string arraySuffix;
+		if(m_shaderBuilder.IsTextureArray(symbol))
+		{
+			auto size = m_shaderBuilder.GetTextureArraySize(symbol);
+			arraySuffix = (size == 0) ? "[]" : string_format("[%d]", size);
+		}
+		//Samplers are only given a binding when they are not in the default set
+		std::string setLayout;
+		if(symbol.set != 0)
+		{
+			setLayout = string_format("layout(%sbinding = %d) ", MakeDescriptorSetQualifier(symbol).c_str(), symbol.unit);
+		}
+		switch(symbol.type)
+		{
+		case CShaderBuilder::SYMBOL_TYPE_UNIFORMTEXELBUFFER:
+			result += string_format("%suniform samplerBuffer c_sampler%s;\r\n", setLayout.c_str(), MakeBindingName(symbol).c_str());
+			break;
+		case CShaderBuilder::SYMBOL_TYPE_STORAGETEXELBUFFERUINT:
+			result += string_format("layout(%sbinding = %d, r32ui) uniform uimageBuffer c_image%s;\r\n",
+			                        MakeDescriptorSetQualifier(symbol).c_str(), symbol.unit, MakeBindingName(symbol).c_str());
+			break;
+		case CShaderBuilder::SYMBOL_TYPE_IMAGE2D:
+		case CShaderBuilder::SYMBOL_TYPE_IMAGE2DARRAY:
+		case CShaderBuilder::SYMBOL_TYPE_IMAGE3D:
+		case CShaderBuilder::SYMBOL_TYPE_IMAGE2DUINT:
+		case CShaderBuilder::SYMBOL_TYPE_IMAGE2DARRAYUINT:
+		case CShaderBuilder::SYMBOL_TYPE_IMAGE3DUINT:
+			result += string_format("layout(%sbinding = %d, %s) uniform %s c_image%s%s;\r\n",
+			                        MakeDescriptorSetQualifier(symbol).c_str(), symbol.unit,
+			                        GetImageFormatName(m_shaderBuilder.GetImageFormat(symbol)), GetImageTypeName(symbol.type),
+			                        MakeBindingName(symbol).c_str(), arraySuffix.c_str());
+			break;
+		default:
+			result += string_format("%suniform sampler2D c_sampler%s%s;\r\n", setLayout.c_str(), MakeBindingName(symbol).c_str(), arraySuffix.c_str());
+			break;
+		}
 	}
 	return result;
 }
 
+std::string CGlslShaderGenerator::MakeTextureName(const CShaderBuilder::SYMBOL& sym) const
+{
+	bool isImage = (sym.type == CShaderBuilder::SYMBOL_TYPE_STORAGETEXELBUFFERUINT) || CShaderBuilder::IsImageType(sym.type);
+	auto name = (isImage ? "c_image" : "c_sampler") + MakeBindingName(sym);
+	if(sym.location == CShaderBuilder::SYMBOL_LOCATION_TEXTURE_ELEMENT)
+	{
+		if(sym.attributes & SYMBOL_ATTRIBUTE_NONUNIFORM)
+		{
+			return name + string_format("[nonuniformEXT(e%d)]", sym.index);
+		}
+		return name + string_format("[e%d]", sym.index);
+	}
+	assert(sym.location == CShaderBuilder::SYMBOL_LOCATION_TEXTURE);
+	return name;
+}
+
 std::string CGlslShaderGenerator::MakeSymbolName(const CShaderBuilder::SYMBOL& sym) const
 {
 	switch(sym.location)
@@ -409,6 +1152,32 @@ std::string CGlslShaderGenerator::MakeSymbolName(const CShaderBuilder::SYMBOL& s
 		return string_format("t%d", sym.index);
 		break;
 	case CShaderBuilder::SYMBOL_LOCATION_UNIFORM:
+		if(sym.type == CShaderBuilder::SYMBOL_TYPE_FLOAT4)
+		{
+			//Float uniforms with less than 4 components are expanded to a vec4
+			switch(m_shaderBuilder.GetUniformComponentCount(sym))
+			{
+			case 1:
+				return string_format("vec4(%s, 0.0, 0.0, 0.0)", MakeLocalSymbolName(sym).c_str());
+			case 2:
+				return string_format("vec4(%s, 0.0, 0.0)", MakeLocalSymbolName(sym).c_str());
+			default:
+				break;
+			}
+		}
+		return MakeLocalSymbolName(sym);
+		break;
+	case CShaderBuilder::SYMBOL_LOCATION_BUFFER_ELEMENT:
+	{
+		auto name = MakeLocalSymbolName(m_shaderBuilder.GetBufferArray(sym));
+		if(sym.attributes & SYMBOL_ATTRIBUTE_NONUNIFORM)
+		{
+			return name + string_format("[nonuniformEXT(b%d)].data", sym.index);
+		}
+		return name + string_format("[b%d].data", sym.index);
+	}
+	break;
+	case CShaderBuilder::SYMBOL_LOCATION_SHARED:
 	case CShaderBuilder::SYMBOL_LOCATION_INPUT:
 	case CShaderBuilder::SYMBOL_LOCATION_OUTPUT:
 	case CShaderBuilder::SYMBOL_LOCATION_VARIABLE:
@@ -432,6 +1201,26 @@ std::string CGlslShaderGenerator::MakeLocalSymbolName(const CShaderBuilder::SYMB
 		{
 			return "ivec3(gl_GlobalInvocationID)";
 		}
+		else if(semantic.type == SEMANTIC_SYSTEM_LIID)
+		{
+			return "ivec3(gl_LocalInvocationID)";
+		}
+		else if(semantic.type == SEMANTIC_SYSTEM_LIINDEX)
+		{
+			return "ivec4(gl_LocalInvocationIndex)";
+		}
+		else if(semantic.type == SEMANTIC_SYSTEM_WGID)
+		{
+			return "ivec3(gl_WorkGroupID)";
+		}
+		else if(semantic.type == SEMANTIC_SYSTEM_SUBGROUP_INVOCATION_ID)
+		{
+			return "ivec4(gl_SubgroupInvocationID)";
+		}
+		else if(semantic.type == SEMANTIC_SYSTEM_SUBGROUP_SIZE)
+		{
+			return "ivec4(gl_SubgroupSize)";
+		}
 		else if(semantic.type == SEMANTIC_SYSTEM_POSITION)
 		{
 			return "gl_FragCoord";
@@ -454,6 +1243,10 @@ std::string CGlslShaderGenerator::MakeLocalSymbolName(const CShaderBuilder::SYMB
 		{
 			return "gl_FragColor";
 		}
+		else if(semantic.type == SEMANTIC_SYSTEM_DEPTH)
+		{
+			return "gl_FragDepth";
+		}
 		else
 		{
 			const char* prefix = (m_shaderType == SHADER_TYPE_VERTEX) ? "v" : "o";
@@ -462,9 +1255,16 @@ std::string CGlslShaderGenerator::MakeLocalSymbolName(const CShaderBuilder::SYMB
 	}
 	break;
 	case CShaderBuilder::SYMBOL_LOCATION_UNIFORM:
+		if(CShaderBuilder::IsBufferPointerType(sym.type))
+		{
+			//Elements are accessed through the referenced block's array
+			return m_shaderBuilder.GetUniformName(sym) + ".data";
+		}
 		return m_shaderBuilder.GetUniformName(sym);
 	case CShaderBuilder::SYMBOL_LOCATION_VARIABLE:
 		return m_shaderBuilder.GetVariableName(sym);
+	case CShaderBuilder::SYMBOL_LOCATION_SHARED:
+		return string_format("s%d", sym.index);
 	default:
 		assert(false);
 		return "unknown";
@@ -487,18 +1287,174 @@ std::string CGlslShaderGenerator::MakeSemanticName(CShaderBuilder::SEMANTIC_INFO
 	}
 }
 
-std::string CGlslShaderGenerator::MakeTypeName(CShaderBuilder::SYMBOL_TYPE type)
+std::string CGlslShaderGenerator::MakePrecisionQualifier(const CShaderBuilder::SYMBOL& symbol) const
+{
+	//Precision qualifiers are not allowed on booleans
+	if(symbol.type == CShaderBuilder::SYMBOL_TYPE_BOOL4) return std::string();
+	if((symbol.type == CShaderBuilder::SYMBOL_TYPE_HALF4) && !(m_flags & FLAG_NATIVE_FLOAT16))
+	{
+		return "mediump ";
+	}
+	auto precision = m_shaderBuilder.GetPrecision(symbol);
+	if(precision == PRECISION_DEFAULT) return std::string();
+	return std::string(GetPrecisionName(precision)) + " ";
+}
+
+const char* CGlslShaderGenerator::GetPrecisionName(PRECISION precision)
+{
+	switch(precision)
+	{
+	default:
+		assert(false);
+		[[fallthrough]];
+	case PRECISION_HIGH:
+		return "highp";
+	case PRECISION_MEDIUM:
+		return "mediump";
+	case PRECISION_LOW:
+		return "lowp";
+	}
+}
+
+const char* CGlslShaderGenerator::GetDepthLayoutName(DEPTH_MODE depthMode)
+{
+	switch(depthMode)
+	{
+	default:
+		assert(false);
+		[[fallthrough]];
+	case DEPTH_MODE_ANY:
+		return nullptr;
+	case DEPTH_MODE_GREATER:
+		return "depth_greater";
+	case DEPTH_MODE_LESS:
+		return "depth_less";
+	case DEPTH_MODE_UNCHANGED:
+		return "depth_unchanged";
+	}
+}
+
+const char* CGlslShaderGenerator::GetSubgroupOperationPrefix(SUBGROUP_OPERATION operation)
+{
+	switch(operation)
+	{
+	default:
+		assert(false);
+		[[fallthrough]];
+	case SUBGROUP_OPERATION_REDUCE:
+		return "";
+	case SUBGROUP_OPERATION_INCLUSIVE_SCAN:
+		return "Inclusive";
+	case SUBGROUP_OPERATION_EXCLUSIVE_SCAN:
+		return "Exclusive";
+	}
+}
+
+const char* CGlslShaderGenerator::GetImageTypeName(CShaderBuilder::SYMBOL_TYPE type)
+{
+	switch(type)
+	{
+	default:
+		assert(false);
+		[[fallthrough]];
+	case CShaderBuilder::SYMBOL_TYPE_IMAGE2D:
+		return "image2D";
+	case CShaderBuilder::SYMBOL_TYPE_IMAGE2DARRAY:
+		return "image2DArray";
+	case CShaderBuilder::SYMBOL_TYPE_IMAGE3D:
+		return "image3D";
+	case CShaderBuilder::SYMBOL_TYPE_IMAGE2DUINT:
+		return "uimage2D";
+	case CShaderBuilder::SYMBOL_TYPE_IMAGE2DARRAYUINT:
+		return "uimage2DArray";
+	case CShaderBuilder::SYMBOL_TYPE_IMAGE3DUINT:
+		return "uimage3D";
+	}
+}
+
+const char* CGlslShaderGenerator::GetImageFormatName(IMAGE_FORMAT format)
+{
+	switch(format)
+	{
+	default:
+		assert(false);
+		[[fallthrough]];
+	case IMAGE_FORMAT_R32UI:
+		return "r32ui";
+	case IMAGE_FORMAT_RGBA8:
+		return "rgba8";
+	case IMAGE_FORMAT_RGBA8UI:
+		return "rgba8ui";
+	case IMAGE_FORMAT_R16UI:
+		return "r16ui";
+	case IMAGE_FORMAT_R8UI:
+		return "r8ui";
+	case IMAGE_FORMAT_RGBA16F:
+		return "rgba16f";
+	case IMAGE_FORMAT_R32F:
+		return "r32f";
+	}
+}
+
+std::string CGlslShaderGenerator::MakeUniformDeclaration(const CShaderBuilder::SYMBOL& symbol) const
+{
+	auto name = MakeLocalSymbolName(symbol);
+	switch(symbol.type)
+	{
+	case CShaderBuilder::SYMBOL_TYPE_ARRAYFLOAT4:
+		return string_format("vec4 %s[%d]", name.c_str(), m_shaderBuilder.GetUniformArraySize(symbol));
+	case CShaderBuilder::SYMBOL_TYPE_ARRAYINT4:
+		return string_format("ivec4 %s[%d]", name.c_str(), m_shaderBuilder.GetUniformArraySize(symbol));
+	case CShaderBuilder::SYMBOL_TYPE_ARRAYMATRIX:
+		return string_format("mat4 %s[%d]", name.c_str(), m_shaderBuilder.GetUniformArraySize(symbol));
+	case CShaderBuilder::SYMBOL_TYPE_BUFFERPOINTERUINT:
+		return "BufferPointerUint " + m_shaderBuilder.GetUniformName(symbol);
+	case CShaderBuilder::SYMBOL_TYPE_BUFFERPOINTERFLOAT4:
+		return "BufferPointerFloat4 " + m_shaderBuilder.GetUniformName(symbol);
+	case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
+	{
+		static const char* floatTypeNames[4] = {"float", "vec2", "vec3", "vec4"};
+		auto componentCount = m_shaderBuilder.GetUniformComponentCount(symbol);
+		assert((componentCount >= 1) && (componentCount <= 4));
+		return string_format("%s %s", floatTypeNames[componentCount - 1], name.c_str());
+	}
+	default:
+		return MakeTypeName(symbol.type) + " " + name;
+	}
+}
+
+std::string CGlslShaderGenerator::MakeDescriptorSetQualifier(const CShaderBuilder::SYMBOL& sym)
+{
+	//The default set is left implicit to keep the output compatible with non Vulkan targets
+	if(sym.set == 0) return std::string();
+	return string_format("set = %d, ", sym.set);
+}
+
+std::string CGlslShaderGenerator::MakeBindingName(const CShaderBuilder::SYMBOL& sym)
+{
+	//Units can be reused in other sets, names then also include the set
+	if(sym.set == 0) return string_format("%d", sym.unit);
+	return string_format("%d_%d", sym.set, sym.unit);
+}
+
+std::string CGlslShaderGenerator::MakeTypeName(CShaderBuilder::SYMBOL_TYPE type) const
 {
 	switch(type)
 	{
 	case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
 		return "vec4";
+	case CShaderBuilder::SYMBOL_TYPE_HALF4:
+		return (m_flags & FLAG_NATIVE_FLOAT16) ? "f16vec4" : "vec4";
 	case CShaderBuilder::SYMBOL_TYPE_INT4:
 		return "ivec4";
 	case CShaderBuilder::SYMBOL_TYPE_UINT4:
 		return "uvec4";
 	case CShaderBuilder::SYMBOL_TYPE_BOOL4:
 		return "bvec4";
+	case CShaderBuilder::SYMBOL_TYPE_USHORT4:
+		return "u16vec4";
+	case CShaderBuilder::SYMBOL_TYPE_UCHAR4:
+		return "u8vec4";
 	case CShaderBuilder::SYMBOL_TYPE_MATRIX:
 		return "mat4";
 	case CShaderBuilder::SYMBOL_TYPE_TEXTURE2D:
@@ -516,6 +1472,14 @@ std::string CGlslShaderGenerator::PrintSymbolRef(const CShaderBuilder::SYMBOLREF
 	{
 		return symbolName;
 	}
+	if(
+	    (ref.symbol.location == CShaderBuilder::SYMBOL_LOCATION_OUTPUT) &&
+	    (m_shaderBuilder.GetOutputSemantic(ref.symbol).type == SEMANTIC_SYSTEM_DEPTH))
+	{
+		//Depth is a scalar
+		assert(ref.swizzle == SWIZZLE_X);
+		return symbolName;
+	}
 	static const char elemChars[4] = {'x', 'y', 'z', 'w'};
 	std::string result = symbolName + ".";
 	auto elemCount = GetSwizzleElementCount(ref.swizzle);
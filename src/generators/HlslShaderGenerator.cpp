@@ -1,5 +1,6 @@
 #include "nuanceur/generators/HlslShaderGenerator.h"
 #include "string_format.h"
+#include <set>
 
 using namespace Nuanceur;
 
@@ -23,6 +24,8 @@ std::string CHlslShaderGenerator::Generate(const std::string& methodName) const
 	result += GenerateOutputStruct();
 	result += GenerateConstants();
 	result += GenerateSamplers();
+	result += GenerateBuffers();
+	result += GenerateFunctions();
 
 	result += string_format("OUTPUT %s(INPUT input)\r\n", methodName.c_str());
 	result += "{\r\n";
@@ -32,13 +35,120 @@ std::string CHlslShaderGenerator::Generate(const std::string& methodName) const
 	for(const auto& symbol : m_shaderBuilder.GetSymbols())
 	{
 		if(symbol.location != CShaderBuilder::SYMBOL_LOCATION_TEMPORARY) continue;
+		result += GenerateTemporary(symbol);
+	}
+
+	result += GenerateStatements(m_shaderBuilder.GetStatements(), true);
+
+	result += "\treturn output;\r\n";
+	result += "}\r\n";
+	return result;
+}
+
+std::string CHlslShaderGenerator::GenerateFunctions() const
+{
+	std::string result;
+	const auto& functions = m_shaderBuilder.GetFunctions();
+	for(uint32 functionIndex = 0; functionIndex < functions.size(); functionIndex++)
+	{
+		const auto& function = functions[functionIndex];
+		std::string params;
+		std::set<uint32> paramIndices;
+		for(const auto& parameter : function.parameters)
+		{
+			if(!params.empty()) params += ", ";
+			params += string_format("%s %s", MakeTypeName(parameter.type).c_str(), MakeSymbolName(parameter).c_str());
+			paramIndices.insert(parameter.index);
+		}
+		auto returnTypeName = (function.returnType == CShaderBuilder::SYMBOL_TYPE_NULL) ? std::string("void") : MakeTypeName(function.returnType);
+		result += string_format("%s f%d(%s)\r\n", returnTypeName.c_str(), functionIndex, params.c_str());
+		result += "{\r\n";
+
+		std::set<uint32> tempIndices;
+		for(const auto& statement : function.statements)
+		{
+			for(const auto* ref : {&statement.dstRef, &statement.src1Ref, &statement.src2Ref, &statement.src3Ref, &statement.src4Ref})
+			{
+				if(ref->symbol.location != CShaderBuilder::SYMBOL_LOCATION_TEMPORARY) continue;
+				if(paramIndices.count(ref->symbol.index)) continue;
+				tempIndices.insert(ref->symbol.index);
+			}
+		}
+		for(const auto& symbol : m_shaderBuilder.GetSymbols())
+		{
+			if(symbol.location != CShaderBuilder::SYMBOL_LOCATION_TEMPORARY) continue;
+			if(!tempIndices.count(symbol.index)) continue;
+			result += GenerateTemporary(symbol);
+		}
+
+		result += GenerateStatements(function.statements, false);
+		result += "}\r\n";
+	}
+	return result;
+}
+
+std::string CHlslShaderGenerator::GenerateTemporary(const CShaderBuilder::SYMBOL& symbol) const
+{
+	std::string result;
+	switch(symbol.type)
+	{
+	default:
+		assert(false);
+		[[fallthrough]];
+	case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
+	{
 		auto temporaryValue = m_shaderBuilder.GetTemporaryValue(symbol);
-		result += string_format("\tfloat4 %s = float4(%f, %f, %f, %f);\r\n",
+		result = string_format("\tfloat4 %s = float4(%f, %f, %f, %f);\r\n",
 		                        MakeSymbolName(symbol).c_str(),
 		                        temporaryValue.x, temporaryValue.y, temporaryValue.z, temporaryValue.w);
 	}
+	break;
+	case CShaderBuilder::SYMBOL_TYPE_HALF4:
+	{
+		auto temporaryValue = m_shaderBuilder.GetTemporaryValue(symbol);
+		auto typeName = MakeTypeName(symbol.type);
+		result = string_format("\t%s %s = %s(%f, %f, %f, %f);\r\n",
+		                        typeName.c_str(), MakeSymbolName(symbol).c_str(), typeName.c_str(),
+		                        temporaryValue.x, temporaryValue.y, temporaryValue.z, temporaryValue.w);
+	}
+	break;
+	case CShaderBuilder::SYMBOL_TYPE_INT4:
+	{
+		auto temporaryValue = m_shaderBuilder.GetTemporaryValueInt(symbol);
+		result = string_format("\tint4 %s = int4(%d, %d, %d, %d);\r\n",
+		                        MakeSymbolName(symbol).c_str(),
+		                        temporaryValue.x, temporaryValue.y, temporaryValue.z, temporaryValue.w);
+	}
+	break;
+	case CShaderBuilder::SYMBOL_TYPE_UINT4:
+	{
+		auto temporaryValue = m_shaderBuilder.GetTemporaryValueInt(symbol);
+		result = string_format("\tuint4 %s = uint4(%u, %u, %u, %u);\r\n",
+		                        MakeSymbolName(symbol).c_str(),
+		                        temporaryValue.x, temporaryValue.y, temporaryValue.z, temporaryValue.w);
+	}
+	break;
+	case CShaderBuilder::SYMBOL_TYPE_BOOL4:
+	{
+		auto temporaryValue = m_shaderBuilder.GetTemporaryValueBool(symbol);
+		result = string_format("\tbool4 %s = bool4(%u, %u, %u, %u);\r\n",
+		                        MakeSymbolName(symbol).c_str(),
+		                        temporaryValue.x, temporaryValue.y, temporaryValue.z, temporaryValue.w);
+	}
+	break;
+	}
+	return result;
+}
+
+std::string CHlslShaderGenerator::GenerateStatements(const CShaderBuilder::StatementList& statements, bool isEntryPoint) const
+{
+	std::string result;
 
-	for(const auto& statement : m_shaderBuilder.GetStatements())
+	//Tracks whether a break is needed before the next case label
+	std::vector<CShaderBuilder::SYMBOL_TYPE> switchSelectorTypes;
+	bool caseHasBody = false;
+
+	for(const auto& statement : statements)
 	{
 		const auto& dstRef = statement.dstRef;
 		const auto& src1Ref = statement.src1Ref;
@@ -60,7 +170,15 @@ std::string CHlslShaderGenerator::Generate(const std::string& methodName) const
 			                        PrintSymbolRef(src2Ref).c_str());
 			break;
 		case CShaderBuilder::STATEMENT_OP_MULTIPLY:
-			if(
+			if(src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_ARRAYMATRIX)
+			{
+				result += string_format("\t%s = mul(%s[%s], %s);\r\n",
+				                        PrintSymbolRef(dstRef).c_str(),
+				                        MakeSymbolName(src1Ref.symbol).c_str(),
+				                        PrintSymbolRef(src3Ref).c_str(),
+				                        PrintSymbolRef(src2Ref).c_str());
+			}
+			else if(
 			    (src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_MATRIX) ||
 			    (src2Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_MATRIX))
 			{
@@ -102,11 +220,25 @@ std::string CHlslShaderGenerator::Generate(const std::string& methodName) const
 			                        PrintSymbolRef(src2Ref).c_str());
 			break;
 		case CShaderBuilder::STATEMENT_OP_MIX:
-			result += string_format("\t%s = lerp(%s, %s, %s);\r\n",
-			                        PrintSymbolRef(dstRef).c_str(),
-			                        PrintSymbolRef(src1Ref).c_str(),
-			                        PrintSymbolRef(src2Ref).c_str(),
-			                        PrintSymbolRef(src3Ref).c_str());
+			if(src3Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_BOOL4)
+			{
+				//Component-wise select, lerp only works with a float selector
+				//HLSL 2021 doesn't allow vector operands for ?: anymore
+				const char* format = (m_flags & FLAG_HLSL_2021) ? "\t%s = select(%s, %s, %s);\r\n" : "\t%s = %s ? %s : %s;\r\n";
+				result += string_format(format,
+				                        PrintSymbolRef(dstRef).c_str(),
+				                        PrintSymbolRef(src3Ref).c_str(),
+				                        PrintSymbolRef(src2Ref).c_str(),
+				                        PrintSymbolRef(src1Ref).c_str());
+			}
+			else
+			{
+				result += string_format("\t%s = lerp(%s, %s, %s);\r\n",
+				                        PrintSymbolRef(dstRef).c_str(),
+				                        PrintSymbolRef(src1Ref).c_str(),
+				                        PrintSymbolRef(src2Ref).c_str(),
+				                        PrintSymbolRef(src3Ref).c_str());
+			}
 			break;
 		case CShaderBuilder::STATEMENT_OP_NEWVECTOR2:
 			result += string_format("\t%s = float2(%s, %s);\r\n",
@@ -141,6 +273,11 @@ std::string CHlslShaderGenerator::Generate(const std::string& methodName) const
 			}
 			break;
 		case CShaderBuilder::STATEMENT_OP_ASSIGN:
+		case CShaderBuilder::STATEMENT_OP_TOFLOAT:
+		case CShaderBuilder::STATEMENT_OP_TOHALF:
+		case CShaderBuilder::STATEMENT_OP_TOINT:
+		case CShaderBuilder::STATEMENT_OP_TOUINT:
+			//Conversions between numeric types are implicit
 			result += string_format("\t%s = %s;\r\n",
 			                        PrintSymbolRef(dstRef).c_str(),
 			                        PrintSymbolRef(src1Ref).c_str());
@@ -172,31 +309,333 @@ std::string CHlslShaderGenerator::Generate(const std::string& methodName) const
 			                        PrintSymbolRef(dstRef).c_str(),
 			                        PrintSymbolRef(src1Ref).c_str());
 			break;
+		case CShaderBuilder::STATEMENT_OP_COMPARE_EQ:
+			result += string_format("\t%s = %s == %s;\r\n",
+			                        PrintSymbolRef(dstRef).c_str(),
+			                        PrintSymbolRef(src1Ref).c_str(),
+			                        PrintSymbolRef(src2Ref).c_str());
+			break;
+		case CShaderBuilder::STATEMENT_OP_COMPARE_NE:
+			result += string_format("\t%s = %s != %s;\r\n",
+			                        PrintSymbolRef(dstRef).c_str(),
+			                        PrintSymbolRef(src1Ref).c_str(),
+			                        PrintSymbolRef(src2Ref).c_str());
+			break;
+		case CShaderBuilder::STATEMENT_OP_COMPARE_LT:
+			result += string_format("\t%s = %s < %s;\r\n",
+			                        PrintSymbolRef(dstRef).c_str(),
+			                        PrintSymbolRef(src1Ref).c_str(),
+			                        PrintSymbolRef(src2Ref).c_str());
+			break;
+		case CShaderBuilder::STATEMENT_OP_COMPARE_LE:
+			result += string_format("\t%s = %s <= %s;\r\n",
+			                        PrintSymbolRef(dstRef).c_str(),
+			                        PrintSymbolRef(src1Ref).c_str(),
+			                        PrintSymbolRef(src2Ref).c_str());
+			break;
+		case CShaderBuilder::STATEMENT_OP_COMPARE_GT:
+			result += string_format("\t%s = %s > %s;\r\n",
+			                        PrintSymbolRef(dstRef).c_str(),
+			                        PrintSymbolRef(src1Ref).c_str(),
+			                        PrintSymbolRef(src2Ref).c_str());
+			break;
+		case CShaderBuilder::STATEMENT_OP_COMPARE_GE:
+			result += string_format("\t%s = %s >= %s;\r\n",
+			                        PrintSymbolRef(dstRef).c_str(),
+			                        PrintSymbolRef(src1Ref).c_str(),
+			                        PrintSymbolRef(src2Ref).c_str());
+			break;
+		case CShaderBuilder::STATEMENT_OP_LOGICAL_NOT:
+			result += string_format("\t%s = !%s;\r\n",
+			                        PrintSymbolRef(dstRef).c_str(),
+			                        PrintSymbolRef(src1Ref).c_str());
+			break;
 		case CShaderBuilder::STATEMENT_OP_SAMPLE:
 			if(m_flags & FLAG_COMBINED_SAMPLER_TEXTURE)
 			{
 				assert(src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_TEXTURE2D);
-				result += string_format("\t%s = tex2D(c_sampler%d, %s);\r\n",
+				result += string_format("\t%s = tex2D(c_sampler%s, %s);\r\n",
 				                        PrintSymbolRef(dstRef).c_str(),
-				                        src1Ref.symbol.unit,
+				                        MakeBindingName(src1Ref.symbol).c_str(),
 				                        PrintSymbolRef(src2Ref).c_str());
 			}
 			else
 			{
-				result += string_format("\t%s = c_texture%d.Sample(c_sampler%d, %s);\r\n",
+				result += string_format("\t%s = %s.Sample(c_sampler%s, %s);\r\n",
 				                        PrintSymbolRef(dstRef).c_str(),
-				                        src1Ref.symbol.unit, src1Ref.symbol.unit,
+				                        MakeTextureName(src1Ref.symbol).c_str(), MakeBindingName(src1Ref.symbol).c_str(),
 				                        PrintSymbolRef(src2Ref).c_str());
 			}
 			break;
+		case CShaderBuilder::STATEMENT_OP_SAMPLE_LOD:
+			if(m_flags & FLAG_COMBINED_SAMPLER_TEXTURE)
+			{
+				result += string_format("\t%s = tex2Dlod(c_sampler%s, float4(%s, 0, %s));\r\n",
+				                        PrintSymbolRef(dstRef).c_str(),
+				                        MakeBindingName(src1Ref.symbol).c_str(),
+				                        PrintSymbolRef(src2Ref).c_str(),
+				                        PrintSymbolRef(src3Ref).c_str());
+			}
+			else
+			{
+				result += string_format("\t%s = %s.SampleLevel(c_sampler%s, %s, %s);\r\n",
+				                        PrintSymbolRef(dstRef).c_str(),
+				                        MakeTextureName(src1Ref.symbol).c_str(), MakeBindingName(src1Ref.symbol).c_str(),
+				                        PrintSymbolRef(src2Ref).c_str(),
+				                        PrintSymbolRef(src3Ref).c_str());
+			}
+			break;
+		case CShaderBuilder::STATEMENT_OP_SAMPLE_GRAD:
+			if(m_flags & FLAG_COMBINED_SAMPLER_TEXTURE)
+			{
+				result += string_format("\t%s = tex2Dgrad(c_sampler%s, %s, %s, %s);\r\n",
+				                        PrintSymbolRef(dstRef).c_str(),
+				                        MakeBindingName(src1Ref.symbol).c_str(),
+				                        PrintSymbolRef(src2Ref).c_str(),
+				                        PrintSymbolRef(src3Ref).c_str(),
+				                        PrintSymbolRef(src4Ref).c_str());
+			}
+			else
+			{
+				result += string_format("\t%s = %s.SampleGrad(c_sampler%s, %s, %s, %s);\r\n",
+				                        PrintSymbolRef(dstRef).c_str(),
+				                        MakeTextureName(src1Ref.symbol).c_str(), MakeBindingName(src1Ref.symbol).c_str(),
+				                        PrintSymbolRef(src2Ref).c_str(),
+				                        PrintSymbolRef(src3Ref).c_str(),
+				                        PrintSymbolRef(src4Ref).c_str());
+			}
+			break;
+		case CShaderBuilder::STATEMENT_OP_SAMPLE_OFFSET:
+			//Not available with combined samplers
+			assert(!(m_flags & FLAG_COMBINED_SAMPLER_TEXTURE));
+			result += string_format("\t%s = %s.Sample(c_sampler%s, %s, int2(%d, %d));\r\n",
+			                        PrintSymbolRef(dstRef).c_str(),
+			                        MakeTextureName(src1Ref.symbol).c_str(), MakeBindingName(src1Ref.symbol).c_str(),
+			                        PrintSymbolRef(src2Ref).c_str(),
+			                        static_cast<int16>(statement.param & 0xFFFF),
+			                        static_cast<int16>(statement.param >> 16));
+			break;
+		case CShaderBuilder::STATEMENT_OP_LOAD:
+			//Only uniform arrays and uint storage buffers are supported by this generator
+			assert(
+			    (src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_ARRAYFLOAT4) ||
+			    (src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_ARRAYINT4) ||
+			    (src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_ARRAYUINT));
+			result += string_format("\t%s = %s[%s];\r\n",
+			                        PrintSymbolRef(dstRef).c_str(),
+			                        MakeSymbolName(src1Ref.symbol).c_str(),
+			                        PrintSymbolRef(src2Ref).c_str());
+			break;
+		case CShaderBuilder::STATEMENT_OP_STORE:
+			assert(src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_ARRAYUINT);
+			result += string_format("\t%s[%s] = %s;\r\n",
+			                        MakeSymbolName(src1Ref.symbol).c_str(),
+			                        PrintSymbolRef(src2Ref).c_str(),
+			                        PrintSymbolRef(src3Ref).c_str());
+			break;
+		case CShaderBuilder::STATEMENT_OP_ATOMICAND:
+		case CShaderBuilder::STATEMENT_OP_ATOMICOR:
+		case CShaderBuilder::STATEMENT_OP_ATOMICXOR:
+		case CShaderBuilder::STATEMENT_OP_ATOMICADD:
+		case CShaderBuilder::STATEMENT_OP_ATOMICMIN:
+		case CShaderBuilder::STATEMENT_OP_ATOMICMAX:
+		case CShaderBuilder::STATEMENT_OP_ATOMICEXCHANGE:
+		{
+			//Interlocked functions don't have scope or memory order, they behave as relaxed device atomics
+			assert(src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_ARRAYUINT);
+			const char* functionName = "";
+			switch(statement.op)
+			{
+			case CShaderBuilder::STATEMENT_OP_ATOMICAND:
+				functionName = "InterlockedAnd";
+				break;
+			case CShaderBuilder::STATEMENT_OP_ATOMICOR:
+				functionName = "InterlockedOr";
+				break;
+			case CShaderBuilder::STATEMENT_OP_ATOMICXOR:
+				functionName = "InterlockedXor";
+				break;
+			case CShaderBuilder::STATEMENT_OP_ATOMICADD:
+				functionName = "InterlockedAdd";
+				break;
+			case CShaderBuilder::STATEMENT_OP_ATOMICMIN:
+				functionName = "InterlockedMin";
+				break;
+			case CShaderBuilder::STATEMENT_OP_ATOMICMAX:
+				functionName = "InterlockedMax";
+				break;
+			default:
+				functionName = "InterlockedExchange";
+				break;
+			}
+			result += string_format("\t%s(%s[%s], %s, %s);\r\n",
+			                        functionName,
+			                        MakeSymbolName(src1Ref.symbol).c_str(),
+			                        PrintSymbolRef(src2Ref).c_str(),
+			                        PrintSymbolRef(src3Ref).c_str(),
+			                        PrintSymbolRef(dstRef).c_str());
+		}
+		break;
+		case CShaderBuilder::STATEMENT_OP_ATOMICCOMPAREEXCHANGE:
+			assert(src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_ARRAYUINT);
+			result += string_format("\tInterlockedCompareExchange(%s[%s], %s, %s, %s);\r\n",
+			                        MakeSymbolName(src1Ref.symbol).c_str(),
+			                        PrintSymbolRef(src2Ref).c_str(),
+			                        PrintSymbolRef(src4Ref).c_str(),
+			                        PrintSymbolRef(src3Ref).c_str(),
+			                        PrintSymbolRef(dstRef).c_str());
+			break;
+		case CShaderBuilder::STATEMENT_OP_FETCH:
+			assert(!(m_flags & FLAG_COMBINED_SAMPLER_TEXTURE));
+			result += string_format("\t%s = %s.Load(int3(%s, %s));\r\n",
+			                        PrintSymbolRef(dstRef).c_str(),
+			                        MakeTextureName(src1Ref.symbol).c_str(),
+			                        PrintSymbolRef(src2Ref).c_str(),
+			                        PrintSymbolRef(src3Ref).c_str());
+			break;
+		case CShaderBuilder::STATEMENT_OP_GATHER:
+		{
+			assert(!(m_flags & FLAG_COMBINED_SAMPLER_TEXTURE));
+			static const char* gatherFunctions[4] = {"GatherRed", "GatherGreen", "GatherBlue", "GatherAlpha"};
+			assert(statement.param < 4);
+			result += string_format("\t%s = %s.%s(c_sampler%s, %s);\r\n",
+			                        PrintSymbolRef(dstRef).c_str(),
+			                        MakeTextureName(src1Ref.symbol).c_str(),
+			                        gatherFunctions[statement.param],
+			                        MakeBindingName(src1Ref.symbol).c_str(),
+			                        PrintSymbolRef(src2Ref).c_str());
+		}
+		break;
+		case CShaderBuilder::STATEMENT_OP_SELECT_TEXTURE:
+			//Descriptor arrays require separate textures and samplers
+			assert(!(m_flags & FLAG_COMBINED_SAMPLER_TEXTURE));
+			result += string_format("\te%d = %s;\r\n",
+			                        dstRef.symbol.index,
+			                        PrintSymbolRef(src2Ref).c_str());
+			break;
+		case CShaderBuilder::STATEMENT_OP_SELECT_BUFFER:
+			result += string_format("\tb%d = %s;\r\n",
+			                        dstRef.symbol.index,
+			                        PrintSymbolRef(src2Ref).c_str());
+			break;
+		case CShaderBuilder::STATEMENT_OP_IF_BEGIN:
+			result += PrintSelectionControl(statement.param);
+			result += string_format("\tif(%s)\r\n", PrintSymbolRef(src1Ref).c_str());
+			result += "\t{\r\n";
+			break;
+		case CShaderBuilder::STATEMENT_OP_RETURN:
+			if(isEntryPoint)
+			{
+				result += "\treturn output;\r\n";
+			}
+			else if(src1Ref.symbol.location != CShaderBuilder::SYMBOL_LOCATION_NULL)
+			{
+				result += string_format("\treturn %s;\r\n", PrintSymbolRef(src1Ref).c_str());
+			}
+			else
+			{
+				result += "\treturn;\r\n";
+			}
+			break;
+		case CShaderBuilder::STATEMENT_OP_CALL:
+		{
+			std::string args;
+			for(const auto* argRef : {&src1Ref, &src2Ref, &src3Ref, &src4Ref})
+			{
+				if(argRef->symbol.location == CShaderBuilder::SYMBOL_LOCATION_NULL) break;
+				if(!args.empty()) args += ", ";
+				args += PrintSymbolRef(*argRef);
+			}
+			if(dstRef.symbol.location != CShaderBuilder::SYMBOL_LOCATION_NULL)
+			{
+				result += string_format("\t%s = f%d(%s);\r\n",
+				                        PrintSymbolRef(dstRef).c_str(), statement.param, args.c_str());
+			}
+			else
+			{
+				result += string_format("\tf%d(%s);\r\n", statement.param, args.c_str());
+			}
+		}
+		break;
+		case CShaderBuilder::STATEMENT_OP_ELSE:
+			result += "\t}\r\n";
+			result += "\telse\r\n";
+			result += "\t{\r\n";
+			break;
+		case CShaderBuilder::STATEMENT_OP_IF_END:
+			result += "\t}\r\n";
+			break;
+		case CShaderBuilder::STATEMENT_OP_SWITCH_BEGIN:
+			result += PrintSelectionControl(statement.param);
+			result += string_format("\tswitch(%s)\r\n", PrintSymbolRef(src1Ref).c_str());
+			result += "\t{\r\n";
+			switchSelectorTypes.push_back(src1Ref.symbol.type);
+			caseHasBody = false;
+			break;
+		case CShaderBuilder::STATEMENT_OP_SWITCH_CASE:
+			assert(!switchSelectorTypes.empty());
+			if(caseHasBody) result += "\tbreak;\r\n";
+			if(switchSelectorTypes.back() == CShaderBuilder::SYMBOL_TYPE_UINT4)
+			{
+				result += string_format("\tcase %uu:\r\n", statement.param);
+			}
+			else
+			{
+				result += string_format("\tcase %d:\r\n", static_cast<int32>(statement.param));
+			}
+			caseHasBody = false;
+			break;
+		case CShaderBuilder::STATEMENT_OP_SWITCH_DEFAULT:
+			if(caseHasBody) result += "\tbreak;\r\n";
+			result += "\tdefault:\r\n";
+			caseHasBody = false;
+			break;
+		case CShaderBuilder::STATEMENT_OP_SWITCH_END:
+			assert(!switchSelectorTypes.empty());
+			result += "\tbreak;\r\n";
+			result += "\t}\r\n";
+			switchSelectorTypes.pop_back();
+			break;
+		case CShaderBuilder::STATEMENT_OP_LOOP_BEGIN:
+			result += PrintLoopControl(statement.param);
+			if(dstRef.symbol.location != CShaderBuilder::SYMBOL_LOCATION_NULL)
+			{
+				auto indexString = PrintSymbolRef(dstRef);
+				result += string_format("\tfor(%s = 0; %s < %s; %s++)\r\n",
+				                        indexString.c_str(), indexString.c_str(),
+				                        PrintSymbolRef(src1Ref).c_str(), indexString.c_str());
+			}
+			else
+			{
+				result += "\twhile(true)\r\n";
+			}
+			result += "\t{\r\n";
+			break;
+		case CShaderBuilder::STATEMENT_OP_LOOP_END:
+			result += "\t}\r\n";
+			break;
+		case CShaderBuilder::STATEMENT_OP_BREAK:
+			result += "\tbreak;\r\n";
+			break;
+		case CShaderBuilder::STATEMENT_OP_CONTINUE:
+			result += "\tcontinue;\r\n";
+			break;
 		default:
 			assert(0);
 			break;
 		}
+		switch(statement.op)
+		{
+		case CShaderBuilder::STATEMENT_OP_SWITCH_BEGIN:
+		case CShaderBuilder::STATEMENT_OP_SWITCH_CASE:
+		case CShaderBuilder::STATEMENT_OP_SWITCH_DEFAULT:
+			break;
+		default:
+			caseHasBody = true;
+			break;
+		}
 	}
 
-	result += "\treturn output;\r\n";
-	result += "}\r\n";
 	return result;
 }
 
@@ -227,8 +666,10 @@ std::string CHlslShaderGenerator::GenerateOutputStruct() const
 	{
 		if(symbol.location != CShaderBuilder::SYMBOL_LOCATION_OUTPUT) continue;
 		auto semantic = m_shaderBuilder.GetOutputSemantic(symbol);
+		//Depth is a scalar
+		auto typeName = (semantic.type == SEMANTIC_SYSTEM_DEPTH) ? std::string("float") : MakeTypeName(symbol.type);
 		result += string_format("\t%s %s : %s;\r\n",
-		                        MakeTypeName(symbol.type).c_str(),
+		                        typeName.c_str(),
 		                        MakeLocalSymbolName(symbol).c_str(),
 		                        MakeSemanticName(semantic).c_str());
 	}
@@ -244,9 +685,41 @@ std::string CHlslShaderGenerator::GenerateConstants() const
 	for(const auto& symbol : m_shaderBuilder.GetSymbols())
 	{
 		if(symbol.location != CShaderBuilder::SYMBOL_LOCATION_UNIFORM) continue;
-		auto constantType = (symbol.type == CShaderBuilder::SYMBOL_TYPE_MATRIX) ? "matrix" : "float4";
-		result += string_format("\t%s %s;\r\n",
-		                        constantType, MakeLocalSymbolName(symbol).c_str());
+		switch(symbol.type)
+		{
+		case CShaderBuilder::SYMBOL_TYPE_ARRAYUINT:
+			//Declared by GenerateBuffers
+			break;
+		case CShaderBuilder::SYMBOL_TYPE_ARRAYFLOAT4:
+		case CShaderBuilder::SYMBOL_TYPE_ARRAYINT4:
+		case CShaderBuilder::SYMBOL_TYPE_ARRAYMATRIX:
+		{
+			//Array elements are 16 bytes aligned in constant buffers, like std140
+			const char* elementType = "float4";
+			if(symbol.type == CShaderBuilder::SYMBOL_TYPE_ARRAYINT4) elementType = "int4";
+			if(symbol.type == CShaderBuilder::SYMBOL_TYPE_ARRAYMATRIX) elementType = "matrix";
+			result += string_format("\t%s %s[%d];\r\n",
+			                        elementType, MakeLocalSymbolName(symbol).c_str(),
+			                        m_shaderBuilder.GetUniformArraySize(symbol));
+		}
+		break;
+		case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
+		{
+			static const char* constantTypes[4] = {"float", "float2", "float3", "float4"};
+			auto componentCount = m_shaderBuilder.GetUniformComponentCount(symbol);
+			assert((componentCount >= 1) && (componentCount <= 4));
+			result += string_format("\t%s %s;\r\n",
+			                        constantTypes[componentCount - 1], MakeLocalSymbolName(symbol).c_str());
+		}
+		break;
+		default:
+		{
+			auto constantType = (symbol.type == CShaderBuilder::SYMBOL_TYPE_MATRIX) ? "matrix" : "float4";
+			result += string_format("\t%s %s;\r\n",
+			                        constantType, MakeLocalSymbolName(symbol).c_str());
+		}
+		break;
+		}
 	}
 	result += "};\r\n";
 	return result;
@@ -257,16 +730,83 @@ std::string CHlslShaderGenerator::GenerateSamplers() const
 	std::string result;
 	for(const auto& symbol : m_shaderBuilder.GetSymbols())
 	{
+		if(symbol.location == CShaderBuilder::SYMBOL_LOCATION_TEXTURE_ELEMENT)
+		{
+			//Index of the selected array element
+			result += string_format("static int e%d;\r\n", symbol.index);
+			continue;
+		}
 		if(symbol.location != CShaderBuilder::SYMBOL_LOCATION_TEXTURE) continue;
-		result += string_format("%s c_texture%d : register(t%d);\r\n",
+		std::string arraySuffix;
+		if(m_shaderBuilder.IsTextureArray(symbol))
+		{
+			//All elements share the same sampler
+			auto size = m_shaderBuilder.GetTextureArraySize(symbol);
+			arraySuffix = (size == 0) ? std::string("[]") : string_format("[%d]", size);
+		}
+		result += string_format("%s c_texture%s%s : register(%s);\r\n",
 		                        MakeTypeName(symbol.type).c_str(),
-		                        symbol.unit, symbol.unit);
-		result += string_format("SamplerState c_sampler%d : register(s%d);\r\n",
-		                        symbol.unit, symbol.unit);
+		                        MakeBindingName(symbol).c_str(), arraySuffix.c_str(), MakeRegisterName('t', symbol).c_str());
+		result += string_format("SamplerState c_sampler%s : register(%s);\r\n",
+		                        MakeBindingName(symbol).c_str(), MakeRegisterName('s', symbol).c_str());
 	}
 	return result;
 }
 
+std::string CHlslShaderGenerator::GenerateBuffers() const
+{
+	std::string result;
+	for(const auto& symbol : m_shaderBuilder.GetSymbols())
+	{
+		if(symbol.location == CShaderBuilder::SYMBOL_LOCATION_BUFFER_ELEMENT)
+		{
+			//Index of the selected array element
+			result += string_format("static int b%d;\r\n", symbol.index);
+			continue;
+		}
+		if(symbol.location != CShaderBuilder::SYMBOL_LOCATION_UNIFORM) continue;
+		if(symbol.type != CShaderBuilder::SYMBOL_TYPE_ARRAYUINT) continue;
+		std::string arraySuffix;
+		if(m_shaderBuilder.IsBufferArray(symbol))
+		{
+			auto size = m_shaderBuilder.GetBufferArraySize(symbol);
+			arraySuffix = (size == 0) ? std::string("[]") : string_format("[%d]", size);
+		}
+		result += string_format("RWStructuredBuffer<uint> %s%s : register(%s);\r\n",
+		                        MakeLocalSymbolName(symbol).c_str(), arraySuffix.c_str(), MakeRegisterName('u', symbol).c_str());
+	}
+	return result;
+}
+
+std::string CHlslShaderGenerator::MakeTextureName(const CShaderBuilder::SYMBOL& sym) const
+{
+	auto name = "c_texture" + MakeBindingName(sym);
+	if(sym.location == CShaderBuilder::SYMBOL_LOCATION_TEXTURE_ELEMENT)
+	{
+		if(sym.attributes & SYMBOL_ATTRIBUTE_NONUNIFORM)
+		{
+			return name + string_format("[NonUniformResourceIndex(e%d)]", sym.index);
+		}
+		return name + string_format("[e%d]", sym.index);
+	}
+	assert(sym.location == CShaderBuilder::SYMBOL_LOCATION_TEXTURE);
+	return name;
+}
+
+std::string CHlslShaderGenerator::MakeBindingName(const CShaderBuilder::SYMBOL& sym)
+{
+	//Units can be reused in other sets, names then also include the set
+	if(sym.set == 0) return string_format("%d", sym.unit);
+	return string_format("%d_%d", sym.set, sym.unit);
+}
+
+std::string CHlslShaderGenerator::MakeRegisterName(char registerType, const CShaderBuilder::SYMBOL& sym)
+{
+	//Descriptor sets are register spaces, the default set is left implicit
+	if(sym.set == 0) return string_format("%c%d", registerType, sym.unit);
+	return string_format("%c%d, space%d", registerType, sym.unit, sym.set);
+}
+
 std::string CHlslShaderGenerator::MakeSymbolName(const CShaderBuilder::SYMBOL& sym) const
 {
 	switch(sym.location)
@@ -281,8 +821,31 @@ std::string CHlslShaderGenerator::MakeSymbolName(const CShaderBuilder::SYMBOL& s
 		return string_format("output.%s", MakeLocalSymbolName(sym).c_str());
 		break;
 	case CShaderBuilder::SYMBOL_LOCATION_UNIFORM:
+		if(sym.type == CShaderBuilder::SYMBOL_TYPE_FLOAT4)
+		{
+			//Float constants with less than 4 components are expanded to a float4
+			switch(m_shaderBuilder.GetUniformComponentCount(sym))
+			{
+			case 1:
+				return string_format("float4(%s, 0, 0, 0)", MakeLocalSymbolName(sym).c_str());
+			case 2:
+				return string_format("float4(%s, 0, 0)", MakeLocalSymbolName(sym).c_str());
+			default:
+				break;
+			}
+		}
 		return MakeLocalSymbolName(sym);
 		break;
+	case CShaderBuilder::SYMBOL_LOCATION_BUFFER_ELEMENT:
+	{
+		auto name = MakeLocalSymbolName(m_shaderBuilder.GetBufferArray(sym));
+		if(sym.attributes & SYMBOL_ATTRIBUTE_NONUNIFORM)
+		{
+			return name + string_format("[NonUniformResourceIndex(b%d)]", sym.index);
+		}
+		return name + string_format("[b%d]", sym.index);
+	}
+	break;
 	default:
 		assert(false);
 		return "unknown";
@@ -306,7 +869,7 @@ std::string CHlslShaderGenerator::MakeLocalSymbolName(const CShaderBuilder::SYMB
 	}
 }
 
-std::string CHlslShaderGenerator::MakeSemanticName(CShaderBuilder::SEMANTIC_INFO semantic)
+std::string CHlslShaderGenerator::MakeSemanticName(CShaderBuilder::SEMANTIC_INFO semantic) const
 {
 	switch(semantic.type)
 	{
@@ -318,18 +881,37 @@ std::string CHlslShaderGenerator::MakeSemanticName(CShaderBuilder::SEMANTIC_INFO
 		return "SV_POSITION";
 	case SEMANTIC_SYSTEM_COLOR:
 		return "SV_TARGET";
+	case SEMANTIC_SYSTEM_DEPTH:
+		//Conservative depth semantics, there is no equivalent to DEPTH_MODE_UNCHANGED
+		switch(m_shaderBuilder.GetMetadata(CShaderBuilder::METADATA_DEPTH_MODE, DEPTH_MODE_ANY))
+		{
+		case DEPTH_MODE_GREATER:
+			return "SV_DepthGreaterEqual";
+		case DEPTH_MODE_LESS:
+			return "SV_DepthLessEqual";
+		default:
+			return "SV_Depth";
+		}
 	default:
 		assert(false);
 		return "";
 	}
 }
 
-std::string CHlslShaderGenerator::MakeTypeName(CShaderBuilder::SYMBOL_TYPE type)
+std::string CHlslShaderGenerator::MakeTypeName(CShaderBuilder::SYMBOL_TYPE type) const
 {
 	switch(type)
 	{
 	case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
 		return "float4";
+	case CShaderBuilder::SYMBOL_TYPE_HALF4:
+		return (m_flags & FLAG_NATIVE_FLOAT16) ? "min16float4" : "float4";
+	case CShaderBuilder::SYMBOL_TYPE_INT4:
+		return "int4";
+	case CShaderBuilder::SYMBOL_TYPE_UINT4:
+		return "uint4";
+	case CShaderBuilder::SYMBOL_TYPE_BOOL4:
+		return "bool4";
 	case CShaderBuilder::SYMBOL_TYPE_MATRIX:
 		return "matrix";
 	case CShaderBuilder::SYMBOL_TYPE_TEXTURE2D:
@@ -347,38 +929,65 @@ std::string CHlslShaderGenerator::PrintSymbolRef(const CShaderBuilder::SYMBOLREF
 	{
 		return symbolName;
 	}
-	switch(ref.swizzle)
+	if(
+	    (ref.symbol.location == CShaderBuilder::SYMBOL_LOCATION_OUTPUT) &&
+	    (m_shaderBuilder.GetOutputSemantic(ref.symbol).type == SEMANTIC_SYSTEM_DEPTH))
+	{
+		//Depth is a scalar
+		assert(ref.swizzle == SWIZZLE_X);
+		return symbolName;
+	}
+	static const char elemChars[4] = {'x', 'y', 'z', 'w'};
+	std::string result = symbolName + ".";
+	auto elemCount = GetSwizzleElementCount(ref.swizzle);
+	for(uint32 i = 0; i < elemCount; i++)
+	{
+		uint32 elem = GetSwizzleElement(ref.swizzle, i);
+		assert(elem < 4);
+		result += elemChars[elem];
+	}
+	return result;
+}
+
+std::string CHlslShaderGenerator::PrintSelectionControl(uint32 selectionControl) const
+{
+	if(selectionControl == SELECTION_CONTROL_NONE)
+	{
+		if(m_flags & FLAG_DEFAULT_SELECTION_FLATTEN)
+		{
+			selectionControl = SELECTION_CONTROL_FLATTEN;
+		}
+		else if(m_flags & FLAG_DEFAULT_SELECTION_DONT_FLATTEN)
+		{
+			selectionControl = SELECTION_CONTROL_DONT_FLATTEN;
+		}
+	}
+	switch(selectionControl)
 	{
-	case SWIZZLE_X:
-		return symbolName + ".x";
-		break;
-	case SWIZZLE_Y:
-		return symbolName + ".y";
-		break;
-	case SWIZZLE_Z:
-		return symbolName + ".z";
-		break;
-	case SWIZZLE_W:
-		return symbolName + ".w";
-		break;
-	case SWIZZLE_XY:
-		return symbolName + ".xy";
-		break;
-	case SWIZZLE_XZ:
-		return symbolName + ".xz";
-		break;
-	case SWIZZLE_ZZ:
-		return symbolName + ".zz";
-		break;
-	case SWIZZLE_XYZ:
-		return symbolName + ".xyz";
-		break;
-	case SWIZZLE_XYZW:
-		return symbolName + ".xyzw";
-		break;
 	default:
 		assert(false);
-		return symbolName;
-		break;
+		[[fallthrough]];
+	case SELECTION_CONTROL_NONE:
+		return "";
+	case SELECTION_CONTROL_FLATTEN:
+		return "\t[flatten]\r\n";
+	case SELECTION_CONTROL_DONT_FLATTEN:
+		return "\t[branch]\r\n";
+	}
+}
+
+std::string CHlslShaderGenerator::PrintLoopControl(uint32 loopControl)
+{
+	switch(loopControl)
+	{
+	default:
+		assert(false);
+		[[fallthrough]];
+	case LOOP_CONTROL_NONE:
+		return "";
+	case LOOP_CONTROL_UNROLL:
+		return "\t[unroll]\r\n";
+	case LOOP_CONTROL_DONT_UNROLL:
+		return "\t[loop]\r\n";
 	}
 }
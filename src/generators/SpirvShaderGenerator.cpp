@@ -1,19 +1,22 @@
 #include <cstring>
 #include <array>
 #include "nuanceur/generators/SpirvShaderGenerator.h"
+#include "MemStream.h"
 
 using namespace Nuanceur;
 
-CSpirvShaderGenerator::CSpirvShaderGenerator(Framework::CStream& outputStream, const CShaderBuilder& shaderBuilder, SHADER_TYPE shaderType)
+CSpirvShaderGenerator::CSpirvShaderGenerator(Framework::CStream& outputStream, const CShaderBuilder& shaderBuilder, SHADER_TYPE shaderType, uint32 flags)
     : m_outputStream(outputStream)
+    , m_currentStream(&outputStream)
     , m_shaderBuilder(shaderBuilder)
     , m_shaderType(shaderType)
+    , m_flags(flags)
 {
 }
 
-void CSpirvShaderGenerator::Generate(Framework::CStream& outputStream, const CShaderBuilder& shaderBuilder, SHADER_TYPE shaderType)
+void CSpirvShaderGenerator::Generate(Framework::CStream& outputStream, const CShaderBuilder& shaderBuilder, SHADER_TYPE shaderType, uint32 flags)
 {
-	CSpirvShaderGenerator generator(outputStream, shaderBuilder, shaderType);
+	CSpirvShaderGenerator generator(outputStream, shaderBuilder, shaderType, flags);
 	generator.Generate();
 }
 
@@ -30,6 +33,61 @@ static CShaderBuilder::SYMBOL_TYPE GetCommonSymbolType(const CShaderBuilder::SYM
 	return op1.symbol.type;
 }
 
+//Rounds to nearest even, values out of range become infinities
+static uint32 ConvertFloatToHalf(float value)
+{
+	uint32 bits = 0;
+	memcpy(&bits, &value, sizeof(float));
+	uint32 sign = (bits >> 16) & 0x8000;
+	uint32 floatExponent = (bits >> 23) & 0xFF;
+	uint32 mantissa = bits & 0x7FFFFF;
+	if(floatExponent == 0xFF)
+	{
+		//Infinity or NaN
+		return sign | 0x7C00 | ((mantissa != 0) ? 0x200 : 0);
+	}
+	int32 exponent = static_cast<int32>(floatExponent) - 127 + 15;
+	if(exponent >= 0x1F)
+	{
+		return sign | 0x7C00;
+	}
+	if(exponent <= 0)
+	{
+		//Denormal
+		if(exponent < -10) return sign;
+		mantissa |= 0x800000;
+		uint32 shift = 14 - exponent;
+		uint32 result = mantissa >> shift;
+		uint32 remainder = mantissa & ((1 << shift) - 1);
+		uint32 halfway = 1 << (shift - 1);
+		if((remainder > halfway) || ((remainder == halfway) && (result & 1))) result++;
+		return sign | result;
+	}
+	uint32 result = (static_cast<uint32>(exponent) << 10) | (mantissa >> 13);
+	uint32 remainder = mantissa & 0x1FFF;
+	//Carry can go in the exponent, which is still valid
+	if((remainder > 0x1000) || ((remainder == 0x1000) && (result & 1))) result++;
+	return sign | result;
+}
+
+static spv::ExecutionMode GetInterlockExecutionMode(INTERLOCK_MODE interlockMode)
+{
+	switch(interlockMode)
+	{
+	default:
+		assert(false);
+		[[fallthrough]];
+	case INTERLOCK_MODE_PIXEL_ORDERED:
+		return spv::ExecutionModePixelInterlockOrderedEXT;
+	case INTERLOCK_MODE_PIXEL_UNORDERED:
+		return spv::ExecutionModePixelInterlockUnorderedEXT;
+	case INTERLOCK_MODE_SAMPLE_ORDERED:
+		return spv::ExecutionModeSampleInterlockOrderedEXT;
+	case INTERLOCK_MODE_SAMPLE_UNORDERED:
+		return spv::ExecutionModeSampleInterlockUnorderedEXT;
+	}
+}
+
 void CSpirvShaderGenerator::Generate()
 {
 	//Some notes:
@@ -43,20 +101,55 @@ void CSpirvShaderGenerator::Generate()
 
 	m_hasTextures = std::count_if(m_shaderBuilder.GetSymbols().begin(), m_shaderBuilder.GetSymbols().end(),
 	                              [](const CShaderBuilder::SYMBOL& symbol) { return symbol.location == CShaderBuilder::SYMBOL_LOCATION_TEXTURE; }) != 0;
+	m_hasUniformTexelBuffer = std::count_if(m_shaderBuilder.GetSymbols().begin(), m_shaderBuilder.GetSymbols().end(),
+	                                        [](const CShaderBuilder::SYMBOL& symbol) { return symbol.type == CShaderBuilder::SYMBOL_TYPE_UNIFORMTEXELBUFFER; }) != 0;
+	m_hasStorageTexelBuffer = std::count_if(m_shaderBuilder.GetSymbols().begin(), m_shaderBuilder.GetSymbols().end(),
+	                                        [](const CShaderBuilder::SYMBOL& symbol) { return symbol.type == CShaderBuilder::SYMBOL_TYPE_STORAGETEXELBUFFERUINT; }) != 0;
+
+	//Checks statements of the main function and of user functions
+	auto hasStatement =
+	    [&](const auto& predicate) {
+		    if(std::any_of(m_shaderBuilder.GetStatements().begin(), m_shaderBuilder.GetStatements().end(), predicate)) return true;
+		    for(const auto& function : m_shaderBuilder.GetFunctions())
+		    {
+			    if(std::any_of(function.statements.begin(), function.statements.end(), predicate)) return true;
+		    }
+		    return false;
+	    };
 
-	bool hasInvocationInterlock = std::count_if(m_shaderBuilder.GetStatements().begin(), m_shaderBuilder.GetStatements().end(),
-	                                            [](const CShaderBuilder::STATEMENT& statement) { return statement.op == CShaderBuilder::STATEMENT_OP_INVOCATION_INTERLOCK_BEGIN; }) != 0;
+	bool hasInvocationInterlock = hasStatement([](const CShaderBuilder::STATEMENT& statement) { return statement.op == CShaderBuilder::STATEMENT_OP_INVOCATION_INTERLOCK_BEGIN; });
+	bool hasDepthOutput = std::any_of(m_shaderBuilder.GetSymbols().begin(), m_shaderBuilder.GetSymbols().end(),
+	                                  [&](const CShaderBuilder::SYMBOL& symbol) {
+		                                  return (symbol.location == CShaderBuilder::SYMBOL_LOCATION_OUTPUT) &&
+		                                         (m_shaderBuilder.GetOutputSemantic(symbol).type == SEMANTIC_SYSTEM_DEPTH);
+	                                  });
 
-	m_has8BitInt = std::count_if(m_shaderBuilder.GetStatements().begin(), m_shaderBuilder.GetStatements().end(),
-	                             [](const CShaderBuilder::STATEMENT& statement) { return statement.op == CShaderBuilder::STATEMENT_OP_STORE8; }) != 0;
+	auto isStatementOp =
+	    [&](std::initializer_list<CShaderBuilder::STATEMENT_OP> ops) {
+		    return hasStatement([&](const CShaderBuilder::STATEMENT& statement) { return std::find(ops.begin(), ops.end(), statement.op) != ops.end(); });
+	    };
+	bool hasSubgroupBallot = isStatementOp({CShaderBuilder::STATEMENT_OP_SUBGROUP_BALLOT, CShaderBuilder::STATEMENT_OP_SUBGROUP_BROADCAST});
+	bool hasSubgroupShuffle = isStatementOp({CShaderBuilder::STATEMENT_OP_SUBGROUP_SHUFFLE});
+	bool hasSubgroupArithmetic = isStatementOp({CShaderBuilder::STATEMENT_OP_SUBGROUP_ADD, CShaderBuilder::STATEMENT_OP_SUBGROUP_MIN,
+	                                            CShaderBuilder::STATEMENT_OP_SUBGROUP_MAX, CShaderBuilder::STATEMENT_OP_SUBGROUP_AND,
+	                                            CShaderBuilder::STATEMENT_OP_SUBGROUP_OR});
+	bool hasSubgroupInput = std::any_of(m_shaderBuilder.GetSymbols().begin(), m_shaderBuilder.GetSymbols().end(),
+	                                    [&](const CShaderBuilder::SYMBOL& symbol) {
+		                                    if(symbol.location != CShaderBuilder::SYMBOL_LOCATION_INPUT) return false;
+		                                    auto semanticType = m_shaderBuilder.GetInputSemantic(symbol).type;
+		                                    return (semanticType == SEMANTIC_SYSTEM_SUBGROUP_INVOCATION_ID) ||
+		                                           (semanticType == SEMANTIC_SYSTEM_SUBGROUP_SIZE);
+	                                    });
+	bool hasSubgroup = hasSubgroupBallot || hasSubgroupShuffle || hasSubgroupArithmetic || hasSubgroupInput;
+
+	m_has8BitInt = hasStatement([](const CShaderBuilder::STATEMENT& statement) { return statement.op == CShaderBuilder::STATEMENT_OP_STORE8; });
 	if(!m_has8BitInt)
 	{
 		m_has8BitInt = std::count_if(m_shaderBuilder.GetSymbols().begin(), m_shaderBuilder.GetSymbols().end(),
 		                             [](const CShaderBuilder::SYMBOL& symbol) { return symbol.type == CShaderBuilder::SYMBOL_TYPE_ARRAYUCHAR; }) != 0;
 	}
 
-	m_has16BitInt = std::count_if(m_shaderBuilder.GetStatements().begin(), m_shaderBuilder.GetStatements().end(),
-	                              [](const CShaderBuilder::STATEMENT& statement) { return statement.op == CShaderBuilder::STATEMENT_OP_STORE16; }) != 0;
+	m_has16BitInt = hasStatement([](const CShaderBuilder::STATEMENT& statement) { return statement.op == CShaderBuilder::STATEMENT_OP_STORE16; });
 	if(!m_has16BitInt)
 	{
 		m_has16BitInt = std::count_if(m_shaderBuilder.GetSymbols().begin(), m_shaderBuilder.GetSymbols().end(),
@@ -65,13 +158,99 @@ void CSpirvShaderGenerator::Generate()
 	// 16bit writes requires 8 bits buffer
 	m_has8BitInt |= m_has16BitInt;
 
-	auto voidTypeId = AllocateId();
+	//2D array and 3D images are addressed with 3 component coordinates
+	bool hasImageInt3Coord = std::any_of(m_shaderBuilder.GetSymbols().begin(), m_shaderBuilder.GetSymbols().end(),
+	                                     [](const CShaderBuilder::SYMBOL& symbol) {
+		                                     return (symbol.type == CShaderBuilder::SYMBOL_TYPE_IMAGE2DARRAY) ||
+		                                            (symbol.type == CShaderBuilder::SYMBOL_TYPE_IMAGE3D) ||
+		                                            (symbol.type == CShaderBuilder::SYMBOL_TYPE_IMAGE2DARRAYUINT) ||
+		                                            (symbol.type == CShaderBuilder::SYMBOL_TYPE_IMAGE3DUINT);
+	                                     });
+	//Arrays indexed with a dynamic index and the elements selected with a non uniform index
+	bool hasSampledImageArray = false;
+	bool hasStorageImageArray = false;
+	bool hasRuntimeDescriptorArray = false;
+	bool hasStorageBufferArray = false;
+	bool hasSampledImageNonUniform = false;
+	bool hasStorageImageNonUniform = false;
+	bool hasStorageBufferNonUniform = false;
+	for(const auto& symbol : m_shaderBuilder.GetSymbols())
+	{
+		bool isSampledImage = (symbol.type == CShaderBuilder::SYMBOL_TYPE_TEXTURE2D);
+		if(symbol.location == CShaderBuilder::SYMBOL_LOCATION_TEXTURE)
+		{
+			if(!m_shaderBuilder.IsTextureArray(symbol)) continue;
+			hasSampledImageArray |= isSampledImage;
+			hasStorageImageArray |= !isSampledImage;
+			hasRuntimeDescriptorArray |= (m_shaderBuilder.GetTextureArraySize(symbol) == 0);
+		}
+		else if(symbol.location == CShaderBuilder::SYMBOL_LOCATION_UNIFORM)
+		{
+			if(!m_shaderBuilder.IsBufferArray(symbol)) continue;
+			hasStorageBufferArray = true;
+			hasRuntimeDescriptorArray |= (m_shaderBuilder.GetBufferArraySize(symbol) == 0);
+		}
+		else if(symbol.attributes & SYMBOL_ATTRIBUTE_NONUNIFORM)
+		{
+			hasSampledImageNonUniform |= (symbol.location == CShaderBuilder::SYMBOL_LOCATION_TEXTURE_ELEMENT) && isSampledImage;
+			hasStorageImageNonUniform |= (symbol.location == CShaderBuilder::SYMBOL_LOCATION_TEXTURE_ELEMENT) && !isSampledImage;
+			hasStorageBufferNonUniform |= (symbol.location == CShaderBuilder::SYMBOL_LOCATION_BUFFER_ELEMENT);
+		}
+	}
+	bool hasNonUniform = hasSampledImageNonUniform || hasStorageImageNonUniform || hasStorageBufferNonUniform;
+	bool hasDescriptorIndexing = hasRuntimeDescriptorArray || hasNonUniform;
+
+	bool hasImageExtendedFormats = std::any_of(m_shaderBuilder.GetSymbols().begin(), m_shaderBuilder.GetSymbols().end(),
+	                                           [&](const CShaderBuilder::SYMBOL& symbol) {
+		                                           if(!CShaderBuilder::IsImageType(symbol.type)) return false;
+		                                           auto format = m_shaderBuilder.GetImageFormat(symbol);
+		                                           return (format == IMAGE_FORMAT_R16UI) || (format == IMAGE_FORMAT_R8UI);
+	                                           });
+
+	m_hasUint2Array = std::count_if(m_shaderBuilder.GetSymbols().begin(), m_shaderBuilder.GetSymbols().end(),
+	                                [](const CShaderBuilder::SYMBOL& symbol) { return symbol.type == CShaderBuilder::SYMBOL_TYPE_ARRAYUINT2; }) != 0;
+	m_hasUint4Array = std::count_if(m_shaderBuilder.GetSymbols().begin(), m_shaderBuilder.GetSymbols().end(),
+	                                [](const CShaderBuilder::SYMBOL& symbol) { return symbol.type == CShaderBuilder::SYMBOL_TYPE_ARRAYUINT4; }) != 0;
+	m_hasBufferPointerUint = std::count_if(m_shaderBuilder.GetSymbols().begin(), m_shaderBuilder.GetSymbols().end(),
+	                                       [](const CShaderBuilder::SYMBOL& symbol) { return symbol.type == CShaderBuilder::SYMBOL_TYPE_BUFFERPOINTERUINT; }) != 0;
+	m_hasBufferPointerFloat4 = std::count_if(m_shaderBuilder.GetSymbols().begin(), m_shaderBuilder.GetSymbols().end(),
+	                                         [](const CShaderBuilder::SYMBOL& symbol) { return symbol.type == CShaderBuilder::SYMBOL_TYPE_BUFFERPOINTERFLOAT4; }) != 0;
+	m_hasBufferPointer = m_hasBufferPointerUint || m_hasBufferPointerFloat4;
+	m_hasSmallFloatUniform = std::count_if(m_shaderBuilder.GetSymbols().begin(), m_shaderBuilder.GetSymbols().end(),
+	                                       [&](const CShaderBuilder::SYMBOL& symbol) {
+		                                       return (symbol.location == CShaderBuilder::SYMBOL_LOCATION_UNIFORM) &&
+		                                              (symbol.type == CShaderBuilder::SYMBOL_TYPE_FLOAT4) &&
+		                                              (m_shaderBuilder.GetUniformComponentCount(symbol) != 4);
+	                                       }) != 0;
+
+	if(m_flags & FLAG_NATIVE_FLOAT16)
+	{
+		m_hasNativeFloat16 = std::count_if(m_shaderBuilder.GetSymbols().begin(), m_shaderBuilder.GetSymbols().end(),
+		                                   [](const CShaderBuilder::SYMBOL& symbol) { return symbol.type == CShaderBuilder::SYMBOL_TYPE_HALF4; }) != 0;
+	}
+
+	m_voidTypeId = AllocateId();
 	auto mainFunctionTypeId = AllocateId();
 	m_glslStd450ExtInst = AllocateId();
 	m_boolTypeId = AllocateId();
 	m_bool4TypeId = AllocateId();
 	m_floatTypeId = AllocateId();
 	m_float4TypeId = AllocateId();
+	if(m_hasTextures || m_hasSmallFloatUniform)
+	{
+		m_float2TypeId = AllocateId();
+	}
+	if(m_hasNativeFloat16)
+	{
+		m_halfTypeId = AllocateId();
+		m_half4TypeId = AllocateId();
+	}
+	else
+	{
+		//Halves are emitted as floats with relaxed precision
+		m_halfTypeId = m_floatTypeId;
+		m_half4TypeId = m_float4TypeId;
+	}
 
 	m_boolConstantFalseId = AllocateId();
 	m_boolConstantTrueId = AllocateId();
@@ -89,6 +268,16 @@ void CSpirvShaderGenerator::Generate()
 	m_ushortArrayTypeId = AllocateId();
 	m_ucharArrayTypeId = AllocateId();
 
+	if(m_hasUint2Array)
+	{
+		m_uint2TypeId = AllocateId();
+		m_uint2ArrayTypeId = AllocateId();
+	}
+	if(m_hasUint4Array)
+	{
+		m_uint4ArrayTypeId = AllocateId();
+	}
+
 	m_intTypeId = AllocateId();
 	m_shortTypeId = AllocateId();
 	m_charTypeId = AllocateId();
@@ -110,18 +299,51 @@ void CSpirvShaderGenerator::Generate()
 	m_functionBool4PointerTypeId = AllocateId();
 	auto outputPerVertexStructPointerTypeId = AllocateId();
 
+	//Needs to be allocated before push constant struct members
+	if(m_hasBufferPointerUint)
+	{
+		m_bufferPointerUintStructTypeId = AllocateId();
+		m_bufferPointerUintTypeId = AllocateId();
+		m_bufferPointerUintElementPtrId = AllocateId();
+		m_pushBufferPointerUintPointerTypeId = AllocateId();
+	}
+	if(m_hasBufferPointerFloat4)
+	{
+		m_bufferPointerFloat4ArrayTypeId = AllocateId();
+		m_bufferPointerFloat4StructTypeId = AllocateId();
+		m_bufferPointerFloat4TypeId = AllocateId();
+		m_bufferPointerFloat4ElementPtrId = AllocateId();
+		m_pushBufferPointerFloat4PointerTypeId = AllocateId();
+	}
+
 	AllocateUniformStructsIds();
 	if(!m_structInfos.empty())
 	{
 		m_pushFloat4PointerTypeId = AllocateId();
 		m_pushInt4PointerTypeId = AllocateId();
 		m_pushMatrix44PointerTypeId = AllocateId();
+		if(m_hasSmallFloatUniform)
+		{
+			m_pushFloatPointerTypeId = AllocateId();
+			m_pushFloat2PointerTypeId = AllocateId();
+			m_uniformFloatPointerTypeId = AllocateId();
+			m_uniformFloat2PointerTypeId = AllocateId();
+		}
 
 		m_uniformFloat4PointerTypeId = AllocateId();
 		m_uniformInt4PointerTypeId = AllocateId();
+		m_uniformMatrix44PointerTypeId = AllocateId();
 		m_uniformUintPtrId = AllocateId();
 		m_uniformUint16PtrId = AllocateId();
 		m_uniformUint8PtrId = AllocateId();
+		if(m_hasUint2Array)
+		{
+			m_uniformUint2PtrId = AllocateId();
+		}
+		if(m_hasUint4Array)
+		{
+			m_uniformUint4PtrId = AllocateId();
+		}
 	}
 
 	if(m_hasTextures)
@@ -132,8 +354,7 @@ void CSpirvShaderGenerator::Generate()
 		m_sampledImageSamplerPointerTypeId = AllocateId();
 
 		//Storage image
-		m_storageImage2DTypeId = AllocateId();
-		m_storageImage2DPointerTypeId = AllocateId();
+		AllocateStorageImageTypeIds();
 		m_imageUintPtrId = AllocateId();
 
 		//Subpass Input
@@ -142,18 +363,53 @@ void CSpirvShaderGenerator::Generate()
 		m_subpassInputPointerTypeId = AllocateId();
 		m_subpassInputUintPointerTypeId = AllocateId();
 
+		//Texel buffer
+		if(m_hasUniformTexelBuffer)
+		{
+			m_uniformTexelBufferTypeId = AllocateId();
+			m_uniformTexelBufferPointerTypeId = AllocateId();
+		}
+		if(m_hasStorageTexelBuffer)
+		{
+			m_storageTexelBufferUintTypeId = AllocateId();
+			m_storageTexelBufferUintPointerTypeId = AllocateId();
+		}
+
 		AllocateTextureIds();
+		AllocateTextureArrayIds();
 	}
 
 	AllocateInputPointerIds();
 	AllocateOutputPointerIds();
 	AllocateVariablePointerIds();
+	AllocateSharedArrayIds();
 
 	m_outputPerVertexVariableId = AllocateId();
 
 	auto mainFunctionId = AllocateId();
 	auto mainFunctionLabelId = AllocateId();
 
+	//User functions, function types are unique for a given signature
+	const auto& functions = m_shaderBuilder.GetFunctions();
+	std::map<std::vector<uint32>, uint32> functionTypeIds;
+	functionTypeIds[{m_voidTypeId}] = mainFunctionTypeId;
+	for(const auto& function : functions)
+	{
+		std::vector<uint32> signature;
+		signature.push_back(GetFunctionReturnTypeId(function));
+		for(const auto& parameter : function.parameters)
+		{
+			signature.push_back(GetVectorTypeId(parameter.type));
+		}
+		auto functionTypeIdIterator = functionTypeIds.find(signature);
+		if(functionTypeIdIterator == std::end(functionTypeIds))
+		{
+			functionTypeIdIterator = functionTypeIds.insert(std::make_pair(signature, AllocateId())).first;
+		}
+		m_functionIds.push_back(AllocateId());
+		m_functionTypeIds.push_back(functionTypeIdIterator->second);
+	}
+
 	WriteOp(spv::OpCapability, spv::CapabilityShader);
 	WriteOp(spv::OpCapability, spv::CapabilityInputAttachment);
 	if(m_has8BitInt)
@@ -170,9 +426,78 @@ void CSpirvShaderGenerator::Generate()
 		WriteOp(spv::OpCapability, spv::CapabilityUniformAndStorageBuffer16BitAccess);
 	}
 
+	if(m_hasNativeFloat16)
+	{
+		WriteOp(spv::OpCapability, spv::CapabilityFloat16);
+	}
+
+	if(m_hasUniformTexelBuffer)
+	{
+		WriteOp(spv::OpCapability, spv::CapabilitySampledBuffer);
+	}
+
+	if(m_hasStorageTexelBuffer)
+	{
+		WriteOp(spv::OpCapability, spv::CapabilityImageBuffer);
+	}
+
+	if(hasImageExtendedFormats)
+	{
+		WriteOp(spv::OpCapability, spv::CapabilityStorageImageExtendedFormats);
+	}
+
+	if(hasSubgroup)
+	{
+		WriteOp(spv::OpCapability, spv::CapabilityGroupNonUniform);
+		if(hasSubgroupBallot)
+			WriteOp(spv::OpCapability, spv::CapabilityGroupNonUniformBallot);
+		if(hasSubgroupShuffle)
+			WriteOp(spv::OpCapability, spv::CapabilityGroupNonUniformShuffle);
+		if(hasSubgroupArithmetic)
+			WriteOp(spv::OpCapability, spv::CapabilityGroupNonUniformArithmetic);
+	}
+
+	if(m_hasBufferPointer)
+	{
+		WriteOp(spv::OpCapability, spv::CapabilityPhysicalStorageBufferAddressesEXT);
+	}
+
+	if(hasSampledImageArray)
+	{
+		WriteOp(spv::OpCapability, spv::CapabilitySampledImageArrayDynamicIndexing);
+	}
+
+	if(hasStorageImageArray)
+	{
+		WriteOp(spv::OpCapability, spv::CapabilityStorageImageArrayDynamicIndexing);
+	}
+
+	if(hasStorageBufferArray)
+	{
+		WriteOp(spv::OpCapability, spv::CapabilityStorageBufferArrayDynamicIndexing);
+	}
+
+	if(hasRuntimeDescriptorArray)
+	{
+		WriteOp(spv::OpCapability, spv::CapabilityRuntimeDescriptorArrayEXT);
+	}
+
+	if(hasNonUniform)
+	{
+		WriteOp(spv::OpCapability, spv::CapabilityShaderNonUniformEXT);
+		if(hasSampledImageNonUniform)
+			WriteOp(spv::OpCapability, spv::CapabilitySampledImageArrayNonUniformIndexingEXT);
+		if(hasStorageImageNonUniform)
+			WriteOp(spv::OpCapability, spv::CapabilityStorageImageArrayNonUniformIndexingEXT);
+		if(hasStorageBufferNonUniform)
+			WriteOp(spv::OpCapability, spv::CapabilityStorageBufferArrayNonUniformIndexingEXT);
+	}
+
+	auto interlockMode = static_cast<INTERLOCK_MODE>(m_shaderBuilder.GetMetadata(CShaderBuilder::METADATA_INTERLOCK_MODE, INTERLOCK_MODE_PIXEL_ORDERED));
+	bool isSampleInterlock = (interlockMode == INTERLOCK_MODE_SAMPLE_ORDERED) || (interlockMode == INTERLOCK_MODE_SAMPLE_UNORDERED);
 	if(hasInvocationInterlock)
 	{
-		WriteOp(spv::OpCapability, spv::CapabilityFragmentShaderPixelInterlockEXT);
+		WriteOp(spv::OpCapability, isSampleInterlock ? spv::CapabilityFragmentShaderSampleInterlockEXT : spv::CapabilityFragmentShaderPixelInterlockEXT);
 		WriteOp(spv::OpExtension, "SPV_EXT_fragment_shader_interlock");
 	}
 	if(m_has8BitInt || m_has16BitInt)
@@ -184,8 +509,16 @@ void CSpirvShaderGenerator::Generate()
 		if(m_has16BitInt)
 			WriteOp(spv::OpExtension, "SPV_KHR_16bit_storage");
 	}
+	if(hasDescriptorIndexing)
+	{
+		WriteOp(spv::OpExtension, "SPV_EXT_descriptor_indexing");
+	}
+	if(m_hasBufferPointer)
+	{
+		WriteOp(spv::OpExtension, "SPV_KHR_physical_storage_buffer");
+	}
 	WriteOp(spv::OpExtInstImport, m_glslStd450ExtInst, "GLSL.std.450");
-	WriteOp(spv::OpMemoryModel, spv::AddressingModelLogical, spv::MemoryModelGLSL450);
+	WriteOp(spv::OpMemoryModel, m_hasBufferPointer ? spv::AddressingModelPhysicalStorageBuffer64EXT : spv::AddressingModelLogical, spv::MemoryModelGLSL450);
 
 	//Write Entry Point
 	{
@@ -234,7 +567,30 @@ void CSpirvShaderGenerator::Generate()
 		WriteOp(spv::OpExecutionMode, mainFunctionId, spv::ExecutionModeOriginUpperLeft);
 		if(hasInvocationInterlock)
 		{
-			WriteOp(spv::OpExecutionMode, mainFunctionId, spv::ExecutionModePixelInterlockOrderedEXT);
+			WriteOp(spv::OpExecutionMode, mainFunctionId, GetInterlockExecutionMode(interlockMode));
+		}
+		if(m_shaderBuilder.GetMetadata(CShaderBuilder::METADATA_EARLY_FRAGMENT_TESTS, 0))
+		{
+			WriteOp(spv::OpExecutionMode, mainFunctionId, spv::ExecutionModeEarlyFragmentTests);
+		}
+		if(hasDepthOutput)
+		{
+			WriteOp(spv::OpExecutionMode, mainFunctionId, spv::ExecutionModeDepthReplacing);
+			auto depthMode = static_cast<DEPTH_MODE>(m_shaderBuilder.GetMetadata(CShaderBuilder::METADATA_DEPTH_MODE, DEPTH_MODE_ANY));
+			switch(depthMode)
+			{
+			case DEPTH_MODE_GREATER:
+				WriteOp(spv::OpExecutionMode, mainFunctionId, spv::ExecutionModeDepthGreater);
+				break;
+			case DEPTH_MODE_LESS:
+				WriteOp(spv::OpExecutionMode, mainFunctionId, spv::ExecutionModeDepthLess);
+				break;
+			case DEPTH_MODE_UNCHANGED:
+				WriteOp(spv::OpExecutionMode, mainFunctionId, spv::ExecutionModeDepthUnchanged);
+				break;
+			default:
+				break;
+			}
 		}
 	}
 	else if(m_shaderType == SHADER_TYPE_COMPUTE)
@@ -262,6 +618,100 @@ void CSpirvShaderGenerator::Generate()
 		RegisterIntConstant(VERTEX_OUTPUT_POINTSIZE_INDEX);
 	}
 
+	bool hasCountedLoop = hasStatement([](const CShaderBuilder::STATEMENT& statement) {
+		return (statement.op == CShaderBuilder::STATEMENT_OP_LOOP_BEGIN) &&
+		       (statement.dstRef.symbol.location != CShaderBuilder::SYMBOL_LOCATION_NULL);
+	});
+	if(hasCountedLoop)
+	{
+		RegisterIntConstant(0); //Will be required to initialize and increment loop indices
+		RegisterIntConstant(1);
+	}
+
+	{
+		//Scopes and semantics of atomic operations are constants
+		auto registerAtomicConstants =
+		    [&](const CShaderBuilder::StatementList& statements) {
+			    for(const auto& statement : statements)
+			    {
+				    if(!IsAtomicStatement(statement.op)) continue;
+				    const auto& resource = statement.src1Ref.symbol;
+				    RegisterIntConstant(GetAtomicScope(statement.param));
+				    RegisterIntConstant(GetAtomicSemantics(resource, GetAtomicOrder(statement.param)));
+				    if(statement.op == CShaderBuilder::STATEMENT_OP_ATOMICCOMPAREEXCHANGE)
+				    {
+					    RegisterIntConstant(GetAtomicSemantics(resource, GetAtomicUnequalOrder(statement.param)));
+				    }
+				    RegisterUintConstant(0); //Will be required to expand the result to 4 components
+			    }
+		    };
+		registerAtomicConstants(m_shaderBuilder.GetStatements());
+		for(const auto& function : m_shaderBuilder.GetFunctions())
+		{
+			registerAtomicConstants(function.statements);
+		}
+	}
+
+	if(hasStatement([](const CShaderBuilder::STATEMENT& statement) { return statement.op == CShaderBuilder::STATEMENT_OP_WORKGROUP_BARRIER; }))
+	{
+		RegisterIntConstant(spv::ScopeWorkgroup);
+		RegisterIntConstant(WORKGROUP_BARRIER_SEMANTICS);
+	}
+
+	if(hasStatement([](const CShaderBuilder::STATEMENT& statement) { return statement.op == CShaderBuilder::STATEMENT_OP_DEVICE_MEMORY_BARRIER; }))
+	{
+		RegisterIntConstant(spv::ScopeDevice);
+		RegisterIntConstant(DEVICE_MEMORY_BARRIER_SEMANTICS);
+	}
+
+	if(hasSubgroupBallot || hasSubgroupShuffle || hasSubgroupArithmetic)
+	{
+		RegisterIntConstant(spv::ScopeSubgroup);
+		//Broadcasted invocation ids must be constants
+		auto registerBroadcastIds =
+		    [&](const CShaderBuilder::StatementList& statements) {
+			    for(const auto& statement : statements)
+			    {
+				    if(statement.op != CShaderBuilder::STATEMENT_OP_SUBGROUP_BROADCAST) continue;
+				    RegisterUintConstant(statement.param);
+			    }
+		    };
+		registerBroadcastIds(m_shaderBuilder.GetStatements());
+		for(const auto& function : m_shaderBuilder.GetFunctions())
+		{
+			registerBroadcastIds(function.statements);
+		}
+	}
+
+	if(m_hasTextures)
+	{
+		//Sample offsets and gather components must be constants
+		auto registerTextureConstants =
+		    [&](const CShaderBuilder::StatementList& statements) {
+			    for(const auto& statement : statements)
+			    {
+				    if(statement.op == CShaderBuilder::STATEMENT_OP_SAMPLE_OFFSET)
+				    {
+					    RegisterIntConstant(GetSampleOffsetX(statement.param));
+					    RegisterIntConstant(GetSampleOffsetY(statement.param));
+					    if(m_sampleOffsetIds.find(statement.param) == std::end(m_sampleOffsetIds))
+					    {
+						    m_sampleOffsetIds[statement.param] = AllocateId();
+					    }
+				    }
+				    else if(statement.op == CShaderBuilder::STATEMENT_OP_GATHER)
+				    {
+					    RegisterIntConstant(statement.param);
+				    }
+			    }
+		    };
+		registerTextureConstants(m_shaderBuilder.GetStatements());
+		for(const auto& function : m_shaderBuilder.GetFunctions())
+		{
+			registerTextureConstants(function.statements);
+		}
+	}
+
 	DecorateUniformStructIds();
 
 	if(m_hasTextures)
@@ -271,20 +721,50 @@ void CSpirvShaderGenerator::Generate()
 
 	DecorateInputPointerIds();
 	DecorateOutputPointerIds();
+	DecorateVariablePointerIds();
 
 	WriteOp(spv::OpDecorate, m_uintArrayTypeId, spv::DecorationArrayStride, 4); //Make this optional
 	if(m_has8BitInt)
 		WriteOp(spv::OpDecorate, m_ucharArrayTypeId, spv::DecorationArrayStride, 1);
 	if(m_has16BitInt)
 		WriteOp(spv::OpDecorate, m_ushortArrayTypeId, spv::DecorationArrayStride, 2);
+	if(m_hasUint2Array)
+		WriteOp(spv::OpDecorate, m_uint2ArrayTypeId, spv::DecorationArrayStride, 8);
+	if(m_hasUint4Array)
+		WriteOp(spv::OpDecorate, m_uint4ArrayTypeId, spv::DecorationArrayStride, 16);
+	if(m_hasBufferPointerUint)
+	{
+		WriteOp(spv::OpDecorate, m_bufferPointerUintStructTypeId, spv::DecorationBlock);
+		WriteOp(spv::OpMemberDecorate, m_bufferPointerUintStructTypeId, 0, spv::DecorationOffset, 0);
+	}
+	if(m_hasBufferPointerFloat4)
+	{
+		WriteOp(spv::OpDecorate, m_bufferPointerFloat4ArrayTypeId, spv::DecorationArrayStride, 16);
+		WriteOp(spv::OpDecorate, m_bufferPointerFloat4StructTypeId, spv::DecorationBlock);
+		WriteOp(spv::OpMemberDecorate, m_bufferPointerFloat4StructTypeId, 0, spv::DecorationOffset, 0);
+	}
+
+	//Results of relaxed precision statements are only known once functions are generated,
+	//everything following annotations is kept aside until their decorations are written
+	Framework::CMemStream declarationStream;
+	m_currentStream = &declarationStream;
 
 	//Type declarations
-	WriteOp(spv::OpTypeVoid, voidTypeId);
-	WriteOp(spv::OpTypeFunction, mainFunctionTypeId, voidTypeId);
+	WriteOp(spv::OpTypeVoid, m_voidTypeId);
+	WriteOp(spv::OpTypeFunction, mainFunctionTypeId, m_voidTypeId);
 	WriteOp(spv::OpTypeBool, m_boolTypeId);
 	WriteOp(spv::OpTypeVector, m_bool4TypeId, m_boolTypeId, 4);
 	WriteOp(spv::OpTypeFloat, m_floatTypeId, 32);
 	WriteOp(spv::OpTypeVector, m_float4TypeId, m_floatTypeId, 4);
+	if(m_hasTextures || m_hasSmallFloatUniform)
+	{
+		WriteOp(spv::OpTypeVector, m_float2TypeId, m_floatTypeId, 2);
+	}
+	if(m_hasNativeFloat16)
+	{
+		WriteOp(spv::OpTypeFloat, m_halfTypeId, 16);
+		WriteOp(spv::OpTypeVector, m_half4TypeId, m_halfTypeId, 4);
+	}
 	WriteOp(spv::OpTypeMatrix, m_matrix44TypeId, m_float4TypeId, 4);
 	WriteOp(spv::OpTypeInt, m_intTypeId, 32, 1);
 	WriteOp(spv::OpTypeVector, m_int2TypeId, m_intTypeId, 2);
@@ -306,6 +786,15 @@ void CSpirvShaderGenerator::Generate()
 	}
 	WriteOp(spv::OpTypeVector, m_uint4TypeId, m_uintTypeId, 4);
 	WriteOp(spv::OpTypeRuntimeArray, m_uintArrayTypeId, m_uintTypeId); //Make this optional
+	if(m_hasUint2Array)
+	{
+		WriteOp(spv::OpTypeVector, m_uint2TypeId, m_uintTypeId, 2);
+		WriteOp(spv::OpTypeRuntimeArray, m_uint2ArrayTypeId, m_uint2TypeId);
+	}
+	if(m_hasUint4Array)
+	{
+		WriteOp(spv::OpTypeRuntimeArray, m_uint4ArrayTypeId, m_uint4TypeId);
+	}
 	WriteOp(spv::OpTypePointer, m_inputFloat4PointerTypeId, spv::StorageClassInput, m_float4TypeId);
 	WriteOp(spv::OpTypePointer, m_inputUint4PointerTypeId, spv::StorageClassInput, m_uint4TypeId);
 	WriteOp(spv::OpTypePointer, m_outputFloatPointerTypeId, spv::StorageClassOutput, m_floatTypeId);
@@ -316,6 +805,17 @@ void CSpirvShaderGenerator::Generate()
 	WriteOp(spv::OpTypePointer, m_functionUint4PointerTypeId, spv::StorageClassFunction, m_uint4TypeId);
 	WriteOp(spv::OpTypePointer, m_functionBool4PointerTypeId, spv::StorageClassFunction, m_bool4TypeId);
 
+	for(const auto& functionTypeIdPair : functionTypeIds)
+	{
+		if(functionTypeIdPair.second == mainFunctionTypeId) continue;
+		WriteOp(spv::OpTypeFunction, functionTypeIdPair.second, functionTypeIdPair.first);
+	}
+
+	if((m_shaderType == SHADER_TYPE_COMPUTE) || hasImageInt3Coord)
+	{
+		WriteOp(spv::OpTypeVector, m_int3TypeId, m_intTypeId, 3);
+	}
+
 	if(m_shaderType == SHADER_TYPE_VERTEX)
 	{
 		WriteOp(spv::OpTypeStruct, perVertexStructTypeId, m_float4TypeId, m_floatTypeId);
@@ -324,11 +824,13 @@ void CSpirvShaderGenerator::Generate()
 	}
 	else if(m_shaderType == SHADER_TYPE_COMPUTE)
 	{
-		WriteOp(spv::OpTypeVector, m_int3TypeId, m_intTypeId, 3);
+		WriteOp(spv::OpTypePointer, m_inputIntPointerTypeId, spv::StorageClassInput, m_intTypeId);
 		WriteOp(spv::OpTypePointer, m_inputInt3PointerTypeId, spv::StorageClassInput, m_int3TypeId);
 	}
-
-	DeclareUniformStructIds();
+	else if(hasSubgroupInput)
+	{
+		WriteOp(spv::OpTypePointer, m_inputIntPointerTypeId, spv::StorageClassInput, m_intTypeId);
+	}
 
 	if(m_hasTextures)
 	{
@@ -338,8 +840,7 @@ void CSpirvShaderGenerator::Generate()
 		WriteOp(spv::OpTypePointer, m_sampledImageSamplerPointerTypeId, spv::StorageClassUniformConstant, m_sampledImageSamplerTypeId);
 
 		//Storage image
-		WriteOp(spv::OpTypeImage, m_storageImage2DTypeId, m_uintTypeId, spv::Dim2D, 0, 0, 0, 2, spv::ImageFormatR32ui);
-		WriteOp(spv::OpTypePointer, m_storageImage2DPointerTypeId, spv::StorageClassUniformConstant, m_storageImage2DTypeId);
+		DeclareStorageImageTypeIds();
 		WriteOp(spv::OpTypePointer, m_imageUintPtrId, spv::StorageClassImage, m_uintTypeId);
 
 		//Subpass input
@@ -348,6 +849,18 @@ void CSpirvShaderGenerator::Generate()
 
 		WriteOp(spv::OpTypeImage, m_subpassInputUintTypeId, m_uintTypeId, spv::DimSubpassData, 0, 0, 0, 2, spv::ImageFormatUnknown);
 		WriteOp(spv::OpTypePointer, m_subpassInputUintPointerTypeId, spv::StorageClassUniformConstant, m_subpassInputUintTypeId);
+
+		//Texel buffer
+		if(m_hasUniformTexelBuffer)
+		{
+			WriteOp(spv::OpTypeImage, m_uniformTexelBufferTypeId, m_floatTypeId, spv::DimBuffer, 0, 0, 0, 1, spv::ImageFormatUnknown);
+			WriteOp(spv::OpTypePointer, m_uniformTexelBufferPointerTypeId, spv::StorageClassUniformConstant, m_uniformTexelBufferTypeId);
+		}
+		if(m_hasStorageTexelBuffer)
+		{
+			WriteOp(spv::OpTypeImage, m_storageTexelBufferUintTypeId, m_uintTypeId, spv::DimBuffer, 0, 0, 0, 2, spv::ImageFormatR32ui);
+			WriteOp(spv::OpTypePointer, m_storageTexelBufferUintPointerTypeId, spv::StorageClassUniformConstant, m_storageTexelBufferUintTypeId);
+		}
 	}
 
 	DeclareInputPointerIds();
@@ -359,20 +872,6 @@ void CSpirvShaderGenerator::Generate()
 		WriteOp(spv::OpVariable, outputPerVertexStructPointerTypeId, m_outputPerVertexVariableId, spv::StorageClassOutput);
 	}
 
-	for(auto& structInfoPair : m_structInfos)
-	{
-		auto& structInfo = structInfoPair.second;
-		auto structUnit = structInfoPair.first;
-		if(structUnit == Nuanceur::UNIFORM_UNIT_PUSHCONSTANT)
-		{
-			WriteOp(spv::OpVariable, structInfo.pointerTypeId, structInfo.variableId, spv::StorageClassPushConstant);
-		}
-		else
-		{
-			WriteOp(spv::OpVariable, structInfo.pointerTypeId, structInfo.variableId, spv::StorageClassUniform);
-		}
-	}
-
 	if(m_hasTextures)
 	{
 		DeclareTextureIds();
@@ -387,6 +886,13 @@ void CSpirvShaderGenerator::Generate()
 		WriteOp(spv::OpConstant, m_floatTypeId, floatConstantIdPair.second, floatConstantIdPair.first);
 	}
 
+	//Declare Half Constants
+	for(const auto& halfConstantIdPair : m_halfConstantIds)
+	{
+		assert(m_hasNativeFloat16);
+		WriteOp(spv::OpConstant, m_halfTypeId, halfConstantIdPair.second, halfConstantIdPair.first);
+	}
+
 	//Declare Int Constants
 	for(const auto& intConstantIdPair : m_intConstantIds)
 	{
@@ -394,6 +900,14 @@ void CSpirvShaderGenerator::Generate()
 		WriteOp(spv::OpConstant, m_intTypeId, intConstantIdPair.second, intConstantIdPair.first);
 	}
 
+	//Declare Sample Offsets
+	for(const auto& sampleOffsetIdPair : m_sampleOffsetIds)
+	{
+		auto offsetXId = m_intConstantIds[GetSampleOffsetX(sampleOffsetIdPair.first)];
+		auto offsetYId = m_intConstantIds[GetSampleOffsetY(sampleOffsetIdPair.first)];
+		WriteOp(spv::OpConstantComposite, m_int2TypeId, sampleOffsetIdPair.second, offsetXId, offsetYId);
+	}
+
 	//Declare Uint Constants
 	for(const auto& uintConstantIdPair : m_uintConstantIds)
 	{
@@ -420,415 +934,735 @@ void CSpirvShaderGenerator::Generate()
 	WriteOp(spv::OpConstantTrue, m_boolTypeId, m_boolConstantTrueId);
 
 	DeclareTemporaryValueIds();
+	auto constantTemporaryValueIds = m_temporaryValueIds;
 
-	bool returnInBlock = false;
+	//Array lengths are constants, uniform blocks and shared arrays are declared after them
+	DeclareUniformStructIds();
+	for(auto& structInfoPair : m_structInfos)
+	{
+		auto& structInfo = structInfoPair.second;
+		auto structUnit = structInfoPair.first.second;
+		if(structUnit == Nuanceur::UNIFORM_UNIT_PUSHCONSTANT)
+		{
+			WriteOp(spv::OpVariable, structInfo.pointerTypeId, structInfo.variableId, spv::StorageClassPushConstant);
+		}
+		else
+		{
+			WriteOp(spv::OpVariable, structInfo.pointerTypeId, structInfo.variableId, spv::StorageClassUniform);
+		}
+	}
+	DeclareSharedArrayIds();
+	if(m_hasTextures)
+	{
+		DeclareTextureArrayIds();
+	}
 
 	//Write main function
+	m_firstInstructionId = m_nextId;
 	{
-		WriteOp(spv::OpFunction, voidTypeId, mainFunctionId, spv::FunctionControlMaskNone, mainFunctionTypeId);
+		WriteOp(spv::OpFunction, m_voidTypeId, mainFunctionId, spv::FunctionControlMaskNone, mainFunctionTypeId);
 		WriteOp(spv::OpLabel, mainFunctionLabelId);
+		m_currentLabelId = mainFunctionLabelId;
+		m_blockTerminated = false;
 
 		DeclareVariablePointerIds();
 
-		for(const auto& statement : m_shaderBuilder.GetStatements())
+		GenerateStatements(m_shaderBuilder.GetStatements());
+
+		assert(m_controlFlowBlocks.empty());
+		if(!m_blockTerminated)
+		{
+			WriteOp(spv::OpReturn);
+		}
+		WriteOp(spv::OpFunctionEnd);
+	}
+
+	//Write user functions, temporaries start from their initial values in every function
+	for(uint32 functionIndex = 0; functionIndex < functions.size(); functionIndex++)
+	{
+		const auto& function = functions[functionIndex];
+		m_temporaryValueIds = constantTemporaryValueIds;
+
+		WriteOp(spv::OpFunction, GetFunctionReturnTypeId(function), m_functionIds[functionIndex], spv::FunctionControlMaskNone, m_functionTypeIds[functionIndex]);
+		for(const auto& parameter : function.parameters)
 		{
-			const auto& dstRef = statement.dstRef;
-			const auto& src1Ref = statement.src1Ref;
-			const auto& src2Ref = statement.src2Ref;
-			const auto& src3Ref = statement.src3Ref;
-			const auto& src4Ref = statement.src4Ref;
-			switch(statement.op)
+			auto parameterId = AllocateId();
+			WriteOp(spv::OpFunctionParameter, GetVectorTypeId(parameter.type), parameterId);
+			m_temporaryValueIds[parameter.index] = parameterId;
+		}
+
+		auto functionLabelId = AllocateId();
+		WriteOp(spv::OpLabel, functionLabelId);
+		m_currentLabelId = functionLabelId;
+		m_blockTerminated = false;
+
+		GenerateStatements(function.statements);
+
+		assert(m_controlFlowBlocks.empty());
+		if(!m_blockTerminated)
+		{
+			if(function.returnType == CShaderBuilder::SYMBOL_TYPE_NULL)
 			{
-			case CShaderBuilder::STATEMENT_OP_ADD:
-				Add(dstRef, src1Ref, src2Ref);
-				break;
-			case CShaderBuilder::STATEMENT_OP_SUBSTRACT:
-				Sub(dstRef, src1Ref, src2Ref);
-				break;
-			case CShaderBuilder::STATEMENT_OP_MULTIPLY:
+				WriteOp(spv::OpReturn);
+			}
+			else
 			{
-				auto src1Id = LoadFromSymbol(src1Ref);
+				//All paths should have returned a value already
+				WriteOp(spv::OpUnreachable);
+			}
+		}
+		WriteOp(spv::OpFunctionEnd);
+	}
+
+	m_currentStream = &m_outputStream;
+	for(auto relaxedPrecisionId : m_relaxedPrecisionIds)
+	{
+		WriteOp(spv::OpDecorate, relaxedPrecisionId, spv::DecorationRelaxedPrecision);
+	}
+	for(auto nonUniformId : m_nonUniformIds)
+	{
+		WriteOp(spv::OpDecorate, nonUniformId, spv::DecorationNonUniformEXT);
+	}
+	m_outputStream.Write(declarationStream.GetBuffer(), declarationStream.GetSize());
+
+	//Patch in bound
+	m_outputStream.Seek(12, Framework::STREAM_SEEK_SET);
+	m_outputStream.Write32(m_nextId);
+
+	m_outputStream.Seek(0, Framework::STREAM_SEEK_END);
+}
+
+void CSpirvShaderGenerator::GenerateStatements(const CShaderBuilder::StatementList& statements)
+{
+	for(auto statementIterator = statements.begin(); statementIterator != statements.end(); statementIterator++)
+	{
+		const auto& statement = *statementIterator;
+		if(m_blockTerminated && !IsControlFlowStatement(statement.op))
+		{
+			//Statements following a return are unreachable, but still need a block
+			auto unreachableLabelId = AllocateId();
+			WriteOp(spv::OpLabel, unreachableLabelId);
+			m_currentLabelId = unreachableLabelId;
+			m_blockTerminated = false;
+		}
+		const auto& dstRef = statement.dstRef;
+		const auto& src1Ref = statement.src1Ref;
+		const auto& src2Ref = statement.src2Ref;
+		const auto& src3Ref = statement.src3Ref;
+		const auto& src4Ref = statement.src4Ref;
+		switch(statement.op)
+		{
+		case CShaderBuilder::STATEMENT_OP_ADD:
+			Add(dstRef, src1Ref, src2Ref);
+			break;
+		case CShaderBuilder::STATEMENT_OP_SUBSTRACT:
+			Sub(dstRef, src1Ref, src2Ref);
+			break;
+		case CShaderBuilder::STATEMENT_OP_MULTIPLY:
+		{
+			if(src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_ARRAYMATRIX)
+			{
+				//Matrix is selected from an uniform array by the index in src3
+				assert(src2Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_FLOAT4);
 				auto src2Id = LoadFromSymbol(src2Ref);
+				auto src3Id = LoadFromSymbol(src3Ref);
+				auto indexId = AllocateId();
+				auto matrixId = AllocateId();
 				auto resultId = AllocateId();
-				if(
-				    (src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_MATRIX) &&
-				    (src2Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_FLOAT4))
-				{
-					WriteOp(spv::OpMatrixTimesVector, m_float4TypeId, resultId, src1Id, src2Id);
-				}
-				else if(
-				    (src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_FLOAT4) &&
-				    (src2Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_FLOAT4))
-				{
-					WriteOp(spv::OpFMul, m_float4TypeId, resultId, src1Id, src2Id);
-				}
-				else if(
-				    (src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_INT4) &&
-				    (src2Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_INT4))
-				{
-					WriteOp(spv::OpIMul, m_int4TypeId, resultId, src1Id, src2Id);
-				}
-				else if(
-				    (src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_UINT4) &&
-				    (src2Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_UINT4))
-				{
-					WriteOp(spv::OpIMul, m_uint4TypeId, resultId, src1Id, src2Id);
-				}
-				else
-				{
-					assert(false);
-				}
+				WriteOp(spv::OpCompositeExtract, m_intTypeId, indexId, src3Id, 0);
+				auto pointerId = GetUniformArrayElementPointerId(src1Ref, indexId);
+				WriteOp(spv::OpLoad, m_matrix44TypeId, matrixId, pointerId);
+				WriteOp(spv::OpMatrixTimesVector, m_float4TypeId, resultId, matrixId, src2Id);
 				StoreToSymbol(dstRef, resultId);
+				break;
+			}
+			auto src1Id = LoadFromSymbol(src1Ref);
+			auto src2Id = LoadFromSymbol(src2Ref);
+			auto resultId = AllocateId();
+			if(
+			    (src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_MATRIX) &&
+			    (src2Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_FLOAT4))
+			{
+				WriteOp(spv::OpMatrixTimesVector, m_float4TypeId, resultId, src1Id, src2Id);
+			}
+			else if(
+			    (src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_FLOAT4) &&
+			    (src2Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_FLOAT4))
+			{
+				WriteOp(spv::OpFMul, m_float4TypeId, resultId, src1Id, src2Id);
+			}
+			else if(
+			    (src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_HALF4) &&
+			    (src2Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_HALF4))
+			{
+				WriteOp(spv::OpFMul, m_half4TypeId, resultId, src1Id, src2Id);
+			}
+			else if(
+			    (src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_INT4) &&
+			    (src2Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_INT4))
+			{
+				WriteOp(spv::OpIMul, m_int4TypeId, resultId, src1Id, src2Id);
 			}
+			else if(
+			    (src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_UINT4) &&
+			    (src2Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_UINT4))
+			{
+				WriteOp(spv::OpIMul, m_uint4TypeId, resultId, src1Id, src2Id);
+			}
+			else
+			{
+				assert(false);
+			}
+			StoreToSymbol(dstRef, resultId);
+		}
+		break;
+		case CShaderBuilder::STATEMENT_OP_DIVIDE:
+			Div(dstRef, src1Ref, src2Ref);
 			break;
-			case CShaderBuilder::STATEMENT_OP_DIVIDE:
-				Div(dstRef, src1Ref, src2Ref);
-				break;
-			case CShaderBuilder::STATEMENT_OP_MODULO:
-				Mod(dstRef, src1Ref, src2Ref);
-				break;
-			case CShaderBuilder::STATEMENT_OP_NEGATE:
-				Negate(dstRef, src1Ref);
-				break;
-			case CShaderBuilder::STATEMENT_OP_ABS:
-				GlslStdOp(GLSLstd450FAbs, dstRef, src1Ref);
-				break;
-			case CShaderBuilder::STATEMENT_OP_CLAMP:
-				Clamp(dstRef, src1Ref, src2Ref, src3Ref);
-				break;
-			case CShaderBuilder::STATEMENT_OP_FRACT:
-				GlslStdOp(GLSLstd450Fract, dstRef, src1Ref);
-				break;
-			case CShaderBuilder::STATEMENT_OP_TRUNC:
-				GlslStdOp(GLSLstd450Trunc, dstRef, src1Ref);
-				break;
-			case CShaderBuilder::STATEMENT_OP_ISINF:
-				ClassifyFloat(spv::OpIsInf, dstRef, src1Ref);
-				break;
-			case CShaderBuilder::STATEMENT_OP_LOG2:
-				GlslStdOp(GLSLstd450Log2, dstRef, src1Ref);
-				break;
-			case CShaderBuilder::STATEMENT_OP_MIN:
-				Min(dstRef, src1Ref, src2Ref);
-				break;
-			case CShaderBuilder::STATEMENT_OP_MAX:
-				Max(dstRef, src1Ref, src2Ref);
-				break;
-			case CShaderBuilder::STATEMENT_OP_DOT:
-				Dot(dstRef, src1Ref, src2Ref);
-				break;
-			case CShaderBuilder::STATEMENT_OP_MIX:
-				Mix(dstRef, src1Ref, src2Ref, src3Ref);
-				break;
-			case CShaderBuilder::STATEMENT_OP_AND:
-				BitwiseOp(spv::OpBitwiseAnd, dstRef, src1Ref, src2Ref);
-				break;
-			case CShaderBuilder::STATEMENT_OP_OR:
-				BitwiseOp(spv::OpBitwiseOr, dstRef, src1Ref, src2Ref);
+		case CShaderBuilder::STATEMENT_OP_MODULO:
+			Mod(dstRef, src1Ref, src2Ref);
+			break;
+		case CShaderBuilder::STATEMENT_OP_NEGATE:
+			Negate(dstRef, src1Ref);
+			break;
+		case CShaderBuilder::STATEMENT_OP_ABS:
+			GlslStdOp(GLSLstd450FAbs, dstRef, src1Ref);
+			break;
+		case CShaderBuilder::STATEMENT_OP_CLAMP:
+			Clamp(dstRef, src1Ref, src2Ref, src3Ref);
+			break;
+		case CShaderBuilder::STATEMENT_OP_FRACT:
+			GlslStdOp(GLSLstd450Fract, dstRef, src1Ref);
+			break;
+		case CShaderBuilder::STATEMENT_OP_TRUNC:
+			GlslStdOp(GLSLstd450Trunc, dstRef, src1Ref);
+			break;
+		case CShaderBuilder::STATEMENT_OP_ISINF:
+			ClassifyFloat(spv::OpIsInf, dstRef, src1Ref);
+			break;
+		case CShaderBuilder::STATEMENT_OP_LOG2:
+			GlslStdOp(GLSLstd450Log2, dstRef, src1Ref);
+			break;
+		case CShaderBuilder::STATEMENT_OP_MIN:
+			Min(dstRef, src1Ref, src2Ref);
+			break;
+		case CShaderBuilder::STATEMENT_OP_MAX:
+			Max(dstRef, src1Ref, src2Ref);
+			break;
+		case CShaderBuilder::STATEMENT_OP_DOT:
+			Dot(dstRef, src1Ref, src2Ref);
+			break;
+		case CShaderBuilder::STATEMENT_OP_MIX:
+			Mix(dstRef, src1Ref, src2Ref, src3Ref);
+			break;
+		case CShaderBuilder::STATEMENT_OP_AND:
+			BitwiseOp(spv::OpBitwiseAnd, dstRef, src1Ref, src2Ref);
+			break;
+		case CShaderBuilder::STATEMENT_OP_OR:
+			BitwiseOp(spv::OpBitwiseOr, dstRef, src1Ref, src2Ref);
+			break;
+		case CShaderBuilder::STATEMENT_OP_XOR:
+			BitwiseOp(spv::OpBitwiseXor, dstRef, src1Ref, src2Ref);
+			break;
+		case CShaderBuilder::STATEMENT_OP_NOT:
+			BitwiseNot(dstRef, src1Ref);
+			break;
+		case CShaderBuilder::STATEMENT_OP_LSHIFT:
+			BitwiseOp(spv::OpShiftLeftLogical, dstRef, src1Ref, src2Ref);
+			break;
+		case CShaderBuilder::STATEMENT_OP_RSHIFT:
+			BitwiseOp(spv::OpShiftRightLogical, dstRef, src1Ref, src2Ref);
+			break;
+		case CShaderBuilder::STATEMENT_OP_RSHIFT_ARITHMETIC:
+			BitwiseOp(spv::OpShiftRightArithmetic, dstRef, src1Ref, src2Ref);
+			break;
+		case CShaderBuilder::STATEMENT_OP_LOGICAL_AND:
+			LogicalOp(spv::OpLogicalAnd, dstRef, src1Ref, src2Ref);
+			break;
+		case CShaderBuilder::STATEMENT_OP_LOGICAL_OR:
+			LogicalOp(spv::OpLogicalOr, dstRef, src1Ref, src2Ref);
+			break;
+		case CShaderBuilder::STATEMENT_OP_LOGICAL_NOT:
+			LogicalNot(dstRef, src1Ref);
+			break;
+		case CShaderBuilder::STATEMENT_OP_COMPARE_EQ:
+		case CShaderBuilder::STATEMENT_OP_COMPARE_NE:
+		case CShaderBuilder::STATEMENT_OP_COMPARE_LT:
+		case CShaderBuilder::STATEMENT_OP_COMPARE_LE:
+		case CShaderBuilder::STATEMENT_OP_COMPARE_GT:
+		case CShaderBuilder::STATEMENT_OP_COMPARE_GE:
+			Compare(statement.op, dstRef, src1Ref, src2Ref);
+			break;
+		case CShaderBuilder::STATEMENT_OP_SAMPLE:
+		{
+			auto src1Id = LoadFromSymbol(src1Ref);
+			auto src2Id = LoadFromSymbol(src2Ref);
+			auto resultId = AllocateId();
+			WriteOp(spv::OpImageSampleImplicitLod, m_float4TypeId, resultId, src1Id, src2Id);
+			StoreToSymbol(dstRef, resultId);
+		}
+		break;
+		case CShaderBuilder::STATEMENT_OP_SAMPLE_LOD:
+		case CShaderBuilder::STATEMENT_OP_SAMPLE_GRAD:
+		case CShaderBuilder::STATEMENT_OP_SAMPLE_OFFSET:
+		case CShaderBuilder::STATEMENT_OP_FETCH:
+		case CShaderBuilder::STATEMENT_OP_GATHER:
+			TextureOp(statement);
+			break;
+		case CShaderBuilder::STATEMENT_OP_SELECT_TEXTURE:
+			SelectTexture(statement);
+			break;
+		case CShaderBuilder::STATEMENT_OP_SELECT_BUFFER:
+			SelectBuffer(statement);
+			break;
+		case CShaderBuilder::STATEMENT_OP_LOAD:
+			Load(dstRef, src1Ref, src2Ref);
+			break;
+		case CShaderBuilder::STATEMENT_OP_STORE:
+			Store(src1Ref, src2Ref, src3Ref);
+			break;
+		case CShaderBuilder::STATEMENT_OP_STORE16:
+			Store16(src1Ref, src2Ref, src3Ref);
+			break;
+		case CShaderBuilder::STATEMENT_OP_STORE8:
+			Store8(src1Ref, src2Ref, src3Ref);
+			break;
+		case CShaderBuilder::STATEMENT_OP_ATOMICAND:
+			AtomicImageOp(spv::OpAtomicAnd, statement);
+			break;
+		case CShaderBuilder::STATEMENT_OP_ATOMICOR:
+			AtomicImageOp(spv::OpAtomicOr, statement);
+			break;
+		case CShaderBuilder::STATEMENT_OP_ATOMICXOR:
+			AtomicImageOp(spv::OpAtomicXor, statement);
+			break;
+		case CShaderBuilder::STATEMENT_OP_ATOMICADD:
+			AtomicImageOp(spv::OpAtomicIAdd, statement);
+			break;
+		case CShaderBuilder::STATEMENT_OP_ATOMICMIN:
+			AtomicImageOp(spv::OpAtomicUMin, statement);
+			break;
+		case CShaderBuilder::STATEMENT_OP_ATOMICMAX:
+			AtomicImageOp(spv::OpAtomicUMax, statement);
+			break;
+		case CShaderBuilder::STATEMENT_OP_ATOMICEXCHANGE:
+			AtomicImageOp(spv::OpAtomicExchange, statement);
+			break;
+		case CShaderBuilder::STATEMENT_OP_ATOMICCOMPAREEXCHANGE:
+			AtomicImageOp(spv::OpAtomicCompareExchange, statement);
+			break;
+		case CShaderBuilder::STATEMENT_OP_SUBGROUP_BALLOT:
+			SubgroupBallot(dstRef, src1Ref);
+			break;
+		case CShaderBuilder::STATEMENT_OP_SUBGROUP_BROADCAST:
+			SubgroupBroadcast(dstRef, src1Ref, statement.param);
+			break;
+		case CShaderBuilder::STATEMENT_OP_SUBGROUP_SHUFFLE:
+			SubgroupShuffle(dstRef, src1Ref, src2Ref);
+			break;
+		case CShaderBuilder::STATEMENT_OP_SUBGROUP_ADD:
+			SubgroupArithmeticOp(spv::OpGroupNonUniformFAdd, spv::OpGroupNonUniformIAdd, spv::OpGroupNonUniformIAdd, dstRef, src1Ref, statement.param);
+			break;
+		case CShaderBuilder::STATEMENT_OP_SUBGROUP_MIN:
+			SubgroupArithmeticOp(spv::OpGroupNonUniformFMin, spv::OpGroupNonUniformSMin, spv::OpGroupNonUniformUMin, dstRef, src1Ref, statement.param);
+			break;
+		case CShaderBuilder::STATEMENT_OP_SUBGROUP_MAX:
+			SubgroupArithmeticOp(spv::OpGroupNonUniformFMax, spv::OpGroupNonUniformSMax, spv::OpGroupNonUniformUMax, dstRef, src1Ref, statement.param);
+			break;
+		case CShaderBuilder::STATEMENT_OP_SUBGROUP_AND:
+			SubgroupArithmeticOp(spv::OpNop, spv::OpGroupNonUniformBitwiseAnd, spv::OpGroupNonUniformBitwiseAnd, dstRef, src1Ref, statement.param);
+			break;
+		case CShaderBuilder::STATEMENT_OP_SUBGROUP_OR:
+			SubgroupArithmeticOp(spv::OpNop, spv::OpGroupNonUniformBitwiseOr, spv::OpGroupNonUniformBitwiseOr, dstRef, src1Ref, statement.param);
+			break;
+		case CShaderBuilder::STATEMENT_OP_TOFLOAT:
+		{
+			auto src1Id = LoadFromSymbol(src1Ref);
+			auto resultId = AllocateId();
+			switch(src1Ref.symbol.type)
+			{
+			case CShaderBuilder::SYMBOL_TYPE_INT4:
+				WriteOp(spv::OpConvertSToF, m_float4TypeId, resultId, src1Id);
 				break;
-			case CShaderBuilder::STATEMENT_OP_XOR:
-				BitwiseOp(spv::OpBitwiseXor, dstRef, src1Ref, src2Ref);
+			case CShaderBuilder::SYMBOL_TYPE_UINT4:
+				WriteOp(spv::OpConvertUToF, m_float4TypeId, resultId, src1Id);
 				break;
-			case CShaderBuilder::STATEMENT_OP_NOT:
-				BitwiseNot(dstRef, src1Ref);
+			case CShaderBuilder::SYMBOL_TYPE_HALF4:
+				if(m_hasNativeFloat16)
+				{
+					WriteOp(spv::OpFConvert, m_float4TypeId, resultId, src1Id);
+				}
+				else
+				{
+					WriteOp(spv::OpCopyObject, m_float4TypeId, resultId, src1Id);
+				}
 				break;
-			case CShaderBuilder::STATEMENT_OP_LSHIFT:
-				BitwiseOp(spv::OpShiftLeftLogical, dstRef, src1Ref, src2Ref);
+			default:
+				assert(false);
 				break;
-			case CShaderBuilder::STATEMENT_OP_RSHIFT:
-				BitwiseOp(spv::OpShiftRightLogical, dstRef, src1Ref, src2Ref);
+			}
+			StoreToSymbol(dstRef, resultId);
+		}
+		break;
+		case CShaderBuilder::STATEMENT_OP_TOHALF:
+		{
+			assert(src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_FLOAT4);
+			auto src1Id = LoadFromSymbol(src1Ref);
+			auto resultId = AllocateId();
+			if(m_hasNativeFloat16)
+			{
+				WriteOp(spv::OpFConvert, m_half4TypeId, resultId, src1Id);
+			}
+			else
+			{
+				WriteOp(spv::OpCopyObject, m_half4TypeId, resultId, src1Id);
+			}
+			StoreToSymbol(dstRef, resultId);
+		}
+		break;
+		case CShaderBuilder::STATEMENT_OP_TOINT:
+		{
+			auto src1Id = LoadFromSymbol(src1Ref);
+			auto resultId = AllocateId();
+			switch(src1Ref.symbol.type)
+			{
+			case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
+				WriteOp(spv::OpConvertFToS, m_int4TypeId, resultId, src1Id);
 				break;
-			case CShaderBuilder::STATEMENT_OP_RSHIFT_ARITHMETIC:
-				BitwiseOp(spv::OpShiftRightArithmetic, dstRef, src1Ref, src2Ref);
+			case CShaderBuilder::SYMBOL_TYPE_UINT4:
+				WriteOp(spv::OpBitcast, m_int4TypeId, resultId, src1Id);
 				break;
-			case CShaderBuilder::STATEMENT_OP_LOGICAL_AND:
-				LogicalOp(spv::OpLogicalAnd, dstRef, src1Ref, src2Ref);
+			default:
+				assert(false);
 				break;
-			case CShaderBuilder::STATEMENT_OP_LOGICAL_OR:
-				LogicalOp(spv::OpLogicalOr, dstRef, src1Ref, src2Ref);
+			}
+			StoreToSymbol(dstRef, resultId);
+		}
+		break;
+		case CShaderBuilder::STATEMENT_OP_TOUINT:
+		{
+			auto src1Id = LoadFromSymbol(src1Ref);
+			auto resultId = AllocateId();
+			switch(src1Ref.symbol.type)
+			{
+			case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
+				WriteOp(spv::OpConvertFToU, m_uint4TypeId, resultId, src1Id);
 				break;
-			case CShaderBuilder::STATEMENT_OP_LOGICAL_NOT:
-				LogicalNot(dstRef, src1Ref);
+			case CShaderBuilder::SYMBOL_TYPE_INT4:
+				WriteOp(spv::OpBitcast, m_uint4TypeId, resultId, src1Id);
 				break;
-			case CShaderBuilder::STATEMENT_OP_COMPARE_EQ:
-			case CShaderBuilder::STATEMENT_OP_COMPARE_NE:
-			case CShaderBuilder::STATEMENT_OP_COMPARE_LT:
-			case CShaderBuilder::STATEMENT_OP_COMPARE_LE:
-			case CShaderBuilder::STATEMENT_OP_COMPARE_GT:
-			case CShaderBuilder::STATEMENT_OP_COMPARE_GE:
-				Compare(statement.op, dstRef, src1Ref, src2Ref);
+			default:
+				assert(false);
 				break;
-			case CShaderBuilder::STATEMENT_OP_SAMPLE:
-			{
-				auto src1Id = LoadFromSymbol(src1Ref);
-				auto src2Id = LoadFromSymbol(src2Ref);
-				auto resultId = AllocateId();
-				WriteOp(spv::OpImageSampleImplicitLod, m_float4TypeId, resultId, src1Id, src2Id);
-				StoreToSymbol(dstRef, resultId);
 			}
-			break;
-			case CShaderBuilder::STATEMENT_OP_LOAD:
-				Load(dstRef, src1Ref, src2Ref);
+			StoreToSymbol(dstRef, resultId);
+		}
+		break;
+		case CShaderBuilder::STATEMENT_OP_TOUCHAR:
+		{
+			auto src1Id = LoadFromSymbol(src1Ref);
+			auto resultId = AllocateId();
+			switch(src1Ref.symbol.type)
+			{
+			case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
+				WriteOp(spv::OpConvertFToU, m_uchar4TypeId, resultId, src1Id);
 				break;
-			case CShaderBuilder::STATEMENT_OP_STORE:
-				Store(src1Ref, src2Ref, src3Ref);
+			case CShaderBuilder::SYMBOL_TYPE_UINT4:
+				WriteOp(spv::OpUConvert, m_uchar4TypeId, resultId, src1Id);
 				break;
-			case CShaderBuilder::STATEMENT_OP_STORE16:
-				Store16(src1Ref, src2Ref, src3Ref);
+			default:
+				assert(false);
 				break;
-			case CShaderBuilder::STATEMENT_OP_STORE8:
-				Store8(src1Ref, src2Ref, src3Ref);
+			}
+			StoreToSymbol(dstRef, resultId);
+		}
+		break;
+		case CShaderBuilder::STATEMENT_OP_TOUSHORT:
+		{
+			auto src1Id = LoadFromSymbol(src1Ref);
+			auto resultId = AllocateId();
+			switch(src1Ref.symbol.type)
+			{
+			case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
+				WriteOp(spv::OpConvertFToU, m_ushort4TypeId, resultId, src1Id);
 				break;
-			case CShaderBuilder::STATEMENT_OP_ATOMICAND:
-				AtomicImageOp(spv::OpAtomicAnd, dstRef, src1Ref, src2Ref, src3Ref);
+			case CShaderBuilder::SYMBOL_TYPE_UINT4:
+				WriteOp(spv::OpUConvert, m_ushort4TypeId, resultId, src1Id);
 				break;
-			case CShaderBuilder::STATEMENT_OP_ATOMICOR:
-				AtomicImageOp(spv::OpAtomicOr, dstRef, src1Ref, src2Ref, src3Ref);
+			default:
+				assert(false);
 				break;
-			case CShaderBuilder::STATEMENT_OP_TOFLOAT:
+			}
+			StoreToSymbol(dstRef, resultId);
+		}
+		break;
+		case CShaderBuilder::STATEMENT_OP_NEWVECTOR2:
+		{
+			auto resultType = GetResultType(statement.dstRef.symbol.type);
+			assert(statement.GetSourceCount() == 2);
+			assert(GetSwizzleElementCount(statement.src1Ref.swizzle) == 1);
+			assert(GetSwizzleElementCount(statement.src2Ref.swizzle) == 1);
+
+			auto src1Id = LoadFromSymbol(src1Ref);
+			auto src2Id = LoadFromSymbol(src2Ref);
+			auto resultId = AllocateId();
+			WriteOp(spv::OpVectorShuffle, resultType, resultId, src1Id, src2Id, 0, 4, 0, 0);
+			StoreToSymbol(dstRef, resultId);
+		}
+		break;
+		case CShaderBuilder::STATEMENT_OP_NEWVECTOR4:
+		{
+			auto resultType = GetResultType(statement.dstRef.symbol.type);
+			switch(statement.GetSourceCount())
 			{
-				auto src1Id = LoadFromSymbol(src1Ref);
-				auto resultId = AllocateId();
-				switch(src1Ref.symbol.type)
+			case 2:
+			{
+				uint32 src1ElementCount = GetSwizzleElementCount(statement.src1Ref.swizzle);
+				uint32 src2ElementCount = GetSwizzleElementCount(statement.src2Ref.swizzle);
+				assert((src1ElementCount + src2ElementCount) == 4);
+				if(
+				    (src1ElementCount == 3) &&
+				    (src2ElementCount == 1))
 				{
-				case CShaderBuilder::SYMBOL_TYPE_INT4:
-					WriteOp(spv::OpConvertSToF, m_float4TypeId, resultId, src1Id);
-					break;
-				case CShaderBuilder::SYMBOL_TYPE_UINT4:
-					WriteOp(spv::OpConvertUToF, m_float4TypeId, resultId, src1Id);
-					break;
-				default:
-					assert(false);
-					break;
+					auto src1Id = LoadFromSymbol(src1Ref);
+					auto src2Id = LoadFromSymbol(src2Ref);
+					auto resultId = AllocateId();
+					WriteOp(spv::OpVectorShuffle, resultType, resultId, src1Id, src2Id, 0, 1, 2, 4);
+					StoreToSymbol(dstRef, resultId);
 				}
-				StoreToSymbol(dstRef, resultId);
-			}
-			break;
-			case CShaderBuilder::STATEMENT_OP_TOINT:
-			{
-				auto src1Id = LoadFromSymbol(src1Ref);
-				auto resultId = AllocateId();
-				switch(src1Ref.symbol.type)
+				else if(
+				    (statement.src1Ref.swizzle == SWIZZLE_X) &&
+				    (statement.src2Ref.swizzle == SWIZZLE_XYZ))
 				{
-				case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
-					WriteOp(spv::OpConvertFToS, m_int4TypeId, resultId, src1Id);
-					break;
-				case CShaderBuilder::SYMBOL_TYPE_UINT4:
-					WriteOp(spv::OpBitcast, m_int4TypeId, resultId, src1Id);
-					break;
-				default:
-					assert(false);
-					break;
+					auto src1Id = LoadFromSymbol(src1Ref);
+					auto src2Id = LoadFromSymbol(src2Ref);
+					auto resultId = AllocateId();
+					WriteOp(spv::OpVectorShuffle, resultType, resultId, src1Id, src2Id, 0, 4, 5, 6);
+					StoreToSymbol(dstRef, resultId);
 				}
-				StoreToSymbol(dstRef, resultId);
-			}
-			break;
-			case CShaderBuilder::STATEMENT_OP_TOUINT:
-			{
-				auto src1Id = LoadFromSymbol(src1Ref);
-				auto resultId = AllocateId();
-				switch(src1Ref.symbol.type)
+				else if(
+				    (statement.src1Ref.swizzle == SWIZZLE_XY) &&
+				    (statement.src2Ref.swizzle == SWIZZLE_XY))
 				{
-				case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
-					WriteOp(spv::OpConvertFToU, m_uint4TypeId, resultId, src1Id);
-					break;
-				case CShaderBuilder::SYMBOL_TYPE_INT4:
-					WriteOp(spv::OpBitcast, m_uint4TypeId, resultId, src1Id);
-					break;
-				default:
-					assert(false);
-					break;
+					auto src1Id = LoadFromSymbol(src1Ref);
+					auto src2Id = LoadFromSymbol(src2Ref);
+					auto resultId = AllocateId();
+					WriteOp(spv::OpVectorShuffle, resultType, resultId, src1Id, src2Id, 0, 1, 4, 5);
+					StoreToSymbol(dstRef, resultId);
 				}
-				StoreToSymbol(dstRef, resultId);
-			}
-			break;
-			case CShaderBuilder::STATEMENT_OP_TOUCHAR:
-			{
-				auto src1Id = LoadFromSymbol(src1Ref);
-				auto resultId = AllocateId();
-				switch(src1Ref.symbol.type)
+				else
 				{
-				case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
-					WriteOp(spv::OpConvertFToU, m_uchar4TypeId, resultId, src1Id);
-					break;
-				case CShaderBuilder::SYMBOL_TYPE_UINT4:
-					WriteOp(spv::OpUConvert, m_uchar4TypeId, resultId, src1Id);
-					break;
-				default:
 					assert(false);
-					break;
 				}
-				StoreToSymbol(dstRef, resultId);
 			}
 			break;
-			case CShaderBuilder::STATEMENT_OP_TOUSHORT:
-			{
-				auto src1Id = LoadFromSymbol(src1Ref);
-				auto resultId = AllocateId();
-				switch(src1Ref.symbol.type)
+			case 4:
+				if(
+				    (statement.src1Ref.swizzle == SWIZZLE_X) &&
+				    (statement.src2Ref.swizzle == SWIZZLE_X) &&
+				    (statement.src3Ref.swizzle == SWIZZLE_X) &&
+				    (statement.src4Ref.swizzle == SWIZZLE_X))
+				{
+					auto src1Id = LoadFromSymbol(src1Ref);
+					auto src2Id = LoadFromSymbol(src2Ref);
+					auto src3Id = LoadFromSymbol(src3Ref);
+					auto src4Id = LoadFromSymbol(src4Ref);
+					auto resultInterId1 = AllocateId();
+					auto resultInterId2 = AllocateId();
+					auto resultId = AllocateId();
+					WriteOp(spv::OpVectorShuffle, resultType, resultInterId1, src1Id, src2Id, 0, 4, 0, 0);
+					WriteOp(spv::OpVectorShuffle, resultType, resultInterId2, src3Id, src4Id, 0, 4, 0, 0);
+					WriteOp(spv::OpVectorShuffle, resultType, resultId, resultInterId1, resultInterId2, 0, 1, 4, 5);
+					StoreToSymbol(dstRef, resultId);
+				}
+				else
 				{
-				case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
-					WriteOp(spv::OpConvertFToU, m_ushort4TypeId, resultId, src1Id);
-					break;
-				case CShaderBuilder::SYMBOL_TYPE_UINT4:
-					WriteOp(spv::OpUConvert, m_ushort4TypeId, resultId, src1Id);
-					break;
-				default:
 					assert(false);
-					break;
 				}
-				StoreToSymbol(dstRef, resultId);
+				break;
+			default:
+				assert(false);
+				break;
 			}
-			break;
-			case CShaderBuilder::STATEMENT_OP_NEWVECTOR2:
+		}
+		break;
+		case CShaderBuilder::STATEMENT_OP_ASSIGN:
+		{
+			auto src1Id = LoadFromSymbol(src1Ref);
+			StoreToSymbol(dstRef, src1Id);
+		}
+		break;
+		case CShaderBuilder::STATEMENT_OP_RETURN:
+			assert(!m_blockTerminated);
+			m_blockTerminated = true;
+			if(src1Ref.symbol.location != CShaderBuilder::SYMBOL_LOCATION_NULL)
 			{
-				auto resultType = GetResultType(statement.dstRef.symbol.type);
-				assert(statement.GetSourceCount() == 2);
-				assert(GetSwizzleElementCount(statement.src1Ref.swizzle) == 1);
-				assert(GetSwizzleElementCount(statement.src2Ref.swizzle) == 1);
-
 				auto src1Id = LoadFromSymbol(src1Ref);
-				auto src2Id = LoadFromSymbol(src2Ref);
-				auto resultId = AllocateId();
-				WriteOp(spv::OpVectorShuffle, resultType, resultId, src1Id, src2Id, 0, 4, 0, 0);
-				StoreToSymbol(dstRef, resultId);
+				WriteOp(spv::OpReturnValue, src1Id);
 			}
-			break;
-			case CShaderBuilder::STATEMENT_OP_NEWVECTOR4:
+			else
 			{
-				auto resultType = GetResultType(statement.dstRef.symbol.type);
-				switch(statement.GetSourceCount())
-				{
-				case 2:
-				{
-					uint32 src1ElementCount = GetSwizzleElementCount(statement.src1Ref.swizzle);
-					uint32 src2ElementCount = GetSwizzleElementCount(statement.src2Ref.swizzle);
-					assert((src1ElementCount + src2ElementCount) == 4);
-					if(
-					    (src1ElementCount == 3) &&
-					    (src2ElementCount == 1))
-					{
-						auto src1Id = LoadFromSymbol(src1Ref);
-						auto src2Id = LoadFromSymbol(src2Ref);
-						auto resultId = AllocateId();
-						WriteOp(spv::OpVectorShuffle, resultType, resultId, src1Id, src2Id, 0, 1, 2, 4);
-						StoreToSymbol(dstRef, resultId);
-					}
-					else if(
-					    (statement.src1Ref.swizzle == SWIZZLE_X) &&
-					    (statement.src2Ref.swizzle == SWIZZLE_XYZ))
-					{
-						auto src1Id = LoadFromSymbol(src1Ref);
-						auto src2Id = LoadFromSymbol(src2Ref);
-						auto resultId = AllocateId();
-						WriteOp(spv::OpVectorShuffle, resultType, resultId, src1Id, src2Id, 0, 4, 5, 6);
-						StoreToSymbol(dstRef, resultId);
-					}
-					else if(
-					    (statement.src1Ref.swizzle == SWIZZLE_XY) &&
-					    (statement.src2Ref.swizzle == SWIZZLE_XY))
-					{
-						auto src1Id = LoadFromSymbol(src1Ref);
-						auto src2Id = LoadFromSymbol(src2Ref);
-						auto resultId = AllocateId();
-						WriteOp(spv::OpVectorShuffle, resultType, resultId, src1Id, src2Id, 0, 1, 4, 5);
-						StoreToSymbol(dstRef, resultId);
-					}
-					else
-					{
-						assert(false);
-					}
-				}
-				break;
-				case 4:
-					if(
-					    (statement.src1Ref.swizzle == SWIZZLE_X) &&
-					    (statement.src2Ref.swizzle == SWIZZLE_X) &&
-					    (statement.src3Ref.swizzle == SWIZZLE_X) &&
-					    (statement.src4Ref.swizzle == SWIZZLE_X))
-					{
-						auto src1Id = LoadFromSymbol(src1Ref);
-						auto src2Id = LoadFromSymbol(src2Ref);
-						auto src3Id = LoadFromSymbol(src3Ref);
-						auto src4Id = LoadFromSymbol(src4Ref);
-						auto resultInterId1 = AllocateId();
-						auto resultInterId2 = AllocateId();
-						auto resultId = AllocateId();
-						WriteOp(spv::OpVectorShuffle, resultType, resultInterId1, src1Id, src2Id, 0, 4, 0, 0);
-						WriteOp(spv::OpVectorShuffle, resultType, resultInterId2, src3Id, src4Id, 0, 4, 0, 0);
-						WriteOp(spv::OpVectorShuffle, resultType, resultId, resultInterId1, resultInterId2, 0, 1, 4, 5);
-						StoreToSymbol(dstRef, resultId);
-					}
-					else
-					{
-						assert(false);
-					}
-					break;
-				default:
-					assert(false);
-					break;
-				}
+				WriteOp(spv::OpReturn);
 			}
 			break;
-			case CShaderBuilder::STATEMENT_OP_ASSIGN:
+		case CShaderBuilder::STATEMENT_OP_CALL:
+		{
+			assert(statement.param < m_functionIds.size());
+			const auto& function = m_shaderBuilder.GetFunctions()[statement.param];
+			std::vector<uint32> argIds;
+			for(const auto* argRef : {&src1Ref, &src2Ref, &src3Ref, &src4Ref})
 			{
-				auto src1Id = LoadFromSymbol(src1Ref);
-				StoreToSymbol(dstRef, src1Id);
+				if(argRef->symbol.location == CShaderBuilder::SYMBOL_LOCATION_NULL) break;
+				argIds.push_back(LoadFromSymbol(*argRef));
 			}
-			break;
-			case CShaderBuilder::STATEMENT_OP_RETURN:
-				assert(!returnInBlock);
-				returnInBlock = true;
-				WriteOp(spv::OpReturn);
-				break;
-			case CShaderBuilder::STATEMENT_OP_INVOCATION_INTERLOCK_BEGIN:
-				WriteOp(spv::OpBeginInvocationInterlockEXT);
-				break;
-			case CShaderBuilder::STATEMENT_OP_INVOCATION_INTERLOCK_END:
-				WriteOp(spv::OpEndInvocationInterlockEXT);
-				break;
-			case CShaderBuilder::STATEMENT_OP_IF_BEGIN:
+			assert(argIds.size() == function.parameters.size());
+			auto resultId = AllocateId();
+			WriteOp(spv::OpFunctionCall, GetFunctionReturnTypeId(function), resultId, m_functionIds[statement.param], argIds);
+			if(dstRef.symbol.location != CShaderBuilder::SYMBOL_LOCATION_NULL)
 			{
-				assert(src1Ref.swizzle == SWIZZLE_X);
-				auto src1Id = LoadFromSymbol(src1Ref);
-				auto beginLabelId = AllocateId();
-				auto endLabelId = AllocateId();
-				auto conditionId = AllocateId();
-				WriteOp(spv::OpCompositeExtract, m_boolTypeId, conditionId, src1Id, 0);
-				WriteOp(spv::OpSelectionMerge, endLabelId, spv::SelectionControlMaskNone);
-				WriteOp(spv::OpBranchConditional, conditionId, beginLabelId, endLabelId);
-				WriteOp(spv::OpLabel, beginLabelId);
-				m_endLabelIds.push(endLabelId);
+				StoreToSymbol(dstRef, resultId);
 			}
+		}
+		break;
+		case CShaderBuilder::STATEMENT_OP_INVOCATION_INTERLOCK_BEGIN:
+			WriteOp(spv::OpBeginInvocationInterlockEXT);
+			break;
+		case CShaderBuilder::STATEMENT_OP_INVOCATION_INTERLOCK_END:
+			WriteOp(spv::OpEndInvocationInterlockEXT);
+			break;
+		case CShaderBuilder::STATEMENT_OP_WORKGROUP_BARRIER:
+			assert(m_intConstantIds.find(spv::ScopeWorkgroup) != std::end(m_intConstantIds));
+			assert(m_intConstantIds.find(WORKGROUP_BARRIER_SEMANTICS) != std::end(m_intConstantIds));
+			WriteOp(spv::OpControlBarrier, m_intConstantIds[spv::ScopeWorkgroup], m_intConstantIds[spv::ScopeWorkgroup],
+			        m_intConstantIds[WORKGROUP_BARRIER_SEMANTICS]);
+			break;
+		case CShaderBuilder::STATEMENT_OP_DEVICE_MEMORY_BARRIER:
+			assert(m_intConstantIds.find(spv::ScopeDevice) != std::end(m_intConstantIds));
+			assert(m_intConstantIds.find(DEVICE_MEMORY_BARRIER_SEMANTICS) != std::end(m_intConstantIds));
+			WriteOp(spv::OpMemoryBarrier, m_intConstantIds[spv::ScopeDevice], m_intConstantIds[DEVICE_MEMORY_BARRIER_SEMANTICS]);
 			break;
-			case CShaderBuilder::STATEMENT_OP_IF_END:
+		case CShaderBuilder::STATEMENT_OP_IF_BEGIN:
+		{
+			assert(src1Ref.swizzle == SWIZZLE_X);
+			auto src1Id = LoadFromSymbol(src1Ref);
+			auto separators = FindBlockSeparators(statementIterator, statements.end());
+			CONTROL_FLOW_BLOCK block;
+			block.mergeLabelId = AllocateId();
+			block.headerTemporaryValueIds = m_temporaryValueIds;
+			auto beginLabelId = AllocateId();
+			auto falseLabelId = block.mergeLabelId;
+			if(separators.empty())
+			{
+				//Condition being false jumps directly to the merge block
+				block.incomings.push_back(std::make_pair(m_currentLabelId, m_temporaryValueIds));
+			}
+			else
+			{
+				assert(separators.size() == 1);
+				falseLabelId = AllocateId();
+				block.regionLabelIds.push_back(falseLabelId);
+			}
+			auto conditionId = AllocateId();
+			WriteOp(spv::OpCompositeExtract, m_boolTypeId, conditionId, src1Id, 0);
+			WriteOp(spv::OpSelectionMerge, block.mergeLabelId, GetSelectionControl(statement.param));
+			WriteOp(spv::OpBranchConditional, conditionId, beginLabelId, falseLabelId);
+			WriteOp(spv::OpLabel, beginLabelId);
+			m_currentLabelId = beginLabelId;
+			m_controlFlowBlocks.push_back(std::move(block));
+		}
+		break;
+		case CShaderBuilder::STATEMENT_OP_SWITCH_BEGIN:
+		{
+			auto src1Id = LoadFromSymbol(src1Ref);
+			auto separators = FindBlockSeparators(statementIterator, statements.end());
+			CONTROL_FLOW_BLOCK block;
+			block.mergeLabelId = AllocateId();
+			block.headerTemporaryValueIds = m_temporaryValueIds;
+			uint32 defaultLabelId = block.mergeLabelId;
+			std::vector<uint32> switchTargets;
+			for(auto separatorIterator = separators.begin(); separatorIterator != separators.end(); separatorIterator++)
 			{
-				assert(m_endLabelIds.size() > 0);
-				auto endLabelId = m_endLabelIds.top();
-				if(!returnInBlock)
+				//Consecutive case statements share the same label
+				bool sharesLabel = (separatorIterator != separators.begin()) && (std::next(*std::prev(separatorIterator)) == *separatorIterator);
+				auto labelId = sharesLabel ? block.regionLabelIds.back() : AllocateId();
+				block.regionLabelIds.push_back(labelId);
+				const auto& separator = **separatorIterator;
+				if(separator.op == CShaderBuilder::STATEMENT_OP_SWITCH_CASE)
+				{
+					switchTargets.push_back(separator.param);
+					switchTargets.push_back(labelId);
+				}
+				else
 				{
-					WriteOp(spv::OpBranch, endLabelId);
+					assert(separator.op == CShaderBuilder::STATEMENT_OP_SWITCH_DEFAULT);
+					defaultLabelId = labelId;
 				}
-				WriteOp(spv::OpLabel, endLabelId);
-				m_endLabelIds.pop();
-				returnInBlock = false;
 			}
-			break;
-			default:
-				assert(false);
+			if(defaultLabelId == block.mergeLabelId)
+			{
+				block.incomings.push_back(std::make_pair(m_currentLabelId, m_temporaryValueIds));
+			}
+			uint32 selectorTypeId = (src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_UINT4) ? m_uintTypeId : m_intTypeId;
+			auto selectorId = AllocateId();
+			WriteOp(spv::OpCompositeExtract, selectorTypeId, selectorId, src1Id, 0);
+			WriteOp(spv::OpSelectionMerge, block.mergeLabelId, GetSelectionControl(statement.param));
+			WriteOp(spv::OpSwitch, selectorId, defaultLabelId, switchTargets);
+			m_blockTerminated = true;
+			m_controlFlowBlocks.push_back(std::move(block));
+		}
+		break;
+		case CShaderBuilder::STATEMENT_OP_ELSE:
+		case CShaderBuilder::STATEMENT_OP_SWITCH_CASE:
+		case CShaderBuilder::STATEMENT_OP_SWITCH_DEFAULT:
+		{
+			assert(!m_controlFlowBlocks.empty());
+			auto& block = m_controlFlowBlocks.back();
+			assert(block.nextRegionIndex < block.regionLabelIds.size());
+			auto regionLabelId = block.regionLabelIds[block.nextRegionIndex++];
+			if(regionLabelId == m_currentLabelId)
+			{
+				//Case sharing the previous case's body
 				break;
 			}
+			BranchToMerge(block);
+			WriteOp(spv::OpLabel, regionLabelId);
+			m_currentLabelId = regionLabelId;
+			m_blockTerminated = false;
+			m_temporaryValueIds = block.headerTemporaryValueIds;
+		}
+		break;
+		case CShaderBuilder::STATEMENT_OP_IF_END:
+		case CShaderBuilder::STATEMENT_OP_SWITCH_END:
+		{
+			assert(!m_controlFlowBlocks.empty());
+			auto& block = m_controlFlowBlocks.back();
+			BranchToMerge(block);
+			BeginMergeBlock(block.mergeLabelId, block.incomings, block.headerTemporaryValueIds);
+			m_controlFlowBlocks.pop_back();
+		}
+		break;
+		case CShaderBuilder::STATEMENT_OP_LOOP_BEGIN:
+			BeginLoop(statement, statementIterator, statements.end());
+			break;
+		case CShaderBuilder::STATEMENT_OP_LOOP_END:
+			EndLoop();
+			break;
+		case CShaderBuilder::STATEMENT_OP_BREAK:
+			BranchToMerge(GetInnermostLoopBlock());
+			break;
+		case CShaderBuilder::STATEMENT_OP_CONTINUE:
+		{
+			auto& block = GetInnermostLoopBlock();
+			block.continueIncomings.push_back(std::make_pair(m_currentLabelId, m_temporaryValueIds));
+			WriteOp(spv::OpBranch, block.continueLabelId);
+			m_blockTerminated = true;
+		}
+		break;
+		default:
+			assert(false);
+			break;
 		}
-
-		WriteOp(spv::OpReturn);
-		WriteOp(spv::OpFunctionEnd);
 	}
-
-	//Patch in bound
-	m_outputStream.Seek(12, Framework::STREAM_SEEK_SET);
-	m_outputStream.Write32(m_nextId);
-
-	m_outputStream.Seek(0, Framework::STREAM_SEEK_END);
 }
 
 void CSpirvShaderGenerator::AllocateInputPointerIds()
@@ -860,14 +1694,50 @@ void CSpirvShaderGenerator::DecorateInputPointerIds()
 			assert(m_shaderType == SHADER_TYPE_VERTEX);
 			WriteOp(spv::OpDecorate, pointerId, spv::DecorationBuiltIn, spv::BuiltInVertexIndex);
 			break;
-		case Nuanceur::SEMANTIC_SYSTEM_GIID:
-			assert(m_shaderType == SHADER_TYPE_COMPUTE);
-			WriteOp(spv::OpDecorate, pointerId, spv::DecorationBuiltIn, spv::BuiltInGlobalInvocationId);
+		case Nuanceur::SEMANTIC_SYSTEM_GIID:
+			assert(m_shaderType == SHADER_TYPE_COMPUTE);
+			WriteOp(spv::OpDecorate, pointerId, spv::DecorationBuiltIn, spv::BuiltInGlobalInvocationId);
+			RegisterIntConstant(0); //Will be required to expand the ID to 4 components
+			break;
+		case Nuanceur::SEMANTIC_SYSTEM_LIID:
+			assert(m_shaderType == SHADER_TYPE_COMPUTE);
+			WriteOp(spv::OpDecorate, pointerId, spv::DecorationBuiltIn, spv::BuiltInLocalInvocationId);
+			RegisterIntConstant(0);
+			break;
+		case Nuanceur::SEMANTIC_SYSTEM_LIINDEX:
+			assert(m_shaderType == SHADER_TYPE_COMPUTE);
+			WriteOp(spv::OpDecorate, pointerId, spv::DecorationBuiltIn, spv::BuiltInLocalInvocationIndex);
+			RegisterIntConstant(0);
+			break;
+		case Nuanceur::SEMANTIC_SYSTEM_WGID:
+			assert(m_shaderType == SHADER_TYPE_COMPUTE);
+			WriteOp(spv::OpDecorate, pointerId, spv::DecorationBuiltIn, spv::BuiltInWorkgroupId);
+			RegisterIntConstant(0);
+			break;
+		case Nuanceur::SEMANTIC_SYSTEM_SUBGROUP_INVOCATION_ID:
+			WriteOp(spv::OpDecorate, pointerId, spv::DecorationBuiltIn, spv::BuiltInSubgroupLocalInvocationId);
+			if(m_shaderType == SHADER_TYPE_FRAGMENT)
+			{
+				WriteOp(spv::OpDecorate, pointerId, spv::DecorationFlat);
+			}
+			RegisterIntConstant(0);
+			break;
+		case Nuanceur::SEMANTIC_SYSTEM_SUBGROUP_SIZE:
+			WriteOp(spv::OpDecorate, pointerId, spv::DecorationBuiltIn, spv::BuiltInSubgroupSize);
+			if(m_shaderType == SHADER_TYPE_FRAGMENT)
+			{
+				WriteOp(spv::OpDecorate, pointerId, spv::DecorationFlat);
+			}
+			RegisterIntConstant(0);
 			break;
 		default:
 		{
 			auto location = MapSemanticToLocation(semantic.type, semantic.index);
 			WriteOp(spv::OpDecorate, pointerId, spv::DecorationLocation, location);
+			if(IsRelaxedPrecision(symbol))
+			{
+				WriteOp(spv::OpDecorate, pointerId, spv::DecorationRelaxedPrecision);
+			}
 		}
 		break;
 		}
@@ -885,10 +1755,15 @@ void CSpirvShaderGenerator::DeclareInputPointerIds()
 		switch(semantic.type)
 		{
 		case Nuanceur::SEMANTIC_SYSTEM_VERTEXINDEX:
+		case Nuanceur::SEMANTIC_SYSTEM_LIINDEX:
+		case Nuanceur::SEMANTIC_SYSTEM_SUBGROUP_INVOCATION_ID:
+		case Nuanceur::SEMANTIC_SYSTEM_SUBGROUP_SIZE:
 			assert(symbol.type == CShaderBuilder::SYMBOL_TYPE_INT4);
 			WriteOp(spv::OpVariable, m_inputIntPointerTypeId, pointerId, spv::StorageClassInput);
 			break;
 		case Nuanceur::SEMANTIC_SYSTEM_GIID:
+		case Nuanceur::SEMANTIC_SYSTEM_LIID:
+		case Nuanceur::SEMANTIC_SYSTEM_WGID:
 			assert(symbol.type == CShaderBuilder::SYMBOL_TYPE_INT4);
 			WriteOp(spv::OpVariable, m_inputInt3PointerTypeId, pointerId, spv::StorageClassInput);
 			break;
@@ -932,8 +1807,23 @@ void CSpirvShaderGenerator::DecorateOutputPointerIds()
 		if(IsBuiltInOutput(semantic.type)) continue;
 		assert(m_outputPointerIds.find(symbol.index) != std::end(m_outputPointerIds));
 		auto pointerId = m_outputPointerIds[symbol.index];
-		auto location = MapSemanticToLocation(semantic.type, semantic.index);
-		WriteOp(spv::OpDecorate, pointerId, spv::DecorationLocation, location);
+		switch(semantic.type)
+		{
+		case Nuanceur::SEMANTIC_SYSTEM_DEPTH:
+			assert(m_shaderType == SHADER_TYPE_FRAGMENT);
+			WriteOp(spv::OpDecorate, pointerId, spv::DecorationBuiltIn, spv::BuiltInFragDepth);
+			break;
+		default:
+		{
+			auto location = MapSemanticToLocation(semantic.type, semantic.index);
+			WriteOp(spv::OpDecorate, pointerId, spv::DecorationLocation, location);
+			if(IsRelaxedPrecision(symbol))
+			{
+				WriteOp(spv::OpDecorate, pointerId, spv::DecorationRelaxedPrecision);
+			}
+		}
+		break;
+		}
 	}
 }
 
@@ -949,7 +1839,14 @@ void CSpirvShaderGenerator::DeclareOutputPointerIds()
 		switch(symbol.type)
 		{
 		case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
-			WriteOp(spv::OpVariable, m_outputFloat4PointerTypeId, pointerId, spv::StorageClassOutput);
+			if(semantic.type == SEMANTIC_SYSTEM_DEPTH)
+			{
+				WriteOp(spv::OpVariable, m_outputFloatPointerTypeId, pointerId, spv::StorageClassOutput);
+			}
+			else
+			{
+				WriteOp(spv::OpVariable, m_outputFloat4PointerTypeId, pointerId, spv::StorageClassOutput);
+			}
 			break;
 		case CShaderBuilder::SYMBOL_TYPE_UINT4:
 			WriteOp(spv::OpVariable, m_outputUint4PointerTypeId, pointerId, spv::StorageClassOutput);
@@ -988,6 +1885,7 @@ uint32 CSpirvShaderGenerator::GetOutputPointerId(const CShaderBuilder::SYMBOLREF
 	break;
 	case Nuanceur::SEMANTIC_TEXCOORD:
 	case Nuanceur::SEMANTIC_SYSTEM_COLOR:
+	case Nuanceur::SEMANTIC_SYSTEM_DEPTH:
 	{
 		assert(m_outputPointerIds.find(symbol.symbol.index) != std::end(m_outputPointerIds));
 		pointerId = m_outputPointerIds[symbol.symbol.index];
@@ -1016,6 +1914,15 @@ void CSpirvShaderGenerator::GatherConstantsFromTemps()
 			RegisterFloatConstant(temporaryValue.w);
 		}
 		break;
+		case CShaderBuilder::SYMBOL_TYPE_HALF4:
+		{
+			auto temporaryValue = m_shaderBuilder.GetTemporaryValue(symbol);
+			RegisterHalfConstant(temporaryValue.x);
+			RegisterHalfConstant(temporaryValue.y);
+			RegisterHalfConstant(temporaryValue.z);
+			RegisterHalfConstant(temporaryValue.w);
+		}
+		break;
 		case CShaderBuilder::SYMBOL_TYPE_INT4:
 		{
 			auto temporaryValue = m_shaderBuilder.GetTemporaryValueInt(symbol);
@@ -1080,6 +1987,15 @@ void CSpirvShaderGenerator::DeclareTemporaryValueIds()
 			WriteOp(spv::OpConstantComposite, m_float4TypeId, temporaryValueId, valueXId, valueYId, valueZId, valueWId);
 		}
 		break;
+		case CShaderBuilder::SYMBOL_TYPE_HALF4:
+		{
+			auto temporaryValue = m_shaderBuilder.GetTemporaryValue(symbol);
+			auto getConstantId = [&](float value) { return m_hasNativeFloat16 ? m_halfConstantIds[ConvertFloatToHalf(value)] : m_floatConstantIds[value]; };
+			WriteOp(spv::OpConstantComposite, m_half4TypeId, temporaryValueId,
+			        getConstantId(temporaryValue.x), getConstantId(temporaryValue.y),
+			        getConstantId(temporaryValue.z), getConstantId(temporaryValue.w));
+		}
+		break;
 		case CShaderBuilder::SYMBOL_TYPE_INT4:
 		{
 			auto temporaryValue = m_shaderBuilder.GetTemporaryValueInt(symbol);
@@ -1135,6 +2051,7 @@ void CSpirvShaderGenerator::DeclareTemporaryValueIds()
 			break;
 		}
 		m_temporaryValueIds[symbol.index] = temporaryValueId;
+		m_temporaryTypeIds[symbol.index] = GetVectorTypeId(symbol.type);
 	}
 }
 
@@ -1161,6 +2078,17 @@ void CSpirvShaderGenerator::WriteVariablePointerNames()
 	}
 }
 
+void CSpirvShaderGenerator::DecorateVariablePointerIds()
+{
+	for(const auto& symbol : m_shaderBuilder.GetSymbols())
+	{
+		if(symbol.location != CShaderBuilder::SYMBOL_LOCATION_VARIABLE) continue;
+		if(!IsRelaxedPrecision(symbol)) continue;
+		assert(m_variablePointerIds.find(symbol.index) != std::end(m_variablePointerIds));
+		WriteOp(spv::OpDecorate, m_variablePointerIds[symbol.index], spv::DecorationRelaxedPrecision);
+	}
+}
+
 void CSpirvShaderGenerator::DeclareVariablePointerIds()
 {
 	for(const auto& symbol : m_shaderBuilder.GetSymbols())
@@ -1189,44 +2117,184 @@ void CSpirvShaderGenerator::DeclareVariablePointerIds()
 	}
 }
 
-void CSpirvShaderGenerator::AllocateUniformStructsIds()
+void CSpirvShaderGenerator::AllocateSharedArrayIds()
 {
 	for(const auto& symbol : m_shaderBuilder.GetSymbols())
 	{
-		if(symbol.location != CShaderBuilder::SYMBOL_LOCATION_UNIFORM) continue;
-		auto& structInfo = m_structInfos[symbol.unit];
-		uint32 memberIndex = structInfo.memberIndex++;
-		structInfo.memberIndices[symbol.index] = memberIndex;
+		if(symbol.location != CShaderBuilder::SYMBOL_LOCATION_SHARED) continue;
+		assert(m_shaderType == SHADER_TYPE_COMPUTE);
+		auto& sharedArrayInfo = m_sharedArrayInfos[symbol.index];
+		sharedArrayInfo.typeId = AllocateId();
+		sharedArrayInfo.pointerTypeId = AllocateId();
+		sharedArrayInfo.variableId = AllocateId();
+		RegisterUintConstant(m_shaderBuilder.GetSharedArraySize(symbol));
+	}
+	if(!m_sharedArrayInfos.empty())
+	{
+		m_workgroupUintPtrId = AllocateId();
+		m_workgroupUint8PtrId = AllocateId();
+		m_workgroupUint16PtrId = AllocateId();
+	}
+}
+
+void CSpirvShaderGenerator::DeclareSharedArrayIds()
+{
+	if(m_sharedArrayInfos.empty()) return;
+	for(const auto& symbol : m_shaderBuilder.GetSymbols())
+	{
+		if(symbol.location != CShaderBuilder::SYMBOL_LOCATION_SHARED) continue;
+		assert(m_sharedArrayInfos.find(symbol.index) != std::end(m_sharedArrayInfos));
+		const auto& sharedArrayInfo = m_sharedArrayInfos[symbol.index];
+		auto size = m_shaderBuilder.GetSharedArraySize(symbol);
+		assert(m_uintConstantIds.find(size) != std::end(m_uintConstantIds));
+		uint32 elementTypeId = EMPTY_ID;
 		switch(symbol.type)
 		{
-		case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
-			structInfo.components.push_back(m_float4TypeId);
-			break;
-		case CShaderBuilder::SYMBOL_TYPE_INT4:
-			structInfo.components.push_back(m_int4TypeId);
-			break;
-		case CShaderBuilder::SYMBOL_TYPE_UINT4:
-			structInfo.components.push_back(m_uint4TypeId);
-			break;
-		case CShaderBuilder::SYMBOL_TYPE_MATRIX:
-			structInfo.components.push_back(m_matrix44TypeId);
-			break;
 		case CShaderBuilder::SYMBOL_TYPE_ARRAYUINT:
-			structInfo.components.push_back(m_uintArrayTypeId);
-			structInfo.isBufferBlock = true;
-			break;
-		case CShaderBuilder::SYMBOL_TYPE_ARRAYUCHAR:
-			structInfo.components.push_back(m_ucharArrayTypeId);
-			structInfo.isBufferBlock = true;
+			elementTypeId = m_uintTypeId;
 			break;
 		case CShaderBuilder::SYMBOL_TYPE_ARRAYUSHORT:
-			structInfo.components.push_back(m_ushortArrayTypeId);
-			structInfo.isBufferBlock = true;
+			elementTypeId = m_ushortTypeId;
+			break;
+		case CShaderBuilder::SYMBOL_TYPE_ARRAYUCHAR:
+			elementTypeId = m_ucharTypeId;
 			break;
 		default:
 			assert(false);
 			break;
 		}
+		WriteOp(spv::OpTypeArray, sharedArrayInfo.typeId, elementTypeId, m_uintConstantIds[size]);
+		WriteOp(spv::OpTypePointer, sharedArrayInfo.pointerTypeId, spv::StorageClassWorkgroup, sharedArrayInfo.typeId);
+		WriteOp(spv::OpVariable, sharedArrayInfo.pointerTypeId, sharedArrayInfo.variableId, spv::StorageClassWorkgroup);
+	}
+	WriteOp(spv::OpTypePointer, m_workgroupUintPtrId, spv::StorageClassWorkgroup, m_uintTypeId);
+	if(m_has8BitInt)
+	{
+		WriteOp(spv::OpTypePointer, m_workgroupUint8PtrId, spv::StorageClassWorkgroup, m_ucharTypeId);
+	}
+	if(m_has16BitInt)
+	{
+		WriteOp(spv::OpTypePointer, m_workgroupUint16PtrId, spv::StorageClassWorkgroup, m_ushortTypeId);
+	}
+}
+
+uint32 CSpirvShaderGenerator::GetSharedArrayElementPointerId(const CShaderBuilder::SYMBOLREF& arrayRef, uint32 indexId)
+{
+	assert(arrayRef.symbol.location == CShaderBuilder::SYMBOL_LOCATION_SHARED);
+	assert(m_sharedArrayInfos.find(arrayRef.symbol.index) != std::end(m_sharedArrayInfos));
+	uint32 pointerTypeId = EMPTY_ID;
+	switch(arrayRef.symbol.type)
+	{
+	case CShaderBuilder::SYMBOL_TYPE_ARRAYUINT:
+		pointerTypeId = m_workgroupUintPtrId;
+		break;
+	case CShaderBuilder::SYMBOL_TYPE_ARRAYUSHORT:
+		pointerTypeId = m_workgroupUint16PtrId;
+		break;
+	case CShaderBuilder::SYMBOL_TYPE_ARRAYUCHAR:
+		pointerTypeId = m_workgroupUint8PtrId;
+		break;
+	default:
+		assert(false);
+		break;
+	}
+	auto pointerId = AllocateId();
+	WriteOp(spv::OpAccessChain, pointerTypeId, pointerId, m_sharedArrayInfos[arrayRef.symbol.index].variableId, indexId);
+	return pointerId;
+}
+
+void CSpirvShaderGenerator::AllocateUniformStructsIds()
+{
+	//Members are declared in the order chosen by the layout to keep offsets increasing
+	auto blockLayouts = UniformLayout::ComputeBlockLayouts(m_shaderBuilder);
+	for(const auto& blockLayoutPair : blockLayouts)
+	{
+		auto& structInfo = m_structInfos[blockLayoutPair.first];
+		structInfo.layout = blockLayoutPair.second;
+		for(uint32 memberIndex = 0; memberIndex < structInfo.layout.members.size(); memberIndex++)
+		{
+			const auto& symbol = structInfo.layout.members[memberIndex].symbol;
+			structInfo.memberIndices[symbol.index] = memberIndex;
+			switch(symbol.type)
+			{
+			case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
+				switch(m_shaderBuilder.GetUniformComponentCount(symbol))
+				{
+				case 1:
+					structInfo.components.push_back(m_floatTypeId);
+					break;
+				case 2:
+					structInfo.components.push_back(m_float2TypeId);
+					break;
+				default:
+					structInfo.components.push_back(m_float4TypeId);
+					break;
+				}
+				break;
+			case CShaderBuilder::SYMBOL_TYPE_INT4:
+				structInfo.components.push_back(m_int4TypeId);
+				break;
+			case CShaderBuilder::SYMBOL_TYPE_UINT4:
+				structInfo.components.push_back(m_uint4TypeId);
+				break;
+			case CShaderBuilder::SYMBOL_TYPE_MATRIX:
+				structInfo.components.push_back(m_matrix44TypeId);
+				break;
+			case CShaderBuilder::SYMBOL_TYPE_BUFFERPOINTERUINT:
+				assert(symbol.unit == static_cast<uint32>(Nuanceur::UNIFORM_UNIT_PUSHCONSTANT));
+				structInfo.components.push_back(m_bufferPointerUintTypeId);
+				break;
+			case CShaderBuilder::SYMBOL_TYPE_BUFFERPOINTERFLOAT4:
+				assert(symbol.unit == static_cast<uint32>(Nuanceur::UNIFORM_UNIT_PUSHCONSTANT));
+				structInfo.components.push_back(m_bufferPointerFloat4TypeId);
+				break;
+			case CShaderBuilder::SYMBOL_TYPE_ARRAYFLOAT4:
+			case CShaderBuilder::SYMBOL_TYPE_ARRAYINT4:
+			case CShaderBuilder::SYMBOL_TYPE_ARRAYMATRIX:
+			{
+				//Every array has its own type since their lengths can differ
+				auto arrayTypeId = AllocateId();
+				m_uniformArrayTypeIds[symbol.index] = arrayTypeId;
+				structInfo.components.push_back(arrayTypeId);
+				RegisterUintConstant(m_shaderBuilder.GetUniformArraySize(symbol));
+			}
+			break;
+			case CShaderBuilder::SYMBOL_TYPE_ARRAYUINT:
+				structInfo.components.push_back(m_uintArrayTypeId);
+				structInfo.isBufferBlock = true;
+				if(m_shaderBuilder.IsBufferArray(symbol))
+				{
+					assert(structInfo.layout.members.size() == 1);
+					structInfo.arrayTypeId = AllocateId();
+					structInfo.elementPointerTypeId = AllocateId();
+					auto size = m_shaderBuilder.GetBufferArraySize(symbol);
+					if(size != 0)
+					{
+						RegisterUintConstant(size);
+					}
+				}
+				break;
+			case CShaderBuilder::SYMBOL_TYPE_ARRAYUINT2:
+				structInfo.components.push_back(m_uint2ArrayTypeId);
+				structInfo.isBufferBlock = true;
+				break;
+			case CShaderBuilder::SYMBOL_TYPE_ARRAYUINT4:
+				structInfo.components.push_back(m_uint4ArrayTypeId);
+				structInfo.isBufferBlock = true;
+				break;
+			case CShaderBuilder::SYMBOL_TYPE_ARRAYUCHAR:
+				structInfo.components.push_back(m_ucharArrayTypeId);
+				structInfo.isBufferBlock = true;
+				break;
+			case CShaderBuilder::SYMBOL_TYPE_ARRAYUSHORT:
+				structInfo.components.push_back(m_ushortArrayTypeId);
+				structInfo.isBufferBlock = true;
+				break;
+			default:
+				assert(false);
+				break;
+			}
+		}
 	}
 
 	for(auto& structInfoPair : m_structInfos)
@@ -1243,7 +2311,7 @@ void CSpirvShaderGenerator::WriteUniformStructNames()
 	for(auto& symbol : m_shaderBuilder.GetSymbols())
 	{
 		if(symbol.location != CShaderBuilder::SYMBOL_LOCATION_UNIFORM) continue;
-		const auto& structInfo = m_structInfos[symbol.unit];
+		const auto& structInfo = m_structInfos[CShaderBuilder::GetBinding(symbol)];
 		auto memberIndexIterator = structInfo.memberIndices.find(symbol.index);
 		assert(memberIndexIterator != std::end(structInfo.memberIndices));
 		auto memberIndex = memberIndexIterator->second;
@@ -1254,50 +2322,54 @@ void CSpirvShaderGenerator::WriteUniformStructNames()
 
 void CSpirvShaderGenerator::DecorateUniformStructIds()
 {
-	for(auto& symbol : m_shaderBuilder.GetSymbols())
+	for(const auto& structInfoPair : m_structInfos)
 	{
-		if(symbol.location != CShaderBuilder::SYMBOL_LOCATION_UNIFORM) continue;
-		auto& structInfo = m_structInfos[symbol.unit];
-		auto memberIndex = structInfo.memberIndices[symbol.index];
-		WriteOp(spv::OpMemberDecorate, structInfo.typeId, memberIndex, spv::DecorationOffset, structInfo.currentOffset);
-		if(symbol.attributes & SYMBOL_ATTRIBUTE_COHERENT)
-		{
-			WriteOp(spv::OpMemberDecorate, structInfo.typeId, memberIndex, spv::DecorationCoherent);
-		}
-		if(symbol.type == CShaderBuilder::SYMBOL_TYPE_MATRIX)
-		{
-			WriteOp(spv::OpMemberDecorate, structInfo.typeId, memberIndex, spv::DecorationColMajor);
-			WriteOp(spv::OpMemberDecorate, structInfo.typeId, memberIndex, spv::DecorationMatrixStride, 16);
-		}
-		RegisterIntConstant(memberIndex);
-		//Assuming std430 layout
-		switch(symbol.type)
+		const auto& structInfo = structInfoPair.second;
+		for(uint32 memberIndex = 0; memberIndex < structInfo.layout.members.size(); memberIndex++)
 		{
-		case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
-		case CShaderBuilder::SYMBOL_TYPE_INT4:
-		case CShaderBuilder::SYMBOL_TYPE_UINT4:
-			//sizeof(float) * 4
-			structInfo.currentOffset += 16;
-			break;
-		case CShaderBuilder::SYMBOL_TYPE_MATRIX:
-			//sizeof(float) * 16
-			structInfo.currentOffset += 64;
-			break;
-		case CShaderBuilder::SYMBOL_TYPE_ARRAYUINT:
-		case CShaderBuilder::SYMBOL_TYPE_ARRAYUCHAR:
-		case CShaderBuilder::SYMBOL_TYPE_ARRAYUSHORT:
-			//This needs to be the last element of a struct
-			break;
-		default:
-			assert(false);
-			break;
+			const auto& memberLayout = structInfo.layout.members[memberIndex];
+			const auto& symbol = memberLayout.symbol;
+			WriteOp(spv::OpMemberDecorate, structInfo.typeId, memberIndex, spv::DecorationOffset, memberLayout.offset);
+			if(symbol.attributes & SYMBOL_ATTRIBUTE_COHERENT)
+			{
+				WriteOp(spv::OpMemberDecorate, structInfo.typeId, memberIndex, spv::DecorationCoherent);
+			}
+			if(memberLayout.matrixStride != 0)
+			{
+				WriteOp(spv::OpMemberDecorate, structInfo.typeId, memberIndex, spv::DecorationColMajor);
+				WriteOp(spv::OpMemberDecorate, structInfo.typeId, memberIndex, spv::DecorationMatrixStride, memberLayout.matrixStride);
+			}
+			RegisterIntConstant(memberIndex);
+			switch(symbol.type)
+			{
+			case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
+				//Missing components are filled with zeros when loaded
+				if(m_shaderBuilder.GetUniformComponentCount(symbol) != 4)
+				{
+					RegisterFloatConstant(0);
+				}
+				break;
+			case CShaderBuilder::SYMBOL_TYPE_BUFFERPOINTERUINT:
+			case CShaderBuilder::SYMBOL_TYPE_BUFFERPOINTERFLOAT4:
+				RegisterIntConstant(0);
+				break;
+			case CShaderBuilder::SYMBOL_TYPE_ARRAYFLOAT4:
+			case CShaderBuilder::SYMBOL_TYPE_ARRAYINT4:
+			case CShaderBuilder::SYMBOL_TYPE_ARRAYMATRIX:
+				WriteOp(spv::OpDecorate, m_uniformArrayTypeIds[symbol.index], spv::DecorationArrayStride, memberLayout.arrayStride);
+				break;
+			default:
+				//Strides of arrays without a fixed size are decorated with their shared types
+				break;
+			}
 		}
 	}
 
 	for(const auto& structInfoPair : m_structInfos)
 	{
 		const auto& structInfo = structInfoPair.second;
-		auto structUnit = structInfoPair.first;
+		auto structSet = structInfoPair.first.first;
+		auto structUnit = structInfoPair.first.second;
 		if(structInfo.isBufferBlock)
 		{
 			WriteOp(spv::OpDecorate, structInfo.typeId, spv::DecorationBufferBlock);
@@ -1308,7 +2380,7 @@ void CSpirvShaderGenerator::DecorateUniformStructIds()
 		}
 		if(structUnit != Nuanceur::UNIFORM_UNIT_PUSHCONSTANT)
 		{
-			WriteOp(spv::OpDecorate, structInfo.variableId, spv::DecorationDescriptorSet, 0);
+			WriteOp(spv::OpDecorate, structInfo.variableId, spv::DecorationDescriptorSet, structSet);
 			WriteOp(spv::OpDecorate, structInfo.variableId, spv::DecorationBinding, structUnit);
 		}
 	}
@@ -1318,16 +2390,72 @@ void CSpirvShaderGenerator::DeclareUniformStructIds()
 {
 	if(m_structInfos.empty()) return;
 
+	if(m_hasBufferPointerUint)
+	{
+		WriteOp(spv::OpTypeStruct, m_bufferPointerUintStructTypeId, m_uintArrayTypeId);
+		WriteOp(spv::OpTypePointer, m_bufferPointerUintTypeId, spv::StorageClassPhysicalStorageBufferEXT, m_bufferPointerUintStructTypeId);
+		WriteOp(spv::OpTypePointer, m_bufferPointerUintElementPtrId, spv::StorageClassPhysicalStorageBufferEXT, m_uintTypeId);
+	}
+	if(m_hasBufferPointerFloat4)
+	{
+		WriteOp(spv::OpTypeRuntimeArray, m_bufferPointerFloat4ArrayTypeId, m_float4TypeId);
+		WriteOp(spv::OpTypeStruct, m_bufferPointerFloat4StructTypeId, m_bufferPointerFloat4ArrayTypeId);
+		WriteOp(spv::OpTypePointer, m_bufferPointerFloat4TypeId, spv::StorageClassPhysicalStorageBufferEXT, m_bufferPointerFloat4StructTypeId);
+		WriteOp(spv::OpTypePointer, m_bufferPointerFloat4ElementPtrId, spv::StorageClassPhysicalStorageBufferEXT, m_float4TypeId);
+	}
+
+	for(const auto& symbol : m_shaderBuilder.GetSymbols())
+	{
+		if(symbol.location != CShaderBuilder::SYMBOL_LOCATION_UNIFORM) continue;
+		auto arrayTypeIterator = m_uniformArrayTypeIds.find(symbol.index);
+		if(arrayTypeIterator == std::end(m_uniformArrayTypeIds)) continue;
+		uint32 elementTypeId = EMPTY_ID;
+		switch(symbol.type)
+		{
+		case CShaderBuilder::SYMBOL_TYPE_ARRAYFLOAT4:
+			elementTypeId = m_float4TypeId;
+			break;
+		case CShaderBuilder::SYMBOL_TYPE_ARRAYINT4:
+			elementTypeId = m_int4TypeId;
+			break;
+		case CShaderBuilder::SYMBOL_TYPE_ARRAYMATRIX:
+			elementTypeId = m_matrix44TypeId;
+			break;
+		default:
+			assert(false);
+			break;
+		}
+		auto size = m_shaderBuilder.GetUniformArraySize(symbol);
+		assert(m_uintConstantIds.find(size) != std::end(m_uintConstantIds));
+		WriteOp(spv::OpTypeArray, arrayTypeIterator->second, elementTypeId, m_uintConstantIds[size]);
+	}
+
 	for(const auto& structInfoPair : m_structInfos)
 	{
 		const auto& structInfo = structInfoPair.second;
-		auto structUnit = structInfoPair.first;
+		auto structUnit = structInfoPair.first.second;
 
 		WriteOp(spv::OpTypeStruct, structInfo.typeId, structInfo.components);
 		if(structUnit == Nuanceur::UNIFORM_UNIT_PUSHCONSTANT)
 		{
 			WriteOp(spv::OpTypePointer, structInfo.pointerTypeId, spv::StorageClassPushConstant, structInfo.typeId);
 		}
+		else if(structInfo.arrayTypeId != EMPTY_ID)
+		{
+			const auto& arraySymbol = structInfo.layout.members[0].symbol;
+			auto size = m_shaderBuilder.GetBufferArraySize(arraySymbol);
+			if(size == 0)
+			{
+				WriteOp(spv::OpTypeRuntimeArray, structInfo.arrayTypeId, structInfo.typeId);
+			}
+			else
+			{
+				assert(m_uintConstantIds.find(size) != std::end(m_uintConstantIds));
+				WriteOp(spv::OpTypeArray, structInfo.arrayTypeId, structInfo.typeId, m_uintConstantIds[size]);
+			}
+			WriteOp(spv::OpTypePointer, structInfo.elementPointerTypeId, spv::StorageClassUniform, structInfo.typeId);
+			WriteOp(spv::OpTypePointer, structInfo.pointerTypeId, spv::StorageClassUniform, structInfo.arrayTypeId);
+		}
 		else
 		{
 			WriteOp(spv::OpTypePointer, structInfo.pointerTypeId, spv::StorageClassUniform, structInfo.typeId);
@@ -1337,10 +2465,26 @@ void CSpirvShaderGenerator::DeclareUniformStructIds()
 	WriteOp(spv::OpTypePointer, m_pushFloat4PointerTypeId, spv::StorageClassPushConstant, m_float4TypeId);
 	WriteOp(spv::OpTypePointer, m_pushInt4PointerTypeId, spv::StorageClassPushConstant, m_int4TypeId);
 	WriteOp(spv::OpTypePointer, m_pushMatrix44PointerTypeId, spv::StorageClassPushConstant, m_matrix44TypeId);
+	if(m_hasSmallFloatUniform)
+	{
+		WriteOp(spv::OpTypePointer, m_pushFloatPointerTypeId, spv::StorageClassPushConstant, m_floatTypeId);
+		WriteOp(spv::OpTypePointer, m_pushFloat2PointerTypeId, spv::StorageClassPushConstant, m_float2TypeId);
+		WriteOp(spv::OpTypePointer, m_uniformFloatPointerTypeId, spv::StorageClassUniform, m_floatTypeId);
+		WriteOp(spv::OpTypePointer, m_uniformFloat2PointerTypeId, spv::StorageClassUniform, m_float2TypeId);
+	}
+	if(m_hasBufferPointerUint)
+		WriteOp(spv::OpTypePointer, m_pushBufferPointerUintPointerTypeId, spv::StorageClassPushConstant, m_bufferPointerUintTypeId);
+	if(m_hasBufferPointerFloat4)
+		WriteOp(spv::OpTypePointer, m_pushBufferPointerFloat4PointerTypeId, spv::StorageClassPushConstant, m_bufferPointerFloat4TypeId);
 
 	WriteOp(spv::OpTypePointer, m_uniformFloat4PointerTypeId, spv::StorageClassUniform, m_float4TypeId);
 	WriteOp(spv::OpTypePointer, m_uniformInt4PointerTypeId, spv::StorageClassUniform, m_int4TypeId);
+	WriteOp(spv::OpTypePointer, m_uniformMatrix44PointerTypeId, spv::StorageClassUniform, m_matrix44TypeId);
 	WriteOp(spv::OpTypePointer, m_uniformUintPtrId, spv::StorageClassUniform, m_uintTypeId);
+	if(m_hasUint2Array)
+		WriteOp(spv::OpTypePointer, m_uniformUint2PtrId, spv::StorageClassUniform, m_uint2TypeId);
+	if(m_hasUint4Array)
+		WriteOp(spv::OpTypePointer, m_uniformUint4PtrId, spv::StorageClassUniform, m_uint4TypeId);
 	if(m_has8BitInt)
 		WriteOp(spv::OpTypePointer, m_uniformUint8PtrId, spv::StorageClassUniform, m_ucharTypeId);
 
@@ -1353,9 +2497,9 @@ void CSpirvShaderGenerator::AllocateTextureIds()
 	for(const auto& symbol : m_shaderBuilder.GetSymbols())
 	{
 		if(symbol.location != CShaderBuilder::SYMBOL_LOCATION_TEXTURE) continue;
-		assert(m_texturePointerIds.find(symbol.unit) == std::end(m_texturePointerIds));
+		assert(m_texturePointerIds.find(CShaderBuilder::GetBinding(symbol)) == std::end(m_texturePointerIds));
 		auto pointerId = AllocateId();
-		m_texturePointerIds[symbol.unit] = pointerId;
+		m_texturePointerIds[CShaderBuilder::GetBinding(symbol)] = pointerId;
 	}
 }
 
@@ -1364,9 +2508,9 @@ void CSpirvShaderGenerator::DecorateTextureIds()
 	for(const auto& symbol : m_shaderBuilder.GetSymbols())
 	{
 		if(symbol.location != CShaderBuilder::SYMBOL_LOCATION_TEXTURE) continue;
-		assert(m_texturePointerIds.find(symbol.unit) != std::end(m_texturePointerIds));
-		auto pointerId = m_texturePointerIds[symbol.unit];
-		WriteOp(spv::OpDecorate, pointerId, spv::DecorationDescriptorSet, 0);
+		assert(m_texturePointerIds.find(CShaderBuilder::GetBinding(symbol)) != std::end(m_texturePointerIds));
+		auto pointerId = m_texturePointerIds[CShaderBuilder::GetBinding(symbol)];
+		WriteOp(spv::OpDecorate, pointerId, spv::DecorationDescriptorSet, symbol.set);
 		WriteOp(spv::OpDecorate, pointerId, spv::DecorationBinding, symbol.unit);
 		if(
 		    (symbol.type == CShaderBuilder::SYMBOL_TYPE_SUBPASSINPUT) ||
@@ -1382,30 +2526,260 @@ void CSpirvShaderGenerator::DeclareTextureIds()
 	for(const auto& symbol : m_shaderBuilder.GetSymbols())
 	{
 		if(symbol.location != CShaderBuilder::SYMBOL_LOCATION_TEXTURE) continue;
-		assert(m_texturePointerIds.find(symbol.unit) != std::end(m_texturePointerIds));
-		auto pointerId = m_texturePointerIds[symbol.unit];
+		//Arrays are declared after constants
+		if(m_shaderBuilder.IsTextureArray(symbol)) continue;
+		assert(m_texturePointerIds.find(CShaderBuilder::GetBinding(symbol)) != std::end(m_texturePointerIds));
+		auto pointerId = m_texturePointerIds[CShaderBuilder::GetBinding(symbol)];
 		switch(symbol.type)
 		{
 		case CShaderBuilder::SYMBOL_TYPE_TEXTURE2D:
 			assert(m_sampledImageSamplerPointerTypeId != EMPTY_ID);
 			WriteOp(spv::OpVariable, m_sampledImageSamplerPointerTypeId, pointerId, spv::StorageClassUniformConstant);
 			break;
+		case CShaderBuilder::SYMBOL_TYPE_IMAGE2D:
+		case CShaderBuilder::SYMBOL_TYPE_IMAGE2DARRAY:
+		case CShaderBuilder::SYMBOL_TYPE_IMAGE3D:
+		case CShaderBuilder::SYMBOL_TYPE_IMAGE2DUINT:
+		case CShaderBuilder::SYMBOL_TYPE_IMAGE2DARRAYUINT:
+		case CShaderBuilder::SYMBOL_TYPE_IMAGE3DUINT:
+		{
+			auto imageInfoIterator = m_storageImageInfos.find(GetStorageImageKey(symbol));
+			assert(imageInfoIterator != std::end(m_storageImageInfos));
+			WriteOp(spv::OpVariable, imageInfoIterator->second.pointerTypeId, pointerId, spv::StorageClassUniformConstant);
+		}
+		break;
+		case CShaderBuilder::SYMBOL_TYPE_SUBPASSINPUT:
+			assert(m_subpassInputPointerTypeId != EMPTY_ID);
+			WriteOp(spv::OpVariable, m_subpassInputPointerTypeId, pointerId, spv::StorageClassUniformConstant);
+			break;
+		case CShaderBuilder::SYMBOL_TYPE_SUBPASSINPUTUINT:
+			assert(m_subpassInputUintPointerTypeId != EMPTY_ID);
+			WriteOp(spv::OpVariable, m_subpassInputUintPointerTypeId, pointerId, spv::StorageClassUniformConstant);
+			break;
+		case CShaderBuilder::SYMBOL_TYPE_UNIFORMTEXELBUFFER:
+			assert(m_uniformTexelBufferPointerTypeId != EMPTY_ID);
+			WriteOp(spv::OpVariable, m_uniformTexelBufferPointerTypeId, pointerId, spv::StorageClassUniformConstant);
+			break;
+		case CShaderBuilder::SYMBOL_TYPE_STORAGETEXELBUFFERUINT:
+			assert(m_storageTexelBufferUintPointerTypeId != EMPTY_ID);
+			WriteOp(spv::OpVariable, m_storageTexelBufferUintPointerTypeId, pointerId, spv::StorageClassUniformConstant);
+			break;
+		default:
+			assert(false);
+			break;
+		}
+	}
+}
+
+void CSpirvShaderGenerator::AllocateTextureArrayIds()
+{
+	for(const auto& symbol : m_shaderBuilder.GetSymbols())
+	{
+		if(symbol.location != CShaderBuilder::SYMBOL_LOCATION_TEXTURE) continue;
+		if(!m_shaderBuilder.IsTextureArray(symbol)) continue;
+		TEXTUREARRAYINFO arrayInfo;
+		arrayInfo.typeId = AllocateId();
+		arrayInfo.pointerTypeId = AllocateId();
+		if(symbol.type == CShaderBuilder::SYMBOL_TYPE_TEXTURE2D)
+		{
+			arrayInfo.elementPointerTypeId = m_sampledImageSamplerPointerTypeId;
+		}
+		else
+		{
+			auto imageInfoIterator = m_storageImageInfos.find(GetStorageImageKey(symbol));
+			assert(imageInfoIterator != std::end(m_storageImageInfos));
+			arrayInfo.elementPointerTypeId = imageInfoIterator->second.pointerTypeId;
+		}
+		m_textureArrayInfos[CShaderBuilder::GetBinding(symbol)] = arrayInfo;
+		auto size = m_shaderBuilder.GetTextureArraySize(symbol);
+		if(size != 0)
+		{
+			RegisterUintConstant(size);
+		}
+	}
+}
+
+void CSpirvShaderGenerator::DeclareTextureArrayIds()
+{
+	for(const auto& symbol : m_shaderBuilder.GetSymbols())
+	{
+		if(symbol.location != CShaderBuilder::SYMBOL_LOCATION_TEXTURE) continue;
+		if(!m_shaderBuilder.IsTextureArray(symbol)) continue;
+		assert(m_textureArrayInfos.find(CShaderBuilder::GetBinding(symbol)) != std::end(m_textureArrayInfos));
+		const auto& arrayInfo = m_textureArrayInfos[CShaderBuilder::GetBinding(symbol)];
+		auto elementTypeId = GetTextureTypeId(symbol);
+		auto size = m_shaderBuilder.GetTextureArraySize(symbol);
+		if(size == 0)
+		{
+			WriteOp(spv::OpTypeRuntimeArray, arrayInfo.typeId, elementTypeId);
+		}
+		else
+		{
+			assert(m_uintConstantIds.find(size) != std::end(m_uintConstantIds));
+			WriteOp(spv::OpTypeArray, arrayInfo.typeId, elementTypeId, m_uintConstantIds[size]);
+		}
+		WriteOp(spv::OpTypePointer, arrayInfo.pointerTypeId, spv::StorageClassUniformConstant, arrayInfo.typeId);
+		WriteOp(spv::OpVariable, arrayInfo.pointerTypeId, m_texturePointerIds[CShaderBuilder::GetBinding(symbol)], spv::StorageClassUniformConstant);
+	}
+}
+
+uint32 CSpirvShaderGenerator::GetTextureTypeId(const CShaderBuilder::SYMBOL& symbol)
+{
+	switch(symbol.type)
+	{
+	case CShaderBuilder::SYMBOL_TYPE_TEXTURE2D:
+		assert(m_sampledImageSamplerTypeId != EMPTY_ID);
+		return m_sampledImageSamplerTypeId;
+	case CShaderBuilder::SYMBOL_TYPE_IMAGE2D:
+	case CShaderBuilder::SYMBOL_TYPE_IMAGE2DARRAY:
+	case CShaderBuilder::SYMBOL_TYPE_IMAGE3D:
+	case CShaderBuilder::SYMBOL_TYPE_IMAGE2DUINT:
+	case CShaderBuilder::SYMBOL_TYPE_IMAGE2DARRAYUINT:
+	case CShaderBuilder::SYMBOL_TYPE_IMAGE3DUINT:
+	{
+		auto imageInfoIterator = m_storageImageInfos.find(GetStorageImageKey(symbol));
+		assert(imageInfoIterator != std::end(m_storageImageInfos));
+		return imageInfoIterator->second.typeId;
+	}
+	case CShaderBuilder::SYMBOL_TYPE_SUBPASSINPUT:
+		assert(m_subpassInputTypeId != EMPTY_ID);
+		return m_subpassInputTypeId;
+	case CShaderBuilder::SYMBOL_TYPE_SUBPASSINPUTUINT:
+		assert(m_subpassInputUintTypeId != EMPTY_ID);
+		return m_subpassInputUintTypeId;
+	case CShaderBuilder::SYMBOL_TYPE_UNIFORMTEXELBUFFER:
+		assert(m_uniformTexelBufferTypeId != EMPTY_ID);
+		return m_uniformTexelBufferTypeId;
+	case CShaderBuilder::SYMBOL_TYPE_STORAGETEXELBUFFERUINT:
+		assert(m_storageTexelBufferUintTypeId != EMPTY_ID);
+		return m_storageTexelBufferUintTypeId;
+	default:
+		assert(false);
+		return EMPTY_ID;
+	}
+}
+
+uint32 CSpirvShaderGenerator::GetTexturePointerId(const CShaderBuilder::SYMBOL& symbol)
+{
+	if(symbol.location == CShaderBuilder::SYMBOL_LOCATION_TEXTURE_ELEMENT)
+	{
+		assert(m_textureElementPointerIds.find(symbol.index) != std::end(m_textureElementPointerIds));
+		return m_textureElementPointerIds[symbol.index];
+	}
+	assert(symbol.location == CShaderBuilder::SYMBOL_LOCATION_TEXTURE);
+	assert(m_texturePointerIds.find(CShaderBuilder::GetBinding(symbol)) != std::end(m_texturePointerIds));
+	return m_texturePointerIds[CShaderBuilder::GetBinding(symbol)];
+}
+
+void CSpirvShaderGenerator::AllocateStorageImageTypeIds()
+{
+	//Images sharing the same dimension, sampled type and format share the same type
+	for(const auto& symbol : m_shaderBuilder.GetSymbols())
+	{
+		if(symbol.location != CShaderBuilder::SYMBOL_LOCATION_TEXTURE) continue;
+		if(!CShaderBuilder::IsImageType(symbol.type)) continue;
+		auto key = GetStorageImageKey(symbol);
+		if(m_storageImageInfos.find(key) != std::end(m_storageImageInfos)) continue;
+		STORAGEIMAGEINFO imageInfo;
+		imageInfo.typeId = AllocateId();
+		imageInfo.pointerTypeId = AllocateId();
+		imageInfo.symbolType = symbol.type;
+		imageInfo.format = m_shaderBuilder.GetImageFormat(symbol);
+		m_storageImageInfos[key] = imageInfo;
+	}
+}
+
+void CSpirvShaderGenerator::DeclareStorageImageTypeIds()
+{
+	for(const auto& imageInfoPair : m_storageImageInfos)
+	{
+		const auto& imageInfo = imageInfoPair.second;
+		uint32 sampledTypeId = EMPTY_ID;
+		spv::Dim dim = spv::Dim2D;
+		uint32 arrayed = 0;
+		switch(imageInfo.symbolType)
+		{
+		case CShaderBuilder::SYMBOL_TYPE_IMAGE2D:
+			sampledTypeId = m_floatTypeId;
+			break;
+		case CShaderBuilder::SYMBOL_TYPE_IMAGE2DARRAY:
+			sampledTypeId = m_floatTypeId;
+			arrayed = 1;
+			break;
+		case CShaderBuilder::SYMBOL_TYPE_IMAGE3D:
+			sampledTypeId = m_floatTypeId;
+			dim = spv::Dim3D;
+			break;
 		case CShaderBuilder::SYMBOL_TYPE_IMAGE2DUINT:
-			assert(m_storageImage2DPointerTypeId != EMPTY_ID);
-			WriteOp(spv::OpVariable, m_storageImage2DPointerTypeId, pointerId, spv::StorageClassUniformConstant);
+			sampledTypeId = m_uintTypeId;
 			break;
-		case CShaderBuilder::SYMBOL_TYPE_SUBPASSINPUT:
-			assert(m_subpassInputPointerTypeId != EMPTY_ID);
-			WriteOp(spv::OpVariable, m_subpassInputPointerTypeId, pointerId, spv::StorageClassUniformConstant);
+		case CShaderBuilder::SYMBOL_TYPE_IMAGE2DARRAYUINT:
+			sampledTypeId = m_uintTypeId;
+			arrayed = 1;
 			break;
-		case CShaderBuilder::SYMBOL_TYPE_SUBPASSINPUTUINT:
-			assert(m_subpassInputUintPointerTypeId != EMPTY_ID);
-			WriteOp(spv::OpVariable, m_subpassInputUintPointerTypeId, pointerId, spv::StorageClassUniformConstant);
+		case CShaderBuilder::SYMBOL_TYPE_IMAGE3DUINT:
+			sampledTypeId = m_uintTypeId;
+			dim = spv::Dim3D;
 			break;
 		default:
 			assert(false);
 			break;
 		}
+		WriteOp(spv::OpTypeImage, imageInfo.typeId, sampledTypeId, dim, 0, arrayed, 0, 2, GetSpirvImageFormat(imageInfo.format));
+		WriteOp(spv::OpTypePointer, imageInfo.pointerTypeId, spv::StorageClassUniformConstant, imageInfo.typeId);
+	}
+}
+
+uint32 CSpirvShaderGenerator::GetStorageImageKey(const CShaderBuilder::SYMBOL& symbol) const
+{
+	return (static_cast<uint32>(symbol.type) << 16) | static_cast<uint32>(m_shaderBuilder.GetImageFormat(symbol));
+}
+
+uint32 CSpirvShaderGenerator::LoadStorageImageCoord(const CShaderBuilder::SYMBOLREF& imageRef, const CShaderBuilder::SYMBOLREF& coordRef)
+{
+	assert(coordRef.symbol.type == CShaderBuilder::SYMBOL_TYPE_INT4);
+	auto coordId = LoadFromSymbol(coordRef);
+	auto cvtCoordId = AllocateId();
+	switch(imageRef.symbol.type)
+	{
+	case CShaderBuilder::SYMBOL_TYPE_IMAGE2D:
+	case CShaderBuilder::SYMBOL_TYPE_IMAGE2DUINT:
+		WriteOp(spv::OpVectorShuffle, m_int2TypeId, cvtCoordId, coordId, coordId, 0, 1);
+		break;
+	case CShaderBuilder::SYMBOL_TYPE_IMAGE2DARRAY:
+	case CShaderBuilder::SYMBOL_TYPE_IMAGE3D:
+	case CShaderBuilder::SYMBOL_TYPE_IMAGE2DARRAYUINT:
+	case CShaderBuilder::SYMBOL_TYPE_IMAGE3DUINT:
+		WriteOp(spv::OpVectorShuffle, m_int3TypeId, cvtCoordId, coordId, coordId, 0, 1, 2);
+		break;
+	default:
+		assert(false);
+		break;
+	}
+	return cvtCoordId;
+}
+
+spv::ImageFormat CSpirvShaderGenerator::GetSpirvImageFormat(IMAGE_FORMAT format)
+{
+	switch(format)
+	{
+	default:
+		assert(false);
+		[[fallthrough]];
+	case IMAGE_FORMAT_R32UI:
+		return spv::ImageFormatR32ui;
+	case IMAGE_FORMAT_RGBA8:
+		return spv::ImageFormatRgba8;
+	case IMAGE_FORMAT_RGBA8UI:
+		return spv::ImageFormatRgba8ui;
+	case IMAGE_FORMAT_R16UI:
+		return spv::ImageFormatR16ui;
+	case IMAGE_FORMAT_R8UI:
+		return spv::ImageFormatR8ui;
+	case IMAGE_FORMAT_RGBA16F:
+		return spv::ImageFormatRgba16f;
+	case IMAGE_FORMAT_R32F:
+		return spv::ImageFormatR32f;
 	}
 }
 
@@ -1415,6 +2789,18 @@ void CSpirvShaderGenerator::RegisterFloatConstant(float value)
 	m_floatConstantIds[value] = AllocateId();
 }
 
+void CSpirvShaderGenerator::RegisterHalfConstant(float value)
+{
+	if(!m_hasNativeFloat16)
+	{
+		RegisterFloatConstant(value);
+		return;
+	}
+	auto halfValue = ConvertFloatToHalf(value);
+	if(m_halfConstantIds.find(halfValue) != std::end(m_halfConstantIds)) return;
+	m_halfConstantIds[halfValue] = AllocateId();
+}
+
 void CSpirvShaderGenerator::RegisterIntConstant(int32 value)
 {
 	if(m_intConstantIds.find(value) != std::end(m_intConstantIds)) return;
@@ -1455,6 +2841,9 @@ uint32 CSpirvShaderGenerator::LoadFromSymbol(const CShaderBuilder::SYMBOLREF& sr
 		switch(semantic.type)
 		{
 		case Nuanceur::SEMANTIC_SYSTEM_VERTEXINDEX:
+		case Nuanceur::SEMANTIC_SYSTEM_LIINDEX:
+		case Nuanceur::SEMANTIC_SYSTEM_SUBGROUP_INVOCATION_ID:
+		case Nuanceur::SEMANTIC_SYSTEM_SUBGROUP_SIZE:
 		{
 			assert(m_intConstantIds.find(0) != std::end(m_intConstantIds));
 			uint32 tempId = AllocateId();
@@ -1463,6 +2852,8 @@ uint32 CSpirvShaderGenerator::LoadFromSymbol(const CShaderBuilder::SYMBOLREF& sr
 		}
 		break;
 		case Nuanceur::SEMANTIC_SYSTEM_GIID:
+		case Nuanceur::SEMANTIC_SYSTEM_LIID:
+		case Nuanceur::SEMANTIC_SYSTEM_WGID:
 		{
 			assert(m_intConstantIds.find(0) != std::end(m_intConstantIds));
 			uint32 tempId = AllocateId();
@@ -1501,9 +2892,9 @@ uint32 CSpirvShaderGenerator::LoadFromSymbol(const CShaderBuilder::SYMBOLREF& sr
 		srcId = AllocateId();
 		auto memberPointerId = AllocateId();
 
-		bool pushCstPtr = (srcRef.symbol.unit == Nuanceur::UNIFORM_UNIT_PUSHCONSTANT);
-		assert(m_structInfos.find(srcRef.symbol.unit) != std::end(m_structInfos));
-		auto structInfo = m_structInfos[srcRef.symbol.unit];
+		bool pushCstPtr = (srcRef.symbol.unit == static_cast<uint32>(Nuanceur::UNIFORM_UNIT_PUSHCONSTANT));
+		assert(m_structInfos.find(CShaderBuilder::GetBinding(srcRef.symbol)) != std::end(m_structInfos));
+		auto structInfo = m_structInfos[CShaderBuilder::GetBinding(srcRef.symbol)];
 		auto memberIndex = structInfo.memberIndices[srcRef.symbol.index];
 		assert(m_intConstantIds.find(memberIndex) != m_intConstantIds.end());
 		auto memberIdxConstantId = m_intConstantIds[memberIndex];
@@ -1511,18 +2902,53 @@ uint32 CSpirvShaderGenerator::LoadFromSymbol(const CShaderBuilder::SYMBOLREF& sr
 		switch(srcRef.symbol.type)
 		{
 		case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
-			WriteOp(spv::OpAccessChain, pushCstPtr ? m_pushFloat4PointerTypeId : m_uniformFloat4PointerTypeId, memberPointerId, structInfo.variableId, memberIdxConstantId);
-			WriteOp(spv::OpLoad, m_float4TypeId, srcId, memberPointerId);
+			switch(m_shaderBuilder.GetUniformComponentCount(srcRef.symbol))
+			{
+			case 1:
+			case 2:
+			{
+				bool isScalar = (m_shaderBuilder.GetUniformComponentCount(srcRef.symbol) == 1);
+				assert(m_floatConstantIds.find(0) != std::end(m_floatConstantIds));
+				auto zeroConstantId = m_floatConstantIds[0];
+				auto valueId = AllocateId();
+				if(isScalar)
+				{
+					WriteOp(spv::OpAccessChain, pushCstPtr ? m_pushFloatPointerTypeId : m_uniformFloatPointerTypeId, memberPointerId, structInfo.variableId, memberIdxConstantId);
+					WriteOp(spv::OpLoad, m_floatTypeId, valueId, memberPointerId);
+					WriteOp(spv::OpCompositeConstruct, m_float4TypeId, srcId, valueId, zeroConstantId, zeroConstantId, zeroConstantId);
+				}
+				else
+				{
+					WriteOp(spv::OpAccessChain, pushCstPtr ? m_pushFloat2PointerTypeId : m_uniformFloat2PointerTypeId, memberPointerId, structInfo.variableId, memberIdxConstantId);
+					WriteOp(spv::OpLoad, m_float2TypeId, valueId, memberPointerId);
+					WriteOp(spv::OpCompositeConstruct, m_float4TypeId, srcId, valueId, zeroConstantId, zeroConstantId);
+				}
+			}
+			break;
+			default:
+				WriteOp(spv::OpAccessChain, pushCstPtr ? m_pushFloat4PointerTypeId : m_uniformFloat4PointerTypeId, memberPointerId, structInfo.variableId, memberIdxConstantId);
+				WriteOp(spv::OpLoad, m_float4TypeId, srcId, memberPointerId);
+				break;
+			}
 			break;
 		case CShaderBuilder::SYMBOL_TYPE_INT4:
 			WriteOp(spv::OpAccessChain, pushCstPtr ? m_pushInt4PointerTypeId : m_uniformInt4PointerTypeId, memberPointerId, structInfo.variableId, memberIdxConstantId);
 			WriteOp(spv::OpLoad, m_int4TypeId, srcId, memberPointerId);
 			break;
 		case CShaderBuilder::SYMBOL_TYPE_MATRIX:
-			assert(pushCstPtr);
-			WriteOp(spv::OpAccessChain, m_pushMatrix44PointerTypeId, memberPointerId, structInfo.variableId, memberIdxConstantId);
+			WriteOp(spv::OpAccessChain, pushCstPtr ? m_pushMatrix44PointerTypeId : m_uniformMatrix44PointerTypeId, memberPointerId, structInfo.variableId, memberIdxConstantId);
 			WriteOp(spv::OpLoad, m_matrix44TypeId, srcId, memberPointerId);
 			break;
+		case CShaderBuilder::SYMBOL_TYPE_BUFFERPOINTERUINT:
+			assert(pushCstPtr);
+			WriteOp(spv::OpAccessChain, m_pushBufferPointerUintPointerTypeId, memberPointerId, structInfo.variableId, memberIdxConstantId);
+			WriteOp(spv::OpLoad, m_bufferPointerUintTypeId, srcId, memberPointerId);
+			break;
+		case CShaderBuilder::SYMBOL_TYPE_BUFFERPOINTERFLOAT4:
+			assert(pushCstPtr);
+			WriteOp(spv::OpAccessChain, m_pushBufferPointerFloat4PointerTypeId, memberPointerId, structInfo.variableId, memberIdxConstantId);
+			WriteOp(spv::OpLoad, m_bufferPointerFloat4TypeId, srcId, memberPointerId);
+			break;
 		default:
 			assert(false);
 			break;
@@ -1530,35 +2956,15 @@ uint32 CSpirvShaderGenerator::LoadFromSymbol(const CShaderBuilder::SYMBOLREF& sr
 	}
 	break;
 	case CShaderBuilder::SYMBOL_LOCATION_TEXTURE:
+	case CShaderBuilder::SYMBOL_LOCATION_TEXTURE_ELEMENT:
 	{
 		assert(m_hasTextures);
-		uint32 imageTypeId = EMPTY_ID;
-		switch(srcRef.symbol.type)
+		srcId = AllocateId();
+		WriteOp(spv::OpLoad, GetTextureTypeId(srcRef.symbol), srcId, GetTexturePointerId(srcRef.symbol));
+		if(srcRef.symbol.attributes & SYMBOL_ATTRIBUTE_NONUNIFORM)
 		{
-		case CShaderBuilder::SYMBOL_TYPE_TEXTURE2D:
-			assert(m_sampledImageSamplerTypeId != EMPTY_ID);
-			imageTypeId = m_sampledImageSamplerTypeId;
-			break;
-		case CShaderBuilder::SYMBOL_TYPE_IMAGE2DUINT:
-			assert(m_storageImage2DTypeId != EMPTY_ID);
-			imageTypeId = m_storageImage2DTypeId;
-			break;
-		case CShaderBuilder::SYMBOL_TYPE_SUBPASSINPUT:
-			assert(m_subpassInputTypeId != EMPTY_ID);
-			imageTypeId = m_subpassInputTypeId;
-			break;
-		case CShaderBuilder::SYMBOL_TYPE_SUBPASSINPUTUINT:
-			assert(m_subpassInputUintTypeId != EMPTY_ID);
-			imageTypeId = m_subpassInputUintTypeId;
-			break;
-		default:
-			assert(false);
-			break;
+			m_nonUniformIds.insert(srcId);
 		}
-		srcId = AllocateId();
-		assert(m_texturePointerIds.find(srcRef.symbol.unit) != std::end(m_texturePointerIds));
-		auto pointerId = m_texturePointerIds[srcRef.symbol.unit];
-		WriteOp(spv::OpLoad, imageTypeId, srcId, pointerId);
 	}
 	break;
 	case CShaderBuilder::SYMBOL_LOCATION_TEMPORARY:
@@ -1605,12 +3011,18 @@ uint32 CSpirvShaderGenerator::LoadFromSymbol(const CShaderBuilder::SYMBOLREF& sr
 		case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
 			srcType = m_float4TypeId;
 			break;
+		case CShaderBuilder::SYMBOL_TYPE_HALF4:
+			srcType = m_half4TypeId;
+			break;
 		case CShaderBuilder::SYMBOL_TYPE_INT4:
 			srcType = m_int4TypeId;
 			break;
 		case CShaderBuilder::SYMBOL_TYPE_UINT4:
 			srcType = m_uint4TypeId;
 			break;
+		case CShaderBuilder::SYMBOL_TYPE_BOOL4:
+			srcType = m_bool4TypeId;
+			break;
 		default:
 			assert(false);
 			break;
@@ -1655,30 +3067,20 @@ uint32 CSpirvShaderGenerator::LoadFromSymbol(const CShaderBuilder::SYMBOLREF& sr
 void CSpirvShaderGenerator::StoreToSymbol(const CShaderBuilder::SYMBOLREF& dstRef, uint32 valueId)
 {
 	assert(IsMaskSwizzle(dstRef.swizzle));
-	uint32 vectorTypeId =
-	    [&]() {
-		    switch(dstRef.symbol.type)
-		    {
-		    default:
-			    assert(false);
-			    [[fallthrough]];
-		    case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
-			    return m_float4TypeId;
-		    case CShaderBuilder::SYMBOL_TYPE_INT4:
-			    return m_int4TypeId;
-		    case CShaderBuilder::SYMBOL_TYPE_UINT4:
-			    return m_uint4TypeId;
-		    case CShaderBuilder::SYMBOL_TYPE_USHORT4:
-			    return m_ushort4TypeId;
-		    case CShaderBuilder::SYMBOL_TYPE_UCHAR4:
-			    return m_uchar4TypeId;
-		    case CShaderBuilder::SYMBOL_TYPE_BOOL4:
-			    return m_bool4TypeId;
-		    }
-	    }();
+	uint32 vectorTypeId = GetVectorTypeId(dstRef.symbol.type);
+	bool relaxedPrecision = IsRelaxedPrecision(dstRef.symbol);
+	if(relaxedPrecision && (valueId >= m_firstInstructionId))
+	{
+		//Constants can't be decorated
+		m_relaxedPrecisionIds.insert(valueId);
+	}
 	auto mixSrcAndDst = [&](uint32 srcValueId, uint32 dstValueId, SWIZZLE_TYPE dstSwizzle) {
 		//Makes a new destination with src and dst, respecting dst swizzle
 		uint32 resultId = AllocateId();
+		if(relaxedPrecision)
+		{
+			m_relaxedPrecisionIds.insert(resultId);
+		}
 		std::array<uint32, 4> components = {0, 1, 2, 3};
 		uint32 elemCount = GetSwizzleElementCount(dstSwizzle);
 		for(int i = 0; i < elemCount; i++)
@@ -1697,7 +3099,7 @@ void CSpirvShaderGenerator::StoreToSymbol(const CShaderBuilder::SYMBOLREF& dstRe
 	{
 		auto pointerId = GetOutputPointerId(dstRef);
 		auto outputSemantic = m_shaderBuilder.GetOutputSemantic(dstRef.symbol);
-		if(outputSemantic.type == SEMANTIC_SYSTEM_POINTSIZE)
+		if((outputSemantic.type == SEMANTIC_SYSTEM_POINTSIZE) || (outputSemantic.type == SEMANTIC_SYSTEM_DEPTH))
 		{
 			//Output is a scalar float and we need to extract the first element from the vector
 			assert(dstRef.swizzle == SWIZZLE_X);
@@ -1791,16 +3193,74 @@ void CSpirvShaderGenerator::StoreToSymbol(const CShaderBuilder::SYMBOLREF& dstRe
 	}
 }
 
+uint32 CSpirvShaderGenerator::GetBufferPointerElementPointerId(const CShaderBuilder::SYMBOLREF& bufferPointerRef, uint32 indexId)
+{
+	assert(CShaderBuilder::IsBufferPointerType(bufferPointerRef.symbol.type));
+	assert(m_intConstantIds.find(0) != std::end(m_intConstantIds));
+	bool isFloat4 = (bufferPointerRef.symbol.type == CShaderBuilder::SYMBOL_TYPE_BUFFERPOINTERFLOAT4);
+	auto bufferPointerId = LoadFromSymbol(bufferPointerRef);
+	auto pointerId = AllocateId();
+	WriteOp(spv::OpAccessChain, isFloat4 ? m_bufferPointerFloat4ElementPtrId : m_bufferPointerUintElementPtrId,
+	        pointerId, bufferPointerId, m_intConstantIds[0], indexId);
+	return pointerId;
+}
+
+uint32 CSpirvShaderGenerator::GetUniformArrayElementPointerId(const CShaderBuilder::SYMBOLREF& arrayRef, uint32 indexId)
+{
+	bool pushCstPtr = (arrayRef.symbol.unit == static_cast<uint32>(Nuanceur::UNIFORM_UNIT_PUSHCONSTANT));
+	uint32 pointerTypeId = EMPTY_ID;
+	switch(arrayRef.symbol.type)
+	{
+	case CShaderBuilder::SYMBOL_TYPE_ARRAYFLOAT4:
+		pointerTypeId = pushCstPtr ? m_pushFloat4PointerTypeId : m_uniformFloat4PointerTypeId;
+		break;
+	case CShaderBuilder::SYMBOL_TYPE_ARRAYINT4:
+		pointerTypeId = pushCstPtr ? m_pushInt4PointerTypeId : m_uniformInt4PointerTypeId;
+		break;
+	case CShaderBuilder::SYMBOL_TYPE_ARRAYMATRIX:
+		pointerTypeId = pushCstPtr ? m_pushMatrix44PointerTypeId : m_uniformMatrix44PointerTypeId;
+		break;
+	default:
+		assert(false);
+		break;
+	}
+	auto arrayAccessParams = GetStructAccessChainParams(arrayRef);
+	auto pointerId = AllocateId();
+	WriteOp(spv::OpAccessChain, pointerTypeId, pointerId, arrayAccessParams.first, arrayAccessParams.second, indexId);
+	return pointerId;
+}
+
 std::pair<uint32, uint32> CSpirvShaderGenerator::GetStructAccessChainParams(const CShaderBuilder::SYMBOLREF& symRef)
 {
-	assert(m_structInfos.find(symRef.symbol.unit) != std::end(m_structInfos));
-	auto structInfo = m_structInfos[symRef.symbol.unit];
+	assert(m_structInfos.find(CShaderBuilder::GetBinding(symRef.symbol)) != std::end(m_structInfos));
+	auto structInfo = m_structInfos[CShaderBuilder::GetBinding(symRef.symbol)];
+	if(symRef.symbol.location == CShaderBuilder::SYMBOL_LOCATION_BUFFER_ELEMENT)
+	{
+		//Members of a buffer array element are reached through the pointer given by SelectBuffer
+		assert(m_bufferElementPointerIds.find(symRef.symbol.index) != std::end(m_bufferElementPointerIds));
+		auto memberIndex = structInfo.memberIndices[m_shaderBuilder.GetBufferArray(symRef.symbol).index];
+		assert(m_intConstantIds.find(memberIndex) != m_intConstantIds.end());
+		return std::make_pair(m_bufferElementPointerIds[symRef.symbol.index], m_intConstantIds[memberIndex]);
+	}
 	auto memberIndex = structInfo.memberIndices[symRef.symbol.index];
 	assert(m_intConstantIds.find(memberIndex) != m_intConstantIds.end());
 	auto memberIdxConstantId = m_intConstantIds[memberIndex];
 	return std::make_pair(structInfo.variableId, memberIdxConstantId);
 }
 
+uint32 CSpirvShaderGenerator::GetStorageBufferUintPointerId(const CShaderBuilder::SYMBOLREF& bufferRef, uint32 indexId)
+{
+	assert(bufferRef.symbol.type == CShaderBuilder::SYMBOL_TYPE_ARRAYUINT);
+	auto bufferAccessParams = GetStructAccessChainParams(bufferRef);
+	auto pointerId = AllocateId();
+	WriteOp(spv::OpAccessChain, m_uniformUintPtrId, pointerId, bufferAccessParams.first, bufferAccessParams.second, indexId);
+	if(bufferRef.symbol.attributes & SYMBOL_ATTRIBUTE_NONUNIFORM)
+	{
+		m_nonUniformIds.insert(pointerId);
+	}
+	return pointerId;
+}
+
 uint32 CSpirvShaderGenerator::ExtractFloat4X(uint32 float4VectorId)
 {
 	uint32 resultId = AllocateId();
@@ -1816,17 +3276,336 @@ uint32 CSpirvShaderGenerator::GetResultType(CShaderBuilder::SYMBOL_TYPE symbolTy
 		return m_uint4TypeId;
 	case CShaderBuilder::SYMBOL_TYPE_INT4:
 		return m_int4TypeId;
+	case CShaderBuilder::SYMBOL_TYPE_BOOL4:
+		return m_bool4TypeId;
+	case CShaderBuilder::SYMBOL_TYPE_HALF4:
+		return m_half4TypeId;
+	default:
+		assert(false);
+		[[fallthrough]];
+	case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
+		return m_float4TypeId;
+	}
+}
+
+uint32 CSpirvShaderGenerator::GetVectorTypeId(CShaderBuilder::SYMBOL_TYPE symbolType) const
+{
+	switch(symbolType)
+	{
 	default:
 		assert(false);
 		[[fallthrough]];
 	case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
 		return m_float4TypeId;
+	case CShaderBuilder::SYMBOL_TYPE_HALF4:
+		return m_half4TypeId;
+	case CShaderBuilder::SYMBOL_TYPE_INT4:
+		return m_int4TypeId;
+	case CShaderBuilder::SYMBOL_TYPE_UINT4:
+		return m_uint4TypeId;
+	case CShaderBuilder::SYMBOL_TYPE_USHORT4:
+		return m_ushort4TypeId;
+	case CShaderBuilder::SYMBOL_TYPE_UCHAR4:
+		return m_uchar4TypeId;
+	case CShaderBuilder::SYMBOL_TYPE_BOOL4:
+		return m_bool4TypeId;
+	}
+}
+
+uint32 CSpirvShaderGenerator::GetFunctionReturnTypeId(const CShaderBuilder::FUNCTION& function) const
+{
+	return (function.returnType == CShaderBuilder::SYMBOL_TYPE_NULL) ? m_voidTypeId : GetVectorTypeId(function.returnType);
+}
+
+spv::SelectionControlMask CSpirvShaderGenerator::GetSelectionControl(uint32 selectionControl) const
+{
+	if(selectionControl == SELECTION_CONTROL_NONE)
+	{
+		if(m_flags & FLAG_DEFAULT_SELECTION_FLATTEN)
+		{
+			selectionControl = SELECTION_CONTROL_FLATTEN;
+		}
+		else if(m_flags & FLAG_DEFAULT_SELECTION_DONT_FLATTEN)
+		{
+			selectionControl = SELECTION_CONTROL_DONT_FLATTEN;
+		}
+	}
+	switch(selectionControl)
+	{
+	default:
+		assert(false);
+		[[fallthrough]];
+	case SELECTION_CONTROL_NONE:
+		return spv::SelectionControlMaskNone;
+	case SELECTION_CONTROL_FLATTEN:
+		return spv::SelectionControlFlattenMask;
+	case SELECTION_CONTROL_DONT_FLATTEN:
+		return spv::SelectionControlDontFlattenMask;
+	}
+}
+
+spv::LoopControlMask CSpirvShaderGenerator::GetLoopControl(uint32 loopControl)
+{
+	switch(loopControl)
+	{
+	default:
+		assert(false);
+		[[fallthrough]];
+	case LOOP_CONTROL_NONE:
+		return spv::LoopControlMaskNone;
+	case LOOP_CONTROL_UNROLL:
+		return spv::LoopControlUnrollMask;
+	case LOOP_CONTROL_DONT_UNROLL:
+		return spv::LoopControlDontUnrollMask;
+	}
+}
+
+bool CSpirvShaderGenerator::IsControlFlowStatement(CShaderBuilder::STATEMENT_OP op)
+{
+	switch(op)
+	{
+	case CShaderBuilder::STATEMENT_OP_ELSE:
+	case CShaderBuilder::STATEMENT_OP_IF_END:
+	case CShaderBuilder::STATEMENT_OP_SWITCH_CASE:
+	case CShaderBuilder::STATEMENT_OP_SWITCH_DEFAULT:
+	case CShaderBuilder::STATEMENT_OP_SWITCH_END:
+	case CShaderBuilder::STATEMENT_OP_LOOP_END:
+		return true;
+	default:
+		return false;
+	}
+}
+
+std::vector<CShaderBuilder::StatementList::const_iterator> CSpirvShaderGenerator::FindBlockSeparators(CShaderBuilder::StatementList::const_iterator beginIterator,
+                                                                                                      CShaderBuilder::StatementList::const_iterator endIterator)
+{
+	//Returns the ELSE/CASE/DEFAULT statements belonging to the block started by beginIterator
+	std::vector<CShaderBuilder::StatementList::const_iterator> result;
+	unsigned int depth = 0;
+	for(auto statementIterator = beginIterator; statementIterator != endIterator; statementIterator++)
+	{
+		switch(statementIterator->op)
+		{
+		case CShaderBuilder::STATEMENT_OP_IF_BEGIN:
+		case CShaderBuilder::STATEMENT_OP_SWITCH_BEGIN:
+		case CShaderBuilder::STATEMENT_OP_LOOP_BEGIN:
+			depth++;
+			break;
+		case CShaderBuilder::STATEMENT_OP_IF_END:
+		case CShaderBuilder::STATEMENT_OP_SWITCH_END:
+		case CShaderBuilder::STATEMENT_OP_LOOP_END:
+			assert(depth != 0);
+			depth--;
+			if(depth == 0) return result;
+			break;
+		case CShaderBuilder::STATEMENT_OP_ELSE:
+		case CShaderBuilder::STATEMENT_OP_SWITCH_CASE:
+		case CShaderBuilder::STATEMENT_OP_SWITCH_DEFAULT:
+			if(depth == 1) result.push_back(statementIterator);
+			break;
+		default:
+			break;
+		}
+	}
+	//Block is not closed
+	assert(false);
+	return result;
+}
+
+std::set<uint32> CSpirvShaderGenerator::FindLoopWrittenTemporaries(CShaderBuilder::StatementList::const_iterator beginIterator,
+                                                                     CShaderBuilder::StatementList::const_iterator endIterator)
+{
+	//Returns the temporaries written inside the loop started by beginIterator (including its index)
+	std::set<uint32> result;
+	unsigned int depth = 0;
+	for(auto statementIterator = beginIterator; statementIterator != endIterator; statementIterator++)
+	{
+		const auto& dstSymbol = statementIterator->dstRef.symbol;
+		if(dstSymbol.location == CShaderBuilder::SYMBOL_LOCATION_TEMPORARY)
+		{
+			result.insert(dstSymbol.index);
+		}
+		switch(statementIterator->op)
+		{
+		case CShaderBuilder::STATEMENT_OP_IF_BEGIN:
+		case CShaderBuilder::STATEMENT_OP_SWITCH_BEGIN:
+		case CShaderBuilder::STATEMENT_OP_LOOP_BEGIN:
+			depth++;
+			break;
+		case CShaderBuilder::STATEMENT_OP_IF_END:
+		case CShaderBuilder::STATEMENT_OP_SWITCH_END:
+		case CShaderBuilder::STATEMENT_OP_LOOP_END:
+			assert(depth != 0);
+			depth--;
+			if(depth == 0) return result;
+			break;
+		default:
+			break;
+		}
+	}
+	//Loop is not closed
+	assert(false);
+	return result;
+}
+
+CSpirvShaderGenerator::CONTROL_FLOW_BLOCK& CSpirvShaderGenerator::GetInnermostLoopBlock()
+{
+	auto blockIterator = std::find_if(m_controlFlowBlocks.rbegin(), m_controlFlowBlocks.rend(),
+	                                  [](const CONTROL_FLOW_BLOCK& block) { return block.continueLabelId != EMPTY_ID; });
+	assert(blockIterator != m_controlFlowBlocks.rend());
+	return *blockIterator;
+}
+
+void CSpirvShaderGenerator::BranchToMerge(CONTROL_FLOW_BLOCK& block)
+{
+	if(m_blockTerminated) return;
+	block.incomings.push_back(std::make_pair(m_currentLabelId, m_temporaryValueIds));
+	WriteOp(spv::OpBranch, block.mergeLabelId);
+	m_blockTerminated = true;
+}
+
+void CSpirvShaderGenerator::BeginMergeBlock(uint32 labelId, const std::vector<MergeIncoming>& incomings, const TemporaryValueIdMap& unreachableTemporaryValueIds)
+{
+	WriteOp(spv::OpLabel, labelId);
+	m_currentLabelId = labelId;
+	m_blockTerminated = false;
+
+	if(incomings.empty())
+	{
+		//Every path returned, merge block is unreachable
+		m_temporaryValueIds = unreachableTemporaryValueIds;
+		return;
+	}
+
+	//Temporaries that were modified on some paths need a phi to select the right value
+	for(auto& temporaryValueIdPair : m_temporaryValueIds)
+	{
+		auto temporaryIndex = temporaryValueIdPair.first;
+		const auto& firstIncoming = incomings[0];
+		uint32 firstValueId = firstIncoming.second.find(temporaryIndex)->second;
+		bool needsPhi = false;
+		std::vector<uint32> phiParams;
+		for(const auto& incoming : incomings)
+		{
+			uint32 valueId = incoming.second.find(temporaryIndex)->second;
+			needsPhi |= (valueId != firstValueId);
+			phiParams.push_back(valueId);
+			phiParams.push_back(incoming.first);
+		}
+		if(needsPhi)
+		{
+			auto phiId = AllocateId();
+			assert(m_temporaryTypeIds.find(temporaryIndex) != std::end(m_temporaryTypeIds));
+			WriteOp(spv::OpPhi, m_temporaryTypeIds[temporaryIndex], phiId, phiParams);
+			temporaryValueIdPair.second = phiId;
+		}
+		else
+		{
+			temporaryValueIdPair.second = firstValueId;
+		}
+	}
+}
+
+void CSpirvShaderGenerator::BeginLoop(const CShaderBuilder::STATEMENT& statement, CShaderBuilder::StatementList::const_iterator beginIterator,
+                                      CShaderBuilder::StatementList::const_iterator endIterator)
+{
+	CONTROL_FLOW_BLOCK block;
+	block.mergeLabelId = AllocateId();
+	block.headerLabelId = AllocateId();
+	block.continueLabelId = AllocateId();
+	block.indexRef = statement.dstRef;
+	auto bodyLabelId = AllocateId();
+
+	bool isCounted = (block.indexRef.symbol.location != CShaderBuilder::SYMBOL_LOCATION_NULL);
+	if(isCounted)
+	{
+		auto zeroId = AllocateId();
+		auto zeroConstantId = m_intConstantIds[0];
+		WriteOp(spv::OpCompositeConstruct, m_int4TypeId, zeroId, zeroConstantId, zeroConstantId, zeroConstantId, zeroConstantId);
+		StoreToSymbol(block.indexRef, zeroId);
+	}
+
+	WriteOp(spv::OpBranch, block.headerLabelId);
+	WriteOp(spv::OpLabel, block.headerLabelId);
+
+	//Temporaries modified by the loop get their value from the preheader or from the back edge
+	auto preheaderLabelId = m_currentLabelId;
+	for(auto temporaryIndex : FindLoopWrittenTemporaries(beginIterator, endIterator))
+	{
+		assert(m_temporaryTypeIds.find(temporaryIndex) != std::end(m_temporaryTypeIds));
+		auto phiId = AllocateId();
+		auto backEdgeValueId = AllocateId();
+		WriteOp(spv::OpPhi, m_temporaryTypeIds[temporaryIndex], phiId,
+		        m_temporaryValueIds[temporaryIndex], preheaderLabelId, backEdgeValueId, block.continueLabelId);
+		m_temporaryValueIds[temporaryIndex] = phiId;
+		block.backEdgeValueIds[temporaryIndex] = backEdgeValueId;
+	}
+	m_currentLabelId = block.headerLabelId;
+	block.headerTemporaryValueIds = m_temporaryValueIds;
+
+	if(isCounted)
+	{
+		auto indexId = AllocateId();
+		auto countId = AllocateId();
+		auto conditionId = AllocateId();
+		WriteOp(spv::OpCompositeExtract, m_intTypeId, indexId, LoadFromSymbol(block.indexRef), 0);
+		WriteOp(spv::OpCompositeExtract, m_intTypeId, countId, LoadFromSymbol(statement.src1Ref), 0);
+		WriteOp(spv::OpSLessThan, m_boolTypeId, conditionId, indexId, countId);
+		WriteOp(spv::OpLoopMerge, block.mergeLabelId, block.continueLabelId, GetLoopControl(statement.param));
+		WriteOp(spv::OpBranchConditional, conditionId, bodyLabelId, block.mergeLabelId);
+		block.incomings.push_back(std::make_pair(m_currentLabelId, m_temporaryValueIds));
+	}
+	else
+	{
+		WriteOp(spv::OpLoopMerge, block.mergeLabelId, block.continueLabelId, GetLoopControl(statement.param));
+		WriteOp(spv::OpBranch, bodyLabelId);
+	}
+
+	WriteOp(spv::OpLabel, bodyLabelId);
+	m_currentLabelId = bodyLabelId;
+	m_blockTerminated = false;
+	m_controlFlowBlocks.push_back(std::move(block));
+}
+
+void CSpirvShaderGenerator::EndLoop()
+{
+	assert(!m_controlFlowBlocks.empty());
+	auto& block = m_controlFlowBlocks.back();
+	assert(block.continueLabelId != EMPTY_ID);
+
+	if(!m_blockTerminated)
+	{
+		block.continueIncomings.push_back(std::make_pair(m_currentLabelId, m_temporaryValueIds));
+		WriteOp(spv::OpBranch, block.continueLabelId);
+	}
+
+	BeginMergeBlock(block.continueLabelId, block.continueIncomings, block.headerTemporaryValueIds);
+	if(block.indexRef.symbol.location != CShaderBuilder::SYMBOL_LOCATION_NULL)
+	{
+		auto indexId = AllocateId();
+		auto nextIndexId = AllocateId();
+		auto nextIndexVectorId = AllocateId();
+		auto zeroConstantId = m_intConstantIds[0];
+		WriteOp(spv::OpCompositeExtract, m_intTypeId, indexId, LoadFromSymbol(block.indexRef), 0);
+		WriteOp(spv::OpIAdd, m_intTypeId, nextIndexId, indexId, m_intConstantIds[1]);
+		WriteOp(spv::OpCompositeConstruct, m_int4TypeId, nextIndexVectorId, nextIndexId, zeroConstantId, zeroConstantId, zeroConstantId);
+		StoreToSymbol(block.indexRef, nextIndexVectorId);
+	}
+	for(const auto& backEdgeValueIdPair : block.backEdgeValueIds)
+	{
+		auto temporaryIndex = backEdgeValueIdPair.first;
+		WriteOp(spv::OpCopyObject, m_temporaryTypeIds[temporaryIndex], backEdgeValueIdPair.second, m_temporaryValueIds[temporaryIndex]);
 	}
+	WriteOp(spv::OpBranch, block.headerLabelId);
+	m_blockTerminated = true;
+
+	BeginMergeBlock(block.mergeLabelId, block.incomings, block.headerTemporaryValueIds);
+	m_controlFlowBlocks.pop_back();
 }
 
 void CSpirvShaderGenerator::Write32(uint32 value)
 {
-	m_outputStream.Write32(value);
+	m_currentStream->Write32(value);
 }
 
 uint32 CSpirvShaderGenerator::MapSemanticToLocation(Nuanceur::SEMANTIC semantic, uint32 index)
@@ -1850,17 +3629,38 @@ uint32 CSpirvShaderGenerator::MapSemanticToLocation(Nuanceur::SEMANTIC semantic,
 		assert(false);
 		break;
 	}
-	return 0;
-}
-
-bool CSpirvShaderGenerator::IsBuiltInOutput(Nuanceur::SEMANTIC semantic) const
-{
-	if(m_shaderType == SHADER_TYPE_VERTEX)
+	return 0;
+}
+
+bool CSpirvShaderGenerator::IsBuiltInOutput(Nuanceur::SEMANTIC semantic) const
+{
+	if(m_shaderType == SHADER_TYPE_VERTEX)
+	{
+		if(semantic == Nuanceur::SEMANTIC_SYSTEM_POSITION) return true;
+		if(semantic == Nuanceur::SEMANTIC_SYSTEM_POINTSIZE) return true;
+	}
+	return false;
+}
+
+bool CSpirvShaderGenerator::IsRelaxedPrecision(const CShaderBuilder::SYMBOL& symbol) const
+{
+	switch(symbol.type)
+	{
+	case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
+	case CShaderBuilder::SYMBOL_TYPE_INT4:
+	case CShaderBuilder::SYMBOL_TYPE_UINT4:
+		break;
+	case CShaderBuilder::SYMBOL_TYPE_HALF4:
+		return !m_hasNativeFloat16;
+	default:
+		return false;
+	}
+	auto precision = m_shaderBuilder.GetPrecision(symbol);
+	if(precision == PRECISION_DEFAULT)
 	{
-		if(semantic == Nuanceur::SEMANTIC_SYSTEM_POSITION) return true;
-		if(semantic == Nuanceur::SEMANTIC_SYSTEM_POINTSIZE) return true;
+		precision = static_cast<PRECISION>(m_shaderBuilder.GetMetadata(CShaderBuilder::METADATA_PRECISION, PRECISION_HIGH));
 	}
-	return false;
+	return (precision == PRECISION_MEDIUM) || (precision == PRECISION_LOW);
 }
 
 uint32 CSpirvShaderGenerator::MakeDefinedInt4Vector(uint32 srcValueId, SWIZZLE_TYPE swizzle)
@@ -1904,6 +3704,9 @@ void CSpirvShaderGenerator::Add(const CShaderBuilder::SYMBOLREF& dstRef, const C
 	case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
 		WriteOp(spv::OpFAdd, m_float4TypeId, resultId, src1Id, src2Id);
 		break;
+	case CShaderBuilder::SYMBOL_TYPE_HALF4:
+		WriteOp(spv::OpFAdd, m_half4TypeId, resultId, src1Id, src2Id);
+		break;
 	case CShaderBuilder::SYMBOL_TYPE_INT4:
 		WriteOp(spv::OpIAdd, m_int4TypeId, resultId, src1Id, src2Id);
 		break;
@@ -1968,6 +3771,9 @@ void CSpirvShaderGenerator::Div(const CShaderBuilder::SYMBOLREF& dstRef, const C
 	case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
 		WriteOp(spv::OpFDiv, m_float4TypeId, resultId, src1Id, src2Id);
 		break;
+	case CShaderBuilder::SYMBOL_TYPE_HALF4:
+		WriteOp(spv::OpFDiv, m_half4TypeId, resultId, src1Id, src2Id);
+		break;
 	case CShaderBuilder::SYMBOL_TYPE_INT4:
 	{
 		uint32 dividerId = MakeDefinedInt4Vector(src2Id, src2Ref.swizzle);
@@ -2024,6 +3830,9 @@ void CSpirvShaderGenerator::Sub(const CShaderBuilder::SYMBOLREF& dstRef, const C
 	case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
 		WriteOp(spv::OpFSub, m_float4TypeId, resultId, src1Id, src2Id);
 		break;
+	case CShaderBuilder::SYMBOL_TYPE_HALF4:
+		WriteOp(spv::OpFSub, m_half4TypeId, resultId, src1Id, src2Id);
+		break;
 	case CShaderBuilder::SYMBOL_TYPE_INT4:
 		WriteOp(spv::OpISub, m_int4TypeId, resultId, src1Id, src2Id);
 		break;
@@ -2050,6 +3859,9 @@ void CSpirvShaderGenerator::Clamp(const CShaderBuilder::SYMBOLREF& dstRef, const
 	case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
 		WriteOp(spv::OpExtInst, m_float4TypeId, resultId, m_glslStd450ExtInst, GLSLstd450::GLSLstd450FClamp, src1Id, src2Id, src3Id);
 		break;
+	case CShaderBuilder::SYMBOL_TYPE_HALF4:
+		WriteOp(spv::OpExtInst, m_half4TypeId, resultId, m_glslStd450ExtInst, GLSLstd450::GLSLstd450FClamp, src1Id, src2Id, src3Id);
+		break;
 	case CShaderBuilder::SYMBOL_TYPE_INT4:
 		WriteOp(spv::OpExtInst, m_int4TypeId, resultId, m_glslStd450ExtInst, GLSLstd450::GLSLstd450SClamp, src1Id, src2Id, src3Id);
 		break;
@@ -2086,12 +3898,12 @@ void CSpirvShaderGenerator::Dot(const CShaderBuilder::SYMBOLREF& dstRef, const C
 
 void CSpirvShaderGenerator::GlslStdOp(GLSLstd450 op, const CShaderBuilder::SYMBOLREF& dstRef, const CShaderBuilder::SYMBOLREF& src1Ref)
 {
-	assert(src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_FLOAT4);
+	assert((src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_FLOAT4) || (src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_HALF4));
 
 	auto src1Id = LoadFromSymbol(src1Ref);
 	auto resultId = AllocateId();
 
-	WriteOp(spv::OpExtInst, m_float4TypeId, resultId, m_glslStd450ExtInst, op, src1Id);
+	WriteOp(spv::OpExtInst, GetResultType(src1Ref.symbol.type), resultId, m_glslStd450ExtInst, op, src1Id);
 
 	StoreToSymbol(dstRef, resultId);
 }
@@ -2107,6 +3919,9 @@ void CSpirvShaderGenerator::Min(const CShaderBuilder::SYMBOLREF& dstRef, const C
 	case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
 		WriteOp(spv::OpExtInst, m_float4TypeId, resultId, m_glslStd450ExtInst, GLSLstd450::GLSLstd450FMin, src1Id, src2Id);
 		break;
+	case CShaderBuilder::SYMBOL_TYPE_HALF4:
+		WriteOp(spv::OpExtInst, m_half4TypeId, resultId, m_glslStd450ExtInst, GLSLstd450::GLSLstd450FMin, src1Id, src2Id);
+		break;
 	case CShaderBuilder::SYMBOL_TYPE_INT4:
 		WriteOp(spv::OpExtInst, m_int4TypeId, resultId, m_glslStd450ExtInst, GLSLstd450::GLSLstd450SMin, src1Id, src2Id);
 		break;
@@ -2132,6 +3947,9 @@ void CSpirvShaderGenerator::Max(const CShaderBuilder::SYMBOLREF& dstRef, const C
 	case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
 		WriteOp(spv::OpExtInst, m_float4TypeId, resultId, m_glslStd450ExtInst, GLSLstd450::GLSLstd450FMax, src1Id, src2Id);
 		break;
+	case CShaderBuilder::SYMBOL_TYPE_HALF4:
+		WriteOp(spv::OpExtInst, m_half4TypeId, resultId, m_glslStd450ExtInst, GLSLstd450::GLSLstd450FMax, src1Id, src2Id);
+		break;
 	case CShaderBuilder::SYMBOL_TYPE_INT4:
 		WriteOp(spv::OpExtInst, m_int4TypeId, resultId, m_glslStd450ExtInst, GLSLstd450::GLSLstd450SMax, src1Id, src2Id);
 		break;
@@ -2149,23 +3967,23 @@ void CSpirvShaderGenerator::Max(const CShaderBuilder::SYMBOLREF& dstRef, const C
 void CSpirvShaderGenerator::Mix(const CShaderBuilder::SYMBOLREF& dstRef, const CShaderBuilder::SYMBOLREF& src1Ref,
                                 const CShaderBuilder::SYMBOLREF& src2Ref, const CShaderBuilder::SYMBOLREF& src3Ref)
 {
-	assert(src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_FLOAT4);
-	assert(src2Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_FLOAT4);
+	assert(src1Ref.symbol.type == src2Ref.symbol.type);
 
 	auto src1Id = LoadFromSymbol(src1Ref);
 	auto src2Id = LoadFromSymbol(src2Ref);
 	auto src3Id = LoadFromSymbol(src3Ref);
 	auto resultId = AllocateId();
 
-	if(src3Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_FLOAT4)
+	if((src3Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_FLOAT4) || (src3Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_HALF4))
 	{
-		WriteOp(spv::OpExtInst, m_float4TypeId, resultId, m_glslStd450ExtInst, GLSLstd450::GLSLstd450FMix,
+		assert(src1Ref.symbol.type == src3Ref.symbol.type);
+		WriteOp(spv::OpExtInst, GetResultType(src1Ref.symbol.type), resultId, m_glslStd450ExtInst, GLSLstd450::GLSLstd450FMix,
 		        src1Id, src2Id, src3Id);
 	}
 	else if(src3Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_BOOL4)
 	{
 		//Order for Select is different from typical Mix
-		WriteOp(spv::OpSelect, m_float4TypeId, resultId, src3Id, src2Id, src1Id);
+		WriteOp(spv::OpSelect, GetResultType(src1Ref.symbol.type), resultId, src3Id, src2Id, src1Id);
 	}
 	else
 	{
@@ -2186,6 +4004,9 @@ void CSpirvShaderGenerator::Negate(const CShaderBuilder::SYMBOLREF& dstRef, cons
 	case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
 		WriteOp(spv::OpFNegate, m_float4TypeId, resultId, src1Id);
 		break;
+	case CShaderBuilder::SYMBOL_TYPE_HALF4:
+		WriteOp(spv::OpFNegate, m_half4TypeId, resultId, src1Id);
+		break;
 	default:
 		assert(false);
 		break;
@@ -2215,129 +4036,606 @@ void CSpirvShaderGenerator::Compare(CShaderBuilder::STATEMENT_OP op, const CShad
 	        {CShaderBuilder::STATEMENT_OP_COMPARE_GE, spv::OpSGreaterThanEqual},
 	    };
 
-	static const CompareOpPair uintCompareOps[] =
-	    {
-	        {CShaderBuilder::STATEMENT_OP_COMPARE_EQ, spv::OpIEqual},
-	        {CShaderBuilder::STATEMENT_OP_COMPARE_NE, spv::OpINotEqual},
-	        {CShaderBuilder::STATEMENT_OP_COMPARE_LT, spv::OpULessThan},
-	        {CShaderBuilder::STATEMENT_OP_COMPARE_LE, spv::OpULessThanEqual},
-	        {CShaderBuilder::STATEMENT_OP_COMPARE_GT, spv::OpUGreaterThan},
-	        {CShaderBuilder::STATEMENT_OP_COMPARE_GE, spv::OpUGreaterThanEqual},
-	    };
+	static const CompareOpPair uintCompareOps[] =
+	    {
+	        {CShaderBuilder::STATEMENT_OP_COMPARE_EQ, spv::OpIEqual},
+	        {CShaderBuilder::STATEMENT_OP_COMPARE_NE, spv::OpINotEqual},
+	        {CShaderBuilder::STATEMENT_OP_COMPARE_LT, spv::OpULessThan},
+	        {CShaderBuilder::STATEMENT_OP_COMPARE_LE, spv::OpULessThanEqual},
+	        {CShaderBuilder::STATEMENT_OP_COMPARE_GT, spv::OpUGreaterThan},
+	        {CShaderBuilder::STATEMENT_OP_COMPARE_GE, spv::OpUGreaterThanEqual},
+	    };
+
+	auto opMatcher = [&](const CompareOpPair& compareOp) { return compareOp.first == op; };
+
+	auto src1Id = LoadFromSymbol(src1Ref);
+	auto src2Id = LoadFromSymbol(src2Ref);
+	auto symbolType = GetCommonSymbolType(src1Ref, src2Ref);
+
+	uint32 scalarTypeId =
+	    [&]() {
+		    switch(symbolType)
+		    {
+		    default:
+			    assert(false);
+			    [[fallthrough]];
+		    case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
+			    return m_floatTypeId;
+		    case CShaderBuilder::SYMBOL_TYPE_INT4:
+			    return m_intTypeId;
+		    case CShaderBuilder::SYMBOL_TYPE_UINT4:
+			    return m_uintTypeId;
+		    }
+	    }();
+
+	static const auto find_if_null =
+	    [](auto beginIterator, auto endIterator, auto matcher) {
+		    auto result = std::find_if(beginIterator, endIterator, matcher);
+		    return (result == endIterator) ? nullptr : result;
+	    };
+
+	const auto compareOp =
+	    [&]() -> const CompareOpPair* {
+		switch(symbolType)
+		{
+		case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
+			return find_if_null(std::begin(floatCompareOps), std::end(floatCompareOps), opMatcher);
+		case CShaderBuilder::SYMBOL_TYPE_INT4:
+			return find_if_null(std::begin(intCompareOps), std::end(intCompareOps), opMatcher);
+		case CShaderBuilder::SYMBOL_TYPE_UINT4:
+			return find_if_null(std::begin(uintCompareOps), std::end(uintCompareOps), opMatcher);
+		default:
+			assert(false);
+			return nullptr;
+		}
+	}();
+	auto opType = compareOp ? compareOp->second : spv::OpNop;
+	assert(opType != spv::OpNop);
+
+	auto resultId = AllocateId();
+	WriteOp(opType, m_bool4TypeId, resultId, src1Id, src2Id);
+
+	StoreToSymbol(dstRef, resultId);
+}
+
+void CSpirvShaderGenerator::AtomicImageOp(spv::Op op, const CShaderBuilder::STATEMENT& statement)
+{
+	const auto& dstRef = statement.dstRef;
+	const auto& src1Ref = statement.src1Ref;
+	const auto& src2Ref = statement.src2Ref;
+	const auto& src3Ref = statement.src3Ref;
+
+	assert(src3Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_UINT4);
+
+	auto scope = GetAtomicScope(statement.param);
+	auto semantics = GetAtomicSemantics(src1Ref.symbol, GetAtomicOrder(statement.param));
+
+	assert(m_intConstantIds.find(scope) != std::end(m_intConstantIds));
+	assert(m_intConstantIds.find(semantics) != std::end(m_intConstantIds));
+
+	auto scopeId = m_intConstantIds[scope];
+	auto semanticsId = m_intConstantIds[semantics];
+
+	uint32 pointerId = EMPTY_ID;
+	if(src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_IMAGE2DUINT)
+	{
+		//Image atomics are only available on 32-bit formats
+		assert(m_shaderBuilder.GetImageFormat(src1Ref.symbol) == IMAGE_FORMAT_R32UI);
+		assert(src2Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_INT4);
+		auto imagePointerId = GetTexturePointerId(src1Ref.symbol);
+
+		auto coordId = LoadFromSymbol(src2Ref);
+
+		assert(m_intConstantIds.find(0) != std::end(m_intConstantIds));
+
+		auto imageSample0Id = m_intConstantIds[0];
+
+		auto cvtCoordId = AllocateId();
+		pointerId = AllocateId();
+
+		assert(m_imageUintPtrId != EMPTY_ID);
+
+		WriteOp(spv::OpVectorShuffle, m_int2TypeId, cvtCoordId, coordId, coordId, 0, 1);
+		WriteOp(spv::OpImageTexelPointer, m_imageUintPtrId, pointerId, imagePointerId, cvtCoordId, imageSample0Id);
+	}
+	else if(src1Ref.symbol.location == CShaderBuilder::SYMBOL_LOCATION_SHARED)
+	{
+		assert(src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_ARRAYUINT);
+		assert(src2Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_INT4);
+		auto src2Id = LoadFromSymbol(src2Ref);
+		auto indexId = AllocateId();
+
+		WriteOp(spv::OpCompositeExtract, m_intTypeId, indexId, src2Id, 0);
+		pointerId = GetSharedArrayElementPointerId(src1Ref, indexId);
+	}
+	else if(src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_BUFFERPOINTERUINT)
+	{
+		assert(src2Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_INT4);
+		auto src2Id = LoadFromSymbol(src2Ref);
+		auto indexId = AllocateId();
+
+		WriteOp(spv::OpCompositeExtract, m_intTypeId, indexId, src2Id, 0);
+		pointerId = GetBufferPointerElementPointerId(src1Ref, indexId);
+	}
+	else
+	{
+		assert(src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_ARRAYUINT);
+		assert(src2Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_INT4);
+		auto src2Id = LoadFromSymbol(src2Ref);
+		auto indexId = AllocateId();
+
+		WriteOp(spv::OpCompositeExtract, m_intTypeId, indexId, src2Id, 0);
+		pointerId = GetStorageBufferUintPointerId(src1Ref, indexId);
+	}
+
+	auto src3Id = LoadFromSymbol(src3Ref);
+	auto valueId = AllocateId();
+	auto resultId = AllocateId();
+	WriteOp(spv::OpCompositeExtract, m_uintTypeId, valueId, src3Id, 0);
+
+	if(op == spv::OpAtomicCompareExchange)
+	{
+		auto unequalSemantics = GetAtomicSemantics(src1Ref.symbol, GetAtomicUnequalOrder(statement.param));
+		assert(m_intConstantIds.find(unequalSemantics) != std::end(m_intConstantIds));
+
+		auto src4Id = LoadFromSymbol(statement.src4Ref);
+		auto comparatorId = AllocateId();
+		WriteOp(spv::OpCompositeExtract, m_uintTypeId, comparatorId, src4Id, 0);
+		WriteOp(op, m_uintTypeId, resultId, pointerId, scopeId, semanticsId, m_intConstantIds[unequalSemantics], valueId, comparatorId);
+	}
+	else
+	{
+		WriteOp(op, m_uintTypeId, resultId, pointerId, scopeId, semanticsId, valueId);
+	}
+
+	assert(m_uintConstantIds.find(0) != std::end(m_uintConstantIds));
+	auto zeroConstantId = m_uintConstantIds[0];
+	auto result4Id = AllocateId();
+	WriteOp(spv::OpCompositeConstruct, m_uint4TypeId, result4Id, resultId, zeroConstantId, zeroConstantId, zeroConstantId);
+	StoreToSymbol(dstRef, result4Id);
+}
+
+bool CSpirvShaderGenerator::IsAtomicStatement(CShaderBuilder::STATEMENT_OP op)
+{
+	switch(op)
+	{
+	case CShaderBuilder::STATEMENT_OP_ATOMICAND:
+	case CShaderBuilder::STATEMENT_OP_ATOMICOR:
+	case CShaderBuilder::STATEMENT_OP_ATOMICXOR:
+	case CShaderBuilder::STATEMENT_OP_ATOMICADD:
+	case CShaderBuilder::STATEMENT_OP_ATOMICMIN:
+	case CShaderBuilder::STATEMENT_OP_ATOMICMAX:
+	case CShaderBuilder::STATEMENT_OP_ATOMICEXCHANGE:
+	case CShaderBuilder::STATEMENT_OP_ATOMICCOMPAREEXCHANGE:
+		return true;
+	default:
+		return false;
+	}
+}
+
+spv::Scope CSpirvShaderGenerator::GetAtomicScope(uint32 param)
+{
+	switch(param & 0xFFFF)
+	{
+	default:
+		assert(false);
+		[[fallthrough]];
+	case MEMORY_SCOPE_DEVICE:
+		return spv::ScopeDevice;
+	case MEMORY_SCOPE_WORKGROUP:
+		return spv::ScopeWorkgroup;
+	case MEMORY_SCOPE_SUBGROUP:
+		return spv::ScopeSubgroup;
+	case MEMORY_SCOPE_INVOCATION:
+		return spv::ScopeInvocation;
+	}
+}
+
+MEMORY_ORDER CSpirvShaderGenerator::GetAtomicOrder(uint32 param)
+{
+	return static_cast<MEMORY_ORDER>(param >> 16);
+}
+
+MEMORY_ORDER CSpirvShaderGenerator::GetAtomicUnequalOrder(uint32 param)
+{
+	//A failed compare exchange doesn't store anything and can't have release semantics
+	switch(GetAtomicOrder(param))
+	{
+	case MEMORY_ORDER_ACQUIRE:
+	case MEMORY_ORDER_ACQUIRE_RELEASE:
+		return MEMORY_ORDER_ACQUIRE;
+	default:
+		return MEMORY_ORDER_RELAXED;
+	}
+}
+
+uint32 CSpirvShaderGenerator::GetAtomicSemantics(const CShaderBuilder::SYMBOL& resource, MEMORY_ORDER order)
+{
+	uint32 semantics = spv::MemorySemanticsMaskNone;
+	switch(order)
+	{
+	default:
+		assert(false);
+		[[fallthrough]];
+	case MEMORY_ORDER_RELAXED:
+		//Storage class bits are meaningless without ordering
+		return semantics;
+	case MEMORY_ORDER_ACQUIRE:
+		semantics = spv::MemorySemanticsAcquireMask;
+		break;
+	case MEMORY_ORDER_RELEASE:
+		semantics = spv::MemorySemanticsReleaseMask;
+		break;
+	case MEMORY_ORDER_ACQUIRE_RELEASE:
+		semantics = spv::MemorySemanticsAcquireReleaseMask;
+		break;
+	}
+	if(resource.type == CShaderBuilder::SYMBOL_TYPE_IMAGE2DUINT)
+	{
+		semantics |= spv::MemorySemanticsImageMemoryMask;
+	}
+	else if(resource.location == CShaderBuilder::SYMBOL_LOCATION_SHARED)
+	{
+		semantics |= spv::MemorySemanticsWorkgroupMemoryMask;
+	}
+	else
+	{
+		semantics |= spv::MemorySemanticsUniformMemoryMask;
+	}
+	return semantics;
+}
+
+void CSpirvShaderGenerator::SubgroupBallot(const CShaderBuilder::SYMBOLREF& dstRef, const CShaderBuilder::SYMBOLREF& src1Ref)
+{
+	assert(src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_BOOL4);
+	assert(dstRef.symbol.type == CShaderBuilder::SYMBOL_TYPE_UINT4);
+	assert(m_intConstantIds.find(spv::ScopeSubgroup) != std::end(m_intConstantIds));
+
+	auto src1Id = LoadFromSymbol(src1Ref);
+	auto predicateId = AllocateId();
+	auto resultId = AllocateId();
+
+	WriteOp(spv::OpCompositeExtract, m_boolTypeId, predicateId, src1Id, 0);
+	WriteOp(spv::OpGroupNonUniformBallot, m_uint4TypeId, resultId, m_intConstantIds[spv::ScopeSubgroup], predicateId);
+	StoreToSymbol(dstRef, resultId);
+}
+
+void CSpirvShaderGenerator::SubgroupBroadcast(const CShaderBuilder::SYMBOLREF& dstRef, const CShaderBuilder::SYMBOLREF& src1Ref, uint32 invocationId)
+{
+	assert(m_intConstantIds.find(spv::ScopeSubgroup) != std::end(m_intConstantIds));
+	assert(m_uintConstantIds.find(invocationId) != std::end(m_uintConstantIds));
+
+	auto src1Id = LoadFromSymbol(src1Ref);
+	auto resultId = AllocateId();
+
+	WriteOp(spv::OpGroupNonUniformBroadcast, GetResultType(src1Ref.symbol.type), resultId, m_intConstantIds[spv::ScopeSubgroup],
+	        src1Id, m_uintConstantIds[invocationId]);
+	StoreToSymbol(dstRef, resultId);
+}
+
+void CSpirvShaderGenerator::SubgroupShuffle(const CShaderBuilder::SYMBOLREF& dstRef, const CShaderBuilder::SYMBOLREF& src1Ref, const CShaderBuilder::SYMBOLREF& src2Ref)
+{
+	assert(src2Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_UINT4);
+	assert(m_intConstantIds.find(spv::ScopeSubgroup) != std::end(m_intConstantIds));
+
+	auto src1Id = LoadFromSymbol(src1Ref);
+	auto src2Id = LoadFromSymbol(src2Ref);
+	auto invocationId = AllocateId();
+	auto resultId = AllocateId();
+
+	WriteOp(spv::OpCompositeExtract, m_uintTypeId, invocationId, src2Id, 0);
+	WriteOp(spv::OpGroupNonUniformShuffle, GetResultType(src1Ref.symbol.type), resultId, m_intConstantIds[spv::ScopeSubgroup],
+	        src1Id, invocationId);
+	StoreToSymbol(dstRef, resultId);
+}
+
+void CSpirvShaderGenerator::SubgroupArithmeticOp(spv::Op floatOp, spv::Op intOp, spv::Op uintOp,
+                                                 const CShaderBuilder::SYMBOLREF& dstRef, const CShaderBuilder::SYMBOLREF& src1Ref, uint32 operation)
+{
+	assert(m_intConstantIds.find(spv::ScopeSubgroup) != std::end(m_intConstantIds));
+
+	auto op = spv::OpNop;
+	switch(src1Ref.symbol.type)
+	{
+	case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
+	case CShaderBuilder::SYMBOL_TYPE_HALF4:
+		op = floatOp;
+		break;
+	case CShaderBuilder::SYMBOL_TYPE_INT4:
+		op = intOp;
+		break;
+	case CShaderBuilder::SYMBOL_TYPE_UINT4:
+		op = uintOp;
+		break;
+	default:
+		break;
+	}
+	assert(op != spv::OpNop);
+
+	auto src1Id = LoadFromSymbol(src1Ref);
+	auto resultId = AllocateId();
+
+	WriteOp(op, GetResultType(src1Ref.symbol.type), resultId, m_intConstantIds[spv::ScopeSubgroup], GetGroupOperation(operation), src1Id);
+	StoreToSymbol(dstRef, resultId);
+}
+
+spv::GroupOperation CSpirvShaderGenerator::GetGroupOperation(uint32 operation)
+{
+	switch(operation)
+	{
+	default:
+		assert(false);
+		[[fallthrough]];
+	case SUBGROUP_OPERATION_REDUCE:
+		return spv::GroupOperationReduce;
+	case SUBGROUP_OPERATION_INCLUSIVE_SCAN:
+		return spv::GroupOperationInclusiveScan;
+	case SUBGROUP_OPERATION_EXCLUSIVE_SCAN:
+		return spv::GroupOperationExclusiveScan;
+	}
+}
+
+void CSpirvShaderGenerator::TextureOp(const CShaderBuilder::STATEMENT& statement)
+{
+	const auto& dstRef = statement.dstRef;
+	const auto& src1Ref = statement.src1Ref;
+	const auto& src2Ref = statement.src2Ref;
+
+	auto src1Id = LoadFromSymbol(src1Ref);
+	auto src2Id = LoadFromSymbol(src2Ref);
+	auto resultId = AllocateId();
+
+	if(src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_UNIFORMTEXELBUFFER)
+	{
+		//Texel buffers are not sampled and don't have mip levels
+		assert(statement.op == CShaderBuilder::STATEMENT_OP_FETCH);
+		auto indexId = AllocateId();
+		WriteOp(spv::OpCompositeExtract, m_intTypeId, indexId, src2Id, 0);
+		WriteOp(spv::OpImageFetch, m_float4TypeId, resultId, src1Id, indexId);
+		StoreToSymbol(dstRef, resultId);
+		return;
+	}
+
+	assert(src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_TEXTURE2D);
+	switch(statement.op)
+	{
+	case CShaderBuilder::STATEMENT_OP_SAMPLE_LOD:
+	{
+		auto lodId = ExtractFloat4X(LoadFromSymbol(statement.src3Ref));
+		WriteOp(spv::OpImageSampleExplicitLod, m_float4TypeId, resultId, src1Id, src2Id, spv::ImageOperandsLodMask, lodId);
+	}
+	break;
+	case CShaderBuilder::STATEMENT_OP_SAMPLE_GRAD:
+	{
+		//Gradients need to have as many components as the texture has dimensions
+		auto src3Id = LoadFromSymbol(statement.src3Ref);
+		auto src4Id = LoadFromSymbol(statement.src4Ref);
+		auto dPdxId = AllocateId();
+		auto dPdyId = AllocateId();
+		WriteOp(spv::OpVectorShuffle, m_float2TypeId, dPdxId, src3Id, src3Id, 0, 1);
+		WriteOp(spv::OpVectorShuffle, m_float2TypeId, dPdyId, src4Id, src4Id, 0, 1);
+		WriteOp(spv::OpImageSampleExplicitLod, m_float4TypeId, resultId, src1Id, src2Id, spv::ImageOperandsGradMask, dPdxId, dPdyId);
+	}
+	break;
+	case CShaderBuilder::STATEMENT_OP_SAMPLE_OFFSET:
+	{
+		assert(m_sampleOffsetIds.find(statement.param) != std::end(m_sampleOffsetIds));
+		auto offsetId = m_sampleOffsetIds[statement.param];
+		WriteOp(spv::OpImageSampleImplicitLod, m_float4TypeId, resultId, src1Id, src2Id, spv::ImageOperandsConstOffsetMask, offsetId);
+	}
+	break;
+	case CShaderBuilder::STATEMENT_OP_FETCH:
+	{
+		//Fetching is done on the image itself, without the sampler
+		auto src3Id = LoadFromSymbol(statement.src3Ref);
+		auto imageId = AllocateId();
+		auto coordId = AllocateId();
+		auto lodId = AllocateId();
+		WriteOp(spv::OpImage, m_sampledImage2DTypeId, imageId, src1Id);
+		WriteOp(spv::OpVectorShuffle, m_int2TypeId, coordId, src2Id, src2Id, 0, 1);
+		WriteOp(spv::OpCompositeExtract, m_intTypeId, lodId, src3Id, 0);
+		WriteOp(spv::OpImageFetch, m_float4TypeId, resultId, imageId, coordId, spv::ImageOperandsLodMask, lodId);
+	}
+	break;
+	case CShaderBuilder::STATEMENT_OP_GATHER:
+	{
+		assert(m_intConstantIds.find(statement.param) != std::end(m_intConstantIds));
+		WriteOp(spv::OpImageGather, m_float4TypeId, resultId, src1Id, src2Id, m_intConstantIds[statement.param]);
+	}
+	break;
+	default:
+		assert(false);
+		break;
+	}
+
+	StoreToSymbol(dstRef, resultId);
+}
 
-	auto opMatcher = [&](const CompareOpPair& compareOp) { return compareOp.first == op; };
+void CSpirvShaderGenerator::SelectTexture(const CShaderBuilder::STATEMENT& statement)
+{
+	const auto& dstRef = statement.dstRef;
+	const auto& src1Ref = statement.src1Ref;
+	const auto& src2Ref = statement.src2Ref;
 
-	auto src1Id = LoadFromSymbol(src1Ref);
+	assert(dstRef.symbol.location == CShaderBuilder::SYMBOL_LOCATION_TEXTURE_ELEMENT);
+	assert(src2Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_INT4);
+	assert(m_textureArrayInfos.find(CShaderBuilder::GetBinding(src1Ref.symbol)) != std::end(m_textureArrayInfos));
+
+	const auto& arrayInfo = m_textureArrayInfos[CShaderBuilder::GetBinding(src1Ref.symbol)];
 	auto src2Id = LoadFromSymbol(src2Ref);
-	auto symbolType = GetCommonSymbolType(src1Ref, src2Ref);
+	auto indexId = AllocateId();
+	auto pointerId = AllocateId();
 
-	uint32 scalarTypeId =
-	    [&]() {
-		    switch(symbolType)
-		    {
-		    default:
-			    assert(false);
-			    [[fallthrough]];
-		    case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
-			    return m_floatTypeId;
-		    case CShaderBuilder::SYMBOL_TYPE_INT4:
-			    return m_intTypeId;
-		    case CShaderBuilder::SYMBOL_TYPE_UINT4:
-			    return m_uintTypeId;
-		    }
-	    }();
+	//The element is loaded where it's used, which must be dominated by this statement
+	WriteOp(spv::OpCompositeExtract, m_intTypeId, indexId, src2Id, 0);
+	WriteOp(spv::OpAccessChain, arrayInfo.elementPointerTypeId, pointerId, GetTexturePointerId(src1Ref.symbol), indexId);
+	if(dstRef.symbol.attributes & SYMBOL_ATTRIBUTE_NONUNIFORM)
+	{
+		m_nonUniformIds.insert(pointerId);
+	}
+	m_textureElementPointerIds[dstRef.symbol.index] = pointerId;
+}
 
-	static const auto find_if_null =
-	    [](auto beginIterator, auto endIterator, auto matcher) {
-		    auto result = std::find_if(beginIterator, endIterator, matcher);
-		    return (result == endIterator) ? nullptr : result;
-	    };
+void CSpirvShaderGenerator::SelectBuffer(const CShaderBuilder::STATEMENT& statement)
+{
+	const auto& dstRef = statement.dstRef;
+	const auto& src1Ref = statement.src1Ref;
+	const auto& src2Ref = statement.src2Ref;
 
-	const auto compareOp =
-	    [&]() -> const CompareOpPair* {
-		switch(symbolType)
-		{
-		case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
-			return find_if_null(std::begin(floatCompareOps), std::end(floatCompareOps), opMatcher);
-		case CShaderBuilder::SYMBOL_TYPE_INT4:
-			return find_if_null(std::begin(intCompareOps), std::end(intCompareOps), opMatcher);
-		case CShaderBuilder::SYMBOL_TYPE_UINT4:
-			return find_if_null(std::begin(uintCompareOps), std::end(uintCompareOps), opMatcher);
-		default:
-			assert(false);
-			return nullptr;
-		}
-	}();
-	auto opType = compareOp ? compareOp->second : spv::OpNop;
-	assert(opType != spv::OpNop);
+	assert(dstRef.symbol.location == CShaderBuilder::SYMBOL_LOCATION_BUFFER_ELEMENT);
+	assert(src2Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_INT4);
+	assert(m_structInfos.find(CShaderBuilder::GetBinding(src1Ref.symbol)) != std::end(m_structInfos));
 
-	auto resultId = AllocateId();
-	WriteOp(opType, m_bool4TypeId, resultId, src1Id, src2Id);
+	const auto& structInfo = m_structInfos[CShaderBuilder::GetBinding(src1Ref.symbol)];
+	assert(structInfo.arrayTypeId != EMPTY_ID);
+	auto src2Id = LoadFromSymbol(src2Ref);
+	auto indexId = AllocateId();
+	auto pointerId = AllocateId();
 
-	StoreToSymbol(dstRef, resultId);
+	WriteOp(spv::OpCompositeExtract, m_intTypeId, indexId, src2Id, 0);
+	WriteOp(spv::OpAccessChain, structInfo.elementPointerTypeId, pointerId, structInfo.variableId, indexId);
+	if(dstRef.symbol.attributes & SYMBOL_ATTRIBUTE_NONUNIFORM)
+	{
+		m_nonUniformIds.insert(pointerId);
+	}
+	m_bufferElementPointerIds[dstRef.symbol.index] = pointerId;
+}
+
+int32 CSpirvShaderGenerator::GetSampleOffsetX(uint32 param)
+{
+	return static_cast<int16>(param & 0xFFFF);
+}
+
+int32 CSpirvShaderGenerator::GetSampleOffsetY(uint32 param)
+{
+	return static_cast<int16>(param >> 16);
 }
 
-void CSpirvShaderGenerator::AtomicImageOp(spv::Op op, const CShaderBuilder::SYMBOLREF& dstRef, const CShaderBuilder::SYMBOLREF& src1Ref,
-                                          const CShaderBuilder::SYMBOLREF& src2Ref, const CShaderBuilder::SYMBOLREF& src3Ref)
+void CSpirvShaderGenerator::Load(const CShaderBuilder::SYMBOLREF& dstRef, const CShaderBuilder::SYMBOLREF& src1Ref, const CShaderBuilder::SYMBOLREF& src2Ref)
 {
 	assert(src2Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_INT4);
-	assert(src3Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_UINT4);
 
-	assert(m_intConstantIds.find(spv::ScopeDevice) != std::end(m_intConstantIds));
-	assert(m_intConstantIds.find(spv::MemorySemanticsMaskNone) != std::end(m_intConstantIds));
+	if(
+	    (src1Ref.symbol.location == CShaderBuilder::SYMBOL_LOCATION_SHARED) &&
+	    (src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_ARRAYUINT))
+	{
+		assert(dstRef.symbol.type == CShaderBuilder::SYMBOL_TYPE_UINT4);
+
+		auto src2Id = LoadFromSymbol(src2Ref);
+		auto indexId = AllocateId();
+		auto tempId = AllocateId();
+		auto resultId = AllocateId();
 
-	auto scopeId = m_intConstantIds[spv::ScopeDevice];
-	auto semanticsId = m_intConstantIds[spv::MemorySemanticsMaskNone];
+		assert(m_uintConstantIds.find(0) != std::end(m_uintConstantIds));
+		auto zeroConstantId = m_uintConstantIds[0];
 
-	if(src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_IMAGE2DUINT)
+		WriteOp(spv::OpCompositeExtract, m_intTypeId, indexId, src2Id, 0);
+		auto pointerId = GetSharedArrayElementPointerId(src1Ref, indexId);
+		WriteOp(spv::OpLoad, m_uintTypeId, tempId, pointerId);
+		WriteOp(spv::OpCompositeConstruct, m_uint4TypeId, resultId, tempId, zeroConstantId, zeroConstantId, zeroConstantId);
+		StoreToSymbol(dstRef, resultId);
+	}
+	else if(src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_BUFFERPOINTERUINT)
 	{
-		assert(m_texturePointerIds.find(src1Ref.symbol.unit) != std::end(m_texturePointerIds));
-		auto imagePointerId = m_texturePointerIds[src1Ref.symbol.unit];
+		assert(dstRef.symbol.type == CShaderBuilder::SYMBOL_TYPE_UINT4);
 
-		auto coordId = LoadFromSymbol(src2Ref);
-		auto valueId = LoadFromSymbol(src3Ref);
+		auto src2Id = LoadFromSymbol(src2Ref);
+		auto indexId = AllocateId();
+		auto tempId = AllocateId();
+		auto resultId = AllocateId();
 
-		assert(m_intConstantIds.find(0) != std::end(m_intConstantIds));
+		assert(m_uintConstantIds.find(0) != std::end(m_uintConstantIds));
+		auto zeroConstantId = m_uintConstantIds[0];
 
-		auto imageSample0Id = m_intConstantIds[0];
+		WriteOp(spv::OpCompositeExtract, m_intTypeId, indexId, src2Id, 0);
+		auto pointerId = GetBufferPointerElementPointerId(src1Ref, indexId);
+		WriteOp(spv::OpLoad, m_uintTypeId, tempId, pointerId, spv::MemoryAccessAlignedMask, 4);
+		WriteOp(spv::OpCompositeConstruct, m_uint4TypeId, resultId, tempId, zeroConstantId, zeroConstantId, zeroConstantId);
+		StoreToSymbol(dstRef, resultId);
+	}
+	else if(src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_BUFFERPOINTERFLOAT4)
+	{
+		assert(dstRef.symbol.type == CShaderBuilder::SYMBOL_TYPE_FLOAT4);
 
-		auto texelPtrId = AllocateId();
+		auto src2Id = LoadFromSymbol(src2Ref);
+		auto indexId = AllocateId();
 		auto resultId = AllocateId();
-		auto cvtCoordId = AllocateId();
-		auto cvtValueId = AllocateId();
 
-		assert(m_imageUintPtrId != EMPTY_ID);
+		WriteOp(spv::OpCompositeExtract, m_intTypeId, indexId, src2Id, 0);
+		auto pointerId = GetBufferPointerElementPointerId(src1Ref, indexId);
+		WriteOp(spv::OpLoad, m_float4TypeId, resultId, pointerId, spv::MemoryAccessAlignedMask, 16);
+		StoreToSymbol(dstRef, resultId);
+	}
+	else if(
+	    (src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_ARRAYFLOAT4) ||
+	    (src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_ARRAYINT4))
+	{
+		bool isFloat = (src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_ARRAYFLOAT4);
+		assert(dstRef.symbol.type == (isFloat ? CShaderBuilder::SYMBOL_TYPE_FLOAT4 : CShaderBuilder::SYMBOL_TYPE_INT4));
 
-		//Build some temporary values
-		WriteOp(spv::OpVectorShuffle, m_int2TypeId, cvtCoordId, coordId, coordId, 0, 1);
-		WriteOp(spv::OpCompositeExtract, m_uintTypeId, cvtValueId, valueId, 0);
+		auto src2Id = LoadFromSymbol(src2Ref);
+		auto indexId = AllocateId();
+		auto resultId = AllocateId();
 
-		WriteOp(spv::OpImageTexelPointer, m_imageUintPtrId, texelPtrId, imagePointerId, cvtCoordId, imageSample0Id);
-		WriteOp(op, m_uintTypeId, resultId, texelPtrId, scopeId, semanticsId, cvtValueId);
+		WriteOp(spv::OpCompositeExtract, m_intTypeId, indexId, src2Id, 0);
+		auto pointerId = GetUniformArrayElementPointerId(src1Ref, indexId);
+		WriteOp(spv::OpLoad, isFloat ? m_float4TypeId : m_int4TypeId, resultId, pointerId);
+		StoreToSymbol(dstRef, resultId);
 	}
 	else if(src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_ARRAYUINT)
 	{
-		auto bufferAccessParams = GetStructAccessChainParams(src1Ref);
-		auto src1Id = AllocateId();
+		assert(dstRef.symbol.type == CShaderBuilder::SYMBOL_TYPE_UINT4);
+
 		auto src2Id = LoadFromSymbol(src2Ref);
-		auto src3Id = LoadFromSymbol(src3Ref);
+		auto tempId = AllocateId();
 		auto indexId = AllocateId();
 		auto resultId = AllocateId();
 
-		auto cvtValueId = AllocateId();
-		WriteOp(spv::OpCompositeExtract, m_uintTypeId, cvtValueId, src3Id, 0);
+		assert(m_uintConstantIds.find(0) != std::end(m_uintConstantIds));
+		auto zeroConstantId = m_uintConstantIds[0];
 
 		WriteOp(spv::OpCompositeExtract, m_intTypeId, indexId, src2Id, 0);
-		WriteOp(spv::OpAccessChain, m_uniformUintPtrId, src1Id, bufferAccessParams.first, bufferAccessParams.second, indexId);
-		WriteOp(op, m_uintTypeId, resultId, src1Id, scopeId, semanticsId, cvtValueId);
+		auto src1Id = GetStorageBufferUintPointerId(src1Ref, indexId);
+		WriteOp(spv::OpLoad, m_uintTypeId, tempId, src1Id);
+		WriteOp(spv::OpCompositeConstruct, m_uint4TypeId, resultId, tempId, zeroConstantId, zeroConstantId, zeroConstantId);
+		StoreToSymbol(dstRef, resultId);
 	}
-}
+	else if(
+	    (src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_ARRAYUCHAR) ||
+	    (src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_ARRAYUSHORT))
+	{
+		assert(dstRef.symbol.type == CShaderBuilder::SYMBOL_TYPE_UINT4);
 
-void CSpirvShaderGenerator::Load(const CShaderBuilder::SYMBOLREF& dstRef, const CShaderBuilder::SYMBOLREF& src1Ref, const CShaderBuilder::SYMBOLREF& src2Ref)
-{
-	assert(src2Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_INT4);
+		bool is8Bit = (src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_ARRAYUCHAR);
+		auto elementTypeId = is8Bit ? m_ucharTypeId : m_ushortTypeId;
+		auto src2Id = LoadFromSymbol(src2Ref);
+		auto indexId = AllocateId();
+		auto tempId = AllocateId();
+		auto valueId = AllocateId();
+		auto resultId = AllocateId();
+
+		assert(m_uintConstantIds.find(0) != std::end(m_uintConstantIds));
+		auto zeroConstantId = m_uintConstantIds[0];
 
-	if(src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_ARRAYUINT)
+		WriteOp(spv::OpCompositeExtract, m_intTypeId, indexId, src2Id, 0);
+		uint32 pointerId = EMPTY_ID;
+		if(src1Ref.symbol.location == CShaderBuilder::SYMBOL_LOCATION_SHARED)
+		{
+			pointerId = GetSharedArrayElementPointerId(src1Ref, indexId);
+		}
+		else
+		{
+			auto bufferAccessParams = GetStructAccessChainParams(src1Ref);
+			pointerId = AllocateId();
+			WriteOp(spv::OpAccessChain, is8Bit ? m_uniformUint8PtrId : m_uniformUint16PtrId, pointerId,
+			        bufferAccessParams.first, bufferAccessParams.second, indexId);
+		}
+		WriteOp(spv::OpLoad, elementTypeId, tempId, pointerId);
+		WriteOp(spv::OpUConvert, m_uintTypeId, valueId, tempId);
+		WriteOp(spv::OpCompositeConstruct, m_uint4TypeId, resultId, valueId, zeroConstantId, zeroConstantId, zeroConstantId);
+		StoreToSymbol(dstRef, resultId);
+	}
+	else if(src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_ARRAYUINT2)
 	{
 		assert(dstRef.symbol.type == CShaderBuilder::SYMBOL_TYPE_UINT4);
 
@@ -2348,25 +4646,48 @@ void CSpirvShaderGenerator::Load(const CShaderBuilder::SYMBOLREF& dstRef, const
 		auto indexId = AllocateId();
 		auto resultId = AllocateId();
 
-		assert(m_uintConstantIds.find(0) != std::end(m_uintConstantIds));
-		auto zeroConstantId = m_uintConstantIds[0];
+		WriteOp(spv::OpCompositeExtract, m_intTypeId, indexId, src2Id, 0);
+		WriteOp(spv::OpAccessChain, m_uniformUint2PtrId, src1Id, bufferAccessParams.first, bufferAccessParams.second, indexId);
+		WriteOp(spv::OpLoad, m_uint2TypeId, tempId, src1Id);
+		WriteOp(spv::OpVectorShuffle, m_uint4TypeId, resultId, tempId, tempId, 0, 1, 0, 1);
+		StoreToSymbol(dstRef, resultId);
+	}
+	else if(src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_ARRAYUINT4)
+	{
+		assert(dstRef.symbol.type == CShaderBuilder::SYMBOL_TYPE_UINT4);
+
+		auto bufferAccessParams = GetStructAccessChainParams(src1Ref);
+		auto src1Id = AllocateId();
+		auto src2Id = LoadFromSymbol(src2Ref);
+		auto indexId = AllocateId();
+		auto resultId = AllocateId();
 
 		WriteOp(spv::OpCompositeExtract, m_intTypeId, indexId, src2Id, 0);
-		WriteOp(spv::OpAccessChain, m_uniformUintPtrId, src1Id, bufferAccessParams.first, bufferAccessParams.second, indexId);
-		WriteOp(spv::OpLoad, m_uintTypeId, tempId, src1Id);
-		WriteOp(spv::OpCompositeConstruct, m_uint4TypeId, resultId, tempId, zeroConstantId, zeroConstantId, zeroConstantId);
+		WriteOp(spv::OpAccessChain, m_uniformUint4PtrId, src1Id, bufferAccessParams.first, bufferAccessParams.second, indexId);
+		WriteOp(spv::OpLoad, m_uint4TypeId, resultId, src1Id);
+		StoreToSymbol(dstRef, resultId);
+	}
+	else if(CShaderBuilder::IsImageType(src1Ref.symbol.type))
+	{
+		assert((dstRef.symbol.type == CShaderBuilder::SYMBOL_TYPE_UINT4) || (dstRef.symbol.type == CShaderBuilder::SYMBOL_TYPE_FLOAT4));
+
+		auto src1Id = LoadFromSymbol(src1Ref);
+		auto coordId = LoadStorageImageCoord(src1Ref, src2Ref);
+		auto resultId = AllocateId();
+		auto resultTypeId = (dstRef.symbol.type == CShaderBuilder::SYMBOL_TYPE_FLOAT4) ? m_float4TypeId : m_uint4TypeId;
+		WriteOp(spv::OpImageRead, resultTypeId, resultId, src1Id, coordId);
 		StoreToSymbol(dstRef, resultId);
 	}
-	else if(src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_IMAGE2DUINT)
+	else if(src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_STORAGETEXELBUFFERUINT)
 	{
 		assert(dstRef.symbol.type == CShaderBuilder::SYMBOL_TYPE_UINT4);
 
 		auto src1Id = LoadFromSymbol(src1Ref);
 		auto src2Id = LoadFromSymbol(src2Ref);
 		auto resultId = AllocateId();
-		auto cvtCoordId = AllocateId();
-		WriteOp(spv::OpVectorShuffle, m_int2TypeId, cvtCoordId, src2Id, src2Id, 0, 1);
-		WriteOp(spv::OpImageRead, m_uint4TypeId, resultId, src1Id, cvtCoordId);
+		auto indexId = AllocateId();
+		WriteOp(spv::OpCompositeExtract, m_intTypeId, indexId, src2Id, 0);
+		WriteOp(spv::OpImageRead, m_uint4TypeId, resultId, src1Id, indexId);
 		StoreToSymbol(dstRef, resultId);
 	}
 	else if(src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_SUBPASSINPUT)
@@ -2398,8 +4719,61 @@ void CSpirvShaderGenerator::Load(const CShaderBuilder::SYMBOLREF& dstRef, const
 void CSpirvShaderGenerator::Store(const CShaderBuilder::SYMBOLREF& src1Ref, const CShaderBuilder::SYMBOLREF& src2Ref, const CShaderBuilder::SYMBOLREF& src3Ref)
 {
 	assert(src2Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_INT4);
+	if(CShaderBuilder::IsImageType(src1Ref.symbol.type))
+	{
+		assert((src3Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_UINT4) || (src3Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_FLOAT4));
+		auto src1Id = LoadFromSymbol(src1Ref);
+		auto coordId = LoadStorageImageCoord(src1Ref, src2Ref);
+		auto src3Id = LoadFromSymbol(src3Ref);
+		WriteOp(spv::OpImageWrite, src1Id, coordId, src3Id);
+		return;
+	}
+	if(src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_BUFFERPOINTERFLOAT4)
+	{
+		assert(src3Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_FLOAT4);
+		auto src2Id = LoadFromSymbol(src2Ref);
+		auto src3Id = LoadFromSymbol(src3Ref);
+		auto indexId = AllocateId();
+
+		WriteOp(spv::OpCompositeExtract, m_intTypeId, indexId, src2Id, 0);
+		WriteOp(spv::OpStore, GetBufferPointerElementPointerId(src1Ref, indexId), src3Id, spv::MemoryAccessAlignedMask, 16);
+		return;
+	}
 	assert(src3Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_UINT4);
-	if(src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_ARRAYUINT)
+	if(src1Ref.symbol.location == CShaderBuilder::SYMBOL_LOCATION_SHARED)
+	{
+		auto src2Id = LoadFromSymbol(src2Ref);
+		auto src3Id = LoadFromSymbol(src3Ref);
+		auto valueId = AllocateId();
+		auto indexId = AllocateId();
+
+		WriteOp(spv::OpCompositeExtract, m_intTypeId, indexId, src2Id, 0);
+		WriteOp(spv::OpCompositeExtract, m_uintTypeId, valueId, src3Id, 0);
+		WriteOp(spv::OpStore, GetSharedArrayElementPointerId(src1Ref, indexId), valueId);
+	}
+	else if(src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_BUFFERPOINTERUINT)
+	{
+		auto src2Id = LoadFromSymbol(src2Ref);
+		auto src3Id = LoadFromSymbol(src3Ref);
+		auto valueId = AllocateId();
+		auto indexId = AllocateId();
+
+		WriteOp(spv::OpCompositeExtract, m_intTypeId, indexId, src2Id, 0);
+		WriteOp(spv::OpCompositeExtract, m_uintTypeId, valueId, src3Id, 0);
+		WriteOp(spv::OpStore, GetBufferPointerElementPointerId(src1Ref, indexId), valueId, spv::MemoryAccessAlignedMask, 4);
+	}
+	else if(src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_ARRAYUINT)
+	{
+		auto src2Id = LoadFromSymbol(src2Ref);
+		auto src3Id = LoadFromSymbol(src3Ref);
+		auto valueId = AllocateId();
+		auto indexId = AllocateId();
+
+		WriteOp(spv::OpCompositeExtract, m_intTypeId, indexId, src2Id, 0);
+		WriteOp(spv::OpCompositeExtract, m_uintTypeId, valueId, src3Id, 0);
+		WriteOp(spv::OpStore, GetStorageBufferUintPointerId(src1Ref, indexId), valueId);
+	}
+	else if(src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_ARRAYUINT2)
 	{
 		auto bufferAccessParams = GetStructAccessChainParams(src1Ref);
 		auto src1Id = AllocateId();
@@ -2409,17 +4783,34 @@ void CSpirvShaderGenerator::Store(const CShaderBuilder::SYMBOLREF& src1Ref, cons
 		auto indexId = AllocateId();
 
 		WriteOp(spv::OpCompositeExtract, m_intTypeId, indexId, src2Id, 0);
-		WriteOp(spv::OpCompositeExtract, m_uintTypeId, valueId, src3Id, 0);
-		WriteOp(spv::OpAccessChain, m_uniformUintPtrId, src1Id, bufferAccessParams.first, bufferAccessParams.second, indexId);
+		WriteOp(spv::OpVectorShuffle, m_uint2TypeId, valueId, src3Id, src3Id, 0, 1);
+		WriteOp(spv::OpAccessChain, m_uniformUint2PtrId, src1Id, bufferAccessParams.first, bufferAccessParams.second, indexId);
 		WriteOp(spv::OpStore, src1Id, valueId);
 	}
-	else
+	else if(src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_ARRAYUINT4)
+	{
+		auto bufferAccessParams = GetStructAccessChainParams(src1Ref);
+		auto src1Id = AllocateId();
+		auto src2Id = LoadFromSymbol(src2Ref);
+		auto src3Id = LoadFromSymbol(src3Ref);
+		auto indexId = AllocateId();
+
+		WriteOp(spv::OpCompositeExtract, m_intTypeId, indexId, src2Id, 0);
+		WriteOp(spv::OpAccessChain, m_uniformUint4PtrId, src1Id, bufferAccessParams.first, bufferAccessParams.second, indexId);
+		WriteOp(spv::OpStore, src1Id, src3Id);
+	}
+	else if(src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_STORAGETEXELBUFFERUINT)
 	{
-		assert(src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_IMAGE2DUINT);
 		auto src1Id = LoadFromSymbol(src1Ref);
 		auto src2Id = LoadFromSymbol(src2Ref);
 		auto src3Id = LoadFromSymbol(src3Ref);
-		WriteOp(spv::OpImageWrite, src1Id, src2Id, src3Id);
+		auto indexId = AllocateId();
+		WriteOp(spv::OpCompositeExtract, m_intTypeId, indexId, src2Id, 0);
+		WriteOp(spv::OpImageWrite, src1Id, indexId, src3Id);
+	}
+	else
+	{
+		assert(false);
 	}
 }
 
@@ -2429,8 +4820,6 @@ void CSpirvShaderGenerator::Store16(const CShaderBuilder::SYMBOLREF& src1Ref, co
 	assert(src3Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_USHORT4);
 	assert(src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_ARRAYUSHORT);
 
-	auto bufferAccessParams = GetStructAccessChainParams(src1Ref);
-	auto src1Id = AllocateId();
 	auto src2Id = LoadFromSymbol(src2Ref);
 	auto src3Id = LoadFromSymbol(src3Ref);
 	auto valueId = AllocateId();
@@ -2439,8 +4828,17 @@ void CSpirvShaderGenerator::Store16(const CShaderBuilder::SYMBOLREF& src1Ref, co
 	WriteOp(spv::OpCompositeExtract, m_intTypeId, indexId, src2Id, 0);
 	WriteOp(spv::OpCompositeExtract, m_ushortTypeId, valueId, src3Id, 0);
 
-	WriteOp(spv::OpAccessChain, m_uniformUint16PtrId, src1Id, bufferAccessParams.first, bufferAccessParams.second, indexId);
-	WriteOp(spv::OpStore, src1Id, valueId);
+	if(src1Ref.symbol.location == CShaderBuilder::SYMBOL_LOCATION_SHARED)
+	{
+		WriteOp(spv::OpStore, GetSharedArrayElementPointerId(src1Ref, indexId), valueId);
+	}
+	else
+	{
+		auto bufferAccessParams = GetStructAccessChainParams(src1Ref);
+		auto src1Id = AllocateId();
+		WriteOp(spv::OpAccessChain, m_uniformUint16PtrId, src1Id, bufferAccessParams.first, bufferAccessParams.second, indexId);
+		WriteOp(spv::OpStore, src1Id, valueId);
+	}
 }
 
 void CSpirvShaderGenerator::Store8(const CShaderBuilder::SYMBOLREF& src1Ref, const CShaderBuilder::SYMBOLREF& src2Ref, const CShaderBuilder::SYMBOLREF& src3Ref)
@@ -2449,8 +4847,6 @@ void CSpirvShaderGenerator::Store8(const CShaderBuilder::SYMBOLREF& src1Ref, con
 	assert(src3Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_UCHAR4);
 	assert(src1Ref.symbol.type == CShaderBuilder::SYMBOL_TYPE_ARRAYUCHAR);
 
-	auto bufferAccessParams = GetStructAccessChainParams(src1Ref);
-	auto src1Id = AllocateId();
 	auto src2Id = LoadFromSymbol(src2Ref);
 	auto src3Id = LoadFromSymbol(src3Ref);
 	auto valueId = AllocateId();
@@ -2459,6 +4855,15 @@ void CSpirvShaderGenerator::Store8(const CShaderBuilder::SYMBOLREF& src1Ref, con
 	WriteOp(spv::OpCompositeExtract, m_intTypeId, indexId, src2Id, 0);
 	WriteOp(spv::OpCompositeExtract, m_ucharTypeId, valueId, src3Id, 0);
 
-	WriteOp(spv::OpAccessChain, m_uniformUint8PtrId, src1Id, bufferAccessParams.first, bufferAccessParams.second, indexId);
-	WriteOp(spv::OpStore, src1Id, valueId);
+	if(src1Ref.symbol.location == CShaderBuilder::SYMBOL_LOCATION_SHARED)
+	{
+		WriteOp(spv::OpStore, GetSharedArrayElementPointerId(src1Ref, indexId), valueId);
+	}
+	else
+	{
+		auto bufferAccessParams = GetStructAccessChainParams(src1Ref);
+		auto src1Id = AllocateId();
+		WriteOp(spv::OpAccessChain, m_uniformUint8PtrId, src1Id, bufferAccessParams.first, bufferAccessParams.second, indexId);
+		WriteOp(spv::OpStore, src1Id, valueId);
+	}
 }
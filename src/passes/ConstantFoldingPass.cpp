@@ -0,0 +1,664 @@
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+#include <algorithm>
+#include "nuanceur/passes/ConstantFoldingPass.h"
+#include "nuanceur/passes/PassUtils.h"
+
+using namespace Nuanceur;
+
+namespace
+{
+	struct VALUE
+	{
+		CShaderBuilder::SYMBOL_TYPE type = CShaderBuilder::SYMBOL_TYPE_NULL;
+		unsigned int count = 0;
+		float f[4] = {};
+		int32 i[4] = {};
+		bool b[4] = {};
+	};
+
+	typedef std::unordered_map<PassUtils::SymbolKey, unsigned int> WriteCountMap;
+	typedef std::unordered_map<PassUtils::SymbolKey, size_t> ReadIndexMap;
+	typedef std::unordered_map<PassUtils::SymbolKey, CShaderBuilder::SYMBOL> SubstitutionMap;
+}
+
+static WriteCountMap CountWrites(const PassUtils::StatementArray& statements)
+{
+	WriteCountMap result;
+	for(const auto& statement : statements)
+	{
+		if(statement.dstRef.symbol.location == CShaderBuilder::SYMBOL_LOCATION_NULL) continue;
+		result[PassUtils::MakeSymbolKey(statement.dstRef.symbol)]++;
+	}
+	return result;
+}
+
+static bool IsConstant(const CShaderBuilder::SYMBOL& symbol, const WriteCountMap& writeCounts)
+{
+	if(symbol.location != CShaderBuilder::SYMBOL_LOCATION_TEMPORARY) return false;
+	switch(symbol.type)
+	{
+	case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
+	case CShaderBuilder::SYMBOL_TYPE_INT4:
+	case CShaderBuilder::SYMBOL_TYPE_UINT4:
+	case CShaderBuilder::SYMBOL_TYPE_BOOL4:
+		break;
+	default:
+		return false;
+	}
+	return writeCounts.find(PassUtils::MakeSymbolKey(symbol)) == std::end(writeCounts);
+}
+
+static VALUE GetConstantValue(const CShaderBuilder& shaderBuilder, const CShaderBuilder::SYMBOL& symbol)
+{
+	VALUE result;
+	result.type = symbol.type;
+	result.count = 4;
+	switch(symbol.type)
+	{
+	case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
+	{
+		auto value = shaderBuilder.GetTemporaryValue(symbol);
+		result.f[0] = value.x;
+		result.f[1] = value.y;
+		result.f[2] = value.z;
+		result.f[3] = value.w;
+	}
+	break;
+	case CShaderBuilder::SYMBOL_TYPE_INT4:
+	case CShaderBuilder::SYMBOL_TYPE_UINT4:
+	{
+		auto value = shaderBuilder.GetTemporaryValueInt(symbol);
+		result.i[0] = value.x;
+		result.i[1] = value.y;
+		result.i[2] = value.z;
+		result.i[3] = value.w;
+	}
+	break;
+	case CShaderBuilder::SYMBOL_TYPE_BOOL4:
+	{
+		auto value = shaderBuilder.GetTemporaryValueBool(symbol);
+		result.b[0] = value.x;
+		result.b[1] = value.y;
+		result.b[2] = value.z;
+		result.b[3] = value.w;
+	}
+	break;
+	default:
+		assert(false);
+		break;
+	}
+	return result;
+}
+
+static VALUE SwizzleValue(const VALUE& value, SWIZZLE_TYPE swizzle)
+{
+	VALUE result;
+	result.type = value.type;
+	result.count = GetSwizzleElementCount(swizzle);
+	for(unsigned int i = 0; i < result.count; i++)
+	{
+		auto element = GetSwizzleElement(swizzle, i);
+		result.f[i] = value.f[element];
+		result.i[i] = value.i[element];
+		result.b[i] = value.b[element];
+	}
+	return result;
+}
+
+static bool IsIntegerType(CShaderBuilder::SYMBOL_TYPE type)
+{
+	return (type == CShaderBuilder::SYMBOL_TYPE_INT4) || (type == CShaderBuilder::SYMBOL_TYPE_UINT4);
+}
+
+static bool EvaluateElement(CShaderBuilder::STATEMENT_OP op, const VALUE* srcs, unsigned int srcCount, unsigned int index, VALUE& result)
+{
+	static const VALUE nullValue;
+	const auto& src1 = srcs[0];
+	const auto& src2 = (srcCount > 1) ? srcs[1] : nullValue;
+	const auto& src3 = (srcCount > 2) ? srcs[2] : nullValue;
+
+	auto srcType = src1.type;
+	bool isFloat = (srcType == CShaderBuilder::SYMBOL_TYPE_FLOAT4);
+	bool isInt = (srcType == CShaderBuilder::SYMBOL_TYPE_INT4);
+	bool isUint = (srcType == CShaderBuilder::SYMBOL_TYPE_UINT4);
+	bool isBool = (srcType == CShaderBuilder::SYMBOL_TYPE_BOOL4);
+
+	float f1 = src1.f[index], f2 = src2.f[index], f3 = src3.f[index];
+	int32 i1 = src1.i[index], i2 = src2.i[index], i3 = src3.i[index];
+	uint32 u1 = i1, u2 = i2;
+	bool b1 = src1.b[index], b2 = src2.b[index], b3 = src3.b[index];
+
+	auto& rf = result.f[index];
+	auto& ri = result.i[index];
+	auto& rb = result.b[index];
+
+	switch(op)
+	{
+	case CShaderBuilder::STATEMENT_OP_ASSIGN:
+		if(srcType != result.type) return false;
+		rf = f1;
+		ri = i1;
+		rb = b1;
+		return true;
+	case CShaderBuilder::STATEMENT_OP_ADD:
+		if(srcType != result.type) return false;
+		if(isFloat) rf = f1 + f2;
+		else if(IsIntegerType(srcType)) ri = static_cast<int32>(u1 + u2);
+		else return false;
+		return true;
+	case CShaderBuilder::STATEMENT_OP_SUBSTRACT:
+		if(srcType != result.type) return false;
+		if(isFloat) rf = f1 - f2;
+		else if(IsIntegerType(srcType)) ri = static_cast<int32>(u1 - u2);
+		else return false;
+		return true;
+	case CShaderBuilder::STATEMENT_OP_MULTIPLY:
+		if(srcType != result.type) return false;
+		if(isFloat) rf = f1 * f2;
+		else if(IsIntegerType(srcType)) ri = static_cast<int32>(u1 * u2);
+		else return false;
+		return true;
+	case CShaderBuilder::STATEMENT_OP_DIVIDE:
+		if(srcType != result.type) return false;
+		if(isFloat)
+		{
+			rf = f1 / f2;
+		}
+		else if(isInt)
+		{
+			if((i2 == 0) || ((i1 == std::numeric_limits<int32>::min()) && (i2 == -1))) return false;
+			ri = i1 / i2;
+		}
+		else
+		{
+			return false;
+		}
+		return true;
+	case CShaderBuilder::STATEMENT_OP_MODULO:
+		if(!isInt || (srcType != result.type)) return false;
+		if((i2 == 0) || ((i1 == std::numeric_limits<int32>::min()) && (i2 == -1))) return false;
+		//Sign of result follows the divisor (SMod)
+		ri = i1 % i2;
+		if((ri != 0) && ((ri < 0) != (i2 < 0))) ri += i2;
+		return true;
+	case CShaderBuilder::STATEMENT_OP_AND:
+	case CShaderBuilder::STATEMENT_OP_OR:
+	case CShaderBuilder::STATEMENT_OP_XOR:
+		if(!IsIntegerType(srcType) || (srcType != result.type)) return false;
+		if(op == CShaderBuilder::STATEMENT_OP_AND) ri = static_cast<int32>(u1 & u2);
+		if(op == CShaderBuilder::STATEMENT_OP_OR) ri = static_cast<int32>(u1 | u2);
+		if(op == CShaderBuilder::STATEMENT_OP_XOR) ri = static_cast<int32>(u1 ^ u2);
+		return true;
+	case CShaderBuilder::STATEMENT_OP_NOT:
+		if(!IsIntegerType(srcType) || (srcType != result.type)) return false;
+		ri = static_cast<int32>(~u1);
+		return true;
+	case CShaderBuilder::STATEMENT_OP_LSHIFT:
+	case CShaderBuilder::STATEMENT_OP_RSHIFT:
+	case CShaderBuilder::STATEMENT_OP_RSHIFT_ARITHMETIC:
+		if(!IsIntegerType(srcType) || (srcType != result.type)) return false;
+		//Shifting by the bit width or more is undefined
+		if(u2 >= 32) return false;
+		if(op == CShaderBuilder::STATEMENT_OP_LSHIFT) ri = static_cast<int32>(u1 << u2);
+		if(op == CShaderBuilder::STATEMENT_OP_RSHIFT) ri = static_cast<int32>(u1 >> u2);
+		if(op == CShaderBuilder::STATEMENT_OP_RSHIFT_ARITHMETIC) ri = (i1 < 0) ? ~static_cast<int32>(~u1 >> u2) : static_cast<int32>(u1 >> u2);
+		return true;
+	case CShaderBuilder::STATEMENT_OP_LOGICAL_AND:
+		if(!isBool) return false;
+		rb = b1 && b2;
+		return true;
+	case CShaderBuilder::STATEMENT_OP_LOGICAL_OR:
+		if(!isBool) return false;
+		rb = b1 || b2;
+		return true;
+	case CShaderBuilder::STATEMENT_OP_LOGICAL_NOT:
+		if(!isBool) return false;
+		rb = !b1;
+		return true;
+	case CShaderBuilder::STATEMENT_OP_COMPARE_EQ:
+	case CShaderBuilder::STATEMENT_OP_COMPARE_NE:
+	case CShaderBuilder::STATEMENT_OP_COMPARE_LT:
+	case CShaderBuilder::STATEMENT_OP_COMPARE_LE:
+	case CShaderBuilder::STATEMENT_OP_COMPARE_GT:
+	case CShaderBuilder::STATEMENT_OP_COMPARE_GE:
+	{
+		if(result.type != CShaderBuilder::SYMBOL_TYPE_BOOL4) return false;
+		//Returns -1, 0 or 1, or 2 if unordered
+		int compareResult = 0;
+		if(isFloat)
+		{
+			if(std::isnan(f1) || std::isnan(f2))
+				compareResult = 2;
+			else
+				compareResult = (f1 < f2) ? -1 : ((f1 > f2) ? 1 : 0);
+		}
+		else if(isInt)
+		{
+			compareResult = (i1 < i2) ? -1 : ((i1 > i2) ? 1 : 0);
+		}
+		else if(isUint)
+		{
+			compareResult = (u1 < u2) ? -1 : ((u1 > u2) ? 1 : 0);
+		}
+		else
+		{
+			return false;
+		}
+		if(compareResult == 2)
+		{
+			//Ordered comparisons are always false with NaNs
+			rb = false;
+			return true;
+		}
+		switch(op)
+		{
+		case CShaderBuilder::STATEMENT_OP_COMPARE_EQ:
+			rb = (compareResult == 0);
+			break;
+		case CShaderBuilder::STATEMENT_OP_COMPARE_NE:
+			rb = (compareResult != 0);
+			break;
+		case CShaderBuilder::STATEMENT_OP_COMPARE_LT:
+			rb = (compareResult < 0);
+			break;
+		case CShaderBuilder::STATEMENT_OP_COMPARE_LE:
+			rb = (compareResult <= 0);
+			break;
+		case CShaderBuilder::STATEMENT_OP_COMPARE_GT:
+			rb = (compareResult > 0);
+			break;
+		case CShaderBuilder::STATEMENT_OP_COMPARE_GE:
+			rb = (compareResult >= 0);
+			break;
+		default:
+			assert(false);
+			break;
+		}
+	}
+		return true;
+	case CShaderBuilder::STATEMENT_OP_MIN:
+	case CShaderBuilder::STATEMENT_OP_MAX:
+	{
+		if(srcType != result.type) return false;
+		bool isMin = (op == CShaderBuilder::STATEMENT_OP_MIN);
+		if(isFloat) rf = isMin ? std::min(f1, f2) : std::max(f1, f2);
+		else if(isInt) ri = isMin ? std::min(i1, i2) : std::max(i1, i2);
+		else if(isUint) ri = static_cast<int32>(isMin ? std::min(u1, u2) : std::max(u1, u2));
+		else return false;
+	}
+		return true;
+	case CShaderBuilder::STATEMENT_OP_CLAMP:
+		if(srcType != result.type) return false;
+		if(isFloat) rf = std::min(std::max(f1, f2), f3);
+		else if(isInt) ri = std::min(std::max(i1, i2), i3);
+		else return false;
+		return true;
+	case CShaderBuilder::STATEMENT_OP_SATURATE:
+		if(!isFloat || (srcType != result.type)) return false;
+		rf = std::min(std::max(f1, 0.f), 1.f);
+		return true;
+	case CShaderBuilder::STATEMENT_OP_NEGATE:
+		if(!isFloat || (srcType != result.type)) return false;
+		rf = -f1;
+		return true;
+	case CShaderBuilder::STATEMENT_OP_ABS:
+		if(!isFloat || (srcType != result.type)) return false;
+		rf = std::fabs(f1);
+		return true;
+	case CShaderBuilder::STATEMENT_OP_FRACT:
+		if(!isFloat || (srcType != result.type)) return false;
+		rf = f1 - std::floor(f1);
+		return true;
+	case CShaderBuilder::STATEMENT_OP_TRUNC:
+		if(!isFloat || (srcType != result.type)) return false;
+		rf = std::trunc(f1);
+		return true;
+	case CShaderBuilder::STATEMENT_OP_MIX:
+		if((srcType != result.type) || (src2.type != result.type)) return false;
+		if(src3.type == CShaderBuilder::SYMBOL_TYPE_BOOL4)
+		{
+			rf = b3 ? f2 : f1;
+			ri = b3 ? i2 : i1;
+			rb = b3 ? b2 : b1;
+		}
+		else if(isFloat && (src3.type == CShaderBuilder::SYMBOL_TYPE_FLOAT4))
+		{
+			rf = f1 * (1.f - f3) + f2 * f3;
+		}
+		else
+		{
+			return false;
+		}
+		return true;
+	case CShaderBuilder::STATEMENT_OP_TOFLOAT:
+		if(result.type != CShaderBuilder::SYMBOL_TYPE_FLOAT4) return false;
+		if(isInt) rf = static_cast<float>(i1);
+		else if(isUint) rf = static_cast<float>(u1);
+		else return false;
+		return true;
+	case CShaderBuilder::STATEMENT_OP_TOINT:
+		if(result.type != CShaderBuilder::SYMBOL_TYPE_INT4) return false;
+		if(isFloat)
+		{
+			//Out of range conversions are undefined
+			if(!((f1 >= -2147483648.f) && (f1 < 2147483648.f))) return false;
+			ri = static_cast<int32>(f1);
+		}
+		else if(isUint)
+		{
+			ri = i1;
+		}
+		else
+		{
+			return false;
+		}
+		return true;
+	case CShaderBuilder::STATEMENT_OP_TOUINT:
+		if(result.type != CShaderBuilder::SYMBOL_TYPE_UINT4) return false;
+		if(isFloat)
+		{
+			if(!((f1 >= 0.f) && (f1 < 4294967296.f))) return false;
+			ri = static_cast<int32>(static_cast<uint32>(f1));
+		}
+		else if(isInt)
+		{
+			ri = i1;
+		}
+		else
+		{
+			return false;
+		}
+		return true;
+	default:
+		return false;
+	}
+}
+
+static bool EvaluateStatement(const CShaderBuilder::STATEMENT& statement, const VALUE* srcs, unsigned int srcCount, VALUE& result)
+{
+	result.type = statement.dstRef.symbol.type;
+	result.count = GetSwizzleElementCount(statement.dstRef.swizzle);
+
+	if(srcCount == 0) return false;
+
+	if(
+	    (statement.op == CShaderBuilder::STATEMENT_OP_NEWVECTOR2) ||
+	    (statement.op == CShaderBuilder::STATEMENT_OP_NEWVECTOR4))
+	{
+		unsigned int elementIndex = 0;
+		for(unsigned int srcIndex = 0; srcIndex < srcCount; srcIndex++)
+		{
+			const auto& src = srcs[srcIndex];
+			if(src.type != result.type) return false;
+			for(unsigned int i = 0; i < src.count; i++)
+			{
+				if(elementIndex == result.count) return false;
+				result.f[elementIndex] = src.f[i];
+				result.i[elementIndex] = src.i[i];
+				result.b[elementIndex] = src.b[i];
+				elementIndex++;
+			}
+		}
+		return (elementIndex == result.count);
+	}
+
+	for(unsigned int srcIndex = 0; srcIndex < srcCount; srcIndex++)
+	{
+		if(srcs[srcIndex].count != result.count) return false;
+	}
+
+	for(unsigned int i = 0; i < result.count; i++)
+	{
+		if(!EvaluateElement(statement.op, srcs, srcCount, i, result)) return false;
+		if((result.type == CShaderBuilder::SYMBOL_TYPE_FLOAT4) && !std::isfinite(result.f[i]))
+		{
+			//Leave non finite results to the GPU
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static CShaderBuilder::SYMBOL CreateConstant(CShaderBuilder& shaderBuilder, const VALUE& value)
+{
+	switch(value.type)
+	{
+	case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
+		return shaderBuilder.CreateConstant(value.f[0], value.f[1], value.f[2], value.f[3]);
+	case CShaderBuilder::SYMBOL_TYPE_INT4:
+		return shaderBuilder.CreateConstantInt(value.i[0], value.i[1], value.i[2], value.i[3]);
+	case CShaderBuilder::SYMBOL_TYPE_UINT4:
+		return shaderBuilder.CreateConstantUint(value.i[0], value.i[1], value.i[2], value.i[3]);
+	case CShaderBuilder::SYMBOL_TYPE_BOOL4:
+		return shaderBuilder.CreateConstantBool(value.b[0], value.b[1], value.b[2], value.b[3]);
+	default:
+		assert(false);
+		return CShaderBuilder::SYMBOL();
+	}
+}
+
+static bool FoldStatements(CShaderBuilder& shaderBuilder)
+{
+	auto& statementList = shaderBuilder.GetStatements();
+	auto statements = PassUtils::StatementArray(std::begin(statementList), std::end(statementList));
+	auto regionEnds = PassUtils::MatchRegions(statements);
+	auto writeCounts = CountWrites(statements);
+
+	ReadIndexMap firstReads;
+	ReadIndexMap lastReads;
+	for(size_t i = 0; i < statements.size(); i++)
+	{
+		PassUtils::ForEachSourceRef(statements[i],
+		                            [&](const CShaderBuilder::SYMBOLREF& srcRef) {
+			                            auto key = PassUtils::MakeSymbolKey(srcRef.symbol);
+			                            firstReads.insert(std::make_pair(key, i));
+			                            lastReads[key] = i;
+		                            });
+	}
+
+	bool changed = false;
+	SubstitutionMap substitutions;
+	std::vector<size_t> enclosingRegionEnds;
+	PassUtils::StatementArray result;
+	result.reserve(statements.size());
+
+	for(size_t i = 0; i < statements.size(); i++)
+	{
+		auto statement = statements[i];
+
+		PassUtils::ForEachSourceRef(statement,
+		                            [&](CShaderBuilder::SYMBOLREF& srcRef) {
+			                            auto substitutionIterator = substitutions.find(PassUtils::MakeSymbolKey(srcRef.symbol));
+			                            if(substitutionIterator == std::end(substitutions)) return;
+			                            srcRef.symbol = substitutionIterator->second;
+		                            });
+
+		if(PassUtils::IsBlockEnd(statement.op))
+		{
+			assert(!enclosingRegionEnds.empty());
+			enclosingRegionEnds.pop_back();
+		}
+		if(PassUtils::IsBlockSeparator(statement.op))
+		{
+			assert(!enclosingRegionEnds.empty());
+			enclosingRegionEnds.back() = regionEnds[i];
+		}
+		if(PassUtils::IsBlockBegin(statement.op))
+		{
+			enclosingRegionEnds.push_back(regionEnds[i]);
+		}
+
+		const auto& dstSymbol = statement.dstRef.symbol;
+		if(
+		    !PassUtils::HasSideEffects(statement.op) &&
+		    (dstSymbol.location == CShaderBuilder::SYMBOL_LOCATION_TEMPORARY) &&
+		    (statement.GetSourceCount() != 0))
+		{
+			auto dstKey = PassUtils::MakeSymbolKey(dstSymbol);
+
+			//The value must not be observed before this statement or outside of the current block region
+			size_t regionEnd = enclosingRegionEnds.empty() ? statements.size() : enclosingRegionEnds.back();
+			auto firstReadIterator = firstReads.find(dstKey);
+			auto lastReadIterator = lastReads.find(dstKey);
+			bool canFold =
+			    (writeCounts[dstKey] == 1) &&
+			    ((firstReadIterator == std::end(firstReads)) || (firstReadIterator->second > i)) &&
+			    ((lastReadIterator == std::end(lastReads)) || (lastReadIterator->second < regionEnd));
+
+			VALUE srcs[4];
+			unsigned int srcCount = 0;
+			PassUtils::ForEachSourceRef(statement,
+			                            [&](const CShaderBuilder::SYMBOLREF& srcRef) {
+				                            if(!IsConstant(srcRef.symbol, writeCounts))
+				                            {
+					                            canFold = false;
+					                            return;
+				                            }
+				                            srcs[srcCount++] = SwizzleValue(GetConstantValue(shaderBuilder, srcRef.symbol), srcRef.swizzle);
+			                            });
+
+			VALUE value;
+			if(canFold && IsMaskSwizzle(statement.dstRef.swizzle) && EvaluateStatement(statement, srcs, srcCount, value))
+			{
+				//Lanes that aren't written keep the initial value of the temporary
+				auto dstValue = GetConstantValue(shaderBuilder, dstSymbol);
+				for(unsigned int elem = 0; elem < value.count; elem++)
+				{
+					auto dstElement = GetSwizzleElement(statement.dstRef.swizzle, elem);
+					dstValue.f[dstElement] = value.f[elem];
+					dstValue.i[dstElement] = value.i[elem];
+					dstValue.b[dstElement] = value.b[elem];
+				}
+				substitutions[dstKey] = CreateConstant(shaderBuilder, dstValue);
+				changed = true;
+				continue;
+			}
+		}
+
+		result.push_back(statement);
+	}
+
+	statementList = CShaderBuilder::StatementList(std::begin(result), std::end(result));
+	return changed;
+}
+
+//Returns the index of the separator starting the region selected by a constant switch selector (INVALID_INDEX if none)
+static size_t FindSelectedCase(const PassUtils::StatementArray& statements, const std::vector<size_t>& regionEnds, size_t beginIndex, int32 selector)
+{
+	size_t defaultIndex = PassUtils::INVALID_INDEX;
+	for(size_t i = regionEnds[beginIndex]; statements[i].op != CShaderBuilder::STATEMENT_OP_SWITCH_END; i = regionEnds[i])
+	{
+		//Consecutive cases share the body of the last one
+		size_t bodyIndex = i;
+		while(PassUtils::IsBlockSeparator(statements[regionEnds[bodyIndex]].op) && (regionEnds[bodyIndex] == bodyIndex + 1))
+		{
+			bodyIndex = regionEnds[bodyIndex];
+		}
+		const auto& statement = statements[i];
+		if((statement.op == CShaderBuilder::STATEMENT_OP_SWITCH_CASE) && (static_cast<int32>(statement.param) == selector))
+		{
+			return bodyIndex;
+		}
+		if(statement.op == CShaderBuilder::STATEMENT_OP_SWITCH_DEFAULT)
+		{
+			defaultIndex = bodyIndex;
+		}
+	}
+	return defaultIndex;
+}
+
+static bool FoldBranches(CShaderBuilder& shaderBuilder)
+{
+	auto& statementList = shaderBuilder.GetStatements();
+	auto statements = PassUtils::StatementArray(std::begin(statementList), std::end(statementList));
+	auto blockEnds = PassUtils::MatchBlocks(statements);
+	auto regionEnds = PassUtils::MatchRegions(statements);
+	auto writeCounts = CountWrites(statements);
+
+	bool changed = false;
+	std::vector<bool> removed(statements.size(), false);
+	for(size_t i = 0; i < statements.size(); i++)
+	{
+		if(removed[i]) continue;
+		const auto& statement = statements[i];
+		if(
+		    (statement.op != CShaderBuilder::STATEMENT_OP_IF_BEGIN) &&
+		    (statement.op != CShaderBuilder::STATEMENT_OP_SWITCH_BEGIN))
+		{
+			continue;
+		}
+		const auto& conditionRef = statement.src1Ref;
+		if(!IsConstant(conditionRef.symbol, writeCounts)) continue;
+
+		auto conditionValue = GetConstantValue(shaderBuilder, conditionRef.symbol);
+		size_t endIndex = blockEnds[i];
+		assert(endIndex != PassUtils::INVALID_INDEX);
+
+		//Only keep the statements between keptBegin and keptEnd (exclusive)
+		size_t keptBegin = endIndex;
+		size_t keptEnd = endIndex;
+		if(statement.op == CShaderBuilder::STATEMENT_OP_IF_BEGIN)
+		{
+			bool condition = conditionValue.b[GetSwizzleElement(conditionRef.swizzle, 0)];
+			size_t elseIndex = regionEnds[i];
+			if(condition)
+			{
+				keptBegin = i + 1;
+				keptEnd = elseIndex;
+			}
+			else if(elseIndex != endIndex)
+			{
+				keptBegin = elseIndex + 1;
+				keptEnd = endIndex;
+			}
+		}
+		else
+		{
+			int32 selector = conditionValue.i[GetSwizzleElement(conditionRef.swizzle, 0)];
+			size_t caseIndex = FindSelectedCase(statements, regionEnds, i, selector);
+			if(caseIndex != PassUtils::INVALID_INDEX)
+			{
+				keptBegin = caseIndex + 1;
+				keptEnd = regionEnds[caseIndex];
+			}
+		}
+		std::fill(removed.begin() + i, removed.begin() + keptBegin, true);
+		std::fill(removed.begin() + keptEnd, removed.begin() + endIndex + 1, true);
+		changed = true;
+	}
+
+	if(!changed) return false;
+
+	CShaderBuilder::StatementList result;
+	unsigned int depth = 0;
+	for(size_t i = 0; i < statements.size(); i++)
+	{
+		if(removed[i]) continue;
+		const auto& statement = statements[i];
+		if(PassUtils::IsBlockBegin(statement.op)) depth++;
+		if(PassUtils::IsBlockEnd(statement.op)) depth--;
+		if((statement.op == CShaderBuilder::STATEMENT_OP_RETURN) && (depth == 0))
+		{
+			//Return became unconditional, anything after it is unreachable
+			break;
+		}
+		result.push_back(statement);
+	}
+	statementList = std::move(result);
+	return true;
+}
+
+void CConstantFoldingPass::Run(CShaderBuilder& shaderBuilder)
+{
+	while(true)
+	{
+		bool changed = false;
+		changed |= FoldStatements(shaderBuilder);
+		changed |= FoldBranches(shaderBuilder);
+		if(!changed) break;
+	}
+}
@@ -0,0 +1,87 @@
+#include <unordered_set>
+#include "nuanceur/passes/DeadCodeEliminationPass.h"
+#include "nuanceur/passes/PassUtils.h"
+
+using namespace Nuanceur;
+
+static bool RemoveUnusedStatements(CShaderBuilder::StatementList& statements)
+{
+	std::unordered_set<PassUtils::SymbolKey> readSymbols;
+	for(const auto& statement : statements)
+	{
+		PassUtils::ForEachSourceRef(statement,
+		                            [&](const CShaderBuilder::SYMBOLREF& srcRef) {
+			                            readSymbols.insert(PassUtils::MakeSymbolKey(srcRef.symbol));
+		                            });
+	}
+
+	bool changed = false;
+	for(auto statementIterator = statements.begin(); statementIterator != statements.end();)
+	{
+		const auto& statement = *statementIterator;
+		const auto& dstSymbol = statement.dstRef.symbol;
+		bool isDead =
+		    !PassUtils::HasSideEffects(statement.op) &&
+		    ((dstSymbol.location == CShaderBuilder::SYMBOL_LOCATION_TEMPORARY) || (dstSymbol.location == CShaderBuilder::SYMBOL_LOCATION_VARIABLE)) &&
+		    (readSymbols.find(PassUtils::MakeSymbolKey(dstSymbol)) == std::end(readSymbols));
+		if(isDead)
+		{
+			statementIterator = statements.erase(statementIterator);
+			changed = true;
+		}
+		else
+		{
+			statementIterator++;
+		}
+	}
+	return changed;
+}
+
+static bool RemoveEmptyBlocks(CShaderBuilder::StatementList& statements)
+{
+	bool changed = false;
+	for(auto statementIterator = statements.begin(); statementIterator != statements.end();)
+	{
+		//Skip case labels without a body, the block is empty if we land on its end
+		auto nextIterator = std::next(statementIterator);
+		while((nextIterator != statements.end()) && PassUtils::IsBlockSeparator(nextIterator->op))
+		{
+			nextIterator++;
+		}
+		if(nextIterator == statements.end())
+		{
+			break;
+		}
+		if(
+		    ((statementIterator->op == CShaderBuilder::STATEMENT_OP_IF_BEGIN) && (nextIterator->op == CShaderBuilder::STATEMENT_OP_IF_END)) ||
+		    ((statementIterator->op == CShaderBuilder::STATEMENT_OP_SWITCH_BEGIN) && (nextIterator->op == CShaderBuilder::STATEMENT_OP_SWITCH_END)))
+		{
+			statementIterator = statements.erase(statementIterator, std::next(nextIterator));
+			changed = true;
+		}
+		else if(
+		    (statementIterator->op == CShaderBuilder::STATEMENT_OP_ELSE) &&
+		    (std::next(statementIterator)->op == CShaderBuilder::STATEMENT_OP_IF_END))
+		{
+			statementIterator = statements.erase(statementIterator);
+			changed = true;
+		}
+		else
+		{
+			statementIterator++;
+		}
+	}
+	return changed;
+}
+
+void CDeadCodeEliminationPass::Run(CShaderBuilder& shaderBuilder)
+{
+	auto& statements = shaderBuilder.GetStatements();
+	while(true)
+	{
+		bool changed = false;
+		changed |= RemoveUnusedStatements(statements);
+		changed |= RemoveEmptyBlocks(statements);
+		if(!changed) break;
+	}
+}
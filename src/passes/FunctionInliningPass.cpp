@@ -0,0 +1,268 @@
+#include <unordered_map>
+#include <unordered_set>
+#include "nuanceur/passes/FunctionInliningPass.h"
+#include "nuanceur/passes/PassUtils.h"
+
+using namespace Nuanceur;
+
+static bool CanInline(const CShaderBuilder::FUNCTION& function, uint32 functionIndex)
+{
+	const auto& statements = function.statements;
+	for(auto statementIterator = std::begin(statements); statementIterator != std::end(statements); statementIterator++)
+	{
+		const auto& statement = *statementIterator;
+		switch(statement.op)
+		{
+		case CShaderBuilder::STATEMENT_OP_RETURN:
+			//Only a return ending the function can become a plain assignment
+			if(std::next(statementIterator) != std::end(statements)) return false;
+			break;
+		case CShaderBuilder::STATEMENT_OP_CALL:
+			if(statement.param == functionIndex) return false;
+			break;
+		default:
+			break;
+		}
+		//Written temporaries are copied and reset to their initial value at every call site
+		if(statement.dstRef.symbol.location == CShaderBuilder::SYMBOL_LOCATION_TEMPORARY)
+		{
+			switch(statement.dstRef.symbol.type)
+			{
+			case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
+			case CShaderBuilder::SYMBOL_TYPE_HALF4:
+			case CShaderBuilder::SYMBOL_TYPE_INT4:
+			case CShaderBuilder::SYMBOL_TYPE_UINT4:
+			case CShaderBuilder::SYMBOL_TYPE_BOOL4:
+				break;
+			default:
+				return false;
+			}
+		}
+	}
+	if(function.returnType != CShaderBuilder::SYMBOL_TYPE_NULL)
+	{
+		if(statements.empty() || (statements.back().op != CShaderBuilder::STATEMENT_OP_RETURN)) return false;
+	}
+	return true;
+}
+
+static CShaderBuilder::SYMBOL CloneTemporary(CShaderBuilder& shaderBuilder, const CShaderBuilder::SYMBOL& symbol)
+{
+	switch(symbol.type)
+	{
+	default:
+		assert(false);
+		[[fallthrough]];
+	case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
+	{
+		auto value = shaderBuilder.GetTemporaryValue(symbol);
+		return shaderBuilder.CreateConstant(value.x, value.y, value.z, value.w);
+	}
+	case CShaderBuilder::SYMBOL_TYPE_HALF4:
+	{
+		auto value = shaderBuilder.GetTemporaryValue(symbol);
+		return shaderBuilder.CreateConstantHalf(value.x, value.y, value.z, value.w);
+	}
+	case CShaderBuilder::SYMBOL_TYPE_INT4:
+	{
+		auto value = shaderBuilder.GetTemporaryValueInt(symbol);
+		return shaderBuilder.CreateConstantInt(value.x, value.y, value.z, value.w);
+	}
+	case CShaderBuilder::SYMBOL_TYPE_UINT4:
+	{
+		auto value = shaderBuilder.GetTemporaryValueInt(symbol);
+		return shaderBuilder.CreateConstantUint(value.x, value.y, value.z, value.w);
+	}
+	case CShaderBuilder::SYMBOL_TYPE_BOOL4:
+	{
+		auto value = shaderBuilder.GetTemporaryValueBool(symbol);
+		return shaderBuilder.CreateConstantBool(value.x, value.y, value.z, value.w);
+	}
+	}
+}
+
+static CShaderBuilder::StatementList InlineCall(CShaderBuilder& shaderBuilder, const CShaderBuilder::STATEMENT& callStatement)
+{
+	const auto& function = shaderBuilder.GetFunctions()[callStatement.param];
+	std::unordered_map<PassUtils::SymbolKey, CShaderBuilder::SYMBOL> renamedSymbols;
+	CShaderBuilder::StatementList result;
+
+	//Parameters that are only read are replaced by the arguments
+	const CShaderBuilder::SYMBOLREF* argRefs[] = {&callStatement.src1Ref, &callStatement.src2Ref, &callStatement.src3Ref, &callStatement.src4Ref};
+	std::unordered_set<PassUtils::SymbolKey> parameterKeys;
+	assert(function.parameters.size() <= 4);
+	for(uint32 paramIndex = 0; paramIndex < function.parameters.size(); paramIndex++)
+	{
+		auto parameterKey = PassUtils::MakeSymbolKey(function.parameters[paramIndex]);
+		renamedSymbols[parameterKey] = argRefs[paramIndex]->symbol;
+		parameterKeys.insert(parameterKey);
+	}
+
+	std::unordered_set<PassUtils::SymbolKey> clonedKeys;
+	for(const auto& statement : function.statements)
+	{
+		const auto& dstSymbol = statement.dstRef.symbol;
+		if(dstSymbol.location != CShaderBuilder::SYMBOL_LOCATION_TEMPORARY) continue;
+		auto dstKey = PassUtils::MakeSymbolKey(dstSymbol);
+		if(!clonedKeys.insert(dstKey).second) continue;
+		auto clone = CloneTemporary(shaderBuilder, dstSymbol);
+		if(parameterKeys.count(dstKey))
+		{
+			//Written parameter needs its own copy of the argument
+			result.push_back(CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_ASSIGN,
+			                                           CShaderBuilder::SYMBOLREF(clone, SWIZZLE_XYZW),
+			                                           CShaderBuilder::SYMBOLREF(renamedSymbols[dstKey], SWIZZLE_XYZW)));
+		}
+		else
+		{
+			//Clone keeps its value when the call site is executed more than once (ie.: in a loop)
+			auto initialValue = CloneTemporary(shaderBuilder, dstSymbol);
+			result.push_back(CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_ASSIGN,
+			                                           CShaderBuilder::SYMBOLREF(clone, SWIZZLE_XYZW),
+			                                           CShaderBuilder::SYMBOLREF(initialValue, SWIZZLE_XYZW)));
+		}
+		renamedSymbols[dstKey] = clone;
+	}
+
+	auto renameRef =
+	    [&](CShaderBuilder::SYMBOLREF& ref) {
+		    auto renamedSymbolIterator = renamedSymbols.find(PassUtils::MakeSymbolKey(ref.symbol));
+		    if(renamedSymbolIterator == std::end(renamedSymbols)) return;
+		    ref.symbol = renamedSymbolIterator->second;
+	    };
+
+	for(auto statement : function.statements)
+	{
+		if(statement.dstRef.symbol.location != CShaderBuilder::SYMBOL_LOCATION_NULL)
+		{
+			renameRef(statement.dstRef);
+		}
+		PassUtils::ForEachSourceRef(statement, renameRef);
+		if(statement.op == CShaderBuilder::STATEMENT_OP_RETURN)
+		{
+			//Last statement, returned value goes to the call's result
+			if(callStatement.dstRef.symbol.location == CShaderBuilder::SYMBOL_LOCATION_NULL) continue;
+			assert(statement.src1Ref.symbol.location != CShaderBuilder::SYMBOL_LOCATION_NULL);
+			result.push_back(CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_ASSIGN, callStatement.dstRef, statement.src1Ref));
+			continue;
+		}
+		result.push_back(statement);
+	}
+
+	return result;
+}
+
+static std::vector<uint32> CountCallSites(const CShaderBuilder& shaderBuilder)
+{
+	const auto& functions = shaderBuilder.GetFunctions();
+	std::vector<uint32> callSiteCounts(functions.size(), 0);
+	auto countCalls =
+	    [&](const CShaderBuilder::StatementList& statements) {
+		    for(const auto& statement : statements)
+		    {
+			    if(statement.op != CShaderBuilder::STATEMENT_OP_CALL) continue;
+			    assert(statement.param < callSiteCounts.size());
+			    callSiteCounts[statement.param]++;
+		    }
+	    };
+	countCalls(shaderBuilder.GetStatements());
+	for(const auto& function : functions)
+	{
+		countCalls(function.statements);
+	}
+	return callSiteCounts;
+}
+
+static bool InlineFunctions(CShaderBuilder& shaderBuilder, unsigned int maxInlinedStatements)
+{
+	auto callSiteCounts = CountCallSites(shaderBuilder);
+
+	auto inlineFirstCall =
+	    [&](CShaderBuilder::StatementList& statements, uint32 callerIndex) {
+		    for(auto statementIterator = std::begin(statements); statementIterator != std::end(statements); statementIterator++)
+		    {
+			    const auto& statement = *statementIterator;
+			    if(statement.op != CShaderBuilder::STATEMENT_OP_CALL) continue;
+			    if(statement.param == callerIndex) continue;
+			    const auto& function = shaderBuilder.GetFunctions()[statement.param];
+			    if(
+			        (callSiteCounts[statement.param] != 1) &&
+			        (function.statements.size() > maxInlinedStatements))
+			    {
+				    continue;
+			    }
+			    if(!CanInline(function, statement.param)) continue;
+			    auto inlinedStatements = InlineCall(shaderBuilder, statement);
+			    statements.splice(statementIterator, inlinedStatements);
+			    statements.erase(statementIterator);
+			    return true;
+		    }
+		    return false;
+	    };
+
+	if(inlineFirstCall(shaderBuilder.GetStatements(), CShaderBuilder::INVALID_FUNCTION)) return true;
+	for(uint32 functionIndex = 0; functionIndex < shaderBuilder.GetFunctions().size(); functionIndex++)
+	{
+		if(inlineFirstCall(shaderBuilder.GetFunctions()[functionIndex].statements, functionIndex)) return true;
+	}
+	return false;
+}
+
+static void RemoveUnusedFunctions(CShaderBuilder& shaderBuilder)
+{
+	auto& functions = shaderBuilder.GetFunctions();
+
+	//Find functions reachable from main
+	std::vector<bool> used(functions.size(), false);
+	std::vector<uint32> pendingFunctions;
+	auto markCalls =
+	    [&](const CShaderBuilder::StatementList& statements) {
+		    for(const auto& statement : statements)
+		    {
+			    if(statement.op != CShaderBuilder::STATEMENT_OP_CALL) continue;
+			    if(used[statement.param]) continue;
+			    used[statement.param] = true;
+			    pendingFunctions.push_back(statement.param);
+		    }
+	    };
+	markCalls(shaderBuilder.GetStatements());
+	while(!pendingFunctions.empty())
+	{
+		auto functionIndex = pendingFunctions.back();
+		pendingFunctions.pop_back();
+		markCalls(functions[functionIndex].statements);
+	}
+
+	std::vector<uint32> newIndices(functions.size(), CShaderBuilder::INVALID_FUNCTION);
+	CShaderBuilder::FunctionArray usedFunctions;
+	for(uint32 functionIndex = 0; functionIndex < functions.size(); functionIndex++)
+	{
+		if(!used[functionIndex]) continue;
+		newIndices[functionIndex] = static_cast<uint32>(usedFunctions.size());
+		usedFunctions.push_back(std::move(functions[functionIndex]));
+	}
+	functions = std::move(usedFunctions);
+
+	auto remapCalls =
+	    [&](CShaderBuilder::StatementList& statements) {
+		    for(auto& statement : statements)
+		    {
+			    if(statement.op != CShaderBuilder::STATEMENT_OP_CALL) continue;
+			    statement.param = newIndices[statement.param];
+			    assert(statement.param != CShaderBuilder::INVALID_FUNCTION);
+		    }
+	    };
+	remapCalls(shaderBuilder.GetStatements());
+	for(auto& function : functions)
+	{
+		remapCalls(function.statements);
+	}
+}
+
+void CFunctionInliningPass::Run(CShaderBuilder& shaderBuilder, unsigned int maxInlinedStatements)
+{
+	while(InlineFunctions(shaderBuilder, maxInlinedStatements))
+	{
+	}
+	RemoveUnusedFunctions(shaderBuilder);
+}
@@ -0,0 +1,243 @@
+#include <unordered_set>
+#include <unordered_map>
+#include "nuanceur/passes/IfConversionPass.h"
+#include "nuanceur/passes/PassUtils.h"
+
+using namespace Nuanceur;
+
+static bool CanSpeculate(CShaderBuilder::STATEMENT_OP op)
+{
+	if(PassUtils::HasSideEffects(op)) return false;
+	switch(op)
+	{
+	case CShaderBuilder::STATEMENT_OP_NOP:
+	//Memory accesses might depend on the condition to be valid
+	case CShaderBuilder::STATEMENT_OP_LOAD:
+	case CShaderBuilder::STATEMENT_OP_SAMPLE:
+	case CShaderBuilder::STATEMENT_OP_SAMPLE_LOD:
+	case CShaderBuilder::STATEMENT_OP_SAMPLE_GRAD:
+	case CShaderBuilder::STATEMENT_OP_SAMPLE_OFFSET:
+	case CShaderBuilder::STATEMENT_OP_FETCH:
+	case CShaderBuilder::STATEMENT_OP_GATHER:
+	//Subgroup operations depend on which invocations are active
+	case CShaderBuilder::STATEMENT_OP_SUBGROUP_BALLOT:
+	case CShaderBuilder::STATEMENT_OP_SUBGROUP_BROADCAST:
+	case CShaderBuilder::STATEMENT_OP_SUBGROUP_SHUFFLE:
+	case CShaderBuilder::STATEMENT_OP_SUBGROUP_ADD:
+	case CShaderBuilder::STATEMENT_OP_SUBGROUP_MIN:
+	case CShaderBuilder::STATEMENT_OP_SUBGROUP_MAX:
+	case CShaderBuilder::STATEMENT_OP_SUBGROUP_AND:
+	case CShaderBuilder::STATEMENT_OP_SUBGROUP_OR:
+		return false;
+	default:
+		return true;
+	}
+}
+
+static bool CanSelect(const CShaderBuilder& shaderBuilder, const CShaderBuilder::SYMBOL& symbol)
+{
+	switch(symbol.type)
+	{
+	case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
+	case CShaderBuilder::SYMBOL_TYPE_INT4:
+	case CShaderBuilder::SYMBOL_TYPE_UINT4:
+	case CShaderBuilder::SYMBOL_TYPE_BOOL4:
+		break;
+	default:
+		return false;
+	}
+	switch(symbol.location)
+	{
+	case CShaderBuilder::SYMBOL_LOCATION_TEMPORARY:
+	case CShaderBuilder::SYMBOL_LOCATION_VARIABLE:
+		return true;
+	case CShaderBuilder::SYMBOL_LOCATION_OUTPUT:
+		//Outputs are read back to be selected
+		return (symbol.type == CShaderBuilder::SYMBOL_TYPE_FLOAT4) &&
+		       (shaderBuilder.GetOutputSemantic(symbol).type != SEMANTIC_SYSTEM_POINTSIZE);
+	default:
+		return false;
+	}
+}
+
+static SWIZZLE_TYPE MakeBroadcastSwizzle(uint32 element, uint32 count)
+{
+	switch(count)
+	{
+	default:
+		assert(false);
+		[[fallthrough]];
+	case 1:
+		return static_cast<SWIZZLE_TYPE>(MakeSwizzle1(element));
+	case 2:
+		return static_cast<SWIZZLE_TYPE>(MakeSwizzle2(element, element));
+	case 3:
+		return static_cast<SWIZZLE_TYPE>(MakeSwizzle3(element, element, element));
+	case 4:
+		return static_cast<SWIZZLE_TYPE>(MakeSwizzle4(element, element, element, element));
+	}
+}
+
+static CShaderBuilder::SYMBOL CreateTemporary(CShaderBuilder& shaderBuilder, CShaderBuilder::SYMBOL_TYPE type)
+{
+	switch(type)
+	{
+	default:
+		assert(false);
+		[[fallthrough]];
+	case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
+		return shaderBuilder.CreateTemporary();
+	case CShaderBuilder::SYMBOL_TYPE_INT4:
+		return shaderBuilder.CreateTemporaryInt();
+	case CShaderBuilder::SYMBOL_TYPE_UINT4:
+		return shaderBuilder.CreateTemporaryUint();
+	case CShaderBuilder::SYMBOL_TYPE_BOOL4:
+		return shaderBuilder.CreateTemporaryBool();
+	}
+}
+
+//Tries to convert the block delimited by beginIndex and endIndex, converted statements are written in result
+static bool ConvertBlock(CShaderBuilder& shaderBuilder, const PassUtils::StatementArray& statements, size_t beginIndex, size_t endIndex,
+                         unsigned int costThreshold, PassUtils::StatementArray& result)
+{
+	const auto& conditionRef = statements[beginIndex].src1Ref;
+	auto conditionKey = PassUtils::MakeSymbolKey(conditionRef.symbol);
+	auto conditionElement = GetSwizzleElement(conditionRef.swizzle, 0);
+
+	size_t elseIndex = endIndex;
+	for(size_t i = beginIndex + 1; i < endIndex; i++)
+	{
+		if(statements[i].op == CShaderBuilder::STATEMENT_OP_ELSE)
+		{
+			elseIndex = i;
+			break;
+		}
+	}
+
+	//Collect symbols referenced outside of the block and in each side of the block
+	std::unordered_set<PassUtils::SymbolKey> outsideSymbols;
+	std::unordered_set<PassUtils::SymbolKey> regionSymbols[2];
+	for(size_t i = 0; i < statements.size(); i++)
+	{
+		if((i == beginIndex) || (i == elseIndex) || (i == endIndex)) continue;
+		auto& symbols = ((i < beginIndex) || (i > endIndex)) ? outsideSymbols : regionSymbols[(i > elseIndex) ? 1 : 0];
+		const auto& statement = statements[i];
+		symbols.insert(PassUtils::MakeSymbolKey(statement.dstRef.symbol));
+		PassUtils::ForEachSourceRef(statement,
+		                            [&](const CShaderBuilder::SYMBOLREF& srcRef) {
+			                            symbols.insert(PassUtils::MakeSymbolKey(srcRef.symbol));
+		                            });
+	}
+
+	//Temporaries only living inside one side of the block can be written unconditionally
+	std::vector<bool> speculated(statements.size(), false);
+	std::unordered_map<PassUtils::SymbolKey, bool> firstReferenceIsWrite;
+	unsigned int cost = 0;
+	for(size_t i = beginIndex + 1; i < endIndex; i++)
+	{
+		if(i == elseIndex)
+		{
+			firstReferenceIsWrite.clear();
+			continue;
+		}
+		const auto& statement = statements[i];
+		if(!CanSpeculate(statement.op)) return false;
+		PassUtils::ForEachSourceRef(statement,
+		                            [&](const CShaderBuilder::SYMBOLREF& srcRef) {
+			                            firstReferenceIsWrite.insert(std::make_pair(PassUtils::MakeSymbolKey(srcRef.symbol), false));
+		                            });
+		const auto& dstSymbol = statement.dstRef.symbol;
+		auto dstKey = PassUtils::MakeSymbolKey(dstSymbol);
+		if(dstKey == conditionKey) return false;
+		firstReferenceIsWrite.insert(std::make_pair(dstKey, true));
+		const auto& otherRegionSymbols = regionSymbols[(i > elseIndex) ? 0 : 1];
+		speculated[i] =
+		    (dstSymbol.location == CShaderBuilder::SYMBOL_LOCATION_TEMPORARY) &&
+		    (outsideSymbols.find(dstKey) == std::end(outsideSymbols)) &&
+		    (otherRegionSymbols.find(dstKey) == std::end(otherRegionSymbols)) &&
+		    firstReferenceIsWrite[dstKey];
+		if(speculated[i] || (statement.op == CShaderBuilder::STATEMENT_OP_ASSIGN))
+		{
+			cost += 1;
+		}
+		else
+		{
+			cost += 2;
+		}
+		if(!speculated[i] && !CanSelect(shaderBuilder, dstSymbol)) return false;
+	}
+	if(cost > costThreshold) return false;
+
+	for(size_t i = beginIndex + 1; i < endIndex; i++)
+	{
+		if(i == elseIndex) continue;
+		auto statement = statements[i];
+		if(speculated[i])
+		{
+			result.push_back(statement);
+			continue;
+		}
+
+		//dst = cond ? value : dst (or dst = cond ? dst : value for the else side)
+		auto dstRef = statement.dstRef;
+		CShaderBuilder::SYMBOLREF valueRef;
+		if(statement.op == CShaderBuilder::STATEMENT_OP_ASSIGN)
+		{
+			valueRef = statement.src1Ref;
+		}
+		else
+		{
+			statement.dstRef.symbol = CreateTemporary(shaderBuilder, dstRef.symbol.type);
+			result.push_back(statement);
+			valueRef = statement.dstRef;
+		}
+		auto selectorRef = CShaderBuilder::SYMBOLREF(conditionRef.symbol,
+		                                             MakeBroadcastSwizzle(conditionElement, GetSwizzleElementCount(dstRef.swizzle)));
+		if(i < elseIndex)
+		{
+			result.push_back(CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_MIX, dstRef, dstRef, valueRef, selectorRef));
+		}
+		else
+		{
+			result.push_back(CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_MIX, dstRef, valueRef, dstRef, selectorRef));
+		}
+	}
+
+	return true;
+}
+
+static bool ConvertBlocks(CShaderBuilder& shaderBuilder, unsigned int costThreshold)
+{
+	auto& statementList = shaderBuilder.GetStatements();
+	auto statements = PassUtils::StatementArray(std::begin(statementList), std::end(statementList));
+	auto blockEnds = PassUtils::MatchBlocks(statements);
+
+	for(size_t i = 0; i < statements.size(); i++)
+	{
+		if(statements[i].op != CShaderBuilder::STATEMENT_OP_IF_BEGIN) continue;
+		if(statements[i].param == SELECTION_CONTROL_DONT_FLATTEN) continue;
+		size_t endIndex = blockEnds[i];
+		assert(endIndex != PassUtils::INVALID_INDEX);
+
+		PassUtils::StatementArray converted;
+		if(!ConvertBlock(shaderBuilder, statements, i, endIndex, costThreshold, converted)) continue;
+
+		PassUtils::StatementArray result;
+		result.reserve(statements.size() + converted.size());
+		result.insert(std::end(result), std::begin(statements), std::begin(statements) + i);
+		result.insert(std::end(result), std::begin(converted), std::end(converted));
+		result.insert(std::end(result), std::begin(statements) + endIndex + 1, std::end(statements));
+		statementList = CShaderBuilder::StatementList(std::begin(result), std::end(result));
+		return true;
+	}
+
+	return false;
+}
+
+void CIfConversionPass::Run(CShaderBuilder& shaderBuilder, unsigned int costThreshold)
+{
+	//Inner blocks are converted first, which can make their parent convertible
+	while(ConvertBlocks(shaderBuilder, costThreshold))
+	{
+	}
+}
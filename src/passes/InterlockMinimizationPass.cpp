@@ -0,0 +1,166 @@
+#include <unordered_set>
+#include "nuanceur/passes/InterlockMinimizationPass.h"
+#include "nuanceur/passes/PassUtils.h"
+
+using namespace Nuanceur;
+
+typedef std::unordered_set<PassUtils::SymbolKey> SymbolKeySet;
+
+struct SYMBOL_ACCESS
+{
+	SymbolKeySet readKeys;
+	SymbolKeySet writtenKeys;
+};
+
+static bool CanMove(const CShaderBuilder::STATEMENT& statement)
+{
+	if(PassUtils::HasSideEffects(statement.op)) return false;
+	//Loads can read memory written by other invocations, they need to stay in the section
+	if(statement.op == CShaderBuilder::STATEMENT_OP_LOAD) return false;
+	return (statement.op != CShaderBuilder::STATEMENT_OP_NOP);
+}
+
+static void AddAccess(const CShaderBuilder::STATEMENT& statement, SYMBOL_ACCESS& access)
+{
+	if(statement.dstRef.symbol.location != CShaderBuilder::SYMBOL_LOCATION_NULL)
+	{
+		access.writtenKeys.insert(PassUtils::MakeSymbolKey(statement.dstRef.symbol));
+	}
+	PassUtils::ForEachSourceRef(statement,
+	                            [&](const CShaderBuilder::SYMBOLREF& srcRef) {
+		                            access.readKeys.insert(PassUtils::MakeSymbolKey(srcRef.symbol));
+	                            });
+}
+
+//Checks if a statement can be moved across statements accessing symbols as described by access
+static bool IsIndependent(const CShaderBuilder::STATEMENT& statement, const SYMBOL_ACCESS& access)
+{
+	auto dstKey = PassUtils::MakeSymbolKey(statement.dstRef.symbol);
+	if(access.readKeys.count(dstKey) || access.writtenKeys.count(dstKey)) return false;
+	bool independent = true;
+	PassUtils::ForEachSourceRef(statement,
+	                            [&](const CShaderBuilder::SYMBOLREF& srcRef) {
+		                            if(access.writtenKeys.count(PassUtils::MakeSymbolKey(srcRef.symbol))) independent = false;
+	                            });
+	return independent;
+}
+
+//Returns the index of the interlock end matching the begin at beginIndex, if both are in the same block
+static size_t FindSectionEnd(const PassUtils::StatementArray& statements, size_t beginIndex)
+{
+	int depth = 0;
+	for(size_t i = beginIndex + 1; i < statements.size(); i++)
+	{
+		auto op = statements[i].op;
+		if(PassUtils::IsBlockBegin(op))
+		{
+			depth++;
+		}
+		else if(PassUtils::IsBlockEnd(op) || (PassUtils::IsBlockSeparator(op) && (depth == 0)))
+		{
+			if(depth == 0) return PassUtils::INVALID_INDEX;
+			depth--;
+		}
+		else if(op == CShaderBuilder::STATEMENT_OP_INVOCATION_INTERLOCK_END)
+		{
+			return (depth == 0) ? i : PassUtils::INVALID_INDEX;
+		}
+	}
+	return PassUtils::INVALID_INDEX;
+}
+
+static bool MinimizeSections(PassUtils::StatementArray& statements)
+{
+	bool changed = false;
+	for(size_t beginIndex = 0; beginIndex < statements.size(); beginIndex++)
+	{
+		if(statements[beginIndex].op != CShaderBuilder::STATEMENT_OP_INVOCATION_INTERLOCK_BEGIN) continue;
+		size_t endIndex = FindSectionEnd(statements, beginIndex);
+		if(endIndex == PassUtils::INVALID_INDEX) continue;
+
+		PassUtils::StatementArray hoisted;
+		PassUtils::StatementArray section;
+		PassUtils::StatementArray sunk;
+
+		//Hoist statements that don't depend on anything that stays in the section
+		{
+			SYMBOL_ACCESS sectionAccess;
+			int depth = 0;
+			for(size_t i = beginIndex + 1; i < endIndex; i++)
+			{
+				const auto& statement = statements[i];
+				if(PassUtils::IsBlockBegin(statement.op)) depth++;
+				if(PassUtils::IsBlockEnd(statement.op)) depth--;
+				if((depth == 0) && CanMove(statement) && IsIndependent(statement, sectionAccess))
+				{
+					hoisted.push_back(statement);
+				}
+				else
+				{
+					AddAccess(statement, sectionAccess);
+					section.push_back(statement);
+				}
+			}
+			assert(depth == 0);
+		}
+
+		//Sink statements that nothing remaining in the section depends on
+		{
+			SYMBOL_ACCESS sectionAccess;
+			PassUtils::StatementArray kept;
+			int depth = 0;
+			for(auto statementIterator = section.rbegin(); statementIterator != section.rend(); statementIterator++)
+			{
+				const auto& statement = *statementIterator;
+				if(PassUtils::IsBlockEnd(statement.op)) depth++;
+				if(PassUtils::IsBlockBegin(statement.op)) depth--;
+				if((depth == 0) && CanMove(statement) && IsIndependent(statement, sectionAccess))
+				{
+					sunk.insert(std::begin(sunk), statement);
+				}
+				else
+				{
+					AddAccess(statement, sectionAccess);
+					kept.insert(std::begin(kept), statement);
+				}
+			}
+			assert(depth == 0);
+			section = std::move(kept);
+		}
+
+		if(hoisted.empty() && sunk.empty()) continue;
+
+		PassUtils::StatementArray result;
+		result.reserve(statements.size());
+		result.insert(std::end(result), std::begin(statements), std::begin(statements) + beginIndex);
+		result.insert(std::end(result), std::begin(hoisted), std::end(hoisted));
+		result.push_back(statements[beginIndex]);
+		result.insert(std::end(result), std::begin(section), std::end(section));
+		result.push_back(statements[endIndex]);
+		result.insert(std::end(result), std::begin(sunk), std::end(sunk));
+		result.insert(std::end(result), std::begin(statements) + endIndex + 1, std::end(statements));
+		beginIndex += hoisted.size();
+		statements = std::move(result);
+		changed = true;
+	}
+	return changed;
+}
+
+void CInterlockMinimizationPass::Run(CShaderBuilder& shaderBuilder)
+{
+	std::vector<CShaderBuilder::StatementList*> statementLists;
+	statementLists.push_back(&shaderBuilder.GetStatements());
+	for(auto& function : shaderBuilder.GetFunctions())
+	{
+		statementLists.push_back(&function.statements);
+	}
+
+	for(auto* statementList : statementLists)
+	{
+		auto statements = PassUtils::StatementArray(std::begin(*statementList), std::end(*statementList));
+		if(MinimizeSections(statements))
+		{
+			*statementList = CShaderBuilder::StatementList(std::begin(statements), std::end(statements));
+		}
+	}
+}
@@ -0,0 +1,149 @@
+#include <algorithm>
+#include "nuanceur/passes/LoopUnrollingPass.h"
+#include "nuanceur/passes/PassUtils.h"
+
+using namespace Nuanceur;
+
+static bool IsConstantCount(const PassUtils::StatementArray& statements, const CShaderBuilder::SYMBOLREF& countRef)
+{
+	//Count must be a temporary that is never written
+	const auto& countSymbol = countRef.symbol;
+	if(countSymbol.location != CShaderBuilder::SYMBOL_LOCATION_TEMPORARY) return false;
+	if(countSymbol.type != CShaderBuilder::SYMBOL_TYPE_INT4) return false;
+	auto countKey = PassUtils::MakeSymbolKey(countSymbol);
+	return std::none_of(std::begin(statements), std::end(statements),
+	                    [&](const CShaderBuilder::STATEMENT& statement) {
+		                    return (statement.dstRef.symbol.location != CShaderBuilder::SYMBOL_LOCATION_NULL) &&
+		                           (PassUtils::MakeSymbolKey(statement.dstRef.symbol) == countKey);
+	                    });
+}
+
+static int32 GetConstantCount(const CShaderBuilder& shaderBuilder, const CShaderBuilder::SYMBOLREF& countRef)
+{
+	auto value = shaderBuilder.GetTemporaryValueInt(countRef.symbol);
+	switch(GetSwizzleElement(countRef.swizzle, 0))
+	{
+	default:
+		assert(false);
+		[[fallthrough]];
+	case 0:
+		return value.x;
+	case 1:
+		return value.y;
+	case 2:
+		return value.z;
+	case 3:
+		return value.w;
+	}
+}
+
+static bool CanUnroll(const PassUtils::StatementArray& statements, size_t beginIndex, size_t endIndex)
+{
+	const auto& indexRef = statements[beginIndex].dstRef;
+	auto indexKey = PassUtils::MakeSymbolKey(indexRef.symbol);
+	auto indexElement = GetSwizzleElement(indexRef.swizzle, 0);
+	for(size_t i = beginIndex + 1; i < endIndex; i++)
+	{
+		const auto& statement = statements[i];
+		switch(statement.op)
+		{
+		//Inner loops are unrolled first
+		case CShaderBuilder::STATEMENT_OP_LOOP_BEGIN:
+		//Early exits would need to skip the remaining copies of the body
+		case CShaderBuilder::STATEMENT_OP_BREAK:
+		case CShaderBuilder::STATEMENT_OP_CONTINUE:
+			return false;
+		default:
+			break;
+		}
+		//Index is replaced by a constant in every copy of the body
+		if(
+		    (statement.dstRef.symbol.location != CShaderBuilder::SYMBOL_LOCATION_NULL) &&
+		    (PassUtils::MakeSymbolKey(statement.dstRef.symbol) == indexKey))
+		{
+			return false;
+		}
+		//Other components of the index symbol keep their value, only the index itself can be replaced
+		bool readsOtherElement = false;
+		PassUtils::ForEachSourceRef(statement,
+		                            [&](const CShaderBuilder::SYMBOLREF& srcRef) {
+			                            if(PassUtils::MakeSymbolKey(srcRef.symbol) != indexKey) return;
+			                            for(uint32 element = 0; element < GetSwizzleElementCount(srcRef.swizzle); element++)
+			                            {
+				                            if(GetSwizzleElement(srcRef.swizzle, element) != indexElement) readsOtherElement = true;
+			                            }
+		                            });
+		if(readsOtherElement) return false;
+	}
+	return true;
+}
+
+static bool UnrollLoops(CShaderBuilder& shaderBuilder, unsigned int maxUnrolledStatements)
+{
+	auto& statementList = shaderBuilder.GetStatements();
+	auto statements = PassUtils::StatementArray(std::begin(statementList), std::end(statementList));
+	auto blockEnds = PassUtils::MatchBlocks(statements);
+
+	for(size_t i = 0; i < statements.size(); i++)
+	{
+		const auto& statement = statements[i];
+		if(statement.op != CShaderBuilder::STATEMENT_OP_LOOP_BEGIN) continue;
+		if(statement.param == LOOP_CONTROL_DONT_UNROLL) continue;
+		//Loops without an index run until Break is called
+		if(statement.dstRef.symbol.location == CShaderBuilder::SYMBOL_LOCATION_NULL) continue;
+		if(!IsConstantCount(statements, statement.src1Ref)) continue;
+		size_t endIndex = blockEnds[i];
+		assert(endIndex != PassUtils::INVALID_INDEX);
+		if(!CanUnroll(statements, i, endIndex)) continue;
+
+		int32 count = std::max<int32>(GetConstantCount(shaderBuilder, statement.src1Ref), 0);
+		size_t bodySize = endIndex - i - 1;
+		if(
+		    (statement.param != LOOP_CONTROL_UNROLL) &&
+		    ((static_cast<size_t>(count) * bodySize) > maxUnrolledStatements))
+		{
+			continue;
+		}
+
+		const auto& indexRef = statement.dstRef;
+		auto indexKey = PassUtils::MakeSymbolKey(indexRef.symbol);
+		PassUtils::StatementArray unrolled;
+		unrolled.reserve((count * bodySize) + 1);
+		for(int32 iteration = 0; iteration < count; iteration++)
+		{
+			auto iterationSymbol = shaderBuilder.CreateConstantInt(iteration, iteration, iteration, iteration);
+			for(size_t bodyIndex = i + 1; bodyIndex < endIndex; bodyIndex++)
+			{
+				auto bodyStatement = statements[bodyIndex];
+				PassUtils::ForEachSourceRef(bodyStatement,
+				                            [&](CShaderBuilder::SYMBOLREF& srcRef) {
+					                            if(PassUtils::MakeSymbolKey(srcRef.symbol) != indexKey) return;
+					                            srcRef.symbol = iterationSymbol;
+				                            });
+				unrolled.push_back(bodyStatement);
+			}
+		}
+
+		//Index holds the count once the loop is done
+		auto countSymbol = shaderBuilder.CreateConstantInt(count, count, count, count);
+		unrolled.push_back(CShaderBuilder::STATEMENT(CShaderBuilder::STATEMENT_OP_ASSIGN, indexRef, CShaderBuilder::SYMBOLREF(countSymbol, SWIZZLE_X)));
+
+		PassUtils::StatementArray result;
+		result.reserve(statements.size() + unrolled.size());
+		result.insert(std::end(result), std::begin(statements), std::begin(statements) + i);
+		result.insert(std::end(result), std::begin(unrolled), std::end(unrolled));
+		result.insert(std::end(result), std::begin(statements) + endIndex + 1, std::end(statements));
+		statementList = CShaderBuilder::StatementList(std::begin(result), std::end(result));
+		return true;
+	}
+
+	return false;
+}
+
+void CLoopUnrollingPass::Run(CShaderBuilder& shaderBuilder, unsigned int maxUnrolledStatements)
+{
+	//Inner loops are unrolled first, which can make their parent unrollable
+	while(UnrollLoops(shaderBuilder, maxUnrolledStatements))
+	{
+	}
+}
@@ -0,0 +1,111 @@
+#include "nuanceur/passes/PassUtils.h"
+
+using namespace Nuanceur;
+
+PassUtils::SymbolKey PassUtils::MakeSymbolKey(const CShaderBuilder::SYMBOL& symbol)
+{
+	return (static_cast<SymbolKey>(symbol.location) << 32) | static_cast<SymbolKey>(symbol.index);
+}
+
+bool PassUtils::HasSideEffects(CShaderBuilder::STATEMENT_OP op)
+{
+	switch(op)
+	{
+	case CShaderBuilder::STATEMENT_OP_STORE:
+	case CShaderBuilder::STATEMENT_OP_STORE16:
+	case CShaderBuilder::STATEMENT_OP_STORE8:
+	case CShaderBuilder::STATEMENT_OP_ATOMICAND:
+	case CShaderBuilder::STATEMENT_OP_ATOMICOR:
+	case CShaderBuilder::STATEMENT_OP_ATOMICXOR:
+	case CShaderBuilder::STATEMENT_OP_ATOMICADD:
+	case CShaderBuilder::STATEMENT_OP_ATOMICMIN:
+	case CShaderBuilder::STATEMENT_OP_ATOMICMAX:
+	case CShaderBuilder::STATEMENT_OP_ATOMICEXCHANGE:
+	case CShaderBuilder::STATEMENT_OP_ATOMICCOMPAREEXCHANGE:
+	case CShaderBuilder::STATEMENT_OP_RETURN:
+	case CShaderBuilder::STATEMENT_OP_INVOCATION_INTERLOCK_BEGIN:
+	case CShaderBuilder::STATEMENT_OP_INVOCATION_INTERLOCK_END:
+	case CShaderBuilder::STATEMENT_OP_WORKGROUP_BARRIER:
+	case CShaderBuilder::STATEMENT_OP_DEVICE_MEMORY_BARRIER:
+	case CShaderBuilder::STATEMENT_OP_IF_BEGIN:
+	case CShaderBuilder::STATEMENT_OP_IF_END:
+	case CShaderBuilder::STATEMENT_OP_ELSE:
+	case CShaderBuilder::STATEMENT_OP_SWITCH_BEGIN:
+	case CShaderBuilder::STATEMENT_OP_SWITCH_CASE:
+	case CShaderBuilder::STATEMENT_OP_SWITCH_DEFAULT:
+	case CShaderBuilder::STATEMENT_OP_SWITCH_END:
+	case CShaderBuilder::STATEMENT_OP_LOOP_BEGIN:
+	case CShaderBuilder::STATEMENT_OP_LOOP_END:
+	case CShaderBuilder::STATEMENT_OP_BREAK:
+	case CShaderBuilder::STATEMENT_OP_CONTINUE:
+	case CShaderBuilder::STATEMENT_OP_CALL:
+		return true;
+	default:
+		return false;
+	}
+}
+
+bool PassUtils::IsBlockBegin(CShaderBuilder::STATEMENT_OP op)
+{
+	return (op == CShaderBuilder::STATEMENT_OP_IF_BEGIN) ||
+	       (op == CShaderBuilder::STATEMENT_OP_SWITCH_BEGIN) ||
+	       (op == CShaderBuilder::STATEMENT_OP_LOOP_BEGIN);
+}
+
+bool PassUtils::IsBlockSeparator(CShaderBuilder::STATEMENT_OP op)
+{
+	return (op == CShaderBuilder::STATEMENT_OP_ELSE) ||
+	       (op == CShaderBuilder::STATEMENT_OP_SWITCH_CASE) ||
+	       (op == CShaderBuilder::STATEMENT_OP_SWITCH_DEFAULT);
+}
+
+bool PassUtils::IsBlockEnd(CShaderBuilder::STATEMENT_OP op)
+{
+	return (op == CShaderBuilder::STATEMENT_OP_IF_END) ||
+	       (op == CShaderBuilder::STATEMENT_OP_SWITCH_END) ||
+	       (op == CShaderBuilder::STATEMENT_OP_LOOP_END);
+}
+
+std::vector<size_t> PassUtils::MatchBlocks(const StatementArray& statements)
+{
+	std::vector<size_t> result(statements.size(), INVALID_INDEX);
+	std::vector<size_t> beginIndices;
+	for(size_t i = 0; i < statements.size(); i++)
+	{
+		auto op = statements[i].op;
+		if(IsBlockBegin(op))
+		{
+			beginIndices.push_back(i);
+		}
+		else if(IsBlockEnd(op))
+		{
+			assert(!beginIndices.empty());
+			result[beginIndices.back()] = i;
+			beginIndices.pop_back();
+		}
+	}
+	assert(beginIndices.empty());
+	return result;
+}
+
+std::vector<size_t> PassUtils::MatchRegions(const StatementArray& statements)
+{
+	std::vector<size_t> result(statements.size(), INVALID_INDEX);
+	std::vector<size_t> regionBeginIndices;
+	for(size_t i = 0; i < statements.size(); i++)
+	{
+		auto op = statements[i].op;
+		if(IsBlockSeparator(op) || IsBlockEnd(op))
+		{
+			assert(!regionBeginIndices.empty());
+			result[regionBeginIndices.back()] = i;
+			regionBeginIndices.pop_back();
+		}
+		if(IsBlockBegin(op) || IsBlockSeparator(op))
+		{
+			regionBeginIndices.push_back(i);
+		}
+	}
+	assert(regionBeginIndices.empty());
+	return result;
+}
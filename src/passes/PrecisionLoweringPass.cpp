@@ -0,0 +1,166 @@
+#include <unordered_set>
+#include "nuanceur/passes/PrecisionLoweringPass.h"
+#include "nuanceur/passes/PassUtils.h"
+
+using namespace Nuanceur;
+
+typedef std::unordered_set<PassUtils::SymbolKey> SymbolKeySet;
+
+//Operations that don't need more precision for their operands than for their result
+static bool PreservesPrecision(CShaderBuilder::STATEMENT_OP op)
+{
+	switch(op)
+	{
+	case CShaderBuilder::STATEMENT_OP_ADD:
+	case CShaderBuilder::STATEMENT_OP_SUBSTRACT:
+	case CShaderBuilder::STATEMENT_OP_MULTIPLY:
+	case CShaderBuilder::STATEMENT_OP_DIVIDE:
+	case CShaderBuilder::STATEMENT_OP_NEGATE:
+	case CShaderBuilder::STATEMENT_OP_ABS:
+	case CShaderBuilder::STATEMENT_OP_CLAMP:
+	case CShaderBuilder::STATEMENT_OP_FRACT:
+	case CShaderBuilder::STATEMENT_OP_MIN:
+	case CShaderBuilder::STATEMENT_OP_MAX:
+	case CShaderBuilder::STATEMENT_OP_MIX:
+	case CShaderBuilder::STATEMENT_OP_SATURATE:
+	case CShaderBuilder::STATEMENT_OP_DOT:
+	case CShaderBuilder::STATEMENT_OP_NORMALIZE:
+	case CShaderBuilder::STATEMENT_OP_LENGTH:
+	case CShaderBuilder::STATEMENT_OP_POW:
+	case CShaderBuilder::STATEMENT_OP_LOG2:
+	case CShaderBuilder::STATEMENT_OP_TRUNC:
+	case CShaderBuilder::STATEMENT_OP_NEWVECTOR2:
+	case CShaderBuilder::STATEMENT_OP_NEWVECTOR4:
+	case CShaderBuilder::STATEMENT_OP_ASSIGN:
+		return true;
+	default:
+		return false;
+	}
+}
+
+static bool IsRelaxed(const CShaderBuilder& shaderBuilder, const CShaderBuilder::SYMBOL& symbol, const SymbolKeySet& relaxedKeys)
+{
+	if(symbol.location == CShaderBuilder::SYMBOL_LOCATION_NULL) return false;
+	if(relaxedKeys.count(PassUtils::MakeSymbolKey(symbol))) return true;
+	auto precision = shaderBuilder.GetPrecision(symbol);
+	return (precision == PRECISION_MEDIUM) || (precision == PRECISION_LOW);
+}
+
+static bool CanRelaxFloatUse(const CShaderBuilder& shaderBuilder, const CShaderBuilder::STATEMENT& statement,
+                             const SymbolKeySet& relaxedKeys, const SymbolKeySet& byteKeys)
+{
+	const auto& dstSymbol = statement.dstRef.symbol;
+	if(PreservesPrecision(statement.op))
+	{
+		return IsRelaxed(shaderBuilder, dstSymbol, relaxedKeys);
+	}
+	//Values converted to integers that are stored as bytes only need to be exact up to 255
+	if((statement.op == CShaderBuilder::STATEMENT_OP_TOINT) || (statement.op == CShaderBuilder::STATEMENT_OP_TOUINT))
+	{
+		return (dstSymbol.location != CShaderBuilder::SYMBOL_LOCATION_NULL) && byteKeys.count(PassUtils::MakeSymbolKey(dstSymbol));
+	}
+	return false;
+}
+
+static bool IsByteUse(const CShaderBuilder::STATEMENT& statement, const CShaderBuilder::SYMBOLREF& srcRef)
+{
+	switch(statement.op)
+	{
+	case CShaderBuilder::STATEMENT_OP_STORE8:
+		return (&srcRef == &statement.src3Ref);
+	case CShaderBuilder::STATEMENT_OP_TOUCHAR:
+		//Only the low byte is kept
+		return true;
+	default:
+		return false;
+	}
+}
+
+void CPrecisionLoweringPass::Run(CShaderBuilder& shaderBuilder)
+{
+	std::vector<const CShaderBuilder::StatementList*> statementLists;
+	statementLists.push_back(&shaderBuilder.GetStatements());
+	SymbolKeySet parameterKeys;
+	for(const auto& function : shaderBuilder.GetFunctions())
+	{
+		statementLists.push_back(&function.statements);
+		for(const auto& parameter : function.parameters)
+		{
+			parameterKeys.insert(PassUtils::MakeSymbolKey(parameter));
+		}
+	}
+
+	//Start with every candidate and remove those having a use that needs full precision
+	//relaxedKeys: float symbols that can be relaxed
+	//byteKeys: integer temporaries only used by 8-bit stores or conversions to 8-bit values
+	SymbolKeySet relaxedKeys;
+	SymbolKeySet byteKeys;
+	for(const auto& symbol : shaderBuilder.GetSymbols())
+	{
+		auto key = PassUtils::MakeSymbolKey(symbol);
+		if(parameterKeys.count(key)) continue;
+		if(shaderBuilder.GetPrecision(symbol) != PRECISION_DEFAULT) continue;
+		switch(symbol.location)
+		{
+		case CShaderBuilder::SYMBOL_LOCATION_TEMPORARY:
+			if(symbol.type == CShaderBuilder::SYMBOL_TYPE_FLOAT4)
+			{
+				relaxedKeys.insert(key);
+			}
+			else if(
+			    (symbol.type == CShaderBuilder::SYMBOL_TYPE_INT4) ||
+			    (symbol.type == CShaderBuilder::SYMBOL_TYPE_UINT4) ||
+			    (symbol.type == CShaderBuilder::SYMBOL_TYPE_UCHAR4))
+			{
+				byteKeys.insert(key);
+			}
+			break;
+		case CShaderBuilder::SYMBOL_LOCATION_VARIABLE:
+			if(symbol.type == CShaderBuilder::SYMBOL_TYPE_FLOAT4)
+			{
+				relaxedKeys.insert(key);
+			}
+			break;
+		case CShaderBuilder::SYMBOL_LOCATION_OUTPUT:
+			if((symbol.type == CShaderBuilder::SYMBOL_TYPE_FLOAT4) && (shaderBuilder.GetOutputSemantic(symbol).type == SEMANTIC_SYSTEM_COLOR))
+			{
+				relaxedKeys.insert(key);
+			}
+			break;
+		default:
+			break;
+		}
+	}
+
+	bool changed = true;
+	while(changed)
+	{
+		changed = false;
+		for(const auto* statementList : statementLists)
+		{
+			for(const auto& statement : *statementList)
+			{
+				PassUtils::ForEachSourceRef(statement,
+				                            [&](const CShaderBuilder::SYMBOLREF& srcRef) {
+					                            auto key = PassUtils::MakeSymbolKey(srcRef.symbol);
+					                            if(relaxedKeys.count(key) && !CanRelaxFloatUse(shaderBuilder, statement, relaxedKeys, byteKeys))
+					                            {
+						                            relaxedKeys.erase(key);
+						                            changed = true;
+					                            }
+					                            if(byteKeys.count(key) && !IsByteUse(statement, srcRef))
+					                            {
+						                            byteKeys.erase(key);
+						                            changed = true;
+					                            }
+				                            });
+			}
+		}
+	}
+
+	for(const auto& symbol : shaderBuilder.GetSymbols())
+	{
+		if(!relaxedKeys.count(PassUtils::MakeSymbolKey(symbol))) continue;
+		shaderBuilder.SetPrecision(symbol, PRECISION_MEDIUM);
+	}
+}
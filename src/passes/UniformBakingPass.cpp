@@ -0,0 +1,78 @@
+#include "nuanceur/passes/UniformBakingPass.h"
+#include "nuanceur/passes/ConstantFoldingPass.h"
+#include "nuanceur/passes/DeadCodeEliminationPass.h"
+#include "nuanceur/passes/PassUtils.h"
+
+using namespace Nuanceur;
+
+void CUniformBakingPass::CValueMap::SetValue(const CShaderBuilder::SYMBOL& symbol, const CVector4& value)
+{
+	assert(symbol.location == CShaderBuilder::SYMBOL_LOCATION_UNIFORM);
+	m_floatValues.erase(symbol.index);
+	m_floatValues.insert(std::make_pair(symbol.index, value));
+}
+
+void CUniformBakingPass::CValueMap::SetValue(const CShaderBuilder::SYMBOL& symbol, const CShaderBuilder::CIntVector4& value)
+{
+	assert(symbol.location == CShaderBuilder::SYMBOL_LOCATION_UNIFORM);
+	m_intValues.erase(symbol.index);
+	m_intValues.insert(std::make_pair(symbol.index, value));
+}
+
+CShaderBuilder CUniformBakingPass::Run(const CShaderBuilder& inputBuilder, const CValueMap& values)
+{
+	auto shaderBuilder = inputBuilder;
+
+	std::unordered_map<unsigned int, CShaderBuilder::SYMBOL> constantSymbols;
+	auto uniformSymbols = shaderBuilder.GetSymbols();
+	for(const auto& symbol : uniformSymbols)
+	{
+		if(symbol.location != CShaderBuilder::SYMBOL_LOCATION_UNIFORM) continue;
+		switch(symbol.type)
+		{
+		case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
+		{
+			auto valueIterator = values.m_floatValues.find(symbol.index);
+			if(valueIterator == std::end(values.m_floatValues)) continue;
+			const auto& value = valueIterator->second;
+			//Components that aren't stored by smaller float uniforms are read as 0
+			auto componentCount = shaderBuilder.GetUniformComponentCount(symbol);
+			constantSymbols[symbol.index] = shaderBuilder.CreateConstant(value.x,
+			                                                             (componentCount > 1) ? value.y : 0,
+			                                                             (componentCount > 2) ? value.z : 0,
+			                                                             (componentCount > 3) ? value.w : 0);
+		}
+		break;
+		case CShaderBuilder::SYMBOL_TYPE_INT4:
+		case CShaderBuilder::SYMBOL_TYPE_UINT4:
+		{
+			auto valueIterator = values.m_intValues.find(symbol.index);
+			if(valueIterator == std::end(values.m_intValues)) continue;
+			const auto& value = valueIterator->second;
+			constantSymbols[symbol.index] = (symbol.type == CShaderBuilder::SYMBOL_TYPE_INT4)
+			                                    ? shaderBuilder.CreateConstantInt(value.x, value.y, value.z, value.w)
+			                                    : shaderBuilder.CreateConstantUint(value.x, value.y, value.z, value.w);
+		}
+		break;
+		default:
+			//Matrices, arrays and other resources can't be replaced by a constant, they are left untouched
+			break;
+		}
+	}
+
+	for(auto& statement : shaderBuilder.GetStatements())
+	{
+		PassUtils::ForEachSourceRef(statement,
+		                            [&](CShaderBuilder::SYMBOLREF& srcRef) {
+			                            if(srcRef.symbol.location != CShaderBuilder::SYMBOL_LOCATION_UNIFORM) return;
+			                            auto constantIterator = constantSymbols.find(srcRef.symbol.index);
+			                            if(constantIterator == std::end(constantSymbols)) return;
+			                            srcRef.symbol = constantIterator->second;
+		                            });
+	}
+
+	CConstantFoldingPass::Run(shaderBuilder);
+	CDeadCodeEliminationPass::Run(shaderBuilder);
+
+	return shaderBuilder;
+}
@@ -0,0 +1,480 @@
+#include <algorithm>
+#include <array>
+#include <unordered_set>
+#include "nuanceur/passes/VectorizationPass.h"
+#include "nuanceur/passes/PassUtils.h"
+
+using namespace Nuanceur;
+
+typedef std::unordered_set<PassUtils::SymbolKey> SymbolKeySet;
+
+//Source component used for every destination component of a statement
+struct LANE
+{
+	uint32 dstElement = 0;
+	std::array<uint32, 4> srcElements = {};
+	const CShaderBuilder::STATEMENT* statement = nullptr;
+};
+
+static bool IsComponentWise(CShaderBuilder::STATEMENT_OP op)
+{
+	switch(op)
+	{
+	case CShaderBuilder::STATEMENT_OP_ADD:
+	case CShaderBuilder::STATEMENT_OP_SUBSTRACT:
+	case CShaderBuilder::STATEMENT_OP_MULTIPLY:
+	case CShaderBuilder::STATEMENT_OP_DIVIDE:
+	case CShaderBuilder::STATEMENT_OP_MODULO:
+	case CShaderBuilder::STATEMENT_OP_AND:
+	case CShaderBuilder::STATEMENT_OP_OR:
+	case CShaderBuilder::STATEMENT_OP_XOR:
+	case CShaderBuilder::STATEMENT_OP_NOT:
+	case CShaderBuilder::STATEMENT_OP_LSHIFT:
+	case CShaderBuilder::STATEMENT_OP_RSHIFT:
+	case CShaderBuilder::STATEMENT_OP_RSHIFT_ARITHMETIC:
+	case CShaderBuilder::STATEMENT_OP_LOGICAL_AND:
+	case CShaderBuilder::STATEMENT_OP_LOGICAL_OR:
+	case CShaderBuilder::STATEMENT_OP_LOGICAL_NOT:
+	case CShaderBuilder::STATEMENT_OP_COMPARE_EQ:
+	case CShaderBuilder::STATEMENT_OP_COMPARE_NE:
+	case CShaderBuilder::STATEMENT_OP_COMPARE_LT:
+	case CShaderBuilder::STATEMENT_OP_COMPARE_LE:
+	case CShaderBuilder::STATEMENT_OP_COMPARE_GT:
+	case CShaderBuilder::STATEMENT_OP_COMPARE_GE:
+	case CShaderBuilder::STATEMENT_OP_POW:
+	case CShaderBuilder::STATEMENT_OP_NEGATE:
+	case CShaderBuilder::STATEMENT_OP_ABS:
+	case CShaderBuilder::STATEMENT_OP_CLAMP:
+	case CShaderBuilder::STATEMENT_OP_FRACT:
+	case CShaderBuilder::STATEMENT_OP_LOG2:
+	case CShaderBuilder::STATEMENT_OP_MIN:
+	case CShaderBuilder::STATEMENT_OP_MAX:
+	case CShaderBuilder::STATEMENT_OP_MIX:
+	case CShaderBuilder::STATEMENT_OP_SATURATE:
+	case CShaderBuilder::STATEMENT_OP_TRUNC:
+	case CShaderBuilder::STATEMENT_OP_ISINF:
+	case CShaderBuilder::STATEMENT_OP_ASSIGN:
+	case CShaderBuilder::STATEMENT_OP_TOFLOAT:
+	case CShaderBuilder::STATEMENT_OP_TOINT:
+	case CShaderBuilder::STATEMENT_OP_TOUINT:
+		return true;
+	default:
+		return false;
+	}
+}
+
+static bool IsCandidate(const CShaderBuilder::STATEMENT& statement)
+{
+	if(!IsComponentWise(statement.op)) return false;
+	switch(statement.dstRef.symbol.location)
+	{
+	case CShaderBuilder::SYMBOL_LOCATION_TEMPORARY:
+	case CShaderBuilder::SYMBOL_LOCATION_VARIABLE:
+	case CShaderBuilder::SYMBOL_LOCATION_OUTPUT:
+		break;
+	default:
+		return false;
+	}
+	auto elemCount = GetSwizzleElementCount(statement.dstRef.swizzle);
+	if(elemCount == 4) return false;
+	bool valid = true;
+	PassUtils::ForEachSourceRef(statement,
+	                            [&](const CShaderBuilder::SYMBOLREF& srcRef) {
+		                            if(srcRef.symbol.type == CShaderBuilder::SYMBOL_TYPE_MATRIX) valid = false;
+		                            if(srcRef.symbol.type == CShaderBuilder::SYMBOL_TYPE_ARRAYMATRIX) valid = false;
+		                            if(GetSwizzleElementCount(srcRef.swizzle) != elemCount) valid = false;
+	                            });
+	return valid;
+}
+
+static uint32 GetElementMask(SWIZZLE_TYPE swizzle)
+{
+	uint32 mask = 0;
+	for(uint32 i = 0; i < GetSwizzleElementCount(swizzle); i++)
+	{
+		mask |= (1 << GetSwizzleElement(swizzle, i));
+	}
+	return mask;
+}
+
+static uint32 GetElementCount(uint32 mask)
+{
+	uint32 count = 0;
+	for(uint32 i = 0; i < 4; i++)
+	{
+		if(mask & (1 << i)) count++;
+	}
+	return count;
+}
+
+static SWIZZLE_TYPE MakeSwizzle(const std::vector<uint32>& elements)
+{
+	assert(!elements.empty() && (elements.size() <= 4));
+	uint32 swizzle = static_cast<uint32>(elements.size()) << 8;
+	for(uint32 i = 0; i < elements.size(); i++)
+	{
+		swizzle |= (elements[i] << (i * 2));
+	}
+	return static_cast<SWIZZLE_TYPE>(swizzle);
+}
+
+static bool WritesSymbol(const CShaderBuilder::STATEMENT& statement, PassUtils::SymbolKey key)
+{
+	return (statement.dstRef.symbol.location != CShaderBuilder::SYMBOL_LOCATION_NULL) &&
+	       (PassUtils::MakeSymbolKey(statement.dstRef.symbol) == key);
+}
+
+//Returns the mask of components read from a symbol
+static uint32 GetReadMask(const CShaderBuilder::STATEMENT& statement, PassUtils::SymbolKey key)
+{
+	uint32 mask = 0;
+	PassUtils::ForEachSourceRef(statement,
+	                            [&](const CShaderBuilder::SYMBOLREF& srcRef) {
+		                            if(PassUtils::MakeSymbolKey(srcRef.symbol) != key) return;
+		                            mask |= GetElementMask(srcRef.swizzle);
+	                            });
+	return mask;
+}
+
+//Parameters are never written by the function itself but get their values from callers
+static bool IsConstant(const CShaderBuilder::SYMBOL& symbol, const SymbolKeySet& writtenKeys, const SymbolKeySet& parameterKeys)
+{
+	auto key = PassUtils::MakeSymbolKey(symbol);
+	return (symbol.location == CShaderBuilder::SYMBOL_LOCATION_TEMPORARY) &&
+	       (writtenKeys.count(key) == 0) && (parameterKeys.count(key) == 0);
+}
+
+template <typename VectorType>
+static auto GetElement(const VectorType& vector, uint32 element)
+{
+	switch(element)
+	{
+	default:
+		assert(false);
+		[[fallthrough]];
+	case 0:
+		return vector.x;
+	case 1:
+		return vector.y;
+	case 2:
+		return vector.z;
+	case 3:
+		return vector.w;
+	}
+}
+
+static bool HaveSameInitialValue(const CShaderBuilder& shaderBuilder, const CShaderBuilder::SYMBOL& symbol1, uint32 element1,
+                                 const CShaderBuilder::SYMBOL& symbol2, uint32 element2)
+{
+	assert(symbol1.type == symbol2.type);
+	switch(symbol1.type)
+	{
+	case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
+	case CShaderBuilder::SYMBOL_TYPE_HALF4:
+		return GetElement(shaderBuilder.GetTemporaryValue(symbol1), element1) == GetElement(shaderBuilder.GetTemporaryValue(symbol2), element2);
+	case CShaderBuilder::SYMBOL_TYPE_INT4:
+	case CShaderBuilder::SYMBOL_TYPE_UINT4:
+		return GetElement(shaderBuilder.GetTemporaryValueInt(symbol1), element1) == GetElement(shaderBuilder.GetTemporaryValueInt(symbol2), element2);
+	case CShaderBuilder::SYMBOL_TYPE_BOOL4:
+		return GetElement(shaderBuilder.GetTemporaryValueBool(symbol1), element1) == GetElement(shaderBuilder.GetTemporaryValueBool(symbol2), element2);
+	default:
+		return false;
+	}
+}
+
+//Makes a new constant holding the selected components of other constants
+static CShaderBuilder::SYMBOL CombineConstants(CShaderBuilder& shaderBuilder, const std::vector<std::pair<CShaderBuilder::SYMBOL, uint32>>& elements)
+{
+	auto type = elements[0].first.type;
+	switch(type)
+	{
+	case CShaderBuilder::SYMBOL_TYPE_FLOAT4:
+	case CShaderBuilder::SYMBOL_TYPE_HALF4:
+	{
+		float values[4] = {};
+		for(uint32 i = 0; i < elements.size(); i++)
+		{
+			values[i] = GetElement(shaderBuilder.GetTemporaryValue(elements[i].first), elements[i].second);
+		}
+		return (type == CShaderBuilder::SYMBOL_TYPE_FLOAT4) ? shaderBuilder.CreateConstant(values[0], values[1], values[2], values[3])
+		                                                    : shaderBuilder.CreateConstantHalf(values[0], values[1], values[2], values[3]);
+	}
+	case CShaderBuilder::SYMBOL_TYPE_INT4:
+	case CShaderBuilder::SYMBOL_TYPE_UINT4:
+	{
+		int32 values[4] = {};
+		for(uint32 i = 0; i < elements.size(); i++)
+		{
+			values[i] = GetElement(shaderBuilder.GetTemporaryValueInt(elements[i].first), elements[i].second);
+		}
+		return (type == CShaderBuilder::SYMBOL_TYPE_INT4) ? shaderBuilder.CreateConstantInt(values[0], values[1], values[2], values[3])
+		                                                  : shaderBuilder.CreateConstantUint(values[0], values[1], values[2], values[3]);
+	}
+	case CShaderBuilder::SYMBOL_TYPE_BOOL4:
+	{
+		bool values[4] = {};
+		for(uint32 i = 0; i < elements.size(); i++)
+		{
+			values[i] = GetElement(shaderBuilder.GetTemporaryValueBool(elements[i].first), elements[i].second);
+		}
+		return shaderBuilder.CreateConstantBool(values[0], values[1], values[2], values[3]);
+	}
+	default:
+		assert(false);
+		return CShaderBuilder::SYMBOL();
+	}
+}
+
+//Checks if the second statement's destination (a temporary only written once) can be moved to unused components
+//of the first statement's destination and computes where its components go
+static bool CanPackTemporaries(const CShaderBuilder& shaderBuilder, const PassUtils::StatementArray& statements, size_t index1, size_t index2,
+                               const SymbolKeySet& externalKeys, std::array<uint32, 4>& elementMap)
+{
+	const auto& symbol1 = statements[index1].dstRef.symbol;
+	const auto& symbol2 = statements[index2].dstRef.symbol;
+	if(symbol1.location != CShaderBuilder::SYMBOL_LOCATION_TEMPORARY) return false;
+	if(symbol2.location != CShaderBuilder::SYMBOL_LOCATION_TEMPORARY) return false;
+	if(symbol1.type != symbol2.type) return false;
+	auto key1 = PassUtils::MakeSymbolKey(symbol1);
+	auto key2 = PassUtils::MakeSymbolKey(symbol2);
+	if(externalKeys.count(key1) || externalKeys.count(key2)) return false;
+
+	uint32 mask1 = GetElementMask(statements[index1].dstRef.swizzle);
+	uint32 mask2 = GetElementMask(statements[index2].dstRef.swizzle);
+	if((GetElementCount(mask1) + GetElementCount(mask2)) > 4) return false;
+
+	for(size_t i = 0; i < statements.size(); i++)
+	{
+		const auto& statement = statements[i];
+		if((i != index1) && WritesSymbol(statement, key1)) return false;
+		if((i != index2) && WritesSymbol(statement, key2)) return false;
+		//Components of the first temporary that are not written must not be used
+		if(GetReadMask(statement, key1) & ~mask1) return false;
+		uint32 readMask2 = GetReadMask(statement, key2);
+		if(readMask2 == 0) continue;
+		if((i <= index2) || (readMask2 & ~mask2)) return false;
+	}
+
+	uint32 nextElement = 0;
+	for(uint32 element = 0; element < 4; element++)
+	{
+		if(!(mask2 & (1 << element))) continue;
+		while(mask1 & (1 << nextElement))
+		{
+			nextElement++;
+		}
+		assert(nextElement < 4);
+		//Statements might be skipped, components must start with the same value
+		if(!HaveSameInitialValue(shaderBuilder, symbol2, element, symbol1, nextElement)) return false;
+		elementMap[element] = nextElement++;
+	}
+	return true;
+}
+
+static bool TryFuse(CShaderBuilder& shaderBuilder, PassUtils::StatementArray& statements, size_t index1, size_t index2,
+                    const SymbolKeySet& writtenKeys, const SymbolKeySet& externalKeys, const SymbolKeySet& parameterKeys)
+{
+	const auto& statement1 = statements[index1];
+	const auto& statement2 = statements[index2];
+	assert(statement1.op == statement2.op);
+
+	auto dstKey1 = PassUtils::MakeSymbolKey(statement1.dstRef.symbol);
+	auto dstKey2 = PassUtils::MakeSymbolKey(statement2.dstRef.symbol);
+	std::array<uint32, 4> elementMap = {0, 1, 2, 3};
+	bool packTemporaries = (dstKey1 != dstKey2);
+	if(packTemporaries)
+	{
+		if(!CanPackTemporaries(shaderBuilder, statements, index1, index2, externalKeys, elementMap)) return false;
+	}
+	else if(GetElementMask(statement1.dstRef.swizzle) & GetElementMask(statement2.dstRef.swizzle))
+	{
+		return false;
+	}
+
+	//Sources must be the same symbols or constants
+	const CShaderBuilder::SYMBOLREF* srcRefs1[] = {&statement1.src1Ref, &statement1.src2Ref, &statement1.src3Ref, &statement1.src4Ref};
+	const CShaderBuilder::SYMBOLREF* srcRefs2[] = {&statement2.src1Ref, &statement2.src2Ref, &statement2.src3Ref, &statement2.src4Ref};
+	std::array<bool, 4> combineConstants = {};
+	for(uint32 i = 0; i < 4; i++)
+	{
+		const auto& srcSymbol1 = srcRefs1[i]->symbol;
+		const auto& srcSymbol2 = srcRefs2[i]->symbol;
+		if((srcSymbol1.location == CShaderBuilder::SYMBOL_LOCATION_NULL) != (srcSymbol2.location == CShaderBuilder::SYMBOL_LOCATION_NULL)) return false;
+		if(srcSymbol1.location == CShaderBuilder::SYMBOL_LOCATION_NULL) continue;
+		//Second statement would see the values written by the first one
+		if(PassUtils::MakeSymbolKey(srcSymbol2) == dstKey1) return false;
+		if(PassUtils::MakeSymbolKey(srcSymbol1) == PassUtils::MakeSymbolKey(srcSymbol2)) continue;
+		if(srcSymbol1.type != srcSymbol2.type) return false;
+		if(!IsConstant(srcSymbol1, writtenKeys, parameterKeys) || !IsConstant(srcSymbol2, writtenKeys, parameterKeys)) return false;
+		combineConstants[i] = true;
+	}
+
+	//Second statement is moved next to the first one
+	for(size_t i = index1 + 1; i < index2; i++)
+	{
+		const auto& statement = statements[i];
+		if(GetReadMask(statement, dstKey2) || WritesSymbol(statement, dstKey2)) return false;
+		if(statement.dstRef.symbol.location == CShaderBuilder::SYMBOL_LOCATION_NULL) continue;
+		if(GetReadMask(statement2, PassUtils::MakeSymbolKey(statement.dstRef.symbol))) return false;
+	}
+
+	std::vector<LANE> lanes;
+	for(const auto* statement : {&statement1, &statement2})
+	{
+		const CShaderBuilder::SYMBOLREF* srcRefs[] = {&statement->src1Ref, &statement->src2Ref, &statement->src3Ref, &statement->src4Ref};
+		for(uint32 i = 0; i < GetSwizzleElementCount(statement->dstRef.swizzle); i++)
+		{
+			LANE lane;
+			lane.statement = statement;
+			lane.dstElement = GetSwizzleElement(statement->dstRef.swizzle, i);
+			if(statement == &statement2)
+			{
+				lane.dstElement = elementMap[lane.dstElement];
+			}
+			for(uint32 srcIndex = 0; srcIndex < 4; srcIndex++)
+			{
+				if(srcRefs[srcIndex]->symbol.location == CShaderBuilder::SYMBOL_LOCATION_NULL) continue;
+				lane.srcElements[srcIndex] = GetSwizzleElement(srcRefs[srcIndex]->swizzle, i);
+			}
+			lanes.push_back(lane);
+		}
+	}
+	std::sort(std::begin(lanes), std::end(lanes), [](const LANE& lane1, const LANE& lane2) { return lane1.dstElement < lane2.dstElement; });
+
+	auto fused = statement1;
+	{
+		std::vector<uint32> dstElements;
+		for(const auto& lane : lanes)
+		{
+			dstElements.push_back(lane.dstElement);
+		}
+		fused.dstRef.swizzle = MakeSwizzle(dstElements);
+	}
+	CShaderBuilder::SYMBOLREF* fusedSrcRefs[] = {&fused.src1Ref, &fused.src2Ref, &fused.src3Ref, &fused.src4Ref};
+	for(uint32 srcIndex = 0; srcIndex < 4; srcIndex++)
+	{
+		if(fusedSrcRefs[srcIndex]->symbol.location == CShaderBuilder::SYMBOL_LOCATION_NULL) continue;
+		std::vector<uint32> srcElements;
+		if(combineConstants[srcIndex])
+		{
+			std::vector<std::pair<CShaderBuilder::SYMBOL, uint32>> constantElements;
+			for(const auto& lane : lanes)
+			{
+				const CShaderBuilder::SYMBOLREF* laneSrcRefs[] = {&lane.statement->src1Ref, &lane.statement->src2Ref, &lane.statement->src3Ref, &lane.statement->src4Ref};
+				constantElements.push_back(std::make_pair(laneSrcRefs[srcIndex]->symbol, lane.srcElements[srcIndex]));
+				srcElements.push_back(static_cast<uint32>(srcElements.size()));
+			}
+			fusedSrcRefs[srcIndex]->symbol = CombineConstants(shaderBuilder, constantElements);
+		}
+		else
+		{
+			for(const auto& lane : lanes)
+			{
+				srcElements.push_back(lane.srcElements[srcIndex]);
+			}
+		}
+		fusedSrcRefs[srcIndex]->swizzle = MakeSwizzle(srcElements);
+	}
+
+	if(packTemporaries)
+	{
+		//Reads of the second temporary now use the components where its values were moved
+		const auto& packedSymbol = statement1.dstRef.symbol;
+		for(size_t i = index2 + 1; i < statements.size(); i++)
+		{
+			PassUtils::ForEachSourceRef(statements[i],
+			                            [&](CShaderBuilder::SYMBOLREF& srcRef) {
+				                            if(PassUtils::MakeSymbolKey(srcRef.symbol) != dstKey2) return;
+				                            std::vector<uint32> srcElements;
+				                            for(uint32 elem = 0; elem < GetSwizzleElementCount(srcRef.swizzle); elem++)
+				                            {
+					                            srcElements.push_back(elementMap[GetSwizzleElement(srcRef.swizzle, elem)]);
+				                            }
+				                            srcRef.symbol = packedSymbol;
+				                            srcRef.swizzle = MakeSwizzle(srcElements);
+			                            });
+		}
+	}
+
+	statements[index1] = fused;
+	statements.erase(std::begin(statements) + index2);
+	return true;
+}
+
+static bool FuseStatements(CShaderBuilder& shaderBuilder, PassUtils::StatementArray& statements, unsigned int maxDistance,
+                           const SymbolKeySet& writtenKeys, const SymbolKeySet& externalKeys, const SymbolKeySet& parameterKeys)
+{
+	for(size_t index1 = 0; index1 < statements.size(); index1++)
+	{
+		if(!IsCandidate(statements[index1])) continue;
+		size_t endIndex = std::min<size_t>(statements.size(), index1 + maxDistance + 1);
+		for(size_t index2 = index1 + 1; index2 < endIndex; index2++)
+		{
+			const auto& statement = statements[index2];
+			//Control flow and memory accesses can't be crossed
+			if(PassUtils::HasSideEffects(statement.op)) break;
+			if(statement.op != statements[index1].op) continue;
+			if(!IsCandidate(statement)) continue;
+			if(TryFuse(shaderBuilder, statements, index1, index2, writtenKeys, externalKeys, parameterKeys)) return true;
+		}
+	}
+	return false;
+}
+
+static void CollectKeys(const CShaderBuilder::StatementList& statements, SymbolKeySet& writtenKeys, SymbolKeySet& usedKeys)
+{
+	for(const auto& statement : statements)
+	{
+		if(statement.dstRef.symbol.location != CShaderBuilder::SYMBOL_LOCATION_NULL)
+		{
+			writtenKeys.insert(PassUtils::MakeSymbolKey(statement.dstRef.symbol));
+			usedKeys.insert(PassUtils::MakeSymbolKey(statement.dstRef.symbol));
+		}
+		PassUtils::ForEachSourceRef(statement,
+		                            [&](const CShaderBuilder::SYMBOLREF& srcRef) {
+			                            usedKeys.insert(PassUtils::MakeSymbolKey(srcRef.symbol));
+		                            });
+	}
+}
+
+void CVectorizationPass::Run(CShaderBuilder& shaderBuilder, unsigned int maxDistance)
+{
+	std::vector<CShaderBuilder::StatementList*> statementLists;
+	statementLists.push_back(&shaderBuilder.GetStatements());
+	SymbolKeySet parameterKeys;
+	for(auto& function : shaderBuilder.GetFunctions())
+	{
+		statementLists.push_back(&function.statements);
+		for(const auto& parameter : function.parameters)
+		{
+			parameterKeys.insert(PassUtils::MakeSymbolKey(parameter));
+		}
+	}
+
+	for(auto* statementList : statementLists)
+	{
+		//Temporaries used by other functions and parameters can't be packed
+		SymbolKeySet writtenKeys;
+		SymbolKeySet externalKeys = parameterKeys;
+		for(auto* otherStatementList : statementLists)
+		{
+			SymbolKeySet usedKeys;
+			CollectKeys(*otherStatementList, writtenKeys, usedKeys);
+			if(otherStatementList != statementList)
+			{
+				externalKeys.insert(std::begin(usedKeys), std::end(usedKeys));
+			}
+		}
+
+		auto statements = PassUtils::StatementArray(std::begin(*statementList), std::end(*statementList));
+		bool changed = false;
+		while(FuseStatements(shaderBuilder, statements, maxDistance, writtenKeys, externalKeys, parameterKeys))
+		{
+			changed = true;
+		}
+		if(changed)
+		{
+			*statementList = CShaderBuilder::StatementList(std::begin(statements), std::end(statements));
+		}
+	}
+}
@@ -0,0 +1,49 @@
+#include "AtomicTest.h"
+#include <algorithm>
+#include "nuanceur/Builder.h"
+
+void CAtomicTest::Run()
+{
+	using namespace Nuanceur;
+
+	auto b = CShaderBuilder();
+	b.SetMetadata(CShaderBuilder::METADATA_LOCALSIZE_X, 4);
+
+	{
+		auto localIndex = CIntLvalue(b.CreateInputInt(Nuanceur::SEMANTIC_SYSTEM_LIINDEX));
+		auto counters = CArrayUintValue(b.CreateUniformArrayUint("counters", 0));
+		auto bit = CUintLvalue(b.CreateTemporaryUint());
+
+		bit = NewUint(b, 1) << ToUint(localIndex);
+
+		AtomicAdd(counters, NewInt(b, 0), NewUint(b, 1), MEMORY_SCOPE_WORKGROUP, MEMORY_ORDER_ACQUIRE_RELEASE);
+		AtomicOr(counters, NewInt(b, 1), bit);
+		AtomicAnd(counters, NewInt(b, 2), ~bit);
+		AtomicXor(counters, NewInt(b, 3), bit);
+		AtomicMax(counters, NewInt(b, 4), ToUint(localIndex));
+		AtomicMin(counters, NewInt(b, 5), ToUint(localIndex) + NewUint(b, 10));
+		AtomicCompareExchange(counters, NewInt(b, 6), NewUint(b, 7), NewUint(b, 0));
+		AtomicExchange(counters, NewInt(b, 7), NewUint(b, 5));
+	}
+
+	{
+		auto instructions = GetSpirvInstructions(b, CSpirvShaderGenerator::SHADER_TYPE_COMPUTE);
+		auto hasOp = [&](uint32 op) {
+			return std::any_of(instructions.begin(), instructions.end(),
+			                   [&](const SPIRV_INSTRUCTION& instruction) { return instruction.op == op; });
+		};
+		assert(hasOp(spv::OpAtomicIAdd));
+		assert(hasOp(spv::OpAtomicOr));
+		assert(hasOp(spv::OpAtomicAnd));
+		assert(hasOp(spv::OpAtomicXor));
+		assert(hasOp(spv::OpAtomicUMax));
+		assert(hasOp(spv::OpAtomicUMin));
+		assert(hasOp(spv::OpAtomicCompareExchange));
+		assert(hasOp(spv::OpAtomicExchange));
+	}
+
+	SUBMIT_PARAMS params;
+	params.setup = "ssbo 0 subdata uint 0 0 0 255 0 0 100 0 0\r\n";
+	params.checks = "probe ssbo uint 0 0 == 4 15 240 15 3 10 7 5\r\n";
+	SubmitCompute(b, 1, params);
+}
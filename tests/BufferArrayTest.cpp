@@ -0,0 +1,72 @@
+#include "BufferArrayTest.h"
+#include <algorithm>
+#include "nuanceur/Builder.h"
+#include "nuanceur/generators/GlslShaderGenerator.h"
+#include "nuanceur/generators/HlslShaderGenerator.h"
+
+void CBufferArrayTest::Run()
+{
+	using namespace Nuanceur;
+
+	auto b = CShaderBuilder();
+
+	{
+		auto inputPosition = CFloat4Lvalue(b.CreateInput(Nuanceur::SEMANTIC_SYSTEM_POSITION));
+		auto outputColor = CFloat4Lvalue(b.CreateOutput(Nuanceur::SEMANTIC_SYSTEM_COLOR));
+		auto sources = CArrayUintDescriptorArrayValue(b.CreateUniformArrayUintDescriptorArray("sources", 0, 2));
+		auto results = CArrayUintDescriptorArrayValue(b.CreateUniformArrayUintDescriptorArray("results", 1, 0));
+		auto pixelIndex = CIntLvalue(b.CreateTemporaryInt());
+		auto value = CUintLvalue(b.CreateTemporaryUint());
+
+		//Same buffer for all invocations when loading, one per pixel when storing
+		pixelIndex = ToInt(inputPosition->x());
+		value = Load(Element(sources, NewInt(b, 1)), pixelIndex);
+		Store(NonUniformElement(results, pixelIndex), pixelIndex, value);
+		AtomicAdd(Element(results, NewInt(b, 0)), NewInt(b, 4), value);
+		outputColor = NewFloat4(b, 0, 0, 0, 1);
+	}
+
+	//The test runner can't bind buffer arrays, so only the generated code is checked
+	{
+		auto instructions = GetSpirvInstructions(b);
+		auto hasOp = [&](uint32 op) {
+			return std::any_of(instructions.begin(), instructions.end(),
+			                   [&](const SPIRV_INSTRUCTION& instruction) { return instruction.op == op; });
+		};
+		auto hasCapability = [&](uint32 capability) {
+			return std::any_of(instructions.begin(), instructions.end(),
+			                   [&](const SPIRV_INSTRUCTION& instruction) {
+				                   return (instruction.op == spv::OpCapability) && (instruction.operands[0] == capability);
+			                   });
+		};
+		auto nonUniformCount = std::count_if(instructions.begin(), instructions.end(),
+		                                     [&](const SPIRV_INSTRUCTION& instruction) {
+			                                     return (instruction.op == spv::OpDecorate) && (instruction.operands[1] == spv::DecorationNonUniformEXT);
+		                                     });
+		assert(hasOp(spv::OpTypeArray));
+		assert(hasOp(spv::OpTypeRuntimeArray));
+		assert(hasCapability(spv::CapabilityStorageBufferArrayDynamicIndexing));
+		assert(hasCapability(spv::CapabilityRuntimeDescriptorArrayEXT));
+		assert(hasCapability(spv::CapabilityShaderNonUniformEXT));
+		assert(hasCapability(spv::CapabilityStorageBufferArrayNonUniformIndexingEXT));
+		//Both the selected block and the stored element pointers are decorated
+		assert(nonUniformCount == 2);
+	}
+
+	{
+		auto shaderCode = CGlslShaderGenerator::Generate(b, CGlslShaderGenerator::SHADER_TYPE_FRAGMENT, 450);
+		assert(shaderCode.find("#extension GL_EXT_nonuniform_qualifier : require") != std::string::npos);
+		assert(shaderCode.find("} sources[2];") != std::string::npos);
+		assert(shaderCode.find("} results[];") != std::string::npos);
+		assert(shaderCode.find("results[nonuniformEXT(") != std::string::npos);
+		assert(shaderCode.find("atomicAdd(results[") != std::string::npos);
+	}
+
+	{
+		auto shaderCode = CHlslShaderGenerator::Generate("main", b);
+		assert(shaderCode.find("RWStructuredBuffer<uint> sources[2] : register(u0);") != std::string::npos);
+		assert(shaderCode.find("RWStructuredBuffer<uint> results[] : register(u1);") != std::string::npos);
+		assert(shaderCode.find("results[NonUniformResourceIndex(") != std::string::npos);
+		assert(shaderCode.find("InterlockedAdd(results[") != std::string::npos);
+	}
+}
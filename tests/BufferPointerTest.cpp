@@ -0,0 +1,62 @@
+#include "BufferPointerTest.h"
+#include <algorithm>
+#include "nuanceur/Builder.h"
+#include "nuanceur/generators/GlslShaderGenerator.h"
+
+void CBufferPointerTest::Run()
+{
+	using namespace Nuanceur;
+
+	auto b = CShaderBuilder();
+	b.SetMetadata(CShaderBuilder::METADATA_LOCALSIZE_X, 4);
+
+	{
+		auto localIndex = CIntLvalue(b.CreateInputInt(Nuanceur::SEMANTIC_SYSTEM_LIINDEX));
+		auto scale = CFloat4Lvalue(b.CreateUniformFloat4("scale", Nuanceur::UNIFORM_UNIT_PUSHCONSTANT));
+		auto counters = CBufferPointerUintValue(b.CreateUniformBufferPointerUint("counters"));
+		auto vectors = CBufferPointerFloat4Value(b.CreateUniformBufferPointerFloat4("vectors"));
+
+		Store(vectors, localIndex, Load(vectors, localIndex) * scale);
+		Store(counters, localIndex, Load(counters, localIndex) + NewUint(b, 1));
+		AtomicAdd(counters, NewInt(b, 4), NewUint(b, 1));
+	}
+
+	//The test runner can't provide device addresses, so only the generated code is checked
+	{
+		auto instructions = GetSpirvInstructions(b, CSpirvShaderGenerator::SHADER_TYPE_COMPUTE);
+		auto hasInstruction = [&](uint32 op, uint32 operandIndex, uint32 operand) {
+			return std::any_of(instructions.begin(), instructions.end(),
+			                   [&](const SPIRV_INSTRUCTION& instruction) {
+				                   return (instruction.op == op) && (instruction.operands.size() > operandIndex) &&
+				                          (instruction.operands[operandIndex] == operand);
+			                   });
+		};
+		auto countAlignedAccesses = [&](uint32 op, uint32 alignment) {
+			//Memory operands follow the pointer (and the value for stores)
+			uint32 maskIndex = (op == spv::OpLoad) ? 3 : 2;
+			return std::count_if(instructions.begin(), instructions.end(),
+			                     [&](const SPIRV_INSTRUCTION& instruction) {
+				                     return (instruction.op == op) && (instruction.operands.size() == maskIndex + 2) &&
+				                            (instruction.operands[maskIndex] == spv::MemoryAccessAlignedMask) &&
+				                            (instruction.operands[maskIndex + 1] == alignment);
+			                     });
+		};
+		assert(hasInstruction(spv::OpCapability, 0, spv::CapabilityPhysicalStorageBufferAddressesEXT));
+		assert(hasInstruction(spv::OpMemoryModel, 0, spv::AddressingModelPhysicalStorageBuffer64EXT));
+		assert(hasInstruction(spv::OpTypePointer, 1, spv::StorageClassPhysicalStorageBufferEXT));
+		assert(countAlignedAccesses(spv::OpLoad, 4) == 1);
+		assert(countAlignedAccesses(spv::OpStore, 4) == 1);
+		assert(countAlignedAccesses(spv::OpLoad, 16) == 1);
+		assert(countAlignedAccesses(spv::OpStore, 16) == 1);
+		assert(std::any_of(instructions.begin(), instructions.end(),
+		                   [](const SPIRV_INSTRUCTION& instruction) { return instruction.op == spv::OpAtomicIAdd; }));
+	}
+
+	{
+		auto shaderCode = CGlslShaderGenerator::Generate(b, CGlslShaderGenerator::SHADER_TYPE_COMPUTE, 450);
+		assert(shaderCode.find("#extension GL_EXT_buffer_reference : require") != std::string::npos);
+		assert(shaderCode.find("layout(push_constant, std430) uniform pushConstants\r\n{\r\n\tvec4 scale;\r\n\tBufferPointerUint counters;\r\n\tBufferPointerFloat4 vectors;\r\n};") != std::string::npos);
+		assert(shaderCode.find("counters.data[") != std::string::npos);
+		assert(shaderCode.find("vectors.data[") != std::string::npos);
+	}
+}
@@ -0,0 +1,45 @@
+#include "ControlFlowTest.h"
+#include "nuanceur/Builder.h"
+
+void CControlFlowTest::Run()
+{
+	using namespace Nuanceur;
+
+	auto b = CShaderBuilder();
+
+	{
+		auto outputColor = CFloat4Lvalue(b.CreateOutput(Nuanceur::SEMANTIC_SYSTEM_COLOR));
+		auto tempValue = CFloat4Lvalue(b.CreateTemporary());
+
+		tempValue = NewFloat4(b, 0, 0, 0, 1);
+		BeginIf(b, NewInt(b, 1) == NewInt(b, 2));
+		{
+			tempValue = NewFloat4(b, 1, 0, 0, 1);
+		}
+		Else(b);
+		{
+			tempValue = NewFloat4(b, 0, 1, 0, 1);
+		}
+		EndIf(b);
+
+		BeginSwitch(b, NewInt(b, 1) + NewInt(b, 1));
+		Case(b, 0);
+		{
+			tempValue = NewFloat4(b, 0, 0, 0, 0);
+		}
+		Case(b, 1);
+		Case(b, 2);
+		{
+			tempValue = tempValue + NewFloat4(b, 0, 0, 1, 0);
+		}
+		Default(b);
+		{
+			tempValue = NewFloat4(b, 1, 1, 1, 1);
+		}
+		EndSwitch(b);
+
+		outputColor = tempValue->xyzw();
+	}
+
+	Submit(b, CVector4(0, 1, 1, 1));
+}
@@ -0,0 +1,21 @@
+#include "DepthTest.h"
+#include "nuanceur/Builder.h"
+
+void CDepthTest::Run()
+{
+	using namespace Nuanceur;
+
+	auto b = CShaderBuilder();
+	b.SetMetadata(CShaderBuilder::METADATA_DEPTH_MODE, DEPTH_MODE_GREATER);
+
+	{
+		auto inputPosition = CFloat4Lvalue(b.CreateInput(Nuanceur::SEMANTIC_SYSTEM_POSITION));
+		auto outputColor = CFloat4Lvalue(b.CreateOutput(Nuanceur::SEMANTIC_SYSTEM_COLOR));
+		auto outputDepth = CFloatLvalue(b.CreateOutput(Nuanceur::SEMANTIC_SYSTEM_DEPTH), SWIZZLE_X);
+
+		outputDepth = (inputPosition->z() * NewFloat(b, 0.5f)) + NewFloat(b, 0.5f);
+		outputColor = NewFloat4(b, 0.25f, 0.5f, 0.75f, 1.0f);
+	}
+
+	Submit(b, CVector4(0.25f, 0.5f, 0.75f, 1.0f));
+}
@@ -0,0 +1,60 @@
+#include "DescriptorArrayTest.h"
+#include <algorithm>
+#include "nuanceur/Builder.h"
+#include "nuanceur/generators/HlslShaderGenerator.h"
+
+void CDescriptorArrayTest::Run()
+{
+	using namespace Nuanceur;
+
+	auto b = CShaderBuilder();
+
+	{
+		auto inputPosition = CFloat4Lvalue(b.CreateInput(Nuanceur::SEMANTIC_SYSTEM_POSITION));
+		auto outputColor = CFloat4Lvalue(b.CreateOutput(Nuanceur::SEMANTIC_SYSTEM_COLOR));
+		auto materials = CTexture2DDescriptorArrayValue(b.CreateTexture2DDescriptorArray(0, 4));
+		auto decals = CTexture2DDescriptorArrayValue(b.CreateTexture2DDescriptorArray(1, 0));
+		auto coord = CFloat2Lvalue(b.CreateTemporary());
+		auto decalIndex = CIntLvalue(b.CreateTemporaryInt());
+
+		coord = inputPosition->xy() * NewFloat2(b, 1.0f / 250.0f, 1.0f / 250.0f);
+		//Same index for all invocations for the first array, one per pixel for the second one
+		decalIndex = ToInt(inputPosition->x());
+		outputColor = Sample(Element(materials, NewInt(b, 2)), coord) +
+		              Sample(NonUniformElement(decals, decalIndex), coord);
+	}
+
+	//The test runner can't bind textures, so only the generated code is checked
+	{
+		auto instructions = GetSpirvInstructions(b);
+		auto hasOp = [&](uint32 op) {
+			return std::any_of(instructions.begin(), instructions.end(),
+			                   [&](const SPIRV_INSTRUCTION& instruction) { return instruction.op == op; });
+		};
+		auto hasCapability = [&](uint32 capability) {
+			return std::any_of(instructions.begin(), instructions.end(),
+			                   [&](const SPIRV_INSTRUCTION& instruction) {
+				                   return (instruction.op == spv::OpCapability) && (instruction.operands[0] == capability);
+			                   });
+		};
+		auto nonUniformCount = std::count_if(instructions.begin(), instructions.end(),
+		                                     [&](const SPIRV_INSTRUCTION& instruction) {
+			                                     return (instruction.op == spv::OpDecorate) && (instruction.operands[1] == spv::DecorationNonUniformEXT);
+		                                     });
+		assert(hasOp(spv::OpTypeArray));
+		assert(hasOp(spv::OpTypeRuntimeArray));
+		assert(hasCapability(spv::CapabilitySampledImageArrayDynamicIndexing));
+		assert(hasCapability(spv::CapabilityRuntimeDescriptorArrayEXT));
+		assert(hasCapability(spv::CapabilityShaderNonUniformEXT));
+		assert(hasCapability(spv::CapabilitySampledImageArrayNonUniformIndexingEXT));
+		//Both the element pointer and the loaded image are decorated
+		assert(nonUniformCount == 2);
+	}
+
+	{
+		auto shaderCode = CHlslShaderGenerator::Generate("main", b);
+		assert(shaderCode.find("Texture2D c_texture0[4] : register(t0);") != std::string::npos);
+		assert(shaderCode.find("Texture2D c_texture1[] : register(t1);") != std::string::npos);
+		assert(shaderCode.find("c_texture1[NonUniformResourceIndex(") != std::string::npos);
+	}
+}
@@ -0,0 +1,134 @@
+#include "DescriptorSetTest.h"
+#include <algorithm>
+#include "nuanceur/Builder.h"
+#include "nuanceur/generators/GlslShaderGenerator.h"
+#include "nuanceur/generators/HlslShaderGenerator.h"
+
+void CDescriptorSetTest::Run()
+{
+	RunSeparateUnits();
+	RunSharedUnitBuffers();
+	RunSharedUnitTextures();
+}
+
+void CDescriptorSetTest::RunSeparateUnits()
+{
+	using namespace Nuanceur;
+
+	auto b = CShaderBuilder();
+	b.SetMetadata(CShaderBuilder::METADATA_LOCALSIZE_X, 4);
+
+	{
+		auto localIndex = CIntLvalue(b.CreateInputInt(Nuanceur::SEMANTIC_SYSTEM_LIINDEX));
+		auto result = CArrayUintValue(b.CreateUniformArrayUint("result", 0));
+		auto source = CArrayUintValue(b.CreateUniformArrayUint("source", 1, 0, 1));
+
+		Store(result, localIndex, Load(source, localIndex) * NewUint(b, 2));
+	}
+
+	{
+		auto instructions = GetSpirvInstructions(b, CSpirvShaderGenerator::SHADER_TYPE_COMPUTE);
+		auto hasDecoration = [&](uint32 decoration, uint32 value) {
+			return std::any_of(instructions.begin(), instructions.end(),
+			                   [&](const SPIRV_INSTRUCTION& instruction) {
+				                   return (instruction.op == spv::OpDecorate) && (instruction.operands.size() == 3) &&
+				                          (instruction.operands[1] == decoration) && (instruction.operands[2] == value);
+			                   });
+		};
+		assert(hasDecoration(spv::DecorationDescriptorSet, 0));
+		assert(hasDecoration(spv::DecorationDescriptorSet, 1));
+		assert(hasDecoration(spv::DecorationBinding, 1));
+	}
+
+	SUBMIT_PARAMS params;
+	params.setup =
+	    "ssbo 0 16\r\n"
+	    "ssbo 1:1 subdata uint 0 1 2 3 4\r\n";
+	params.checks = "probe ssbo uint 0 0 == 2 4 6 8\r\n";
+	SubmitCompute(b, 1, params);
+}
+
+void CDescriptorSetTest::RunSharedUnitBuffers()
+{
+	using namespace Nuanceur;
+
+	auto b = CShaderBuilder();
+	b.SetMetadata(CShaderBuilder::METADATA_LOCALSIZE_X, 4);
+
+	{
+		auto localIndex = CIntLvalue(b.CreateInputInt(Nuanceur::SEMANTIC_SYSTEM_LIINDEX));
+		auto result = CArrayUintValue(b.CreateUniformArrayUint("result", 0));
+		auto source = CArrayUintValue(b.CreateUniformArrayUint("source", 0, 0, 1));
+
+		Store(result, localIndex, Load(source, localIndex) + NewUint(b, 1));
+	}
+
+	{
+		//Each set gets its own block, both bound to the same unit
+		auto instructions = GetSpirvInstructions(b, CSpirvShaderGenerator::SHADER_TYPE_COMPUTE);
+		auto bindingCount = std::count_if(instructions.begin(), instructions.end(),
+		                                  [&](const SPIRV_INSTRUCTION& instruction) {
+			                                  return (instruction.op == spv::OpDecorate) && (instruction.operands[1] == spv::DecorationBinding);
+		                                  });
+		auto blockCount = std::count_if(instructions.begin(), instructions.end(),
+		                                [&](const SPIRV_INSTRUCTION& instruction) {
+			                                return (instruction.op == spv::OpDecorate) && (instruction.operands[1] == spv::DecorationBufferBlock);
+		                                });
+		assert(bindingCount == 2);
+		assert(blockCount == 2);
+	}
+
+	{
+		auto shaderCode = CGlslShaderGenerator::Generate(b, CGlslShaderGenerator::SHADER_TYPE_COMPUTE, 450);
+		assert(shaderCode.find("layout(std430, binding = 0) buffer uniforms_0\r\n") != std::string::npos);
+		assert(shaderCode.find("layout(std430, set = 1, binding = 0) buffer uniforms_1_0\r\n") != std::string::npos);
+	}
+
+	SUBMIT_PARAMS params;
+	params.setup =
+	    "ssbo 0 16\r\n"
+	    "ssbo 1:0 subdata uint 0 1 2 3 4\r\n";
+	params.checks = "probe ssbo uint 0 0 == 2 3 4 5\r\n";
+	SubmitCompute(b, 1, params);
+}
+
+void CDescriptorSetTest::RunSharedUnitTextures()
+{
+	using namespace Nuanceur;
+
+	auto b = CShaderBuilder();
+
+	{
+		auto inputPosition = CFloat4Lvalue(b.CreateInput(Nuanceur::SEMANTIC_SYSTEM_POSITION));
+		auto outputColor = CFloat4Lvalue(b.CreateOutput(Nuanceur::SEMANTIC_SYSTEM_COLOR));
+		auto albedo = CTexture2DValue(b.CreateTexture2D(0));
+		auto lightMap = CTexture2DValue(b.CreateTexture2D(0, 1));
+		auto coord = CFloat2Lvalue(b.CreateTemporary());
+
+		coord = inputPosition->xy() * NewFloat2(b, 1.0f / 250.0f, 1.0f / 250.0f);
+		outputColor = Sample(albedo, coord) * Sample(lightMap, coord);
+	}
+
+	//The test runner can't bind textures, so only the generated code is checked
+	{
+		auto instructions = GetSpirvInstructions(b);
+		auto bindingCount = std::count_if(instructions.begin(), instructions.end(),
+		                                  [&](const SPIRV_INSTRUCTION& instruction) {
+			                                  return (instruction.op == spv::OpDecorate) && (instruction.operands[1] == spv::DecorationBinding);
+		                                  });
+		assert(bindingCount == 2);
+	}
+
+	{
+		auto shaderCode = CGlslShaderGenerator::Generate(b, CGlslShaderGenerator::SHADER_TYPE_FRAGMENT, 450);
+		assert(shaderCode.find("uniform sampler2D c_sampler0;") != std::string::npos);
+		assert(shaderCode.find("layout(set = 1, binding = 0) uniform sampler2D c_sampler1_0;") != std::string::npos);
+	}
+
+	{
+		auto shaderCode = CHlslShaderGenerator::Generate("main", b);
+		assert(shaderCode.find("Texture2D c_texture0 : register(t0);") != std::string::npos);
+		assert(shaderCode.find("Texture2D c_texture1_0 : register(t0, space1);") != std::string::npos);
+		assert(shaderCode.find("c_texture1_0.Sample(c_sampler1_0, ") != std::string::npos);
+	}
+}
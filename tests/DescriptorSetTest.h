@@ -0,0 +1,14 @@
+#pragma once
+
+#include "Test.h"
+
+class CDescriptorSetTest : public CTest
+{
+public:
+	void Run() override;
+
+private:
+	void RunSeparateUnits();
+	void RunSharedUnitBuffers();
+	void RunSharedUnitTextures();
+};
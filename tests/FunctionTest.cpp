@@ -0,0 +1,98 @@
+#include "FunctionTest.h"
+#include "nuanceur/Builder.h"
+#include "nuanceur/passes/FunctionInliningPass.h"
+
+void CFunctionTest::Run()
+{
+	RunInlining();
+	RunInlinedCallInLoop();
+}
+
+void CFunctionTest::RunInlining()
+{
+	using namespace Nuanceur;
+
+	auto b = CShaderBuilder();
+
+	{
+		auto scaleFunction = BeginFunction(b, CShaderBuilder::SYMBOL_TYPE_FLOAT4);
+		{
+			auto value = CFloat4Lvalue(b.CreateParameter(CShaderBuilder::SYMBOL_TYPE_FLOAT4));
+			auto factor = CFloat4Lvalue(b.CreateParameter(CShaderBuilder::SYMBOL_TYPE_FLOAT4));
+			Return(b, value * factor);
+		}
+		EndFunction(b);
+
+		auto limitFunction = BeginFunction(b, CShaderBuilder::SYMBOL_TYPE_FLOAT4);
+		{
+			auto value = CFloat4Lvalue(b.CreateParameter(CShaderBuilder::SYMBOL_TYPE_FLOAT4));
+			auto valueX = CFloatLvalue(value.symbol, SWIZZLE_X);
+			BeginIf(b, NewFloat(b, 0.5f) < valueX);
+			{
+				Return(b, NewFloat4(b, 0.5f, 0.25f, 0.25f, 0));
+			}
+			EndIf(b);
+			Return(b, value);
+		}
+		EndFunction(b);
+
+		auto outputColor = CFloat4Lvalue(b.CreateOutput(Nuanceur::SEMANTIC_SYSTEM_COLOR));
+		auto color = CFloat4Lvalue(b.CreateTemporary());
+		auto limitedColor = CFloat4Lvalue(b.CreateTemporary());
+
+		color = CFloat4Lvalue(Call(b, scaleFunction, NewFloat4(b, 0.5f, 1, 0, 1), NewFloat4(b, 0.5f, 0.5f, 1, 1)))->xyzw();
+		color = CFloat4Lvalue(Call(b, limitFunction, color))->xyzw();
+		limitedColor = CFloat4Lvalue(Call(b, limitFunction, NewFloat4(b, 1, 0, 0, 1)))->xyzw();
+		outputColor = color + limitedColor;
+	}
+
+	//Scale is only called once and gets inlined, limit returns early and is kept
+	CFunctionInliningPass::Run(b);
+
+	assert(b.GetFunctions().size() == 1);
+	for(const auto& statement : b.GetStatements())
+	{
+		assert((statement.op != CShaderBuilder::STATEMENT_OP_CALL) || (statement.param == 0));
+	}
+
+	Submit(b, CVector4(0.75f, 0.75f, 0.25f, 1));
+}
+
+void CFunctionTest::RunInlinedCallInLoop()
+{
+	using namespace Nuanceur;
+
+	auto b = CShaderBuilder();
+
+	{
+		auto accumulateFunction = BeginFunction(b, CShaderBuilder::SYMBOL_TYPE_FLOAT4);
+		{
+			auto value = CFloat4Lvalue(b.CreateParameter(CShaderBuilder::SYMBOL_TYPE_FLOAT4));
+			auto total = CFloat4Lvalue(b.CreateTemporary());
+			auto totalX = CFloatLvalue(total.symbol, SWIZZLE_X);
+			//Total starts at 0 in every call
+			totalX = totalX + value->x();
+			Return(b, total);
+		}
+		EndFunction(b);
+
+		auto outputColor = CFloat4Lvalue(b.CreateOutput(Nuanceur::SEMANTIC_SYSTEM_COLOR));
+		auto color = CFloat4Lvalue(b.CreateTemporary());
+		auto colorX = CFloatLvalue(color.symbol, SWIZZLE_X);
+		auto index = CIntLvalue(b.CreateTemporaryInt());
+
+		color = NewFloat4(b, 0, 0, 0, 1);
+		BeginLoop(b, index, NewInt(b, 3), LOOP_CONTROL_DONT_UNROLL);
+		{
+			colorX = colorX + CFloat4Lvalue(Call(b, accumulateFunction, NewFloat4(b, 0.25f, 0, 0, 0)))->x();
+		}
+		EndLoop(b);
+		outputColor = color->xyzw();
+	}
+
+	CFunctionInliningPass::Run(b);
+
+	assert(b.GetFunctions().empty());
+
+	Submit(b, CVector4(0.75f, 0, 0, 1));
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "Test.h"
+
+class CFunctionTest : public CTest
+{
+public:
+	void Run() override;
+
+private:
+	void RunInlining();
+	void RunInlinedCallInLoop();
+};
@@ -0,0 +1,59 @@
+#include "HalfTest.h"
+#include <algorithm>
+#include "nuanceur/Builder.h"
+
+void CHalfTest::Run()
+{
+	auto b = Nuanceur::CShaderBuilder();
+	BuildShader(b);
+	RunRelaxed(b);
+	RunNative(b);
+}
+
+void CHalfTest::BuildShader(Nuanceur::CShaderBuilder& b)
+{
+	using namespace Nuanceur;
+
+	{
+		auto outputColor = CFloat4Lvalue(b.CreateOutput(Nuanceur::SEMANTIC_SYSTEM_COLOR));
+		auto color = CHalf4Lvalue(b.CreateTemporaryHalf());
+		auto tint = CHalf2Lvalue(b.CreateTemporaryHalf());
+
+		color = ToHalf(NewFloat4(b, 1.0f, 0.5f, 0.25f, 1.0f)) * NewHalf4(b, 0.5f, 0.5f, 0.5f, 1.0f);
+		tint = NewHalf2(b, 0.25f, 0.0f) + NewHalf2(b, 0.0f, 0.25f);
+		color = Mix(color, NewHalf4(tint, tint), NewHalf4(b, 0.5f, 0.0f, 0.0f, 0.0f));
+
+		outputColor = ToFloat(Clamp(color, NewHalf4(b, 0, 0, 0, 0), NewHalf4(b, 1, 1, 1, 1)));
+	}
+}
+
+void CHalfTest::RunRelaxed(const Nuanceur::CShaderBuilder& b)
+{
+	//Half symbols are relaxed 32-bit floats, no 16-bit type is declared
+	auto instructions = GetSpirvInstructions(b);
+	assert(std::none_of(instructions.begin(), instructions.end(),
+	                    [](const SPIRV_INSTRUCTION& instruction) {
+		                    return (instruction.op == spv::OpCapability) && (instruction.operands[0] == spv::CapabilityFloat16);
+	                    }));
+
+	Submit(b, CVector4(0.375f, 0.25f, 0.125f, 1.0f));
+}
+
+void CHalfTest::RunNative(const Nuanceur::CShaderBuilder& b)
+{
+	auto instructions = GetSpirvInstructions(b, Nuanceur::CSpirvShaderGenerator::SHADER_TYPE_FRAGMENT, Nuanceur::CSpirvShaderGenerator::FLAG_NATIVE_FLOAT16);
+	assert(std::any_of(instructions.begin(), instructions.end(),
+	                   [](const SPIRV_INSTRUCTION& instruction) {
+		                   return (instruction.op == spv::OpCapability) && (instruction.operands[0] == spv::CapabilityFloat16);
+	                   }));
+	//Operands are the result id and the width
+	assert(std::any_of(instructions.begin(), instructions.end(),
+	                   [](const SPIRV_INSTRUCTION& instruction) {
+		                   return (instruction.op == spv::OpTypeFloat) && (instruction.operands[1] == 16);
+	                   }));
+
+	SUBMIT_PARAMS params;
+	params.requirements = "shaderFloat16\r\n";
+	params.generatorFlags = Nuanceur::CSpirvShaderGenerator::FLAG_NATIVE_FLOAT16;
+	Submit(b, CVector4(0.375f, 0.25f, 0.125f, 1.0f), params);
+}
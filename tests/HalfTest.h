@@ -0,0 +1,14 @@
+#pragma once
+
+#include "Test.h"
+
+class CHalfTest : public CTest
+{
+public:
+	void Run() override;
+
+private:
+	void BuildShader(Nuanceur::CShaderBuilder&);
+	void RunRelaxed(const Nuanceur::CShaderBuilder&);
+	void RunNative(const Nuanceur::CShaderBuilder&);
+};
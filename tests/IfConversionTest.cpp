@@ -0,0 +1,91 @@
+#include "IfConversionTest.h"
+#include <algorithm>
+#include "nuanceur/Builder.h"
+#include "nuanceur/generators/HlslShaderGenerator.h"
+#include "nuanceur/passes/IfConversionPass.h"
+
+void CIfConversionTest::Run()
+{
+	RunConstantCondition();
+	RunVaryingCondition();
+}
+
+void CIfConversionTest::RunConstantCondition()
+{
+	using namespace Nuanceur;
+
+	auto b = CShaderBuilder();
+
+	{
+		auto outputColor = CFloat4Lvalue(b.CreateOutput(Nuanceur::SEMANTIC_SYSTEM_COLOR));
+		auto tempValue = CFloat4Lvalue(b.CreateTemporary());
+		auto tempValueX = CFloatLvalue(tempValue.symbol, SWIZZLE_X);
+
+		tempValue = NewFloat4(b, 0, 0, 0, 1);
+		BeginIf(b, NewInt(b, 2) == NewInt(b, 2));
+		{
+			tempValueX = NewFloat(b, 0.25f) * NewFloat(b, 2);
+		}
+		EndIf(b);
+		BeginIf(b, NewInt(b, 1) == NewInt(b, 2));
+		{
+			tempValueX = NewFloat(b, 1);
+		}
+		EndIf(b);
+		outputColor = NewFloat4(tempValue->xxx(), tempValue->w());
+	}
+
+	CIfConversionPass::Run(b);
+
+	for(const auto& statement : b.GetStatements())
+	{
+		assert(statement.op != CShaderBuilder::STATEMENT_OP_IF_BEGIN);
+	}
+
+	Submit(b, CVector4(0.5f, 0.5f, 0.5f, 1));
+}
+
+void CIfConversionTest::RunVaryingCondition()
+{
+	using namespace Nuanceur;
+
+	auto b = CShaderBuilder();
+
+	{
+		auto inputPosition = CFloat4Lvalue(b.CreateInput(Nuanceur::SEMANTIC_SYSTEM_POSITION));
+		auto outputColor = CFloat4Lvalue(b.CreateOutput(Nuanceur::SEMANTIC_SYSTEM_COLOR));
+		auto tempValue = CFloat4Lvalue(b.CreateTemporary());
+
+		//Fragment coordinates are always positive, but the condition can't be folded
+		tempValue = NewFloat4(b, 0, 0, 0, 1);
+		BeginIf(b, NewFloat(b, -1) < inputPosition->x());
+		{
+			tempValue = NewFloat4(b, 0.5f, 0.5f, 0.5f, 1);
+		}
+		EndIf(b);
+		outputColor = tempValue->xyzw();
+	}
+
+	CIfConversionPass::Run(b);
+
+	for(const auto& statement : b.GetStatements())
+	{
+		assert(statement.op != CShaderBuilder::STATEMENT_OP_IF_BEGIN);
+	}
+
+	{
+		auto instructions = GetSpirvInstructions(b);
+		assert(std::any_of(instructions.begin(), instructions.end(),
+		                   [](const SPIRV_INSTRUCTION& instruction) { return instruction.op == spv::OpSelect; }));
+	}
+
+	{
+		auto shaderCode = CHlslShaderGenerator::Generate("main", b);
+		assert(shaderCode.find(" ? ") != std::string::npos);
+		auto shaderCode2021 = CHlslShaderGenerator::Generate("main", b, CHlslShaderGenerator::FLAG_HLSL_2021);
+		assert(shaderCode2021.find(" = select(") != std::string::npos);
+		assert(shaderCode2021.find(" ? ") == std::string::npos);
+	}
+
+	Submit(b, CVector4(0.5f, 0.5f, 0.5f, 1));
+}
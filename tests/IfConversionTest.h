@@ -0,0 +1,13 @@
+#pragma once
+
+#include "Test.h"
+
+class CIfConversionTest : public CTest
+{
+public:
+	void Run() override;
+
+private:
+	void RunConstantCondition();
+	void RunVaryingCondition();
+};
@@ -0,0 +1,52 @@
+#include "ImageFormatTest.h"
+#include <algorithm>
+#include "nuanceur/Builder.h"
+
+void CImageFormatTest::Run()
+{
+	using namespace Nuanceur;
+
+	auto b = CShaderBuilder();
+
+	{
+		auto inputPosition = CFloat4Lvalue(b.CreateInput(Nuanceur::SEMANTIC_SYSTEM_POSITION));
+		auto outputColor = CFloat4Lvalue(b.CreateOutput(Nuanceur::SEMANTIC_SYSTEM_COLOR));
+		auto colorImage = CImage2DValue(b.CreateImage2D(0, IMAGE_FORMAT_RGBA8));
+		auto layerImage = CImage2DArrayValue(b.CreateImage2DArray(1, IMAGE_FORMAT_RGBA16F));
+		auto volumeImage = CImage3DValue(b.CreateImage3D(2, IMAGE_FORMAT_R32F));
+		auto maskImage = CImageUint2DValue(b.CreateImage2DUint(3, IMAGE_FORMAT_R16UI));
+		auto idImage = CImageUint3DValue(b.CreateImage3DUint(4, IMAGE_FORMAT_R8UI));
+		auto coord = CInt2Lvalue(b.CreateTemporaryInt());
+
+		coord = ToInt(inputPosition->xy());
+		Store(colorImage, coord, Load(layerImage, NewInt3(b, 0, 0, 1)));
+		Store(volumeImage, NewInt3(b, 1, 2, 3), Load(colorImage, coord));
+		Store(idImage, NewInt3(b, 0, 0, 0), Load(maskImage, coord));
+		outputColor = NewFloat4(b, 0.25f, 0.5f, 0.75f, 1.0f);
+	}
+
+	//The test runner can't bind storage images, so only the generated types are checked
+	auto instructions = GetSpirvInstructions(b);
+	auto hasImageType = [&](uint32 dim, uint32 arrayed, uint32 format) {
+		return std::any_of(instructions.begin(), instructions.end(),
+		                   [&](const SPIRV_INSTRUCTION& instruction) {
+			                   return (instruction.op == spv::OpTypeImage) &&
+			                          (instruction.operands[2] == dim) &&
+			                          (instruction.operands[4] == arrayed) &&
+			                          (instruction.operands[6] == 2) &&
+			                          (instruction.operands[7] == format);
+		                   });
+	};
+	auto hasCapability = [&](uint32 capability) {
+		return std::any_of(instructions.begin(), instructions.end(),
+		                   [&](const SPIRV_INSTRUCTION& instruction) {
+			                   return (instruction.op == spv::OpCapability) && (instruction.operands[0] == capability);
+		                   });
+	};
+	assert(hasImageType(spv::Dim2D, 0, spv::ImageFormatRgba8));
+	assert(hasImageType(spv::Dim2D, 1, spv::ImageFormatRgba16f));
+	assert(hasImageType(spv::Dim3D, 0, spv::ImageFormatR32f));
+	assert(hasImageType(spv::Dim2D, 0, spv::ImageFormatR16ui));
+	assert(hasImageType(spv::Dim3D, 0, spv::ImageFormatR8ui));
+	assert(hasCapability(spv::CapabilityStorageImageExtendedFormats));
+}
@@ -0,0 +1,51 @@
+#include "InterlockModeTest.h"
+#include <algorithm>
+#include "nuanceur/Builder.h"
+#include "nuanceur/generators/SpirvShaderGenerator.h"
+
+void CInterlockModeTest::Run()
+{
+	using namespace Nuanceur;
+
+	auto b = CShaderBuilder();
+	b.SetMetadata(CShaderBuilder::METADATA_INTERLOCK_MODE, INTERLOCK_MODE_SAMPLE_UNORDERED);
+
+	{
+		auto inputPosition = CFloat4Lvalue(b.CreateInput(Nuanceur::SEMANTIC_SYSTEM_POSITION));
+		auto outputColor = CFloat4Lvalue(b.CreateOutput(Nuanceur::SEMANTIC_SYSTEM_COLOR));
+		auto counters = CArrayUintValue(b.CreateUniformArrayUint("counters", 0));
+		auto index = CIntLvalue(b.CreateTemporaryInt());
+		auto count = CUintLvalue(b.CreateTemporaryUint());
+
+		//One counter per pixel of the 250x250 framebuffer
+		index = ToInt(inputPosition->y()) * NewInt(b, 250) + ToInt(inputPosition->x());
+
+		BeginInvocationInterlock(b);
+		{
+			count = Load(counters, index) + NewUint(b, 1);
+			Store(counters, index, count);
+		}
+		EndInvocationInterlock(b);
+
+		outputColor = NewFloat4(ToFloat(count) * NewFloat(b, 0.25f), NewFloat3(b, 0.5f, 0.75f, 1.0f));
+	}
+
+	{
+		auto instructions = GetSpirvInstructions(b);
+		auto hasInstruction = [&](uint32 op, uint32 operand) {
+			return std::any_of(instructions.begin(), instructions.end(),
+			                   [&](const SPIRV_INSTRUCTION& instruction) {
+				                   return (instruction.op == op) && (instruction.operands.back() == operand);
+			                   });
+		};
+		assert(hasInstruction(spv::OpExecutionMode, spv::ExecutionModeSampleInterlockUnorderedEXT));
+		assert(hasInstruction(spv::OpCapability, spv::CapabilityFragmentShaderSampleInterlockEXT));
+		assert(!hasInstruction(spv::OpCapability, spv::CapabilityFragmentShaderPixelInterlockEXT));
+	}
+
+	SUBMIT_PARAMS params;
+	params.requirements = "VK_EXT_fragment_shader_interlock\r\nfragmentShaderSampleInterlock\r\nfragmentStoresAndAtomics\r\n";
+	params.setup = "ssbo 0 250000\r\n";
+	params.checks = "probe ssbo uint 0 0 == 1 1 1 1\r\n";
+	Submit(b, CVector4(0.25f, 0.5f, 0.75f, 1.0f), params);
+}
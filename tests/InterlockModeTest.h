@@ -0,0 +1,9 @@
+#pragma once
+
+#include "Test.h"
+
+class CInterlockModeTest : public CTest
+{
+public:
+	void Run() override;
+};
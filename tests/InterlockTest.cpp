@@ -0,0 +1,92 @@
+#include "InterlockTest.h"
+#include <algorithm>
+#include "nuanceur/Builder.h"
+#include "nuanceur/passes/InterlockMinimizationPass.h"
+#include "nuanceur/generators/SpirvShaderGenerator.h"
+
+void CInterlockTest::Run()
+{
+	using namespace Nuanceur;
+
+	auto b = CShaderBuilder();
+
+	{
+		auto inputPosition = CFloat4Lvalue(b.CreateInput(Nuanceur::SEMANTIC_SYSTEM_POSITION));
+		auto outputColor = CFloat4Lvalue(b.CreateOutput(Nuanceur::SEMANTIC_SYSTEM_COLOR));
+		auto texture = CTexture2DValue(b.CreateTexture2D(0));
+		auto framebuffer = CImageUint2DValue(b.CreateImage2DUint(1));
+		auto coord = CInt2Lvalue(b.CreateTemporaryInt());
+		auto srcColor = CFloat4Lvalue(b.CreateTemporary());
+		auto dstColor = CUint4Lvalue(b.CreateTemporaryUint());
+
+		BeginInvocationInterlock(b);
+		{
+			coord = ToInt(inputPosition->xy());
+			srcColor = Sample(texture, inputPosition->xy() * NewFloat2(b, 1.0f / 64.0f, 1.0f / 64.0f));
+			dstColor = Load(framebuffer, coord);
+			Store(framebuffer, coord, dstColor & ToUint(srcColor * NewFloat4(b, 255, 255, 255, 255)));
+			outputColor = ToFloat(dstColor) * NewFloat4(b, 1.0f / 255.0f, 1.0f / 255.0f, 1.0f / 255.0f, 1.0f / 255.0f);
+		}
+		EndInvocationInterlock(b);
+	}
+
+	CInterlockMinimizationPass::Run(b);
+
+	//Only the load and the store (with the value they depend on) are left in the critical section
+	bool inSection = false;
+	bool sectionDone = false;
+	unsigned int sectionSize = 0;
+	for(const auto& statement : b.GetStatements())
+	{
+		switch(statement.op)
+		{
+		case CShaderBuilder::STATEMENT_OP_INVOCATION_INTERLOCK_BEGIN:
+			inSection = true;
+			break;
+		case CShaderBuilder::STATEMENT_OP_INVOCATION_INTERLOCK_END:
+			inSection = false;
+			sectionDone = true;
+			break;
+		case CShaderBuilder::STATEMENT_OP_SAMPLE:
+		case CShaderBuilder::STATEMENT_OP_TOINT:
+			assert(!inSection && !sectionDone);
+			break;
+		case CShaderBuilder::STATEMENT_OP_LOAD:
+		case CShaderBuilder::STATEMENT_OP_STORE:
+			assert(inSection);
+			break;
+		case CShaderBuilder::STATEMENT_OP_TOFLOAT:
+			assert(sectionDone);
+			break;
+		default:
+			break;
+		}
+		if(inSection) sectionSize++;
+	}
+	assert(sectionSize == 5);
+
+	//Generated code must keep the sampling outside and the image accesses inside of the critical section
+	{
+		auto instructions = GetSpirvInstructions(b);
+		auto findInstruction = [&](uint32 op) {
+			auto instructionIterator = std::find_if(instructions.begin(), instructions.end(),
+			                                        [op](const SPIRV_INSTRUCTION& instruction) { return instruction.op == op; });
+			return static_cast<size_t>(instructionIterator - instructions.begin());
+		};
+		auto beginIndex = findInstruction(spv::OpBeginInvocationInterlockEXT);
+		auto endIndex = findInstruction(spv::OpEndInvocationInterlockEXT);
+		auto sampleIndex = findInstruction(spv::OpImageSampleImplicitLod);
+		auto readIndex = findInstruction(spv::OpImageRead);
+		auto writeIndex = findInstruction(spv::OpImageWrite);
+		assert(endIndex != instructions.size());
+		assert(sampleIndex < beginIndex);
+		assert((beginIndex < readIndex) && (readIndex < writeIndex) && (writeIndex < endIndex));
+
+		auto executionModeIterator = std::find_if(instructions.begin(), instructions.end(),
+		                                          [](const SPIRV_INSTRUCTION& instruction) {
+			                                          return (instruction.op == spv::OpExecutionMode) &&
+			                                                 (instruction.operands[1] == spv::ExecutionModePixelInterlockOrderedEXT);
+		                                          });
+		assert(executionModeIterator != instructions.end());
+	}
+}
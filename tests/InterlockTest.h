@@ -0,0 +1,9 @@
+#pragma once
+
+#include "Test.h"
+
+class CInterlockTest : public CTest
+{
+public:
+	void Run() override;
+};
@@ -0,0 +1,57 @@
+#include "LoopTest.h"
+#include "nuanceur/Builder.h"
+#include "nuanceur/passes/LoopUnrollingPass.h"
+
+void CLoopTest::Run()
+{
+	using namespace Nuanceur;
+
+	auto b = CShaderBuilder();
+
+	{
+		auto outputColor = CFloat4Lvalue(b.CreateOutput(Nuanceur::SEMANTIC_SYSTEM_COLOR));
+		auto tempValue = CFloat4Lvalue(b.CreateTemporary());
+		auto tempValueX = CFloatLvalue(tempValue.symbol, SWIZZLE_X);
+		auto tempValueY = CFloatLvalue(tempValue.symbol, SWIZZLE_Y);
+		auto tempValueZ = CFloatLvalue(tempValue.symbol, SWIZZLE_Z);
+		auto index = CIntLvalue(b.CreateTemporaryInt());
+		auto indexVector = CInt4Lvalue(b.CreateTemporaryInt());
+		auto indexVectorX = CIntLvalue(indexVector.symbol);
+
+		tempValue = NewFloat4(b, 0, 0, 0, 1);
+		BeginLoop(b, index, NewInt(b, 4));
+		{
+			tempValueX = tempValueX + (ToFloat(index) * NewFloat(b, 0.125f));
+		}
+		EndLoop(b);
+		BeginLoop(b, index, NewInt(b, 8), LOOP_CONTROL_DONT_UNROLL);
+		{
+			BeginIf(b, index == NewInt(b, 2));
+			{
+				Break(b);
+			}
+			EndIf(b);
+			tempValueY = tempValueY + NewFloat(b, 0.25f);
+		}
+		EndLoop(b);
+		//Reads another component of the index symbol, can't be unrolled
+		indexVector = NewInt4(b, 0, 2, 0, 0);
+		BeginLoop(b, indexVectorX, NewInt(b, 4));
+		{
+			tempValueZ = tempValueZ + (ToFloat(indexVector->y()) * NewFloat(b, 0.0625f));
+		}
+		EndLoop(b);
+		outputColor = tempValue->xyzw();
+	}
+
+	CLoopUnrollingPass::Run(b);
+
+	unsigned int loopCount = 0;
+	for(const auto& statement : b.GetStatements())
+	{
+		if(statement.op == CShaderBuilder::STATEMENT_OP_LOOP_BEGIN) loopCount++;
+	}
+	assert(loopCount == 2);
+
+	Submit(b, CVector4(0.75f, 0.5f, 0.5f, 1));
+}
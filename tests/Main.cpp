@@ -1,18 +1,72 @@
 #include <functional>
+#include "AtomicTest.h"
 #include "BasicTest.h"
+#include "BufferArrayTest.h"
+#include "BufferPointerTest.h"
+#include "ControlFlowTest.h"
+#include "DepthTest.h"
+#include "DescriptorArrayTest.h"
+#include "DescriptorSetTest.h"
+#include "FunctionTest.h"
+#include "HalfTest.h"
+#include "IfConversionTest.h"
+#include "ImageFormatTest.h"
+#include "InterlockModeTest.h"
+#include "InterlockTest.h"
+#include "LoopTest.h"
+#include "PrecisionTest.h"
+#include "SelectionControlTest.h"
+#include "SharedArrayTest.h"
+#include "SmallIntLoadTest.h"
+#include "SubgroupTest.h"
 #include "Swizzle1Test.h"
 #include "Swizzle2Test.h"
 #include "SwizzleTempTest.h"
+#include "TexelBufferTest.h"
+#include "TextureOpTest.h"
+#include "UintArrayTest.h"
+#include "UniformArrayTest.h"
+#include "UniformBakingTest.h"
+#include "UniformLayoutTest.h"
+#include "UniformPackingTest.h"
+#include "VectorizationTest.h"
 
 typedef std::function<CTest*()> TestFactoryFunction;
 
 // clang-format off
 static const TestFactoryFunction s_factories[] =
 {
+	[]() { return new CAtomicTest(); },
 	[]() { return new CBasicTest(); },
+	[]() { return new CBufferArrayTest(); },
+	[]() { return new CBufferPointerTest(); },
+	[]() { return new CControlFlowTest(); },
+	[]() { return new CDepthTest(); },
+	[]() { return new CDescriptorArrayTest(); },
+	[]() { return new CDescriptorSetTest(); },
+	[]() { return new CFunctionTest(); },
+	[]() { return new CHalfTest(); },
+	[]() { return new CIfConversionTest(); },
+	[]() { return new CImageFormatTest(); },
+	[]() { return new CInterlockModeTest(); },
+	[]() { return new CInterlockTest(); },
+	[]() { return new CLoopTest(); },
+	[]() { return new CPrecisionTest(); },
+	[]() { return new CSelectionControlTest(); },
+	[]() { return new CSharedArrayTest(); },
+	[]() { return new CSmallIntLoadTest(); },
+	[]() { return new CSubgroupTest(); },
 	[]() { return new CSwizzle1Test(); },
 	[]() { return new CSwizzle2Test(); },
 	[]() { return new CSwizzleTempTest(); },
+	[]() { return new CTexelBufferTest(); },
+	[]() { return new CTextureOpTest(); },
+	[]() { return new CUintArrayTest(); },
+	[]() { return new CUniformArrayTest(); },
+	[]() { return new CUniformBakingTest(); },
+	[]() { return new CUniformLayoutTest(); },
+	[]() { return new CUniformPackingTest(); },
+	[]() { return new CVectorizationTest(); },
 };
 // clang-format on
 
@@ -0,0 +1,92 @@
+#include "PrecisionTest.h"
+#include "nuanceur/Builder.h"
+#include "nuanceur/passes/PrecisionLoweringPass.h"
+
+void CPrecisionTest::Run()
+{
+	RunColorOutput();
+	RunByteStore();
+}
+
+void CPrecisionTest::RunColorOutput()
+{
+	using namespace Nuanceur;
+
+	auto b = CShaderBuilder();
+
+	CShaderBuilder::SYMBOL outputSymbol;
+	CShaderBuilder::SYMBOL colorSymbol;
+	CShaderBuilder::SYMBOL scaleSymbol;
+	CShaderBuilder::SYMBOL tintSymbol;
+
+	{
+		auto outputColor = CFloat4Lvalue(b.CreateOutput(Nuanceur::SEMANTIC_SYSTEM_COLOR));
+		auto color = CFloat4Lvalue(b.CreateTemporary());
+		auto scale = CFloat4Lvalue(b.CreateTemporary());
+		auto threshold = CFloat4Lvalue(b.CreateTemporary());
+		auto tint = CFloat4Lvalue(b.CreateTemporary());
+
+		//Explicit precision is kept by the pass
+		b.SetPrecision(scale.symbol, PRECISION_HIGH);
+
+		scale = NewFloat4(b, 0.5f, 0.5f, 0.5f, 1.0f);
+		threshold = NewFloat4(b, 0.25f, 0.25f, 0.25f, 0.25f);
+		tint = NewFloat4(b, 0.25f, 0.25f, 0.25f, 0.0f);
+		color = NewFloat4(b, 1.0f, 0.5f, 0.0f, 1.0f) * scale;
+		BeginIf(b, CFloatLvalue(threshold.symbol, SWIZZLE_X) < CFloatLvalue(color.symbol, SWIZZLE_X));
+		{
+			outputColor = color + tint;
+		}
+		EndIf(b);
+
+		outputSymbol = outputColor.symbol;
+		colorSymbol = color.symbol;
+		scaleSymbol = scale.symbol;
+		tintSymbol = tint.symbol;
+	}
+
+	CPrecisionLoweringPass::Run(b);
+
+	//Tint only ends up in the output color, color is also used by a comparison
+	assert(b.GetPrecision(outputSymbol) == PRECISION_MEDIUM);
+	assert(b.GetPrecision(tintSymbol) == PRECISION_MEDIUM);
+	assert(b.GetPrecision(colorSymbol) == PRECISION_DEFAULT);
+	assert(b.GetPrecision(scaleSymbol) == PRECISION_HIGH);
+
+	Submit(b, CVector4(0.75f, 0.5f, 0.25f, 1.0f));
+}
+
+void CPrecisionTest::RunByteStore()
+{
+	using namespace Nuanceur;
+
+	auto b = CShaderBuilder();
+
+	CShaderBuilder::SYMBOL levelSymbol;
+	CShaderBuilder::SYMBOL maskedLevelSymbol;
+
+	{
+		auto outputColor = CFloat4Lvalue(b.CreateOutput(Nuanceur::SEMANTIC_SYSTEM_COLOR));
+		auto bytes = CArrayUcharValue(b.CreateUniformArrayUchar("bytes", 0));
+		auto level = CFloat4Lvalue(b.CreateTemporary());
+		auto maskedLevel = CFloat4Lvalue(b.CreateTemporary());
+		auto levelX = CFloatLvalue(level.symbol, SWIZZLE_X);
+		auto maskedLevelX = CFloatLvalue(maskedLevel.symbol, SWIZZLE_X);
+
+		level = NewFloat4(b, 0.5f, 0, 0, 0) * NewFloat4(b, 255, 0, 0, 0);
+		maskedLevel = NewFloat4(b, 0.25f, 0, 0, 0) * NewFloat4(b, 255, 0, 0, 0);
+		Store(bytes, NewInt(b, 0), ToUchar(ToUint(levelX)));
+		//Converted value feeds an AND instead of the byte conversion, it keeps its precision
+		Store(bytes, NewInt(b, 1), ToUchar(ToUint(maskedLevelX) & NewUint(b, 0xFF)));
+
+		outputColor = NewFloat4(b, 1, 1, 1, 1);
+
+		levelSymbol = level.symbol;
+		maskedLevelSymbol = maskedLevel.symbol;
+	}
+
+	CPrecisionLoweringPass::Run(b);
+
+	assert(b.GetPrecision(levelSymbol) == PRECISION_MEDIUM);
+	assert(b.GetPrecision(maskedLevelSymbol) == PRECISION_DEFAULT);
+}
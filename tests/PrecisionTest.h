@@ -0,0 +1,13 @@
+#pragma once
+
+#include "Test.h"
+
+class CPrecisionTest : public CTest
+{
+public:
+	void Run() override;
+
+private:
+	void RunColorOutput();
+	void RunByteStore();
+};
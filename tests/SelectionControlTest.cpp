@@ -0,0 +1,57 @@
+#include "SelectionControlTest.h"
+#include "nuanceur/Builder.h"
+#include "nuanceur/generators/SpirvShaderGenerator.h"
+
+void CSelectionControlTest::Run()
+{
+	using namespace Nuanceur;
+
+	auto b = CShaderBuilder();
+
+	{
+		auto outputColor = CFloat4Lvalue(b.CreateOutput(Nuanceur::SEMANTIC_SYSTEM_COLOR));
+		auto tempValue = CFloat4Lvalue(b.CreateTemporary());
+
+		tempValue = NewFloat4(b, 0, 0, 0, 1);
+		BeginIf(b, NewInt(b, 1) == NewInt(b, 1), SELECTION_CONTROL_FLATTEN);
+		{
+			tempValue = tempValue + NewFloat4(b, 0.25f, 0, 0, 0);
+		}
+		EndIf(b);
+		BeginIf(b, NewInt(b, 1) == NewInt(b, 2), SELECTION_CONTROL_DONT_FLATTEN);
+		{
+			tempValue = NewFloat4(b, 1, 1, 1, 1);
+		}
+		Else(b);
+		{
+			tempValue = tempValue + NewFloat4(b, 0, 0.5f, 0, 0);
+		}
+		EndIf(b);
+		BeginSwitch(b, NewInt(b, 2), SELECTION_CONTROL_FLATTEN);
+		Case(b, 2);
+		{
+			tempValue = tempValue + NewFloat4(b, 0, 0, 0.75f, 0);
+		}
+		Default(b);
+		{
+			tempValue = NewFloat4(b, 0, 0, 0, 0);
+		}
+		EndSwitch(b);
+
+		outputColor = tempValue->xyzw();
+	}
+
+	//Hints must end up on the merge instructions, in order
+	std::vector<uint32> selectionControls;
+	for(const auto& instruction : GetSpirvInstructions(b))
+	{
+		if(instruction.op != spv::OpSelectionMerge) continue;
+		selectionControls.push_back(instruction.operands[1]);
+	}
+	assert(selectionControls.size() == 3);
+	assert(selectionControls[0] == spv::SelectionControlFlattenMask);
+	assert(selectionControls[1] == spv::SelectionControlDontFlattenMask);
+	assert(selectionControls[2] == spv::SelectionControlFlattenMask);
+
+	Submit(b, CVector4(0.25f, 0.5f, 0.75f, 1.0f));
+}
@@ -0,0 +1,43 @@
+#include "SharedArrayTest.h"
+#include "nuanceur/Builder.h"
+
+void CSharedArrayTest::Run()
+{
+	using namespace Nuanceur;
+
+	static constexpr uint32 invocationCount = 4;
+
+	auto b = CShaderBuilder();
+	b.SetMetadata(CShaderBuilder::METADATA_LOCALSIZE_X, invocationCount);
+
+	{
+		auto localIndex = CIntLvalue(b.CreateInputInt(Nuanceur::SEMANTIC_SYSTEM_LIINDEX));
+		auto result = CArrayUintValue(b.CreateUniformArrayUint("result", 0));
+		auto shared32 = CArrayUintValue(b.CreateSharedArrayUint(invocationCount));
+		auto shared16 = CArrayUshortValue(b.CreateSharedArrayUshort(invocationCount));
+		auto shared8 = CArrayUcharValue(b.CreateSharedArrayUchar(invocationCount));
+		auto value = CUintLvalue(b.CreateTemporaryUint());
+		auto otherIndex = CIntLvalue(b.CreateTemporaryInt());
+
+		value = ToUint(localIndex) + NewUint(b, 1);
+		Store(shared32, localIndex, value * NewUint(b, 100000));
+		Store(shared16, localIndex, ToUshort(value * NewUint(b, 1000)));
+		Store(shared8, localIndex, ToUchar(value));
+
+		WorkgroupBarrier(b);
+
+		//Read back what the mirrored invocation wrote
+		otherIndex = NewInt(b, invocationCount - 1) - localIndex;
+		Store(result, localIndex, Load(shared32, otherIndex) + Load(shared16, otherIndex) + Load(shared8, otherIndex));
+	}
+
+	SUBMIT_PARAMS params;
+	//Small integer types also declare the buffer storage capabilities
+	params.requirements =
+	    "shaderInt8\r\nshaderInt16\r\n"
+	    "storageBuffer8BitAccess\r\nuniformAndStorageBuffer8BitAccess\r\n"
+	    "storageBuffer16BitAccess\r\nuniformAndStorageBuffer16BitAccess\r\n";
+	params.setup = "ssbo 0 16\r\n";
+	params.checks = "probe ssbo uint 0 0 == 404004 303003 202002 101001\r\n";
+	SubmitCompute(b, 1, params);
+}
@@ -0,0 +1,32 @@
+#include "SmallIntLoadTest.h"
+#include "nuanceur/Builder.h"
+
+void CSmallIntLoadTest::Run()
+{
+	using namespace Nuanceur;
+
+	auto b = CShaderBuilder();
+	b.SetMetadata(CShaderBuilder::METADATA_LOCALSIZE_X, 4);
+
+	{
+		auto localIndex = CIntLvalue(b.CreateInputInt(Nuanceur::SEMANTIC_SYSTEM_LIINDEX));
+		auto source8 = CArrayUcharValue(b.CreateUniformArrayUchar("source8", 0));
+		auto source16 = CArrayUshortValue(b.CreateUniformArrayUshort("source16", 1));
+		auto result = CArrayUintValue(b.CreateUniformArrayUint("result", 2));
+
+		//Loaded values are zero extended
+		Store(result, localIndex, Load(source8, localIndex) + Load(source16, localIndex));
+	}
+
+	SUBMIT_PARAMS params;
+	params.requirements =
+	    "shaderInt8\r\nshaderInt16\r\n"
+	    "storageBuffer8BitAccess\r\nuniformAndStorageBuffer8BitAccess\r\n"
+	    "storageBuffer16BitAccess\r\nuniformAndStorageBuffer16BitAccess\r\n";
+	params.setup =
+	    "ssbo 0 subdata uint8_t 0 1 2 3 250\r\n"
+	    "ssbo 1 subdata uint16_t 0 1000 2000 3000 65000\r\n"
+	    "ssbo 2 16\r\n";
+	params.checks = "probe ssbo uint 2 0 == 1001 2002 3003 65250\r\n";
+	SubmitCompute(b, 1, params);
+}
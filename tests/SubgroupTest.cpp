@@ -0,0 +1,23 @@
+#include "SubgroupTest.h"
+#include "nuanceur/Builder.h"
+
+void CSubgroupTest::Run()
+{
+	using namespace Nuanceur;
+
+	auto b = CShaderBuilder();
+
+	{
+		auto outputColor = CFloat4Lvalue(b.CreateOutput(Nuanceur::SEMANTIC_SYSTEM_COLOR));
+
+		//All invocations use the same values, reductions must give them back
+		auto mask = SubgroupAnd(NewUint(b, 3)) & SubgroupOr(NewUint(b, 1));
+		outputColor = NewFloat4(
+		    SubgroupMax(NewFloat(b, 0.25f)),
+		    SubgroupMin(NewFloat(b, 0.5f)),
+		    ToFloat(mask) * NewFloat(b, 0.75f),
+		    NewFloat(b, 1.0f));
+	}
+
+	Submit(b, CVector4(0.25f, 0.5f, 0.75f, 1.0f));
+}
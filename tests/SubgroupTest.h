@@ -0,0 +1,9 @@
+#pragma once
+
+#include "Test.h"
+
+class CSubgroupTest : public CTest
+{
+public:
+	void Run() override;
+};
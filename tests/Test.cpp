@@ -6,14 +6,53 @@
 #include "MemStream.h"
 #include "string_format.h"
 
-void CTest::Submit(const Nuanceur::CShaderBuilder& shaderBuilder, const CVector4& expectedValue)
+void CTest::Submit(const Nuanceur::CShaderBuilder& shaderBuilder, const CVector4& expectedValue, const SUBMIT_PARAMS& params)
 {
 	std::string testString;
+	if(!params.requirements.empty())
+	{
+		testString += "[require]\r\n";
+		testString += params.requirements;
+	}
 	testString += "[vertex shader passthrough]\r\n";
 	testString += "[fragment shader binary]\r\n";
+	testString += PrintShaderBinary(GenerateCode(shaderBuilder, Nuanceur::CSpirvShaderGenerator::SHADER_TYPE_FRAGMENT, params.generatorFlags));
+
+	testString += "[test]\r\n";
+	testString += params.setup;
+	testString += "draw rect -1 -1 2 2\r\n";
+	testString += "\r\n";
+
+	testString += string_format("probe all rgba %f %f %f %f\r\n",
+		expectedValue.x, expectedValue.y, expectedValue.z, expectedValue.w);
+	testString += params.checks;
 
-	auto shader = GenerateCode(shaderBuilder);
+	Execute(testString);
+}
+
+void CTest::SubmitCompute(const Nuanceur::CShaderBuilder& shaderBuilder, uint32 groupCount, const SUBMIT_PARAMS& params)
+{
+	std::string testString;
+	if(!params.requirements.empty())
+	{
+		testString += "[require]\r\n";
+		testString += params.requirements;
+	}
+	testString += "[compute shader binary]\r\n";
+	testString += PrintShaderBinary(GenerateCode(shaderBuilder, Nuanceur::CSpirvShaderGenerator::SHADER_TYPE_COMPUTE, params.generatorFlags));
+
+	testString += "[test]\r\n";
+	testString += params.setup;
+	testString += string_format("compute %d 1 1\r\n", groupCount);
+	testString += "\r\n";
+	testString += params.checks;
 
+	Execute(testString);
+}
+
+std::string CTest::PrintShaderBinary(const std::vector<uint32>& shader)
+{
+	std::string result;
 	static constexpr uint32 lineSize = 16;
 	uint32 lines = (shader.size() + lineSize - 1) / lineSize;
 	for(int i = 0; i < lines; i++)
@@ -22,18 +61,15 @@ void CTest::Submit(const Nuanceur::CShaderBuilder& shaderBuilder, const CVector4
 		{
 			uint32 itemIndex = (i * lineSize) + j;
 			if(itemIndex == shader.size()) break;
-			testString += string_format("%x ", shader[itemIndex]);
+			result += string_format("%x ", shader[itemIndex]);
 		}
-		testString += "\r\n";
+		result += "\r\n";
 	}
+	return result;
+}
 
-	testString += "[test]\r\n";
-	testString += "draw rect -1 -1 2 2\r\n";
-	testString += "\r\n";
-
-	testString += string_format("probe all rgba %f %f %f %f\r\n",
-		expectedValue.x, expectedValue.y, expectedValue.z, expectedValue.w);
-
+void CTest::Execute(const std::string& testString)
+{
 	/* Create a source representing the file */
 	struct vr_source* source = vr_source_from_string(testString.c_str());
 
@@ -51,9 +87,29 @@ void CTest::Submit(const Nuanceur::CShaderBuilder& shaderBuilder, const CVector4
 	assert(result == VR_RESULT_PASS);
 }
 
-std::vector<uint32> CTest::GenerateCode(const Nuanceur::CShaderBuilder& shaderBuilder)
+std::vector<uint32> CTest::GenerateCode(const Nuanceur::CShaderBuilder& shaderBuilder, Nuanceur::CSpirvShaderGenerator::SHADER_TYPE shaderType, uint32 generatorFlags)
 {
 	Framework::CMemStream shaderStream;
-	Nuanceur::CSpirvShaderGenerator::Generate(shaderStream, shaderBuilder, Nuanceur::CSpirvShaderGenerator::SHADER_TYPE_FRAGMENT);
+	Nuanceur::CSpirvShaderGenerator::Generate(shaderStream, shaderBuilder, shaderType, generatorFlags);
 	return std::vector<uint32>(reinterpret_cast<uint32*>(shaderStream.GetBuffer()), reinterpret_cast<uint32*>(shaderStream.GetBuffer() + shaderStream.GetSize()));
 }
+
+std::vector<CTest::SPIRV_INSTRUCTION> CTest::GetSpirvInstructions(const Nuanceur::CShaderBuilder& shaderBuilder, Nuanceur::CSpirvShaderGenerator::SHADER_TYPE shaderType, uint32 generatorFlags)
+{
+	//Skip the header (magic, version, generator, bound, schema)
+	static constexpr uint32 headerSize = 5;
+	auto shader = GenerateCode(shaderBuilder, shaderType, generatorFlags);
+	std::vector<SPIRV_INSTRUCTION> result;
+	uint32 position = headerSize;
+	while(position < shader.size())
+	{
+		uint32 wordCount = shader[position] >> 16;
+		assert(wordCount != 0);
+		SPIRV_INSTRUCTION instruction;
+		instruction.op = shader[position] & 0xFFFF;
+		instruction.operands.assign(shader.begin() + position + 1, shader.begin() + position + wordCount);
+		result.push_back(instruction);
+		position += wordCount;
+	}
+	return result;
+}
@@ -1,14 +1,11 @@
 #pragma once
 
+#include <string>
 #include <vector>
 #include "math/Vector4.h"
+#include "nuanceur/generators/SpirvShaderGenerator.h"
 #include "Types.h"
 
-namespace Nuanceur
-{
-	class CShaderBuilder;
-}
-
 class CTest
 {
 public:
@@ -16,8 +13,37 @@ public:
 	virtual void Run() = 0;
 
 protected:
-	void Submit(const Nuanceur::CShaderBuilder&, const CVector4&);
+	struct SPIRV_INSTRUCTION
+	{
+		uint32 op = 0;
+		std::vector<uint32> operands;
+	};
+
+	//vkrunner script lines for tests that need device features or buffers
+	struct SUBMIT_PARAMS
+	{
+		SUBMIT_PARAMS()
+		    : generatorFlags(0)
+		{
+		}
+
+		std::string requirements; //Lines of the [require] section (ie.: device features)
+		std::string setup;        //Commands run before drawing (ie.: buffer contents)
+		std::string checks;       //Commands run after drawing (ie.: buffer probes)
+		uint32 generatorFlags;    //Flags given to the SPIR-V generator
+	};
+
+	void Submit(const Nuanceur::CShaderBuilder&, const CVector4&, const SUBMIT_PARAMS& = SUBMIT_PARAMS());
+	//Dispatches a compute shader, results are expected to be checked through params.checks
+	void SubmitCompute(const Nuanceur::CShaderBuilder&, uint32 groupCount, const SUBMIT_PARAMS&);
+
+	//Decodes the generated SPIR-V to check its contents
+	std::vector<SPIRV_INSTRUCTION> GetSpirvInstructions(const Nuanceur::CShaderBuilder&,
+	                                                    Nuanceur::CSpirvShaderGenerator::SHADER_TYPE = Nuanceur::CSpirvShaderGenerator::SHADER_TYPE_FRAGMENT,
+	                                                    uint32 generatorFlags = 0);
 
 private:
-	std::vector<uint32> GenerateCode(const Nuanceur::CShaderBuilder&);
+	std::vector<uint32> GenerateCode(const Nuanceur::CShaderBuilder&, Nuanceur::CSpirvShaderGenerator::SHADER_TYPE, uint32 generatorFlags);
+	static std::string PrintShaderBinary(const std::vector<uint32>&);
+	static void Execute(const std::string&);
 };
@@ -0,0 +1,51 @@
+#include "TexelBufferTest.h"
+#include <algorithm>
+#include "nuanceur/Builder.h"
+
+void CTexelBufferTest::Run()
+{
+	using namespace Nuanceur;
+
+	auto b = CShaderBuilder();
+
+	{
+		auto inputPosition = CFloat4Lvalue(b.CreateInput(Nuanceur::SEMANTIC_SYSTEM_POSITION));
+		auto outputColor = CFloat4Lvalue(b.CreateOutput(Nuanceur::SEMANTIC_SYSTEM_COLOR));
+		auto uniformBuffer = CUniformTexelBufferValue(b.CreateUniformTexelBuffer(0));
+		auto storageBuffer = CStorageTexelBufferUintValue(b.CreateStorageTexelBufferUint(1));
+		auto index = CIntLvalue(b.CreateTemporaryInt());
+
+		index = ToInt(inputPosition->x());
+		Store(storageBuffer, index, Load(storageBuffer, index + NewInt(b, 1)));
+		outputColor = Fetch(uniformBuffer, index);
+	}
+
+	//The test runner can't bind texel buffers, so only the generated instructions are checked
+	auto instructions = GetSpirvInstructions(b);
+	auto hasOp = [&](uint32 op) {
+		return std::any_of(instructions.begin(), instructions.end(),
+		                   [&](const SPIRV_INSTRUCTION& instruction) { return instruction.op == op; });
+	};
+	auto hasBufferImageType = [&](uint32 sampled, uint32 format) {
+		return std::any_of(instructions.begin(), instructions.end(),
+		                   [&](const SPIRV_INSTRUCTION& instruction) {
+			                   return (instruction.op == spv::OpTypeImage) &&
+			                          (instruction.operands[2] == spv::DimBuffer) &&
+			                          (instruction.operands[6] == sampled) &&
+			                          (instruction.operands[7] == format);
+		                   });
+	};
+	auto hasCapability = [&](uint32 capability) {
+		return std::any_of(instructions.begin(), instructions.end(),
+		                   [&](const SPIRV_INSTRUCTION& instruction) {
+			                   return (instruction.op == spv::OpCapability) && (instruction.operands[0] == capability);
+		                   });
+	};
+	assert(hasBufferImageType(1, spv::ImageFormatUnknown));
+	assert(hasBufferImageType(2, spv::ImageFormatR32ui));
+	assert(hasCapability(spv::CapabilitySampledBuffer));
+	assert(hasCapability(spv::CapabilityImageBuffer));
+	assert(hasOp(spv::OpImageFetch));
+	assert(hasOp(spv::OpImageRead));
+	assert(hasOp(spv::OpImageWrite));
+}
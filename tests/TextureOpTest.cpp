@@ -0,0 +1,45 @@
+#include "TextureOpTest.h"
+#include <algorithm>
+#include "nuanceur/Builder.h"
+
+void CTextureOpTest::Run()
+{
+	using namespace Nuanceur;
+
+	auto b = CShaderBuilder();
+
+	{
+		auto inputPosition = CFloat4Lvalue(b.CreateInput(Nuanceur::SEMANTIC_SYSTEM_POSITION));
+		auto outputColor = CFloat4Lvalue(b.CreateOutput(Nuanceur::SEMANTIC_SYSTEM_COLOR));
+		auto texture = CTexture2DValue(b.CreateTexture2D(0));
+		auto coord = CFloat2Lvalue(b.CreateTemporary());
+		auto color = CFloat4Lvalue(b.CreateTemporary());
+
+		coord = inputPosition->xy() * NewFloat2(b, 1.0f / 250.0f, 1.0f / 250.0f);
+		color = SampleLod(texture, coord, NewFloat(b, 1.0f));
+		color = color + SampleGrad(texture, coord, NewFloat2(b, 0.1f, 0.0f), NewFloat2(b, 0.0f, 0.1f));
+		color = color + SampleOffset(texture, coord, 1, -1);
+		color = color + Fetch(texture, ToInt(inputPosition->xy()), NewInt(b, 0));
+		color = color + Gather(texture, coord, 2);
+		outputColor = color->xyzw();
+	}
+
+	//The test runner can't bind textures, so only the generated instructions are checked
+	auto instructions = GetSpirvInstructions(b);
+	auto findOperands = [&](uint32 op, uint32 imageOperands) {
+		return std::any_of(instructions.begin(), instructions.end(),
+		                   [&](const SPIRV_INSTRUCTION& instruction) {
+			                   return (instruction.op == op) && (instruction.operands.size() > 4) &&
+			                          (instruction.operands[4] == imageOperands);
+		                   });
+	};
+	auto hasOp = [&](uint32 op) {
+		return std::any_of(instructions.begin(), instructions.end(),
+		                   [&](const SPIRV_INSTRUCTION& instruction) { return instruction.op == op; });
+	};
+	assert(findOperands(spv::OpImageSampleExplicitLod, spv::ImageOperandsLodMask));
+	assert(findOperands(spv::OpImageSampleExplicitLod, spv::ImageOperandsGradMask));
+	assert(findOperands(spv::OpImageSampleImplicitLod, spv::ImageOperandsConstOffsetMask));
+	assert(findOperands(spv::OpImageFetch, spv::ImageOperandsLodMask));
+	assert(hasOp(spv::OpImageGather));
+}
@@ -0,0 +1,32 @@
+#include "UintArrayTest.h"
+#include "nuanceur/Builder.h"
+
+void CUintArrayTest::Run()
+{
+	using namespace Nuanceur;
+
+	auto b = CShaderBuilder();
+	b.SetMetadata(CShaderBuilder::METADATA_LOCALSIZE_X, 2);
+
+	{
+		auto localIndex = CIntLvalue(b.CreateInputInt(Nuanceur::SEMANTIC_SYSTEM_LIINDEX));
+		auto source = CArrayUint4Value(b.CreateUniformArrayUint4("source", 0));
+		auto result2 = CArrayUint2Value(b.CreateUniformArrayUint2("result2", 1));
+		auto result4 = CArrayUint4Value(b.CreateUniformArrayUint4("result4", 2));
+		auto value = CUint4Lvalue(b.CreateTemporaryUint());
+
+		value = Load(source, localIndex);
+		Store(result2, localIndex, value->zw());
+		Store(result4, NewInt(b, 1) - localIndex, value);
+	}
+
+	SUBMIT_PARAMS params;
+	params.setup =
+	    "ssbo 0 subdata uint 0 1 2 3 4 5 6 7 8\r\n"
+	    "ssbo 1 16\r\n"
+	    "ssbo 2 32\r\n";
+	params.checks =
+	    "probe ssbo uint 1 0 == 3 4 7 8\r\n"
+	    "probe ssbo uint 2 0 == 5 6 7 8 1 2 3 4\r\n";
+	SubmitCompute(b, 1, params);
+}
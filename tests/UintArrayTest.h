@@ -0,0 +1,9 @@
+#pragma once
+
+#include "Test.h"
+
+class CUintArrayTest : public CTest
+{
+public:
+	void Run() override;
+};
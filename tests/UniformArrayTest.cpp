@@ -0,0 +1,36 @@
+#include "UniformArrayTest.h"
+#include "nuanceur/Builder.h"
+#include "nuanceur/generators/HlslShaderGenerator.h"
+
+void CUniformArrayTest::Run()
+{
+	using namespace Nuanceur;
+
+	auto b = CShaderBuilder();
+
+	{
+		auto outputColor = CFloat4Lvalue(b.CreateOutput(Nuanceur::SEMANTIC_SYSTEM_COLOR));
+		auto transforms = CArrayMatrix44Value(b.CreateUniformArrayMatrix("transforms", 2, 0));
+		auto colors = CArrayFloat4Value(b.CreateUniformArrayFloat4("colors", 2, 0));
+		auto indices = CArrayInt4Value(b.CreateUniformArrayInt4("indices", 2, 0));
+		auto index = CIntLvalue(b.CreateTemporaryInt());
+
+		index = Load(indices, NewInt(b, 1))->x();
+		outputColor = Multiply(transforms, index, Load(colors, index));
+	}
+
+	{
+		auto shaderCode = CHlslShaderGenerator::Generate("main", b);
+		assert(shaderCode.find("\tmatrix transforms[2];\r\n\tfloat4 colors[2];\r\n\tint4 indices[2];\r\n") != std::string::npos);
+		assert(shaderCode.find("mul(transforms[") != std::string::npos);
+	}
+
+	//Members are all 16 bytes aligned with std140: transforms at 0, colors at 128, indices at 160.
+	//transforms[1] scales x and y and translates y, the matrix is given in column major order.
+	SUBMIT_PARAMS params;
+	params.setup =
+	    "uniform ubo 0 mat4 64 0.5 0 0 0  0 0.25 0 0  0 0 1 0  0 0.25 0 1\r\n"
+	    "uniform ubo 0 vec4 144 1 1 0.5 1\r\n"
+	    "uniform ubo 0 ivec4 176 1 0 0 0\r\n";
+	Submit(b, CVector4(0.5f, 0.5f, 0.5f, 1.0f), params);
+}
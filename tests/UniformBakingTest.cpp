@@ -0,0 +1,83 @@
+#include "UniformBakingTest.h"
+#include "nuanceur/Builder.h"
+#include "nuanceur/passes/UniformBakingPass.h"
+
+void CUniformBakingTest::Run()
+{
+	RunVectorUniforms();
+	RunSmallFloatUniforms();
+}
+
+void CUniformBakingTest::RunVectorUniforms()
+{
+	using namespace Nuanceur;
+
+	auto b = CShaderBuilder();
+
+	auto flagsSymbol = b.CreateUniformInt4("flags", Nuanceur::UNIFORM_UNIT_PUSHCONSTANT);
+	auto colorSymbol = b.CreateUniformFloat4("color", Nuanceur::UNIFORM_UNIT_PUSHCONSTANT);
+	auto transformSymbol = b.CreateUniformMatrix("transform", Nuanceur::UNIFORM_UNIT_PUSHCONSTANT);
+
+	{
+		auto outputColor = CFloat4Lvalue(b.CreateOutput(Nuanceur::SEMANTIC_SYSTEM_COLOR));
+		auto flags = CInt4Lvalue(flagsSymbol);
+		auto color = CFloat4Lvalue(colorSymbol);
+
+		auto transform = CMatrix44Value(transformSymbol);
+
+		outputColor = NewFloat4(b, 0, 0, 0, 0);
+		BeginIf(b, (flags->x() & NewInt(b, 1)) == NewInt(b, 1));
+		{
+			outputColor = color * NewFloat4(b, 2, 2, 2, 2);
+		}
+		EndIf(b);
+		BeginIf(b, (flags->y() & NewInt(b, 1)) == NewInt(b, 1));
+		{
+			outputColor = NewFloat4(b, 1, 1, 1, 1);
+		}
+		EndIf(b);
+		BeginIf(b, (flags->z() & NewInt(b, 1)) == NewInt(b, 1));
+		{
+			outputColor = transform * outputColor;
+		}
+		EndIf(b);
+	}
+
+	CUniformBakingPass::CValueMap values;
+	values.SetValue(flagsSymbol, CShaderBuilder::CIntVector4(1, 0, 0, 0));
+	values.SetValue(colorSymbol, CVector4(0.25f, 0.5f, 0, 0.5f));
+	//Matrices can't be baked, their value is ignored
+	values.SetValue(transformSymbol, CVector4(1, 1, 1, 1));
+
+	auto bakedBuilder = CUniformBakingPass::Run(b, values);
+
+	Submit(bakedBuilder, CVector4(0.5f, 1, 0, 1));
+}
+
+void CUniformBakingTest::RunSmallFloatUniforms()
+{
+	using namespace Nuanceur;
+
+	auto b = CShaderBuilder();
+
+	auto biasSymbol = b.CreateUniformFloat("bias", Nuanceur::UNIFORM_UNIT_PUSHCONSTANT);
+	auto offsetSymbol = b.CreateUniformFloat2("offset", Nuanceur::UNIFORM_UNIT_PUSHCONSTANT);
+
+	{
+		auto outputColor = CFloat4Lvalue(b.CreateOutput(Nuanceur::SEMANTIC_SYSTEM_COLOR));
+		auto bias = CFloat4Lvalue(biasSymbol);
+		auto offset = CFloat4Lvalue(offsetSymbol);
+
+		//Reads the components that aren't stored by the uniforms
+		outputColor = offset->wxyz() + bias->wzyx();
+	}
+
+	//Components beyond the uniform's size are baked as 0
+	CUniformBakingPass::CValueMap values;
+	values.SetValue(biasSymbol, CVector4(0.25f, 0.125f, 0.125f, 0.125f));
+	values.SetValue(offsetSymbol, CVector4(0.5f, 0.75f, 0.125f, 0.125f));
+
+	auto bakedBuilder = CUniformBakingPass::Run(b, values);
+
+	Submit(bakedBuilder, CVector4(0, 0.5f, 0.75f, 0.25f));
+}
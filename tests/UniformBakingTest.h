@@ -0,0 +1,13 @@
+#pragma once
+
+#include "Test.h"
+
+class CUniformBakingTest : public CTest
+{
+public:
+	void Run() override;
+
+private:
+	void RunVectorUniforms();
+	void RunSmallFloatUniforms();
+};
@@ -0,0 +1,59 @@
+#include "UniformLayoutTest.h"
+#include "nuanceur/Builder.h"
+#include "nuanceur/builder/UniformLayout.h"
+
+void CUniformLayoutTest::Run()
+{
+	using namespace Nuanceur;
+
+	auto b = CShaderBuilder();
+
+	auto srcSymbol = b.CreateUniformBufferPointerUint("src");
+	auto scaleSymbol = b.CreateUniformFloat4("scale", Nuanceur::UNIFORM_UNIT_PUSHCONSTANT);
+	auto dstSymbol = b.CreateUniformBufferPointerUint("dst");
+	auto tintSymbol = b.CreateUniformFloat4("tint", 0);
+	auto matricesSymbol = b.CreateUniformArrayMatrix("matrices", 2, 0);
+
+	{
+		auto outputColor = CFloat4Lvalue(b.CreateOutput(Nuanceur::SEMANTIC_SYSTEM_COLOR));
+		outputColor = NewFloat4(b, 0.25f, 0.5f, 0.75f, 1.0f);
+	}
+
+	{
+		//Pointers are placed after vectors to avoid padding
+		auto blockLayouts = UniformLayout::ComputeBlockLayouts(b);
+		const auto& pushConstantLayout = blockLayouts[CShaderBuilder::BINDING(0, Nuanceur::UNIFORM_UNIT_PUSHCONSTANT)];
+		assert(pushConstantLayout.layout == UNIFORM_LAYOUT_STD430);
+		assert(pushConstantLayout.size == 32);
+		assert(pushConstantLayout.members[0].symbol.index == scaleSymbol.index);
+		assert(pushConstantLayout.members[1].symbol.index == srcSymbol.index);
+		assert(pushConstantLayout.members[1].offset == 16);
+		assert(pushConstantLayout.members[2].symbol.index == dstSymbol.index);
+		assert(pushConstantLayout.members[2].offset == 24);
+
+		const auto& blockLayout = blockLayouts[CShaderBuilder::BINDING(0, 0)];
+		assert(blockLayout.layout == UNIFORM_LAYOUT_STD140);
+		assert(blockLayout.size == 144);
+		assert(blockLayout.members[0].symbol.index == tintSymbol.index);
+		assert(blockLayout.members[1].symbol.index == matricesSymbol.index);
+		assert(blockLayout.members[1].offset == 16);
+		assert(blockLayout.members[1].arrayStride == 64);
+		assert(blockLayout.members[1].matrixStride == 16);
+	}
+
+	{
+		//Vectors only need to be aligned on their components with scalar layout
+		b.SetMetadata(CShaderBuilder::METADATA_SCALAR_BLOCK_LAYOUT, 1);
+		auto blockLayouts = UniformLayout::ComputeBlockLayouts(b);
+		const auto& pushConstantLayout = blockLayouts[CShaderBuilder::BINDING(0, Nuanceur::UNIFORM_UNIT_PUSHCONSTANT)];
+		assert(pushConstantLayout.layout == UNIFORM_LAYOUT_SCALAR);
+		assert(pushConstantLayout.size == 32);
+		assert(pushConstantLayout.members[0].symbol.index == srcSymbol.index);
+		assert(pushConstantLayout.members[1].symbol.index == dstSymbol.index);
+		assert(pushConstantLayout.members[2].symbol.index == scaleSymbol.index);
+		assert(pushConstantLayout.members[2].offset == 16);
+		b.SetMetadata(CShaderBuilder::METADATA_SCALAR_BLOCK_LAYOUT, 0);
+	}
+
+	Submit(b, CVector4(0.25f, 0.5f, 0.75f, 1.0f));
+}
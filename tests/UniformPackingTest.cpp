@@ -0,0 +1,59 @@
+#include "UniformPackingTest.h"
+#include "nuanceur/Builder.h"
+#include "nuanceur/builder/UniformLayout.h"
+
+void CUniformPackingTest::Run()
+{
+	using namespace Nuanceur;
+
+	auto b = CShaderBuilder();
+
+	auto biasSymbol = b.CreateUniformFloat("bias", Nuanceur::UNIFORM_UNIT_PUSHCONSTANT);
+	auto offsetSymbol = b.CreateUniformFloat2("offset", Nuanceur::UNIFORM_UNIT_PUSHCONSTANT);
+	auto tintSymbol = b.CreateUniformFloat4("tint", Nuanceur::UNIFORM_UNIT_PUSHCONSTANT);
+
+	{
+		auto outputColor = CFloat4Lvalue(b.CreateOutput(Nuanceur::SEMANTIC_SYSTEM_COLOR));
+		auto bias = CFloatLvalue(biasSymbol);
+		auto offset = CFloat2Lvalue(offsetSymbol);
+		auto tint = CFloat4Lvalue(tintSymbol);
+
+		outputColor = tint + NewFloat4(offset, NewFloat2(bias, bias));
+	}
+
+	{
+		//The scalar fills the space left after the vec2
+		auto blockLayouts = UniformLayout::ComputeBlockLayouts(b);
+		const auto& pushConstantLayout = blockLayouts[CShaderBuilder::BINDING(0, Nuanceur::UNIFORM_UNIT_PUSHCONSTANT)];
+		assert(pushConstantLayout.layout == UNIFORM_LAYOUT_STD430);
+		assert(pushConstantLayout.size == 28);
+		assert(pushConstantLayout.members[0].symbol.index == tintSymbol.index);
+		assert(pushConstantLayout.members[1].symbol.index == offsetSymbol.index);
+		assert(pushConstantLayout.members[1].offset == 16);
+		assert(pushConstantLayout.members[1].size == 8);
+		assert(pushConstantLayout.members[2].symbol.index == biasSymbol.index);
+		assert(pushConstantLayout.members[2].offset == 24);
+		assert(pushConstantLayout.members[2].size == 4);
+	}
+
+	{
+		//All members are aligned on their components with scalar layout, declaration order is kept
+		b.SetMetadata(CShaderBuilder::METADATA_SCALAR_BLOCK_LAYOUT, 1);
+		auto blockLayouts = UniformLayout::ComputeBlockLayouts(b);
+		const auto& pushConstantLayout = blockLayouts[CShaderBuilder::BINDING(0, Nuanceur::UNIFORM_UNIT_PUSHCONSTANT)];
+		assert(pushConstantLayout.size == 28);
+		assert(pushConstantLayout.members[0].symbol.index == biasSymbol.index);
+		assert(pushConstantLayout.members[1].symbol.index == offsetSymbol.index);
+		assert(pushConstantLayout.members[1].offset == 4);
+		assert(pushConstantLayout.members[2].symbol.index == tintSymbol.index);
+		assert(pushConstantLayout.members[2].offset == 12);
+		b.SetMetadata(CShaderBuilder::METADATA_SCALAR_BLOCK_LAYOUT, 0);
+	}
+
+	SUBMIT_PARAMS params;
+	params.setup =
+	    "push vec4 0 0.5 0.25 0.5 0.875\r\n"
+	    "push vec2 16 0.25 0.5\r\n"
+	    "push float 24 0.125\r\n";
+	Submit(b, CVector4(0.75f, 0.75f, 0.625f, 1.0f), params);
+}
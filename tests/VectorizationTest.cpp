@@ -0,0 +1,67 @@
+#include "VectorizationTest.h"
+#include "nuanceur/Builder.h"
+#include "nuanceur/passes/VectorizationPass.h"
+
+void CVectorizationTest::Run()
+{
+	using namespace Nuanceur;
+
+	auto b = CShaderBuilder();
+
+	{
+		auto outputColor = CFloat4Lvalue(b.CreateOutput(Nuanceur::SEMANTIC_SYSTEM_COLOR));
+		auto baseColor = CFloat4Lvalue(b.CreateTemporary());
+		auto color = CFloat4Lvalue(b.CreateTemporary());
+
+		baseColor = NewFloat4(b, 0.5f, 1.0f, 0.5f, 0.25f);
+
+		auto baseColorX = CFloatLvalue(baseColor.symbol, SWIZZLE_X);
+		auto baseColorY = CFloatLvalue(baseColor.symbol, SWIZZLE_Y);
+		auto baseColorZ = CFloatLvalue(baseColor.symbol, SWIZZLE_Z);
+		auto colorX = CFloatLvalue(color.symbol, SWIZZLE_X);
+		auto colorY = CFloatLvalue(color.symbol, SWIZZLE_Y);
+		auto colorZ = CFloatLvalue(color.symbol, SWIZZLE_Z);
+		auto colorW = CFloatLvalue(color.symbol, SWIZZLE_W);
+
+		colorX = baseColorX * NewFloat(b, 0.5f) + baseColorX;
+		colorY = baseColorY * NewFloat(b, 0.25f) + baseColorZ;
+		colorZ = baseColorZ * NewFloat(b, 0.5f);
+		colorW = NewFloat(b, 1.0f);
+
+		outputColor = color->xyzw();
+	}
+
+	auto statementCount = b.GetStatements().size();
+	CVectorizationPass::Run(b);
+	assert(b.GetStatements().size() < statementCount);
+
+	Submit(b, CVector4(0.75f, 0.75f, 0.25f, 1.0f));
+
+	//Parameters are never written inside of functions, but must not be combined as constants
+	auto fb = CShaderBuilder();
+
+	{
+		auto offsetFunction = BeginFunction(fb, CShaderBuilder::SYMBOL_TYPE_FLOAT4);
+		{
+			auto value1 = CFloat4Lvalue(fb.CreateParameter(CShaderBuilder::SYMBOL_TYPE_FLOAT4));
+			auto value2 = CFloat4Lvalue(fb.CreateParameter(CShaderBuilder::SYMBOL_TYPE_FLOAT4));
+			auto result = CFloat4Lvalue(fb.CreateTemporary());
+
+			auto resultX = CFloatLvalue(result.symbol, SWIZZLE_X);
+			auto resultY = CFloatLvalue(result.symbol, SWIZZLE_Y);
+
+			resultX = CFloatLvalue(value1.symbol, SWIZZLE_X) + NewFloat(fb, 0.25f);
+			resultY = CFloatLvalue(value2.symbol, SWIZZLE_Y) + NewFloat(fb, 0.25f);
+			Return(fb, result);
+		}
+		EndFunction(fb);
+
+		auto outputColor = CFloat4Lvalue(fb.CreateOutput(Nuanceur::SEMANTIC_SYSTEM_COLOR));
+		auto offset = CFloat4Lvalue(Call(fb, offsetFunction, NewFloat4(fb, 0.25f, 0, 0, 0), NewFloat4(fb, 0, 0.5f, 0, 0)));
+		outputColor = offset + NewFloat4(fb, 0, 0, 0.75f, 1.0f);
+	}
+
+	CVectorizationPass::Run(fb);
+
+	Submit(fb, CVector4(0.5f, 0.75f, 0.75f, 1.0f));
+}